@@ -2,7 +2,7 @@
  * @Description: IDLog 异步日志示例 (手动配置)
  * @Author: InverseDark
  * @Date: 2025-12-27 13:08:21
- * @LastEditTime: 2025-12-27 14:17:42
+ * @LastEditTime: 2026-10-18 23:34:08
  * @LastEditors: InverseDark
  */
 #include "IDLog/IDLog.h"
@@ -57,7 +57,7 @@ void RunLoadTest()
 
     auto worker = [&](int id) {
         for (int i = 0; i < logsPerThread; ++i) {
-            IDLOG_INFO_FMT("Thread-%d log message #%d", id, i);
+            IDLOG_INFO_FMT("Thread-{} log message #{}", id, i);
             counter++;
         }
     };
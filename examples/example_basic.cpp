@@ -2,7 +2,7 @@
  * @Description: IDLog 基础用法示例
  * @Author: InverseDark
  * @Date: 2025-12-27 13:07:38
- * @LastEditTime: 2025-12-27 13:13:38
+ * @LastEditTime: 2026-10-18 23:34:08
  * @LastEditors: InverseDark
  */
 #include "IDLog/IDLog.h"
@@ -31,8 +31,8 @@ void DemoFormattedMacros()
     std::string userName = "Alice";
     double processingTime = 12.5;
 
-    IDLOG_INFO_FMT("用户登录: ID=%d, Name=%s", userId, userName.c_str());
-    IDLOG_WARN_FMT("处理耗时较长: %.2f ms", processingTime);
+    IDLOG_INFO_FMT("用户登录: ID={}, Name={}", userId, userName);
+    IDLOG_WARN_FMT("处理耗时较长: {:.2f} ms", processingTime);
 }
 
 // 演示：手动获取 Logger 对象
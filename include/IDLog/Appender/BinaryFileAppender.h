@@ -0,0 +1,52 @@
+/**
+ * @Description: 二进制文件输出器头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 14:26:40
+ * @LastEditTime: 2026-10-18 15:24:37
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_APPENDER_BINARYFILEAPPENDER_H
+#define IDLOG_APPENDER_BINARYFILEAPPENDER_H
+
+#include "IDLog/Appender/FileAppender.h"
+#include "IDLog/Formatter/BinaryFormatter.h"
+
+namespace IDLog
+{
+	/// @brief 二进制文件输出器
+	/// @details 使用 BinaryFormatter 将日志编码为紧凑的二进制流写入文件，
+	///			 热路径上不做时间与文本格式化，字符串通过字典只写一次。
+	///			 编码与写入在同一把锁内完成，保证字典项先于引用它的记录落盘；
+	///			 每个新文件（包括滚动后的文件）都从新段开始，可被 idlog-decode 独立解码。
+	class IDLOG_API BinaryFileAppender : public FileAppender
+	{
+	public:
+		/// @brief 构造函数
+		/// @param filename [IN] 日志文件名
+		/// @param segmentRecords [IN] 每段最多包含的记录数
+		/// @param rollPolicy [IN] 滚动策略，默认为不滚动
+		/// @param maxSize [IN] 最大文件大小，仅在按大小滚动时有效，默认为10MB
+		explicit BinaryFileAppender(const std::string &filename,
+									size_t segmentRecords = 8192,
+									RollPolicy rollPolicy = RollPolicy::NONE,
+									size_t maxSize = 10 * 1024 * 1024);
+
+		/// @brief 析构函数
+		~BinaryFileAppender() override;
+
+		/// @brief 编码日志事件并写入文件
+		/// @param event [IN] 日志事件智能指针
+		void Append(const LogEventPtr &event) override;
+
+		/// @brief 获取输出器名称
+		/// @return 输出器名称
+		std::string GetName() const override;
+
+	protected:
+		/// @brief 文件打开后重置编码状态，使新文件从新段开始
+		void OnFileOpened() override;
+	};
+
+} // namespace IDLog
+
+#endif // !IDLOG_APPENDER_BINARYFILEAPPENDER_H
@@ -2,7 +2,7 @@
  * @Description: 控制台输出器头文件
  * @Author: InverseDark
  * @Date: 2025-12-18 21:19:49
- * @LastEditTime: 2025-12-18 21:19:49
+ * @LastEditTime: 2026-10-19 09:12:40
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_APPENDER_CONSOLEAPPENDER_H
@@ -14,6 +14,10 @@ namespace IDLog
 {
 	/// @brief 控制台输出器
 	/// @details 将日志输出到标准输出(stdout)或标准错误(stderr)
+	///			 直接对文件描述符做缓冲写入，不经过 iostream：
+	///			 - 输出为终端时按行刷新（遇到换行即写出），并按需着色
+	///			 - 输出为管道/文件时缓冲区满或刷新间隔到达才写出
+	///			 - 可选非阻塞模式：输出端写不进去时丢弃日志而不是阻塞调用线程
 	class IDLOG_API ConsoleAppender : public LogAppender
 	{
 	public:
@@ -24,6 +28,14 @@ namespace IDLog
 			STDERR	///< 标准错误
 		};
 
+		/// @brief 颜色模式枚举
+		enum class ColorMode
+		{
+			AUTO,	///< 仅当输出为终端时着色
+			ALWAYS, ///< 总是着色
+			NEVER	///< 从不着色
+		};
+
 	public:
 		/// @brief 构造函数
 		/// @param target [IN] 输出目标，默认为标准输出
@@ -31,7 +43,7 @@ namespace IDLog
 		explicit ConsoleAppender(Target target = Target::STDOUT,
 								 FormatterPtr formatter = nullptr);
 		/// @brief 析构函数
-		~ConsoleAppender() override = default;
+		~ConsoleAppender() override;
 
 		/// @brief 输出日志事件到控制台
 		/// @param event [IN] 日志事件智能指针
@@ -53,28 +65,73 @@ namespace IDLog
 		Target GetTarget() const;
 
 		/// @brief 设置是否使用颜色输出
-		/// @param useColor [IN] 是否使用颜色
+		/// @param useColor [IN] 是否使用颜色（等价于 ColorMode::ALWAYS / ColorMode::NEVER）
 		void SetUseColor(bool useColor);
 
 		/// @brief 获取是否使用颜色输出
-		/// @return 是否使用颜色
+		/// @return 当前输出目标下实际是否着色
 		bool GetUseColor() const;
 
+		/// @brief 设置颜色模式
+		/// @param mode [IN] 颜色模式
+		void SetColorMode(ColorMode mode);
+
+		/// @brief 获取颜色模式
+		/// @return 颜色模式
+		ColorMode GetColorMode() const;
+
+		/// @brief 设置写缓冲区大小
+		/// @param bufferSize [IN] 缓冲区大小（字节），为0时每条日志直接写出
+		void SetBufferSize(size_t bufferSize);
+
+		/// @brief 获取写缓冲区大小
+		/// @return 缓冲区大小（字节）
+		size_t GetBufferSize() const;
+
+		/// @brief 设置定时刷新间隔
+		/// @param flushIntervalMs [IN] 刷新间隔（毫秒），为0时不做定时刷新
+		void SetFlushInterval(uint64_t flushIntervalMs);
+
+		/// @brief 获取定时刷新间隔
+		/// @return 刷新间隔（毫秒）
+		uint64_t GetFlushInterval() const;
+
+		/// @brief 设置非阻塞模式
+		/// @param nonBlocking [IN] 是否启用非阻塞模式
+		/// @details 非阻塞模式下输出端暂时不可写（如管道已满）时丢弃待写日志并计数，
+		///			 只在日志边界停止写入，不会输出半条日志
+		void SetNonBlocking(bool nonBlocking);
+
+		/// @brief 获取是否为非阻塞模式
+		/// @return 是否启用非阻塞模式
+		bool IsNonBlocking() const;
+
+		/// @brief 获取因输出端不可写而丢弃的日志数量
+		/// @return 丢弃的日志数量
+		uint64_t GetDroppedCount() const;
+
+		/// @brief 判断当前输出目标是否为终端
+		/// @return 是否为终端
+		bool IsTerminal() const;
+
 	private:
-		/// @brief 根据日志级别获取颜色代码
-		/// @param level [IN] 日志级别
-		/// @return 颜色代码字符串
-		std::string GetLevelColor(LogLevel level) const;
+		/// @brief 刷新缓冲区（无锁版本，调用方需持有 m_mutex）
+		void FlushNoLock();
+
+		/// @brief 启动定时刷新线程（无锁版本，调用方需持有 m_mutex）
+		void StartFlushThreadNoLock();
 
-		/// @brief 获取重置颜色代码
-		/// @return 颜色代码字符串
-		std::string GetResetColor() const;
+		/// @brief 定时刷新线程函数
+		void FlushThreadFunc();
+
+	private:
+		/// @brief 控制台输出器实现结构体前向声明
+		struct Impl;
 
 	private:
-		Target m_target; ///< 输出目标
-		bool m_useColor; ///< 是否使用颜色输出
+		Impl *m_pImpl; ///< 控制台输出器实现指针
 	};
 
 } // namespace IDLog
 
-#endif // !IDLOG_APPENDER_CONSOLEAPPENDER_H
\ No newline at end of file
+#endif // !IDLOG_APPENDER_CONSOLEAPPENDER_H
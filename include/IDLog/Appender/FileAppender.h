@@ -2,7 +2,7 @@
  * @Description: 文件输出器头文件
  * @Author: InverseDark
  * @Date: 2025-12-19 12:13:05
- * @LastEditTime: 2025-12-19 12:20:17
+ * @LastEditTime: 2026-10-18 15:02:44
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_APPENDER_FILEAPPENDER_H
@@ -94,6 +94,22 @@ namespace IDLog
 		/// @return 最大文件大小（字节）
 		size_t GetMaxFileSize() const;
 
+		/// @brief 设置时间索引间隔
+		/// @details 启用后在日志文件旁维护 <文件名>.idx 稀疏索引，每隔若干条记录或若干字节
+		///			 记录一次（时间戳，文件偏移），供 Utils::LogReader 按时间范围定位；
+		///			 滚动时索引随日志文件一起重命名。两个参数均为0时关闭索引。
+		/// @param records [IN] 每隔多少条记录写一个索引项，为0时不按记录数
+		/// @param bytes [IN] 每隔多少字节写一个索引项，为0时不按字节数
+		void SetIndexInterval(size_t records, size_t bytes);
+
+		/// @brief 获取按记录数的索引间隔
+		/// @return 记录数
+		size_t GetIndexRecords() const;
+
+		/// @brief 获取按字节数的索引间隔
+		/// @return 字节数
+		size_t GetIndexBytes() const;
+
 	protected:
 		/// @brief 检查是否需要滚动日志文件
 		/// @param event [IN] 日志事件智能指针
@@ -125,6 +141,27 @@ namespace IDLog
 		/// @brief 无锁关闭日志文件（仅供内部使用）
 		void CloseNoLock();
 
+		/// @brief 无锁写入原始数据（仅供内部使用，调用方需持有 m_mutex）
+		/// @param data [IN] 数据指针
+		/// @param size [IN] 数据长度
+		void WriteNoLock(const char *data, size_t size);
+
+		/// @brief 按索引间隔判断是否需要写索引项，需要时在当前写入位置写入（调用方需持有 m_mutex）
+		/// @param event [IN] 即将写入的日志事件
+		void MaybeIndexNoLock(const LogEventPtr &event);
+
+		/// @brief 在当前写入位置无条件写入索引项（调用方需持有 m_mutex，未启用索引时忽略）
+		/// @param event [IN] 即将写入的日志事件
+		void WriteIndexEntryNoLock(const LogEventPtr &event);
+
+		/// @brief 文件打开后的回调（调用方持有 m_mutex）
+		/// @details 子类可重写以在每个新文件（包括滚动后的新文件）开头写入文件头等信息
+		virtual void OnFileOpened();
+
+		/// @brief 设置是否以二进制模式打开文件，会重新打开当前文件
+		/// @param binary [IN] 是否为二进制模式
+		void SetBinaryMode(bool binary);
+
 	private:
 		/// @brief 文件输出器实现结构体前向声明
 		struct Impl;
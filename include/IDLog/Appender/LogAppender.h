@@ -2,7 +2,7 @@
  * @Description: 日志输出器基类头文件
  * @Author: InverseDark
  * @Date: 2025-12-18 20:26:38
- * @LastEditTime: 2025-12-26 21:24:17
+ * @LastEditTime: 2026-10-18 19:24:50
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_APPENDER_LOGAPPENDER_H
@@ -14,6 +14,7 @@
 
 namespace IDLog
 {
+	class AppenderMetrics;
 
 	/// @brief 日志输出器基类
 	/// @details 所有输出目标（控制台、文件、网络等）的基类
@@ -59,6 +60,15 @@ namespace IDLog
 		/// @brief 刷新输出缓冲区
 		virtual void Flush() = 0;
 
+		/// @brief 获取输出器指标
+		/// @details 记录数、字节数、写调用、刷新、写入错误等，由各输出器在写出路径上更新
+		/// @return 输出器指标引用
+		AppenderMetrics &GetMetrics();
+
+		/// @brief 获取输出器指标（常量版本）
+		/// @return 输出器指标引用
+		const AppenderMetrics &GetMetrics() const;
+
 	protected:
 		/// @brief 获取格式化器（无锁版本）
 		/// @return 格式化器智能指针
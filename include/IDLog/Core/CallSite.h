@@ -0,0 +1,199 @@
+/**
+ * @Description: 调用点统计头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 20:21:36
+ * @LastEditTime: 2026-10-18 20:21:36
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_CORE_CALLSITE_H
+#define IDLOG_CORE_CALLSITE_H
+
+#include "IDLog/Core/Macro.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace IDLog
+{
+	/// @brief 日志调用点
+	/// @details 每条日志语句（文件、行号、函数）对应一个静态实例，由 IDLOG_SOURCE_LOCATION 宏在首次执行时创建并注册，
+	///			 此后随 SourceLocation 传入日志器。计数使用 relaxed 原子加，仅在调用点统计开启时更新。
+	///			 实例生命周期为静态存储期，注册后不会注销。
+	class IDLOG_API CallSite
+	{
+	public:
+		/// @brief 构造函数（同时注册到调用点统计器）
+		/// @param fileName [IN] 源文件名，需为静态字符串
+		/// @param functionName [IN] 函数名，需为静态字符串
+		/// @param lineNumber [IN] 行号
+		CallSite(const char *fileName, const char *functionName, int lineNumber);
+
+		/// @brief 拷贝构造函数(禁用)
+		CallSite(const CallSite &) = delete;
+
+		/// @brief 拷贝赋值运算符(禁用)
+		CallSite &operator=(const CallSite &) = delete;
+
+		/// @brief 记录一次输出
+		/// @param bytes [IN] 消息字节数
+		void RecordEmitted(size_t bytes)
+		{
+			m_calls.fetch_add(1, std::memory_order_relaxed);
+			m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+		}
+
+		/// @brief 记录一次丢弃（被过滤器拒绝或被异步队列丢弃）
+		/// @param bytes [IN] 消息字节数
+		void RecordDropped(size_t bytes)
+		{
+			m_droppedCalls.fetch_add(1, std::memory_order_relaxed);
+			m_droppedBytes.fetch_add(bytes, std::memory_order_relaxed);
+		}
+
+		/// @brief 清零计数
+		void Reset();
+
+		/// @brief 获取源文件名
+		/// @return 源文件名
+		const char *GetFileName() const { return m_fileName; }
+
+		/// @brief 获取函数名
+		/// @return 函数名
+		const char *GetFunctionName() const { return m_functionName; }
+
+		/// @brief 获取行号
+		/// @return 行号
+		int GetLineNumber() const { return m_lineNumber; }
+
+		/// @brief 获取输出次数
+		/// @return 次数
+		uint64_t GetCalls() const { return m_calls.load(std::memory_order_relaxed); }
+
+		/// @brief 获取输出字节数
+		/// @return 字节数
+		uint64_t GetBytes() const { return m_bytes.load(std::memory_order_relaxed); }
+
+		/// @brief 获取丢弃次数
+		/// @return 次数
+		uint64_t GetDroppedCalls() const { return m_droppedCalls.load(std::memory_order_relaxed); }
+
+		/// @brief 获取丢弃字节数
+		/// @return 字节数
+		uint64_t GetDroppedBytes() const { return m_droppedBytes.load(std::memory_order_relaxed); }
+
+		/// @brief 获取注册链表中的下一个调用点
+		/// @return 下一个调用点，没有时返回空指针
+		const CallSite *GetNext() const { return m_next; }
+
+	private:
+		/// @brief 调用点统计器负责串联注册链表
+		friend class CallSiteProfiler;
+
+	private:
+		const char *m_fileName;				  ///< 源文件名
+		const char *m_functionName;			  ///< 函数名
+		int m_lineNumber;					  ///< 行号
+		std::atomic<uint64_t> m_calls;		  ///< 输出次数
+		std::atomic<uint64_t> m_bytes;		  ///< 输出字节数
+		std::atomic<uint64_t> m_droppedCalls; ///< 丢弃次数
+		std::atomic<uint64_t> m_droppedBytes; ///< 丢弃字节数
+		CallSite *m_next;					  ///< 注册链表中的下一个调用点
+	};
+
+	/// @brief 调用点统计快照
+	struct IDLOG_API CallSiteStats
+	{
+		std::string fileName;	   ///< 源文件名
+		std::string functionName;  ///< 函数名
+		int lineNumber = 0;		   ///< 行号
+		uint64_t calls = 0;		   ///< 输出次数
+		uint64_t bytes = 0;		   ///< 输出字节数
+		uint64_t droppedCalls = 0; ///< 丢弃次数
+		uint64_t droppedBytes = 0; ///< 丢弃字节数
+	};
+
+	/// @brief 调用点统计器
+	/// @details 维护所有调用点的无锁注册链表（头插，只增不减），开启后日志器在每次输出时更新调用点计数，
+	///			 报告时取快照排序，列出输出量最大的日志语句。
+	class IDLOG_API CallSiteProfiler
+	{
+	public:
+		/// @brief 排序依据枚举
+		enum class SortKey
+		{
+			BYTES,		  ///< 按输出字节数
+			CALLS,		  ///< 按输出次数
+			DROPPED_BYTES ///< 按丢弃字节数
+		};
+
+	public:
+		/// @brief 获取调用点统计器单例实例
+		/// @return 调用点统计器实例引用
+		static CallSiteProfiler &GetInstance();
+
+		/// @brief 拷贝构造函数(禁用)
+		CallSiteProfiler(const CallSiteProfiler &) = delete;
+
+		/// @brief 拷贝赋值运算符(禁用)
+		CallSiteProfiler &operator=(const CallSiteProfiler &) = delete;
+
+		/// @brief 启用/禁用调用点统计
+		/// @param enabled [IN] 启用/禁用
+		void Enable(bool enabled = true);
+
+		/// @brief 检查调用点统计是否启用
+		/// @return 启用返回true，否则返回false
+		bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+		/// @brief 注册调用点（由 CallSite 构造函数调用）
+		/// @param callSite [IN] 调用点
+		void Register(CallSite *callSite);
+
+		/// @brief 获取已注册的调用点数量
+		/// @return 数量
+		size_t GetCallSiteCount() const;
+
+		/// @brief 获取所有有输出或丢弃记录的调用点快照
+		/// @return 调用点快照列表（按注册的逆序）
+		std::vector<CallSiteStats> GetAllCallSites() const;
+
+		/// @brief 获取输出量最大的若干调用点
+		/// @param count [IN] 数量
+		/// @param key [IN] 排序依据
+		/// @return 调用点快照列表（降序）
+		std::vector<CallSiteStats> GetTopCallSites(size_t count, SortKey key = SortKey::BYTES) const;
+
+		/// @brief 清零所有调用点的计数
+		void Reset();
+
+		/// @brief 生成调用点报告
+		/// @param count [IN] 列出的调用点数量
+		/// @return 报告字符串，包含每个调用点的次数、字节数、占总字节数的比例与丢弃量
+		std::string GenerateReport(size_t count = 20) const;
+
+	private:
+		/// @brief 构造函数
+		CallSiteProfiler();
+		/// @brief 析构函数
+		~CallSiteProfiler() = default;
+
+	private:
+		std::atomic<bool> m_enabled;	  ///< 是否启用
+		std::atomic<CallSite *> m_head;	  ///< 注册链表头
+		std::atomic<size_t> m_count;	  ///< 已注册的调用点数量
+	};
+
+} // namespace IDLog
+
+/// @brief 便捷宏：构造带调用点的源文件位置
+/// @details 每个展开处生成一个独立的 lambda，其中的静态 CallSite 只在首次执行时构造并注册一次
+#define IDLOG_SOURCE_LOCATION()                                                            \
+	IDLog::SourceLocation(__FILE__, __FUNCTION__, __LINE__,                                \
+						  [](const char *idlogFunction) -> IDLog::CallSite * {             \
+							  static IDLog::CallSite s_idlogCallSite(__FILE__, idlogFunction, __LINE__); \
+							  return &s_idlogCallSite;                                     \
+						  }(__FUNCTION__))
+
+#endif // !IDLOG_CORE_CALLSITE_H
@@ -2,7 +2,7 @@
  * @Description: 配置头文件
  * @Author: InverseDark
  * @Date: 2025-12-21 11:40:26
- * @LastEditTime: 2025-12-21 15:14:17
+ * @LastEditTime: 2026-10-19 09:55:40
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_CORE_CONFIGURATION_H
@@ -29,6 +29,7 @@ namespace IDLog
 				LogLevel rootLevel = LogLevel::INFO; ///< 根日志级别，默认INFO
 				bool enableStatistics = false;	 ///< 是否启用日志统计，默认禁用
 				uint64_t statisticsInterval = 60; ///< 日志统计间隔，单位秒，默认60秒
+				std::string statisticsFile;		  ///< 统计共享内存文件路径，为空时不发布，为"default"时使用默认路径
 			} global;								///< 全局配置选项
 			
 			/// @brief 日志器配置选项结构体
@@ -45,6 +46,12 @@ namespace IDLog
 			{
 				std::string type;				   ///< 过滤器类型
 				std::map<std::string, std::string> params; ///< 过滤器参数键值对
+
+				bool operator==(const FilterConfig &other) const
+				{
+					return type == other.type && params == other.params;
+				}
+				bool operator!=(const FilterConfig &other) const { return !(*this == other); }
 			};
 
 			/// @brief 输出器配置选项结构体
@@ -53,6 +60,12 @@ namespace IDLog
 				std::string type;				   ///< 输出器类型
 				std::string formatter;			   ///< 格式化器名称
 				std::map<std::string, std::string> params; ///< 输出器参数键值对
+
+				bool operator==(const AppenderConfig &other) const
+				{
+					return type == other.type && formatter == other.formatter && params == other.params;
+				}
+				bool operator!=(const AppenderConfig &other) const { return !(*this == other); }
 			};
 
 			/// @brief 格式化器配置选项结构体
@@ -60,12 +73,19 @@ namespace IDLog
 			{
 				std::string type;				   ///< 格式化器类型
 				std::map<std::string, std::string> params; ///< 格式化器参数键值对
+
+				bool operator==(const FormatterConfig &other) const
+				{
+					return type == other.type && params == other.params;
+				}
+				bool operator!=(const FormatterConfig &other) const { return !(*this == other); }
 			};
 			
 			std::map<std::string, LoggerConfig> loggers; ///< 日志器配置选项映射，键为日志器名称
 			std::map<std::string, FilterConfig> filters; ///< 过滤器配置选项映射，键为过滤器名称
 			std::map<std::string, AppenderConfig> appenders; ///< 输出器配置选项映射，键为输出器名称
 			std::map<std::string, FormatterConfig> formatters; ///< 格式化器配置选项映射，键为格式化器名称
+			std::map<std::string, LogLevel> levels;			   ///< 级别规则（[levels] 节），键为日志器名称或通配模式，如 "net.*"
 
 			/// @brief 验证配置选项的有效性
 			/// @return 如果配置有效，返回true；否则返回false
@@ -112,6 +132,9 @@ namespace IDLog
 		const Options& GetOptions() const;
 
 		/// @brief 应用配置选项
+		/// @details 增量应用：配置未变化的输出器与过滤器沿用现有实例（异步队列、已打开的文件与统计都保留），
+		///			 同名输出器在引用它的日志器之间共享；只有发生变化的日志器会原子地替换输出器与过滤器列表。
+		///			 任一实例创建失败时不修改任何日志器，当前配置选项与配置解析器也保持不变。
 		/// @param options [IN] 配置选项
 		/// @return 应用成功返回true，否则返回false
 		bool ApplyOptions(const Options &options);
@@ -140,8 +163,10 @@ namespace IDLog
 		Formatter::Pointer CreateFormatterFromConfig(const Options::FormatterConfig &config);
 
 		/// @brief 启用或禁用自动重新加载配置
+		/// @details 监视已加载的配置文件所在目录，文件变化平息后自动重新加载（Linux 下为毫秒级）；
+		///			 编辑器保存与原子重命名部署都能感知。尚未加载配置文件时，在加载后开始监视。
 		/// @param enable [IN] 是否启用自动重新加载
-		/// @param intervalSeconds [IN] 重新加载间隔时间，单位秒，默认60秒
+		/// @param intervalSeconds [IN] 系统通知不可用时的轮询间隔，单位秒，默认60秒
 		void EnableAutoReload(bool enable, uint64_t intervalSeconds = 60);
 
 		/// @brief 检查是否启用自动重新加载配置
@@ -158,8 +183,8 @@ namespace IDLog
 		/// @brief 析构函数
 		~Configuration();
 
-		/// @brief 自动重新加载线程函数
-		void AutoReloadThread();
+		/// @brief 按当前设置重启配置文件监视器（未启用自动重新加载时仅停止）
+		void RestartWatcher();
 
 		/// @brief 更新配置解析器内容
 		/// @return 更新成功返回true，否则返回false
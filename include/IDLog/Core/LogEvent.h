@@ -2,13 +2,14 @@
  * @Description: 日志事件头文件
  * @Author: InverseDark
  * @Date: 2025-12-18 18:45:19
- * @LastEditTime: 2025-12-18 18:47:41
+ * @LastEditTime: 2026-10-18 23:48:52
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_CORE_LOGEVENT_H
 #define IDLOG_CORE_LOGEVENT_H
 
 #include "IDLog/Core/LogLevel.h"
+#include "IDLog/Core/LogMessage.h"
 
 #include <sstream>
 #include <chrono>
@@ -16,6 +17,9 @@
 
 namespace IDLog
 {
+	/// @brief 日志调用点前向声明
+	class CallSite;
+
 	/// @brief 源文件位置信息
 	/// @details 用于记录日志调用所在的源文件、函数和行号
 	struct IDLOG_API SourceLocation
@@ -23,13 +27,15 @@ namespace IDLog
 		const char *fileName;	  ///< 源文件名
 		const char *functionName; ///< 函数名
 		int lineNumber;			  ///< 行号
+		CallSite *callSite;		  ///< 调用点计数器，未启用调用点统计的调用方为空
 
 		/// @brief 构造函数
 		/// @param file [IN] 文件名，通常使用__FILE__
 		/// @param function [IN] 函数名，通常使用__FUNCTION__或__func__
 		/// @param line [IN] 行号，通常使用__LINE__
-		SourceLocation(const char *file = "", const char *function = "", int line = 0)
-			: fileName(file), functionName(function), lineNumber(line) {}
+		/// @param site [IN] 调用点计数器，通常由 IDLOG_SOURCE_LOCATION 宏提供
+		SourceLocation(const char *file = "", const char *function = "", int line = 0, CallSite *site = nullptr)
+			: fileName(file), functionName(function), lineNumber(line), callSite(site) {}
 
 		/// @brief 获取简短的文件名（去掉路径）
 		/// @return 简短的文件名
@@ -58,9 +64,20 @@ namespace IDLog
 		/// @brief 构造函数
 		/// @param level [IN] 日志级别
 		/// @param loggerName [IN] 日志器名称
+		/// @param message [IN] 日志消息：右值字符串被移动，静态消息只保存指针，其他来源复制一次
+		/// @param location [IN] 源文件位置
+		LogEvent(LogLevel level, const std::string &loggerName, LogMessage message = LogMessage(), const SourceLocation &location = SourceLocation());
+
+		/// @brief 构造函数（使用给定的时间与线程信息，用于从持久化数据还原事件）
+		/// @param level [IN] 日志级别
+		/// @param loggerName [IN] 日志器名称
 		/// @param message [IN] 日志消息
 		/// @param location [IN] 源文件位置
-		LogEvent(LogLevel level, const std::string &loggerName, const std::string& message = "", const SourceLocation &location = SourceLocation());
+		/// @param time [IN] 时间戳
+		/// @param threadId [IN] 线程ID
+		/// @param threadName [IN] 线程名称
+		LogEvent(LogLevel level, const std::string &loggerName, const std::string &message, const SourceLocation &location,
+				 TimePoint time, const std::string &threadId, const std::string &threadName);
 
 		/// @brief 析构函数
 		~LogEvent();
@@ -82,9 +99,14 @@ namespace IDLog
 		TimePoint GetTime() const;
 
 		/// @brief 获取日志消息
+		/// @details 静态消息首次调用时才生成字符串，热路径应使用 GetLogMessageView
 		/// @return 日志消息
 		const std::string &GetLogMessage() const;
 
+		/// @brief 获取日志消息视图（静态消息不生成字符串）
+		/// @return 日志消息视图，在事件生命周期内有效
+		std::string_view GetLogMessageView() const;
+
 		/// @brief 获取线程ID
 		/// @return 线程ID
 		const std::string &GetThreadId() const;
@@ -2,7 +2,7 @@
  * @Description: Log 工厂头文件
  * @Author: InverseDark
  * @Date: 2025-12-21 12:56:33
- * @LastEditTime: 2025-12-22 21:12:46
+ * @LastEditTime: 2026-10-19 12:35:10
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_CORE_LOGFACTORY_H
@@ -34,14 +34,14 @@ namespace IDLog
 		/// @param params [IN] 输出器参数键值对
 		/// @param formatter [IN] 格式化器类型
 		/// @param formatterParams [IN] 格式化器参数键值对
-		/// @return 输出器智能指针
+		/// @return 输出器智能指针，指定的格式化器创建失败时为空
 		virtual LogAppender::Pointer CreateLogAppender(const std::string &type, const std::map<std::string, std::string>& params = {},
 													   const std::string &formatter = "", const std::map<std::string, std::string>& formatterParams = {});
 
 		/// @brief 创建格式化器实例
 		/// @param type [IN] 格式化器类型
 		/// @param params [IN] 格式化器参数键值对
-		/// @return 格式化器智能指针
+		/// @return 格式化器智能指针，类型未知或参数无效（如 json 的 fields 含无法识别的字段）时为空
 		virtual Formatter::Pointer CreateFormatter(const std::string &type, const std::map<std::string, std::string>& params = {});
 
 		/// @brief 创建过滤器实例
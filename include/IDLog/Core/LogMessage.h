@@ -0,0 +1,137 @@
+/**
+ * @Description: 日志消息参数头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 23:48:52
+ * @LastEditTime: 2026-10-18 23:48:52
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_CORE_LOGMESSAGE_H
+#define IDLOG_CORE_LOGMESSAGE_H
+
+#include "IDLog/Core/Macro.h"
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace IDLog
+{
+	/// @brief 静态消息
+	/// @details 指向静态存储期的字符串（字符串字面量），日志事件只保存指针与长度，不复制内容。
+	///			 通常由 IDLOG_STATIC_MESSAGE 宏或日志宏自动生成，手动构造时调用方需保证字符串在进程生命周期内有效
+	struct StaticMessage
+	{
+		const char *data; ///< 字符串起始地址
+		size_t size;	  ///< 字符串长度
+
+		/// @brief 构造函数
+		/// @param text [IN] 静态存储期的字符串
+		/// @param length [IN] 字符串长度
+		constexpr StaticMessage(const char *text, size_t length)
+			: data(text), size(length) {}
+	};
+
+	/// @brief 日志消息参数
+	/// @details 只在调用期间引用调用方的字符串，不持有数据，用作 Logger 记录接口的参数类型：
+	///			 字符串字面量、const char*、std::string_view 直接引用，创建日志事件时复制一次；
+	///			 右值 std::string 在创建日志事件时被移动；静态消息不复制
+	class LogMessage
+	{
+	public:
+		/// @brief 消息来源
+		enum class Kind : unsigned char
+		{
+			BORROWED, ///< 借用的字符串，需要复制
+			MOVABLE,  ///< 右值 std::string，可以移动
+			STATIC	  ///< 静态存储期的字符串，不需要复制
+		};
+
+	public:
+		/// @brief 构造函数（空消息）
+		LogMessage() : m_text(), m_movable(nullptr), m_kind(Kind::BORROWED) {}
+
+		/// @brief 构造函数（引用 std::string）
+		/// @param text [IN] 消息
+		LogMessage(const std::string &text) : m_text(text), m_movable(nullptr), m_kind(Kind::BORROWED) {}
+
+		/// @brief 构造函数（右值 std::string，创建事件时移动）
+		/// @param text [IN] 消息
+		LogMessage(std::string &&text) : m_text(text), m_movable(&text), m_kind(Kind::MOVABLE) {}
+
+		/// @brief 构造函数（引用 std::string_view）
+		/// @param text [IN] 消息
+		LogMessage(std::string_view text) : m_text(text), m_movable(nullptr), m_kind(Kind::BORROWED) {}
+
+		/// @brief 构造函数（引用 C 字符串，空指针视为空消息）
+		/// @param text [IN] 消息
+		LogMessage(const char *text)
+			: m_text(text ? std::string_view(text) : std::string_view()), m_movable(nullptr), m_kind(Kind::BORROWED) {}
+
+		/// @brief 构造函数（静态消息）
+		/// @param text [IN] 消息
+		LogMessage(StaticMessage text)
+			: m_text(text.data, text.size), m_movable(nullptr), m_kind(Kind::STATIC) {}
+
+		/// @brief 获取消息内容
+		/// @return 消息内容
+		std::string_view View() const { return m_text; }
+
+		/// @brief 获取消息来源
+		/// @return 消息来源
+		Kind GetKind() const { return m_kind; }
+
+		/// @brief 取出消息：右值字符串被移动，其他来源复制
+		/// @return 消息字符串
+		std::string Take() const
+		{
+			if (m_kind == Kind::MOVABLE)
+			{
+				return std::move(*m_movable);
+			}
+			return std::string(m_text);
+		}
+
+	private:
+		std::string_view m_text; ///< 消息内容
+		std::string *m_movable;	 ///< 右值字符串，用于移动
+		Kind m_kind;			 ///< 消息来源
+	};
+
+	namespace detail
+	{
+		/// @brief 日志宏的消息参数：编译器能确定是字符串字面量时转为静态消息，其他类型原样转发
+		template <typename T>
+		inline T &&MakeLogMessage(T &&message, bool)
+		{
+			return static_cast<T &&>(message);
+		}
+
+		/// @brief 日志宏的消息参数（C 字符串）
+		/// @param message [IN] 消息
+		/// @param literal [IN] 是否为字符串字面量
+		inline LogMessage MakeLogMessage(const char *message, bool literal)
+		{
+			if (literal && message)
+			{
+				return LogMessage(StaticMessage(message, std::char_traits<char>::length(message)));
+			}
+			return LogMessage(message);
+		}
+	} // namespace detail
+} // namespace IDLog
+
+/// @brief 把字符串字面量包装为静态消息（参数不是字面量时编译报错）
+#define IDLOG_STATIC_MESSAGE(literal) IDLog::StaticMessage("" literal, sizeof("" literal) - 1)
+
+/// @brief 检查表达式是否为编译期可知的字符串（字符串字面量或指向它的常量指针），
+///		   不支持的编译器上总是为false（退化为复制一次）
+#if defined(__GNUC__) || defined(__clang__)
+#define IDLOG_IS_LITERAL(expr) __builtin_constant_p(expr)
+#else
+#define IDLOG_IS_LITERAL(expr) false
+#endif
+
+/// @brief 日志宏使用的消息参数：字符串字面量不复制，其他参数按 LogMessage 的规则传递
+#define IDLOG_MESSAGE(msg) IDLog::detail::MakeLogMessage(msg, IDLOG_IS_LITERAL(msg))
+
+#endif // !IDLOG_CORE_LOGMESSAGE_H
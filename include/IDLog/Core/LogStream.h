@@ -0,0 +1,114 @@
+/**
+ * @Description: 流式日志头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-19 00:05:31
+ * @LastEditTime: 2026-10-19 00:05:31
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_CORE_LOGSTREAM_H
+#define IDLOG_CORE_LOGSTREAM_H
+
+#include "IDLog/Core/Logger.h"
+#include "IDLog/Core/CallSite.h"
+
+#include <ostream>
+
+namespace IDLog
+{
+	namespace detail
+	{
+		/// @brief 线程局部的流缓冲槽前向声明
+		struct LogStreamSlot;
+	} // namespace detail
+
+	/// @brief 流式日志
+	/// @details 临时对象，用 operator<< 拼接消息，析构时提交给日志器。
+	///			 消息写入线程局部的可复用缓冲区，不为每条日志新建 ostringstream；
+	///			 嵌套使用（拼接参数时又记录了日志）时各自使用独立的缓冲区。
+	///			 每条日志结束后缓冲区的格式状态（std::hex、精度等）会被重置，不影响下一条。
+	///			 为避免每条日志一次堆分配，不使用实现指针。
+	class IDLOG_API LogStream
+	{
+	public:
+		/// @brief 构造函数
+		/// @param logger [IN] 日志器，需在本对象析构前保持有效
+		/// @param level [IN] 日志级别
+		/// @param location [IN] 源文件位置
+		LogStream(Logger &logger, LogLevel level, const SourceLocation &location = SourceLocation());
+
+		/// @brief 析构函数，提交消息
+		~LogStream();
+
+		/// @brief 拷贝构造函数(禁用)
+		LogStream(const LogStream &) = delete;
+
+		/// @brief 拷贝赋值运算符(禁用)
+		LogStream &operator=(const LogStream &) = delete;
+
+		/// @brief 获取底层输出流
+		/// @return 输出流
+		std::ostream &Stream() { return *m_stream; }
+
+		/// @brief 追加内容
+		/// @tparam T 任意支持 operator<< 的类型
+		/// @param value [IN] 内容
+		/// @return 自身引用
+		template <typename T>
+		LogStream &operator<<(const T &value)
+		{
+			*m_stream << value;
+			return *this;
+		}
+
+		/// @brief 应用输出流操纵符（如 std::endl）
+		/// @param manipulator [IN] 操纵符
+		/// @return 自身引用
+		LogStream &operator<<(std::ostream &(*manipulator)(std::ostream &))
+		{
+			manipulator(*m_stream);
+			return *this;
+		}
+
+		/// @brief 应用 ios_base 操纵符（如 std::hex、std::fixed）
+		/// @param manipulator [IN] 操纵符
+		/// @return 自身引用
+		LogStream &operator<<(std::ios_base &(*manipulator)(std::ios_base &))
+		{
+			manipulator(*m_stream);
+			return *this;
+		}
+
+	private:
+		Logger &m_logger;			   ///< 日志器
+		SourceLocation m_location;	   ///< 源文件位置
+		detail::LogStreamSlot *m_slot; ///< 占用的线程局部缓冲槽
+		std::ostream *m_stream;		   ///< 缓冲槽中的输出流
+		LogLevel m_level;			   ///< 日志级别
+	};
+} // namespace IDLog
+
+/// @brief 便捷宏：流式记录日志，级别未启用时右侧的表达式都不会求值
+/// @details 用法：IDLOG_INFO_S(logger) << "x=" << x;
+///			 logger 可以是 Logger::Pointer、Logger* 或返回它们的表达式，只求值一次；
+///			 宏展开为完整的 if/else，在不带花括号的 if 中使用也不会改变 else 的归属
+#define IDLOG_LOG_S(logger, level)                                                           \
+	if (const auto &idlogStreamLogger = (logger); !idlogStreamLogger->IsLevelEnabled(level)) \
+	{                                                                                        \
+	}                                                                                        \
+	else                                                                                     \
+		IDLog::LogStream(*idlogStreamLogger, level, IDLOG_SOURCE_LOCATION())
+
+/// @brief 便捷宏：流式记录TRACE级别的日志
+#define IDLOG_TRACE_S(logger) IDLOG_LOG_S(logger, IDLog::LogLevel::TRACE)
+/// @brief 便捷宏：流式记录DEBUG级别的日志
+#define IDLOG_DEBUG_S(logger) IDLOG_LOG_S(logger, IDLog::LogLevel::DBG)
+/// @brief 便捷宏：流式记录INFO级别的日志
+#define IDLOG_INFO_S(logger) IDLOG_LOG_S(logger, IDLog::LogLevel::INFO)
+/// @brief 便捷宏：流式记录WARN级别的日志
+#define IDLOG_WARN_S(logger) IDLOG_LOG_S(logger, IDLog::LogLevel::WARN)
+/// @brief 便捷宏：流式记录ERROR级别的日志
+#define IDLOG_ERROR_S(logger) IDLOG_LOG_S(logger, IDLog::LogLevel::ERR)
+/// @brief 便捷宏：流式记录FATAL级别的日志
+#define IDLOG_FATAL_S(logger) IDLOG_LOG_S(logger, IDLog::LogLevel::FATAL)
+
+#endif // !IDLOG_CORE_LOGSTREAM_H
@@ -0,0 +1,175 @@
+/**
+ * @Description: 条件与限频日志宏头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-19 00:21:47
+ * @LastEditTime: 2026-10-19 11:10:42
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_CORE_LOGTHROTTLE_H
+#define IDLOG_CORE_LOGTHROTTLE_H
+
+#include "IDLog/Core/LoggerManager.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace IDLog
+{
+	namespace detail
+	{
+		/// @brief 每 N 次记录一次的调用点状态
+		struct EveryNState
+		{
+			std::atomic<uint64_t> count{0}; ///< 已到达次数
+
+			/// @brief 判断本次是否记录（第 1、N+1、2N+1... 次记录）
+			/// @param n [IN] 间隔次数，不大于1时每次都记录
+			/// @return 需要记录返回true
+			bool ShouldLog(uint64_t n)
+			{
+				return n <= 1 || count.fetch_add(1, std::memory_order_relaxed) % n == 0;
+			}
+		};
+
+		/// @brief 只记录前 N 次的调用点状态
+		struct FirstNState
+		{
+			std::atomic<uint64_t> count{0}; ///< 已记录次数
+
+			/// @brief 判断本次是否记录
+			/// @param n [IN] 最多记录次数
+			/// @return 需要记录返回true
+			bool ShouldLog(uint64_t n)
+			{
+				// 达到上限后只剩一次读取，不再写共享缓存行
+				if (count.load(std::memory_order_relaxed) >= n)
+				{
+					return false;
+				}
+				return count.fetch_add(1, std::memory_order_relaxed) < n;
+			}
+		};
+
+		/// @brief 每隔一段时间最多记录一次的调用点状态
+		struct EveryMsState
+		{
+			std::atomic<int64_t> next{std::numeric_limits<int64_t>::min()}; ///< 下一次允许记录的时间（纳秒）
+
+			/// @brief 判断本次是否记录，多个线程同时到期时只有一个记录
+			/// @param ms [IN] 间隔毫秒数
+			/// @return 需要记录返回true
+			bool ShouldLog(uint64_t ms)
+			{
+				const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+										std::chrono::steady_clock::now().time_since_epoch())
+										.count();
+				int64_t expected = next.load(std::memory_order_relaxed);
+				if (now < expected)
+				{
+					return false;
+				}
+				return next.compare_exchange_strong(expected, now + static_cast<int64_t>(ms) * 1000000,
+													std::memory_order_relaxed);
+			}
+		};
+	} // namespace detail
+} // namespace IDLog
+
+/// @brief 展开宏参数（兼容 MSVC 传统预处理器对 __VA_ARGS__ 的处理）
+#define IDLOG_DETAIL_EXPAND(x) x
+/// @brief 取第一个宏参数
+#define IDLOG_DETAIL_FIRST(first, ...) first
+/// @brief 编译期检查 "格式字符串, 参数..." 形式的宏参数
+#define IDLOG_DETAIL_CHECK_FORMAT_ARGS(...) \
+	IDLOG_CHECK_FORMAT(IDLOG_DETAIL_EXPAND(IDLOG_DETAIL_FIRST(__VA_ARGS__, 0)), IDLOG_FORMAT_ARG_COUNT(__VA_ARGS__) - 1)
+
+// 以下宏的可变参数为 "格式字符串, 参数..."，与 IDLOG_*_FMT 相同，在编译期检查。
+// 先检查级别，级别未启用时条件、计数与参数都不会求值；不记录时不会创建日志事件，也不会调用 Logger::Log。
+// 每个调用点持有自己的静态原子状态，多线程共享计数。
+
+/// @brief 条件成立时记录日志（先检查级别，再求值条件）
+#define IDLOG_LOG_IF(logger, level, cond, ...) \
+	do \
+	{ \
+		IDLOG_DETAIL_CHECK_FORMAT_ARGS(__VA_ARGS__); \
+		const auto &idlogCondLogger = (logger); \
+		if (idlogCondLogger->IsLevelEnabled(level) && (cond)) \
+		{ \
+			idlogCondLogger->LogFmt(level, IDLOG_SOURCE_LOCATION(), __VA_ARGS__); \
+		} \
+	} while (0)
+
+/// @brief 调用点每到达 n 次记录一次（第 1、n+1、2n+1... 次）
+#define IDLOG_LOG_EVERY_N(logger, level, n, ...) \
+	do \
+	{ \
+		IDLOG_DETAIL_CHECK_FORMAT_ARGS(__VA_ARGS__); \
+		static IDLog::detail::EveryNState idlogEveryNState; \
+		const auto &idlogCondLogger = (logger); \
+		if (idlogCondLogger->IsLevelEnabled(level) && idlogEveryNState.ShouldLog(n)) \
+		{ \
+			idlogCondLogger->LogFmt(level, IDLOG_SOURCE_LOCATION(), __VA_ARGS__); \
+		} \
+	} while (0)
+
+/// @brief 调用点只记录前 n 次
+#define IDLOG_LOG_FIRST_N(logger, level, n, ...) \
+	do \
+	{ \
+		IDLOG_DETAIL_CHECK_FORMAT_ARGS(__VA_ARGS__); \
+		static IDLog::detail::FirstNState idlogFirstNState; \
+		const auto &idlogCondLogger = (logger); \
+		if (idlogCondLogger->IsLevelEnabled(level) && idlogFirstNState.ShouldLog(n)) \
+		{ \
+			idlogCondLogger->LogFmt(level, IDLOG_SOURCE_LOCATION(), __VA_ARGS__); \
+		} \
+	} while (0)
+
+/// @brief 调用点每 ms 毫秒最多记录一次
+#define IDLOG_LOG_EVERY_MS(logger, level, ms, ...) \
+	do \
+	{ \
+		IDLOG_DETAIL_CHECK_FORMAT_ARGS(__VA_ARGS__); \
+		static IDLog::detail::EveryMsState idlogEveryMsState; \
+		const auto &idlogCondLogger = (logger); \
+		if (idlogCondLogger->IsLevelEnabled(level) && idlogEveryMsState.ShouldLog(ms)) \
+		{ \
+			idlogCondLogger->LogFmt(level, IDLOG_SOURCE_LOCATION(), __VA_ARGS__); \
+		} \
+	} while (0)
+
+/// @brief 便捷宏：条件成立时记录各级别日志（使用根日志器）
+#define IDLOG_TRACE_IF(cond, ...) IDLOG_LOG_IF(IDLOG_GET_ROOT_LOGGER(), IDLog::LogLevel::TRACE, cond, __VA_ARGS__)
+#define IDLOG_DEBUG_IF(cond, ...) IDLOG_LOG_IF(IDLOG_GET_ROOT_LOGGER(), IDLog::LogLevel::DBG, cond, __VA_ARGS__)
+#define IDLOG_INFO_IF(cond, ...) IDLOG_LOG_IF(IDLOG_GET_ROOT_LOGGER(), IDLog::LogLevel::INFO, cond, __VA_ARGS__)
+#define IDLOG_WARN_IF(cond, ...) IDLOG_LOG_IF(IDLOG_GET_ROOT_LOGGER(), IDLog::LogLevel::WARN, cond, __VA_ARGS__)
+#define IDLOG_ERROR_IF(cond, ...) IDLOG_LOG_IF(IDLOG_GET_ROOT_LOGGER(), IDLog::LogLevel::ERR, cond, __VA_ARGS__)
+#define IDLOG_FATAL_IF(cond, ...) IDLOG_LOG_IF(IDLOG_GET_ROOT_LOGGER(), IDLog::LogLevel::FATAL, cond, __VA_ARGS__)
+
+/// @brief 便捷宏：每 n 次记录一次各级别日志（指定日志器）
+#define IDLOG_TRACE_EVERY_N(logger, n, ...) IDLOG_LOG_EVERY_N(logger, IDLog::LogLevel::TRACE, n, __VA_ARGS__)
+#define IDLOG_DEBUG_EVERY_N(logger, n, ...) IDLOG_LOG_EVERY_N(logger, IDLog::LogLevel::DBG, n, __VA_ARGS__)
+#define IDLOG_INFO_EVERY_N(logger, n, ...) IDLOG_LOG_EVERY_N(logger, IDLog::LogLevel::INFO, n, __VA_ARGS__)
+#define IDLOG_WARN_EVERY_N(logger, n, ...) IDLOG_LOG_EVERY_N(logger, IDLog::LogLevel::WARN, n, __VA_ARGS__)
+#define IDLOG_ERROR_EVERY_N(logger, n, ...) IDLOG_LOG_EVERY_N(logger, IDLog::LogLevel::ERR, n, __VA_ARGS__)
+#define IDLOG_FATAL_EVERY_N(logger, n, ...) IDLOG_LOG_EVERY_N(logger, IDLog::LogLevel::FATAL, n, __VA_ARGS__)
+
+/// @brief 便捷宏：只记录前 n 次各级别日志（指定日志器）
+#define IDLOG_TRACE_FIRST_N(logger, n, ...) IDLOG_LOG_FIRST_N(logger, IDLog::LogLevel::TRACE, n, __VA_ARGS__)
+#define IDLOG_DEBUG_FIRST_N(logger, n, ...) IDLOG_LOG_FIRST_N(logger, IDLog::LogLevel::DBG, n, __VA_ARGS__)
+#define IDLOG_INFO_FIRST_N(logger, n, ...) IDLOG_LOG_FIRST_N(logger, IDLog::LogLevel::INFO, n, __VA_ARGS__)
+#define IDLOG_WARN_FIRST_N(logger, n, ...) IDLOG_LOG_FIRST_N(logger, IDLog::LogLevel::WARN, n, __VA_ARGS__)
+#define IDLOG_ERROR_FIRST_N(logger, n, ...) IDLOG_LOG_FIRST_N(logger, IDLog::LogLevel::ERR, n, __VA_ARGS__)
+#define IDLOG_FATAL_FIRST_N(logger, n, ...) IDLOG_LOG_FIRST_N(logger, IDLog::LogLevel::FATAL, n, __VA_ARGS__)
+
+/// @brief 便捷宏：每 ms 毫秒最多记录一次各级别日志（指定日志器）
+#define IDLOG_TRACE_EVERY_MS(logger, ms, ...) IDLOG_LOG_EVERY_MS(logger, IDLog::LogLevel::TRACE, ms, __VA_ARGS__)
+#define IDLOG_DEBUG_EVERY_MS(logger, ms, ...) IDLOG_LOG_EVERY_MS(logger, IDLog::LogLevel::DBG, ms, __VA_ARGS__)
+#define IDLOG_INFO_EVERY_MS(logger, ms, ...) IDLOG_LOG_EVERY_MS(logger, IDLog::LogLevel::INFO, ms, __VA_ARGS__)
+#define IDLOG_WARN_EVERY_MS(logger, ms, ...) IDLOG_LOG_EVERY_MS(logger, IDLog::LogLevel::WARN, ms, __VA_ARGS__)
+#define IDLOG_ERROR_EVERY_MS(logger, ms, ...) IDLOG_LOG_EVERY_MS(logger, IDLog::LogLevel::ERR, ms, __VA_ARGS__)
+#define IDLOG_FATAL_EVERY_MS(logger, ms, ...) IDLOG_LOG_EVERY_MS(logger, IDLog::LogLevel::FATAL, ms, __VA_ARGS__)
+
+#endif // !IDLOG_CORE_LOGTHROTTLE_H
@@ -2,7 +2,7 @@
  * @Description: 日志记录器头文件
  * @Author: InverseDark
  * @Date: 2025-12-18 18:22:29
- * @LastEditTime: 2025-12-18 18:59:52
+ * @LastEditTime: 2026-10-19 12:04:31
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_CORE_LOGGER_H
@@ -13,9 +13,12 @@
 #include "IDLog/Appender/LogAppender.h"
 #include "IDLog/Filter/Filter.h"
 #include "IDLog/Utils/StringUtil.h"
+#include "IDLog/Utils/Format.h"
 
 namespace IDLog
 {
+	class LoggerManager;
+
 	/// @brief 日志器类
 	/// @details 用户主要交互的接口，提供不同级别的日志记录方法
 	///			 支持日志级别过滤和多个输出目标（Appender）
@@ -44,40 +47,95 @@ namespace IDLog
 		/// @return 当前Logger对象的引用
 		Logger &operator=(const Logger &) = delete;
 
+		/// @brief 获取进程内共享的默认输出器
+		/// @details 新建的日志器默认输出到这个控制台输出器（使用共享的默认格式化器），
+		///			 创建日志器因此不需要新建输出器与解析模式
+		/// @return 默认输出器
+		static const AppenderPtr &GetDefaultAppender();
+
 		/// @brief 获取日志器名称
 		/// @return 日志器名称
 		const std::string &GetName() const;
 
+		/// @brief 获取日志器编号
+		/// @details 构造时分配，同时存在的日志器之间唯一，过滤器在创建日志事件之前用它识别日志器。
+		///			 日志器析构后编号被回收，再分配给新日志器前代数（GetIdGeneration）递增
+		/// @return 日志器编号
+		uint32_t GetId() const;
+
+		/// @brief 根据编号获取日志器名称
+		/// @param id [IN] 日志器编号
+		/// @return 日志器名称，编号无效或日志器已析构时为空
+		static std::string GetNameById(uint32_t id);
+
+		/// @brief 获取编号当前的代数（无锁）
+		/// @details 按编号缓存结果的过滤器同时记录代数，代数变化说明编号已属于另一个日志器
+		/// @param id [IN] 日志器编号
+		/// @return 代数
+		static uint32_t GetIdGeneration(uint32_t id);
+
 		/// @brief 获取当前日志级别
 		/// @return 当前日志级别
 		LogLevel GetLevel() const;
 
 		/// @brief 设置日志级别
+		/// @details 由日志管理器管理的日志器等同于 LoggerManager::SetLoggerLevel：记为单独设置的级别并下发到子日志器，
+		///			 之后的级别规则与父级别变化不会覆盖它；根日志器等同于 LoggerManager::SetRootLevel
 		/// @param level [IN] 新的日志级别
 		void SetLevel(LogLevel level);
 
-		/// @brief 添加输出目标
+		/// @brief 检查指定级别的日志是否会被记录（只比较级别，不经过过滤器）
+		/// @param level [IN] 日志级别
+		/// @return 会被记录返回true
+		bool IsLevelEnabled(LogLevel level) const;
+
+		/// @brief 添加自身的输出目标
 		/// @param appender [IN] 输出目标智能指针
 		void AddAppender(const AppenderPtr &appender);
 
-		/// @brief 移除所有输出目标
+		/// @brief 移除自身的所有输出目标（仍会输出到继承的输出目标）
 		void ClearAppenders();
 
-		/// @brief 获取所有输出目标
+		/// @brief 获取自身的输出目标（不含继承的）
 		/// @return 输出目标列表
 		std::vector<AppenderPtr> GetAppenders() const;
 
+		/// @brief 获取实际输出的目标：自身的输出目标，叠加时再加上父日志器的实际输出目标（已去重）
+		/// @return 输出目标列表
+		std::vector<AppenderPtr> GetEffectiveAppenders() const;
+
+		/// @brief 设置是否叠加父日志器的输出目标
+		/// @param additive [IN] true 时日志同时输出到父日志器（递归）的输出目标，默认true
+		void SetAdditive(bool additive);
+
+		/// @brief 检查是否叠加父日志器的输出目标
+		/// @return 叠加返回true，否则返回false
+		bool IsAdditive() const;
+
+		/// @brief 获取父日志器（由日志管理器按名称层次维护）
+		/// @return 父日志器，根日志器与未由管理器管理的日志器返回空
+		Pointer GetParent() const;
+
+		/// @brief 一次性替换自身的所有输出目标（其他线程看不到中间状态）
+		/// @param appenders [IN] 新的输出目标列表，空指针会被忽略
+		void SetAppenders(const std::vector<AppenderPtr> &appenders);
+
 		/// @brief 添加过滤器
 		/// @param filter [IN] 过滤器智能指针
 		void AddFilter(const FilterPtr &filter);
 
-		/// @brief 移除所有过滤器
+		/// @brief 移除所有过滤器（被移除的过滤器尚未提交的说明输出到本日志器）
 		void ClearFilters();
 
 		/// @brief 获取所有过滤器
 		/// @return 过滤器列表
 		std::vector<FilterPtr> GetFilters() const;
 
+		/// @brief 一次性替换所有过滤器（其他线程看不到中间状态）
+		/// @details 被移除的过滤器尚未提交的说明输出到本日志器
+		/// @param filters [IN] 新的过滤器列表，空指针会被忽略
+		void SetFilters(const std::vector<FilterPtr> &filters);
+
 		/// @brief 启用/禁用统计
 		/// @param enabled [IN] 启用/禁用
 		void EnableStatistics(bool enabled = true);
@@ -87,122 +145,153 @@ namespace IDLog
 		bool IsStatisticsEnabled() const;
 
 		/// @brief 记录日志消息
+		/// @details 消息可以是 std::string、std::string_view、C 字符串或静态消息（见 LogMessage），
+		///			 右值 std::string 被移动到日志事件中，静态消息（日志宏传入的字符串字面量）不复制
 		/// @param level [IN] 日志级别
 		/// @param message [IN] 日志消息
 		/// @param location [IN] 源文件位置
-		void Log(LogLevel level, const std::string &message,
+		void Log(LogLevel level, LogMessage message,
 				 const SourceLocation &location = SourceLocation());
 
 		/// @brief 记录TRACE级别的日志消息
 		/// @param message [IN] 日志消息
 		/// @param location [IN] 源文件位置
-		void Trace(const std::string &message,
+		void Trace(LogMessage message,
 				   const SourceLocation &location = SourceLocation());
 
 		/// @brief 记录DEBUG级别的日志消息
 		/// @param message [IN] 日志消息
 		/// @param location [IN] 源文件位置
-		void Debug(const std::string &message,
+		void Debug(LogMessage message,
 				   const SourceLocation &location = SourceLocation());
 
 		/// @brief 记录INFO级别的日志消息
 		/// @param message [IN] 日志消息
 		/// @param location [IN] 源文件位置
-		void Info(const std::string &message,
+		void Info(LogMessage message,
 				  const SourceLocation &location = SourceLocation());
 
 		/// @brief 记录WARN级别的日志消息
 		/// @param message [IN] 日志消息
 		/// @param location [IN] 源文件位置
-		void Warn(const std::string &message,
+		void Warn(LogMessage message,
 				  const SourceLocation &location = SourceLocation());
 
 		/// @brief 记录ERROR级别的日志消息
 		/// @param message [IN] 日志消息
 		/// @param location [IN] 源文件位置
-		void Error(const std::string &message,
+		void Error(LogMessage message,
 				   const SourceLocation &location = SourceLocation());
 
 		/// @brief 记录FATAL级别的日志消息
 		/// @param message [IN] 日志消息
 		/// @param location [IN] 源文件位置
-		void Fatal(const std::string &message,
+		void Fatal(LogMessage message,
 				   const SourceLocation &location = SourceLocation());
 
+		/// @brief 记录格式化的日志消息
+		/// @tparam Args 可变参数模板
+		/// @param level [IN] 日志级别
+		/// @param format [IN] 格式字符串，"{}" 风格（语法见 Utils/Format.h）
+		/// @param args [IN] 格式参数
+		template <typename... Args>
+		void LogFmt(LogLevel level, std::string_view format, const Args &...args)
+		{
+			if (ShouldLog(GetLevel(), level))
+			{
+				Log(level, Utils::Format(format, args...));
+			}
+		}
+
+		/// @brief 记录格式化的日志消息（附带源文件位置）
+		/// @tparam Args 可变参数模板
+		/// @param level [IN] 日志级别
+		/// @param location [IN] 源文件位置
+		/// @param format [IN] 格式字符串，"{}" 风格（语法见 Utils/Format.h）
+		/// @param args [IN] 格式参数
+		template <typename... Args>
+		void LogFmt(LogLevel level, const SourceLocation &location, std::string_view format, const Args &...args)
+		{
+			if (ShouldLog(GetLevel(), level))
+			{
+				Log(level, Utils::Format(format, args...), location);
+			}
+		}
+
 		/// @brief 记录格式化的TRACE级别日志消息
 		/// @tparam Args 可变参数模板
-		/// @param format [IN] 格式字符串
+		/// @param format [IN] 格式字符串，"{}" 风格（语法见 Utils/Format.h）
 		/// @param args [IN] 格式参数
 		template <typename... Args>
-		void TraceFmt(const std::string &format, Args... args)
+		void TraceFmt(std::string_view format, const Args &...args)
 		{
 			if (ShouldLog(GetLevel(), LogLevel::TRACE))
 			{
-				Log(LogLevel::TRACE, Utils::StringUtil::Format(format, args...));
+				Log(LogLevel::TRACE, Utils::Format(format, args...));
 			}
 		}
 		/// @brief 记录格式化的DEBUG级别日志消息
 		/// @tparam Args 可变参数模板
-		/// @param format [IN] 格式字符串
+		/// @param format [IN] 格式字符串，"{}" 风格（语法见 Utils/Format.h）
 		/// @param args [IN] 格式参数
 		template <typename... Args>
-		void DebugFmt(const std::string &format, Args... args)
+		void DebugFmt(std::string_view format, const Args &...args)
 		{
 			if (ShouldLog(GetLevel(), LogLevel::DBG))
 			{
-				Log(LogLevel::DBG, Utils::StringUtil::Format(format, args...));
+				Log(LogLevel::DBG, Utils::Format(format, args...));
 			}
 		}
 
 		/// @brief 记录格式化的INFO级别日志消息
 		/// @tparam Args 可变参数模板
-		/// @param format [IN] 格式字符串
+		/// @param format [IN] 格式字符串，"{}" 风格（语法见 Utils/Format.h）
 		/// @param args [IN] 格式参数
 		template <typename... Args>
-		void InfoFmt(const std::string &format, Args... args)
+		void InfoFmt(std::string_view format, const Args &...args)
 		{
 			if (ShouldLog(GetLevel(), LogLevel::INFO))
 			{
-				Log(LogLevel::INFO, Utils::StringUtil::Format(format, args...));
+				Log(LogLevel::INFO, Utils::Format(format, args...));
 			}
 		}
 
 		/// @brief 记录格式化的WARN级别日志消息
 		/// @tparam Args 可变参数模板
-		/// @param format [IN] 格式字符串
+		/// @param format [IN] 格式字符串，"{}" 风格（语法见 Utils/Format.h）
 		/// @param args [IN] 格式参数
 		template <typename... Args>
-		void WarnFmt(const std::string &format, Args... args)
+		void WarnFmt(std::string_view format, const Args &...args)
 		{
 			if (ShouldLog(GetLevel(), LogLevel::WARN))
 			{
-				Log(LogLevel::WARN, Utils::StringUtil::Format(format, args...));
+				Log(LogLevel::WARN, Utils::Format(format, args...));
 			}
 		}
 
 		/// @brief 记录格式化的ERROR级别日志消息
 		/// @tparam Args 可变参数模板
-		/// @param format [IN] 格式字符串
+		/// @param format [IN] 格式字符串，"{}" 风格（语法见 Utils/Format.h）
 		/// @param args [IN] 格式参数
 		template <typename... Args>
-		void ErrorFmt(const std::string &format, Args... args)
+		void ErrorFmt(std::string_view format, const Args &...args)
 		{
 			if (ShouldLog(GetLevel(), LogLevel::ERR))
 			{
-				Log(LogLevel::ERR, Utils::StringUtil::Format(format, args...));
+				Log(LogLevel::ERR, Utils::Format(format, args...));
 			}
 		}
 
 		/// @brief 记录格式化的FATAL级别日志消息
 		/// @tparam Args 可变参数模板
-		/// @param format [IN] 格式字符串
+		/// @param format [IN] 格式字符串，"{}" 风格（语法见 Utils/Format.h）
 		/// @param args [IN] 格式参数
 		template <typename... Args>
-		void FatalFmt(const std::string &format, Args... args)
+		void FatalFmt(std::string_view format, const Args &...args)
 		{
 			if (ShouldLog(GetLevel(), LogLevel::FATAL))
 			{
-				Log(LogLevel::FATAL, Utils::StringUtil::Format(format, args...));
+				Log(LogLevel::FATAL, Utils::Format(format, args...));
 			}
 		}
 
@@ -220,16 +309,68 @@ namespace IDLog
 				return;
 			}
 
-			// 延迟计算消息
-			std::string message = messageFunc();
-			Log(level, message, location);
+			// 延迟计算消息，结果移动到日志事件中
+			Log(level, messageFunc(), location);
 		}
 
 	private:
-		/// @brief 应用过滤器
+		friend class LoggerManager;
+
+		/// @brief 预先计算的过滤器链
+		struct FilterChain;
+
+		/// @brief 创建日志事件之前应用过滤器链开头能提前决策的过滤器
+		/// @param chain [IN] 过滤器链
+		/// @param level [IN] 日志级别
+		/// @param location [IN] 源文件位置
+		/// @return 过滤决策，中立表示需要创建日志事件并应用剩余的过滤器
+		FilterDecision PreApplyFilters(const FilterChain &chain, LogLevel level, const SourceLocation &location) const;
+
+		/// @brief 应用过滤器链中剩余的过滤器
+		/// @param chain [IN] 过滤器链
 		/// @param event [IN] 日志事件智能指针
 		/// @return 过滤决策
-		FilterDecision ApplyFilters(const LogEventPtr &event) const;
+		FilterDecision ApplyFilters(const FilterChain &chain, const LogEventPtr &event) const;
+
+		/// @brief 获取过滤器列表（调用方需持有列表互斥锁）
+		/// @return 过滤器列表
+		std::vector<FilterPtr> GetFiltersLocked() const;
+
+		/// @brief 重新计算并发布过滤器链（调用方需持有列表互斥锁）
+		/// @param filters [IN] 新的过滤器列表
+		/// @return 被移除的过滤器
+		std::vector<FilterPtr> PublishFilters(std::vector<FilterPtr> filters);
+
+		/// @brief 输出过滤器在本条日志期间提交的说明
+		/// @param location [IN] 当前日志的源文件位置
+		void AppendFilterNotices(const SourceLocation &location);
+
+		/// @brief 取出过滤器尚未提交的说明并输出（调用方不能持有列表互斥锁）
+		/// @param filters [IN] 过滤器列表
+		void FlushFilters(const std::vector<FilterPtr> &filters);
+
+		/// @brief 把说明输出到实际输出目标（不经过过滤器）
+		/// @param notices [IN] 说明列表
+		/// @param location [IN] 说明使用的源文件位置
+		void WriteNotices(std::vector<Filter::Notice> &notices, const SourceLocation &location);
+
+		/// @brief 设置父日志器并重新计算实际输出目标（由日志管理器调用）
+		/// @param parent [IN] 父日志器
+		void SetParent(const Pointer &parent);
+
+		/// @brief 写入计算出的有效级别（由日志管理器调用）
+		/// @param level [IN] 有效级别
+		void StoreLevel(LogLevel level);
+
+		/// @brief 设置是否由日志管理器管理（由日志管理器调用）
+		/// @param managed [IN] 是否受管理
+		void SetManaged(bool managed);
+
+		/// @brief 根据自身输出目标与父日志器的实际输出目标重新计算实际输出目标
+		void RebuildEffectiveAppenders();
+
+		/// @brief 自身输出目标或叠加设置变化后，更新自身及子日志器的实际输出目标
+		void OnAppendersChanged();
 
 	private:
 		/// @brief 日志器实现结构体前向声明
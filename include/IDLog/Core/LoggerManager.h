@@ -2,19 +2,28 @@
  * @Description: 日志管理器头文件
  * @Author: InverseDark
  * @Date: 2025-12-18 22:32:19
- * @LastEditTime: 2025-12-18 22:37:11
+ * @LastEditTime: 2026-10-19 10:47:08
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_CORE_LOGGERMANAGER_H
 #define IDLOG_CORE_LOGGERMANAGER_H
 
 #include "IDLog/Core/Logger.h"
+#include "IDLog/Core/CallSite.h"
+
+#include <map>
 
 namespace IDLog
 {
 	/// @brief 日志管理器类
 	/// @details 单例模式，管理所有Logger实例
-	///			 提供按名称获取Logger的功能，支持日志器层次结构
+	///			 提供按名称获取Logger的功能，支持以'.'分隔的日志器层次结构：
+	///			 日志器的有效级别依次取自身单独设置的级别、匹配自身名称的最具体级别规则（如 "net.*"）、
+	///			 父日志器的有效级别，最后是根日志级别。级别变化时立即重新计算并下发到受影响的日志器，
+	///			 记录日志时仍只读取日志器自身的一个原子级别。
+	///			 父日志器为名称上最近的已创建祖先（没有时为根日志器），叠加的日志器会输出到祖先的输出目标；
+	///			 实际输出目标在树结构或输出目标变化时预先展开，记录日志时不遍历父链。
+	///			 管理器创建的日志器自身没有输出目标，默认从根日志器继承。
 	class IDLOG_API LoggerManager
 	{
 	public:
@@ -34,6 +43,7 @@ namespace IDLog
 		LoggerManager &operator=(const LoggerManager &) = delete;
 
 		/// @brief 获取或创建日志器
+		/// @details 已存在的日志器通过无锁索引查找，只有创建新日志器时加锁
 		/// @param name [IN] 日志器名称
 		/// @return 日志器智能指针
 		LoggerPtr GetLogger(const std::string &name);
@@ -49,23 +59,55 @@ namespace IDLog
 		bool HasLogger(const std::string &name);
 
 		/// @brief 设置指定名称日志器的级别
-		/// @param name [IN] 日志器名称
+		/// @details 同时下发到未单独设置级别的子日志器（O(子树大小)）；日志器可以尚未创建，创建时生效
+		/// @param name [IN] 日志器名称，"ROOT" 等同于 SetRootLevel
 		/// @param level [IN] 新的日志级别
 		void SetLoggerLevel(const std::string &name, LogLevel level);
 
+		/// @brief 清除指定日志器单独设置的级别，恢复从规则或父日志器继承
+		/// @param name [IN] 日志器名称
+		void ResetLoggerLevel(const std::string &name);
+
+		/// @brief 获取指定名称日志器的有效级别（日志器可以尚未创建）
+		/// @param name [IN] 日志器名称
+		/// @return 有效级别
+		LogLevel GetEffectiveLevel(const std::string &name);
+
+		/// @brief 添加或更新级别规则
+		/// @details 模式支持 '*'（任意字符序列，可跨越'.'）与 '?'，对之后创建的日志器同样生效；
+		///			 多条规则匹配时模式越长越优先
+		/// @param pattern [IN] 日志器名称或通配模式，如 "net.*"
+		/// @param level [IN] 日志级别
+		void SetLevelRule(const std::string &pattern, LogLevel level);
+
+		/// @brief 删除级别规则
+		/// @param pattern [IN] 添加时使用的模式
+		/// @return 规则存在返回true，否则返回false
+		bool RemoveLevelRule(const std::string &pattern);
+
+		/// @brief 替换全部级别规则（只重新计算一次）
+		/// @param rules [IN] 模式到级别的映射
+		void SetLevelRules(const std::map<std::string, LogLevel> &rules);
+
+		/// @brief 获取全部级别规则
+		/// @return 模式到级别的映射
+		std::map<std::string, LogLevel> GetLevelRules() const;
+
 		/// @brief 删除指定名称的日志器
 		/// @param name [IN] 日志器名称
 		void RemoveLogger(const std::string &name);
 
-		/// @brief 获取根日志器
-		/// @return 根日志器智能指针
-		LoggerPtr GetRootLogger();
+		/// @brief 获取根日志器（无锁）
+		/// @return 根日志器智能指针的引用，在管理器析构前一直有效（Clear 不替换根日志器，只恢复它的初始状态）
+		const LoggerPtr &GetRootLogger();
 
 		/// @brief 设置根日志器的级别
+		/// @details 同时下发到所有未单独设置级别且不匹配任何规则的日志器
 		/// @param level [IN] 新的日志级别
 		void SetRootLevel(LogLevel level);
 
-		/// @brief 清空所有日志器
+		/// @brief 清空所有日志器、单独设置的级别与级别规则
+		/// @details 根日志器保持同一个实例，恢复为默认输出目标、无过滤器、根日志级别 INFO
 		void Clear();
 
 		/// @brief 关闭日志管理器，释放资源
@@ -77,6 +119,17 @@ namespace IDLog
 		/// @brief 析构函数
 		~LoggerManager();
 
+		friend class Logger;
+
+		/// @brief 日志器直接设置级别时记为单独设置的级别并下发（由 Logger::SetLevel 调用）
+		/// @param logger [IN] 设置级别的日志器
+		/// @param level [IN] 新的日志级别
+		void SetExplicitLevel(Logger &logger, LogLevel level);
+
+		/// @brief 日志器的输出目标或叠加设置变化后，重新展开它及子树的实际输出目标（由 Logger 调用）
+		/// @param logger [IN] 发生变化的日志器
+		void RebuildAppenders(Logger &logger);
+
 	private:
 		/// @brief 日志管理器实现结构体前向声明
 		struct Impl;
@@ -94,56 +147,118 @@ namespace IDLog
 #define IDLOG_SHUTDOWN() IDLog::LoggerManager::GetInstance().Shutdown()
 
 /// @brief 便捷宏：快速记录TRACE级别的日志（使用根日志器）
-#define IDLOG_TRACE(msg) IDLOG_GET_ROOT_LOGGER()->Trace(msg, IDLog::SourceLocation(__FILE__, __FUNCTION__, __LINE__))
+#define IDLOG_TRACE(msg) IDLOG_GET_ROOT_LOGGER()->Trace(IDLOG_MESSAGE(msg), IDLOG_SOURCE_LOCATION())
 /// @brief 便捷宏：快速记录DEBUG级别的日志（使用根日志器）
-#define IDLOG_DEBUG(msg) IDLOG_GET_ROOT_LOGGER()->Debug(msg, IDLog::SourceLocation(__FILE__, __FUNCTION__, __LINE__))
+#define IDLOG_DEBUG(msg) IDLOG_GET_ROOT_LOGGER()->Debug(IDLOG_MESSAGE(msg), IDLOG_SOURCE_LOCATION())
 /// @brief 便捷宏：快速记录INFO级别的日志（使用根日志器）
-#define IDLOG_INFO(msg) IDLOG_GET_ROOT_LOGGER()->Info(msg, IDLog::SourceLocation(__FILE__, __FUNCTION__, __LINE__))
+#define IDLOG_INFO(msg) IDLOG_GET_ROOT_LOGGER()->Info(IDLOG_MESSAGE(msg), IDLOG_SOURCE_LOCATION())
 /// @brief 便捷宏：快速记录WARN级别的日志（使用根日志器）
-#define IDLOG_WARN(msg) IDLOG_GET_ROOT_LOGGER()->Warn(msg, IDLog::SourceLocation(__FILE__, __FUNCTION__, __LINE__))
+#define IDLOG_WARN(msg) IDLOG_GET_ROOT_LOGGER()->Warn(IDLOG_MESSAGE(msg), IDLOG_SOURCE_LOCATION())
 /// @brief 便捷宏：快速记录ERROR级别的日志（使用根日志器）
-#define IDLOG_ERROR(msg) IDLOG_GET_ROOT_LOGGER()->Error(msg, IDLog::SourceLocation(__FILE__, __FUNCTION__, __LINE__))
+#define IDLOG_ERROR(msg) IDLOG_GET_ROOT_LOGGER()->Error(IDLOG_MESSAGE(msg), IDLOG_SOURCE_LOCATION())
 /// @brief 便捷宏：快速记录FATAL级别的日志（使用根日志器）
-#define IDLOG_FATAL(msg) IDLOG_GET_ROOT_LOGGER()->Fatal(msg, IDLog::SourceLocation(__FILE__, __FUNCTION__, __LINE__))
+#define IDLOG_FATAL(msg) IDLOG_GET_ROOT_LOGGER()->Fatal(IDLOG_MESSAGE(msg), IDLOG_SOURCE_LOCATION())
+
+// 格式化宏的格式字符串必须是字符串字面量，语法错误或占位符个数与参数个数不一致时编译报错
 
 /// @brief 便捷宏：快速记录格式化的TRACE级别日志（使用根日志器）
-#define IDLOG_TRACE_FMT(format, ...) IDLOG_GET_ROOT_LOGGER()->TraceFmt(format, ##__VA_ARGS__)
+#define IDLOG_TRACE_FMT(format, ...) \
+	do \
+	{ \
+		IDLOG_CHECK_FORMAT(format, IDLOG_FORMAT_ARG_COUNT(__VA_ARGS__)); \
+		IDLOG_GET_ROOT_LOGGER()->TraceFmt(format, ##__VA_ARGS__); \
+	} while (0)
 /// @brief 便捷宏：快速记录格式化的DEBUG级别日志（使用根日志器）
-#define IDLOG_DEBUG_FMT(format, ...) IDLOG_GET_ROOT_LOGGER()->DebugFmt(format, ##__VA_ARGS__)
+#define IDLOG_DEBUG_FMT(format, ...) \
+	do \
+	{ \
+		IDLOG_CHECK_FORMAT(format, IDLOG_FORMAT_ARG_COUNT(__VA_ARGS__)); \
+		IDLOG_GET_ROOT_LOGGER()->DebugFmt(format, ##__VA_ARGS__); \
+	} while (0)
 /// @brief 便捷宏：快速记录格式化的INFO级别日志（使用根日志器）
-#define IDLOG_INFO_FMT(format, ...) IDLOG_GET_ROOT_LOGGER()->InfoFmt(format, ##__VA_ARGS__)
+#define IDLOG_INFO_FMT(format, ...) \
+	do \
+	{ \
+		IDLOG_CHECK_FORMAT(format, IDLOG_FORMAT_ARG_COUNT(__VA_ARGS__)); \
+		IDLOG_GET_ROOT_LOGGER()->InfoFmt(format, ##__VA_ARGS__); \
+	} while (0)
 /// @brief 便捷宏：快速记录格式化的WARN级别日志（使用根日志器）
-#define IDLOG_WARN_FMT(format, ...) IDLOG_GET_ROOT_LOGGER()->WarnFmt(format, ##__VA_ARGS__)
+#define IDLOG_WARN_FMT(format, ...) \
+	do \
+	{ \
+		IDLOG_CHECK_FORMAT(format, IDLOG_FORMAT_ARG_COUNT(__VA_ARGS__)); \
+		IDLOG_GET_ROOT_LOGGER()->WarnFmt(format, ##__VA_ARGS__); \
+	} while (0)
 /// @brief 便捷宏：快速记录格式化的ERROR级别日志（使用根日志器）
-#define IDLOG_ERROR_FMT(format, ...) IDLOG_GET_ROOT_LOGGER()->ErrorFmt(format, ##__VA_ARGS__)
+#define IDLOG_ERROR_FMT(format, ...) \
+	do \
+	{ \
+		IDLOG_CHECK_FORMAT(format, IDLOG_FORMAT_ARG_COUNT(__VA_ARGS__)); \
+		IDLOG_GET_ROOT_LOGGER()->ErrorFmt(format, ##__VA_ARGS__); \
+	} while (0)
 /// @brief 便捷宏：快速记录格式化的FATAL级别日志（使用根日志器）
-#define IDLOG_FATAL_FMT(format, ...) IDLOG_GET_ROOT_LOGGER()->FatalFmt(format, ##__VA_ARGS__)
+#define IDLOG_FATAL_FMT(format, ...) \
+	do \
+	{ \
+		IDLOG_CHECK_FORMAT(format, IDLOG_FORMAT_ARG_COUNT(__VA_ARGS__)); \
+		IDLOG_GET_ROOT_LOGGER()->FatalFmt(format, ##__VA_ARGS__); \
+	} while (0)
 
 /// @brief 便捷宏：快速记录TRACE级别的日志（指定日志器名称）
-#define IDLOG_LOGGER_TRACE(loggerName, msg) IDLOG_GET_LOGGER(loggerName)->Trace(msg, IDLog::SourceLocation(__FILE__, __FUNCTION__, __LINE__))
+#define IDLOG_LOGGER_TRACE(loggerName, msg) IDLOG_GET_LOGGER(loggerName)->Trace(IDLOG_MESSAGE(msg), IDLOG_SOURCE_LOCATION())
 /// @brief 便捷宏：快速记录DEBUG级别的日志（指定日志器名称）
-#define IDLOG_LOGGER_DEBUG(loggerName, msg) IDLOG_GET_LOGGER(loggerName)->Debug(msg, IDLog::SourceLocation(__FILE__, __FUNCTION__, __LINE__))
+#define IDLOG_LOGGER_DEBUG(loggerName, msg) IDLOG_GET_LOGGER(loggerName)->Debug(IDLOG_MESSAGE(msg), IDLOG_SOURCE_LOCATION())
 /// @brief 便捷宏：快速记录INFO级别的日志（指定日志器名称）
-#define IDLOG_LOGGER_INFO(loggerName, msg) IDLOG_GET_LOGGER(loggerName)->Info(msg, IDLog::SourceLocation(__FILE__, __FUNCTION__, __LINE__))
+#define IDLOG_LOGGER_INFO(loggerName, msg) IDLOG_GET_LOGGER(loggerName)->Info(IDLOG_MESSAGE(msg), IDLOG_SOURCE_LOCATION())
 /// @brief 便捷宏：快速记录WARN级别的日志（指定日志器名称）
-#define IDLOG_LOGGER_WARN(loggerName, msg) IDLOG_GET_LOGGER(loggerName)->Warn(msg, IDLog::SourceLocation(__FILE__, __FUNCTION__, __LINE__))
+#define IDLOG_LOGGER_WARN(loggerName, msg) IDLOG_GET_LOGGER(loggerName)->Warn(IDLOG_MESSAGE(msg), IDLOG_SOURCE_LOCATION())
 /// @brief 便捷宏：快速记录ERROR级别的日志（指定日志器名称）
-#define IDLOG_LOGGER_ERROR(loggerName, msg) IDLOG_GET_LOGGER(loggerName)->Error(msg, IDLog::SourceLocation(__FILE__, __FUNCTION__, __LINE__))
+#define IDLOG_LOGGER_ERROR(loggerName, msg) IDLOG_GET_LOGGER(loggerName)->Error(IDLOG_MESSAGE(msg), IDLOG_SOURCE_LOCATION())
 /// @brief 便捷宏：快速记录FATAL级别的日志（指定日志器名称）
-#define IDLOG_LOGGER_FATAL(loggerName, msg) IDLOG_GET_LOGGER(loggerName)->Fatal(msg, IDLog::SourceLocation(__FILE__, __FUNCTION__, __LINE__))
+#define IDLOG_LOGGER_FATAL(loggerName, msg) IDLOG_GET_LOGGER(loggerName)->Fatal(IDLOG_MESSAGE(msg), IDLOG_SOURCE_LOCATION())
 
 /// @brief 便捷宏：快速记录格式化的TRACE级别日志（指定日志器名称）
-#define IDLOG_LOGGER_TRACE_FMT(loggerName, format, ...) IDLOG_GET_LOGGER(loggerName)->TraceFmt(format, ##__VA_ARGS__)
+#define IDLOG_LOGGER_TRACE_FMT(loggerName, format, ...) \
+	do \
+	{ \
+		IDLOG_CHECK_FORMAT(format, IDLOG_FORMAT_ARG_COUNT(__VA_ARGS__)); \
+		IDLOG_GET_LOGGER(loggerName)->TraceFmt(format, ##__VA_ARGS__); \
+	} while (0)
 /// @brief 便捷宏：快速记录格式化的DEBUG级别日志（指定日志器名称）
-#define IDLOG_LOGGER_DEBUG_FMT(loggerName, format, ...) IDLOG_GET_LOGGER(loggerName)->DebugFmt(format, ##__VA_ARGS__)
+#define IDLOG_LOGGER_DEBUG_FMT(loggerName, format, ...) \
+	do \
+	{ \
+		IDLOG_CHECK_FORMAT(format, IDLOG_FORMAT_ARG_COUNT(__VA_ARGS__)); \
+		IDLOG_GET_LOGGER(loggerName)->DebugFmt(format, ##__VA_ARGS__); \
+	} while (0)
 /// @brief 便捷宏：快速记录格式化的INFO级别日志（指定日志器名称）
-#define IDLOG_LOGGER_INFO_FMT(loggerName, format, ...) IDLOG_GET_LOGGER(loggerName)->InfoFmt(format, ##__VA_ARGS__)
+#define IDLOG_LOGGER_INFO_FMT(loggerName, format, ...) \
+	do \
+	{ \
+		IDLOG_CHECK_FORMAT(format, IDLOG_FORMAT_ARG_COUNT(__VA_ARGS__)); \
+		IDLOG_GET_LOGGER(loggerName)->InfoFmt(format, ##__VA_ARGS__); \
+	} while (0)
 /// @brief 便捷宏：快速记录格式化的WARN级别日志（指定日志器名称）
-#define IDLOG_LOGGER_WARN_FMT(loggerName, format, ...) IDLOG_GET_LOGGER(loggerName)->WarnFmt(format, ##__VA_ARGS__)
+#define IDLOG_LOGGER_WARN_FMT(loggerName, format, ...) \
+	do \
+	{ \
+		IDLOG_CHECK_FORMAT(format, IDLOG_FORMAT_ARG_COUNT(__VA_ARGS__)); \
+		IDLOG_GET_LOGGER(loggerName)->WarnFmt(format, ##__VA_ARGS__); \
+	} while (0)
 /// @brief 便捷宏：快速记录格式化的ERROR级别日志（指定日志器名称）
-#define IDLOG_LOGGER_ERROR_FMT(loggerName, format, ...) IDLOG_GET_LOGGER(loggerName)->ErrorFmt(format, ##__VA_ARGS__)
+#define IDLOG_LOGGER_ERROR_FMT(loggerName, format, ...) \
+	do \
+	{ \
+		IDLOG_CHECK_FORMAT(format, IDLOG_FORMAT_ARG_COUNT(__VA_ARGS__)); \
+		IDLOG_GET_LOGGER(loggerName)->ErrorFmt(format, ##__VA_ARGS__); \
+	} while (0)
 /// @brief 便捷宏：快速记录格式化的FATAL级别日志（指定日志器名称）
-#define IDLOG_LOGGER_FATAL_FMT(loggerName, format, ...) IDLOG_GET_LOGGER(loggerName)->FatalFmt(format, ##__VA_ARGS__)
+#define IDLOG_LOGGER_FATAL_FMT(loggerName, format, ...) \
+	do \
+	{ \
+		IDLOG_CHECK_FORMAT(format, IDLOG_FORMAT_ARG_COUNT(__VA_ARGS__)); \
+		IDLOG_GET_LOGGER(loggerName)->FatalFmt(format, ##__VA_ARGS__); \
+	} while (0)
 
 } // namespace IDLog
 
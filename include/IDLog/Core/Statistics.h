@@ -2,7 +2,7 @@
  * @Description: 统计信息头文件
  * @Author: InverseDark
  * @Date: 2025-12-23 10:07:00
- * @LastEditTime: 2025-12-23 16:03:47
+ * @LastEditTime: 2026-10-19 12:24:10
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_CORE_STATISTICS_H
@@ -15,9 +15,15 @@
 #include <mutex>
 #include <map>
 #include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace IDLog
 {
+	class LogAppender;
+
 	/// @brief 级别统计信息类
 	class IDLOG_API LevelStatistics
 	{
@@ -50,6 +56,9 @@ namespace IDLog
 		void IncrementCount();
 		/// @brief 减少日志计数
 		void DecrementCount();
+		/// @brief 增加日志计数
+		/// @param count [IN] 增加的计数
+		void AddCount(uint64_t count);
 		/// @brief 增加日志字节数
 		/// @param bytes [IN] 增加的字节数
 		void AddBytes(uint64_t bytes);
@@ -69,58 +78,330 @@ namespace IDLog
 		Impl* m_pImpl; ///< 级别统计信息实现指针
 	};
 
-	/// @brief 时间窗口类
-	class IDLOG_API TimeWindow
+	/// @brief 滑动时间窗口速率类
+	/// @details 固定的每秒桶环：每个级别的日志数、字节数各有 kSlotCount 个桶，每个桶是一个64位原子字，
+	///			 高24位为秒标签（单调时钟秒数的低24位），低40位为计数。
+	///			 写入只计算桶序号，再按桶标签是否为当前秒，用掩码选择“累加”或“从零开始”，没有锁，也没有其他分支；
+	///			 读取时按需汇总最近 N 个完整秒中标签有效的桶，得到每秒日志数、字节数。
+	///			 窗口最长 kMaxWindowSeconds 秒，不包含正在进行的当前秒。
+	class IDLOG_API RateWindow
 	{
+	public:
+		/// @brief 桶数量（秒）
+		static constexpr uint32_t kSlotCount = 64;
+		/// @brief 最长窗口（秒）
+		static constexpr uint32_t kMaxWindowSeconds = 60;
+
 	public:
 		/// @brief 构造函数
-		TimeWindow();
+		RateWindow();
 		/// @brief 析构函数
-		~TimeWindow();
+		~RateWindow();
 
 		/// @brief 拷贝构造函数
-		/// @param other [IN] 另一个TimeWindow对象
-		TimeWindow(const TimeWindow& other);
+		/// @param other [IN] 另一个RateWindow对象
+		RateWindow(const RateWindow& other);
 
 		/// @brief 拷贝赋值运算符
-		/// @param other [IN] 另一个TimeWindow对象
-		/// @return 当前TimeWindow对象的引用
-		TimeWindow& operator=(const TimeWindow& other);
+		/// @param other [IN] 另一个RateWindow对象
+		/// @return 当前RateWindow对象的引用
+		RateWindow& operator=(const RateWindow& other);
+
+		/// @brief 记录一条日志（单写者：并发记录不会损坏桶，但个别计数可能丢失，多线程记录由 StatisticsManager 的线程分片负责）
+		/// @param level [IN] 日志级别
+		/// @param bytes [IN] 日志字节数
+		/// @param nowSec [IN] 当前秒数（单调时钟）
+		void Record(LogLevel level, uint64_t bytes, uint64_t nowSec = GetCurrentSecond());
+
+		/// @brief 合并另一个速率窗口（只合并最近 kSlotCount 秒内的桶）
+		/// @param other [IN] 另一个速率窗口
+		/// @param nowSec [IN] 当前秒数（单调时钟）
+		void Merge(const RateWindow& other, uint64_t nowSec = GetCurrentSecond());
 
+		/// @brief 重置速率窗口
+		void Reset();
+
+		/// @brief 获取最近若干秒内的日志数（所有级别）
+		/// @param windowSeconds [IN] 窗口长度（秒），超过 kMaxWindowSeconds 时按 kMaxWindowSeconds 计算
+		/// @param nowSec [IN] 当前秒数（单调时钟）
+		/// @return 日志数
+		uint64_t GetLogCount(uint32_t windowSeconds, uint64_t nowSec = GetCurrentSecond()) const;
 
-		/// @brief 获取窗口开始时间
-		/// @return 窗口开始时间点
-		std::chrono::steady_clock::time_point GetStartTime() const;
+		/// @brief 获取最近若干秒内指定级别的日志数
+		/// @param level [IN] 日志级别
+		/// @param windowSeconds [IN] 窗口长度（秒）
+		/// @param nowSec [IN] 当前秒数（单调时钟）
+		/// @return 日志数
+		uint64_t GetLogCount(LogLevel level, uint32_t windowSeconds, uint64_t nowSec = GetCurrentSecond()) const;
+
+		/// @brief 获取最近若干秒内的日志字节数（所有级别）
+		/// @param windowSeconds [IN] 窗口长度（秒）
+		/// @param nowSec [IN] 当前秒数（单调时钟）
+		/// @return 字节数
+		uint64_t GetByteCount(uint32_t windowSeconds, uint64_t nowSec = GetCurrentSecond()) const;
+
+		/// @brief 获取最近若干秒内指定级别的日志字节数
+		/// @param level [IN] 日志级别
+		/// @param windowSeconds [IN] 窗口长度（秒）
+		/// @param nowSec [IN] 当前秒数（单调时钟）
+		/// @return 字节数
+		uint64_t GetByteCount(LogLevel level, uint32_t windowSeconds, uint64_t nowSec = GetCurrentSecond()) const;
 
-		/// @brief 获取每秒日志数
+		/// @brief 获取最近若干秒的每秒日志数（所有级别）
+		/// @param windowSeconds [IN] 窗口长度（秒），常用 1、10、60
+		/// @return 每秒日志数
+		double GetLogsPerSecond(uint32_t windowSeconds) const;
+
+		/// @brief 获取最近若干秒指定级别的每秒日志数
+		/// @param level [IN] 日志级别
+		/// @param windowSeconds [IN] 窗口长度（秒）
 		/// @return 每秒日志数
-		uint64_t GetLogsPerSecond() const;
+		double GetLogsPerSecond(LogLevel level, uint32_t windowSeconds) const;
 
-		/// @brief 获取每秒字节数
+		/// @brief 获取最近若干秒的每秒字节数（所有级别）
+		/// @param windowSeconds [IN] 窗口长度（秒）
 		/// @return 每秒字节数
-		uint64_t GetBytesPerSecond() const;
+		double GetBytesPerSecond(uint32_t windowSeconds) const;
+
+		/// @brief 获取最近若干秒指定级别的每秒字节数
+		/// @param level [IN] 日志级别
+		/// @param windowSeconds [IN] 窗口长度（秒）
+		/// @return 每秒字节数
+		double GetBytesPerSecond(LogLevel level, uint32_t windowSeconds) const;
+
+		/// @brief 获取当前秒数
+		/// @return 单调时钟的秒数
+		static uint64_t GetCurrentSecond()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+	private:
+		/// @brief 统计管理类汇总线程分片时直接合并桶
+		friend class StatisticsManager;
+
+		/// @brief 速率窗口实现结构体前向声明
+		struct Impl;
+
+	private:
+		Impl* m_pImpl; ///< 速率窗口实现指针
+	};
+
+	/// @brief 延迟类型枚举
+	enum class LatencyType
+	{
+		LOG_CALL,	///< Logger::Log 调用耗时（含同步输出器）
+		QUEUE_WAIT, ///< AsyncAppender 中从入队到出队的等待时间
+		SINK_WRITE	///< 输出器写入/刷新底层文件或终端的耗时
+	};
 
-		/// @brief 设置窗口开始时间
-		/// @param timePoint [IN] 窗口开始时间点
-		void SetStartTime(const std::chrono::steady_clock::time_point& timePoint);
+	/// @brief 延迟直方图类
+	/// @details 对数-线性分桶（HDR 风格）：小于 2^(kSubBucketBits+1) 纳秒的值精确记录，
+	///			 更大的值按 2 的幂分段，每段再线性划分为 2^kSubBucketBits 个桶，相对误差不超过 1/2^kSubBucketBits。
+	///			 超过 2^kMaxValueBits 纳秒的值计入最后一个桶，最大值始终精确记录。
+	///			 本类本身不是线程安全的，多线程记录由 StatisticsManager 的线程分片负责。
+	class IDLOG_API LatencyHistogram
+	{
+	public:
+		/// @brief 每段线性子桶的位数
+		static constexpr uint32_t kSubBucketBits = 4;
+		/// @brief 可分辨的最大值位数（2^36 纳秒约 68 秒）
+		static constexpr uint32_t kMaxValueBits = 36;
+		/// @brief 桶数量
+		static constexpr size_t kBucketCount = (size_t(2) << kSubBucketBits) + (kMaxValueBits - kSubBucketBits - 1) * (size_t(1) << kSubBucketBits);
+
+	public:
+		/// @brief 构造函数
+		LatencyHistogram();
+		/// @brief 析构函数
+		~LatencyHistogram();
+
+		/// @brief 拷贝构造函数
+		/// @param other [IN] 另一个LatencyHistogram对象
+		LatencyHistogram(const LatencyHistogram& other);
+
+		/// @brief 拷贝赋值运算符
+		/// @param other [IN] 另一个LatencyHistogram对象
+		/// @return 当前LatencyHistogram对象的引用
+		LatencyHistogram& operator=(const LatencyHistogram& other);
 
-		/// @brief 设置每秒日志数
-		/// @param logsPerSecond [IN] 每秒日志数
-		void SetLogsPerSecond(uint64_t logsPerSecond);
+		/// @brief 记录一个值
+		/// @param valueNs [IN] 延迟（纳秒）
+		void Record(uint64_t valueNs);
 
-		/// @brief 设置每秒字节数
-		/// @param bytesPerSecond [IN] 每秒字节数
-		void SetBytesPerSecond(uint64_t bytesPerSecond);
+		/// @brief 合并另一个直方图
+		/// @param other [IN] 另一个直方图
+		void Merge(const LatencyHistogram& other);
 
-		/// @brief 重置时间窗口
+		/// @brief 重置直方图
 		void Reset();
 
+		/// @brief 获取记录的值数量
+		/// @return 数量
+		uint64_t GetCount() const;
+
+		/// @brief 获取最大值
+		/// @return 最大值（纳秒）
+		uint64_t GetMax() const;
+
+		/// @brief 获取平均值
+		/// @return 平均值（纳秒）
+		uint64_t GetMean() const;
+
+		/// @brief 获取百分位数
+		/// @param percentile [IN] 百分位（0~100，如 99.9）
+		/// @return 该百分位所在桶的上界（不超过最大值），没有数据时返回0
+		uint64_t GetPercentile(double percentile) const;
+
+		/// @brief 将百分位摘要转换为JSON对象字符串
+		/// @return 形如 {"count":N,"p50":..,"p90":..,"p99":..,"p999":..,"max":..} 的字符串
+		std::string ToJson() const;
+
+		/// @brief 将百分位摘要转换为可读字符串
+		/// @return 形如 count=N, p50=..ns, ... 的字符串
+		std::string ToString() const;
+
+		/// @brief 计算值所在的桶
+		/// @param valueNs [IN] 值（纳秒）
+		/// @return 桶序号
+		static size_t GetBucketIndex(uint64_t valueNs);
+
+		/// @brief 获取桶的上界（桶内的最大值）
+		/// @param index [IN] 桶序号
+		/// @return 上界（纳秒）
+		static uint64_t GetBucketUpperBound(size_t index);
+
 	private:
-		/// @brief 时间窗口实现结构体前向声明
+		/// @brief 统计管理类汇总线程分片时直接填充桶计数
+		friend class StatisticsManager;
+
+		/// @brief 延迟直方图实现结构体前向声明
 		struct Impl;
+	private:
+		Impl* m_pImpl; ///< 延迟直方图实现指针
+	};
+
+	/// @brief 输出器指标类
+	/// @details 记录单个输出器的 I/O 情况，用于区分卡顿来自格式化、队列还是磁盘。
+	///			 计数均为原子变量，可在任意线程更新；刷新耗时直方图由内部互斥锁保护（刷新频率低）。
+	///			 拷贝得到的是当前时刻的快照。
+	class IDLOG_API AppenderMetrics
+	{
+	public:
+		/// @brief 丢弃计数的分类数量，按 AsyncAppender::OverflowPolicy 的序号（BLOCK、DROP_OLDEST、DROP_NEWEST）索引
+		static constexpr size_t kDropPolicyCount = 3;
+
+	public:
+		/// @brief 构造函数
+		AppenderMetrics();
+		/// @brief 析构函数
+		~AppenderMetrics();
+
+		/// @brief 拷贝构造函数
+		/// @param other [IN] 另一个AppenderMetrics对象
+		AppenderMetrics(const AppenderMetrics& other);
+
+		/// @brief 拷贝赋值运算符
+		/// @param other [IN] 另一个AppenderMetrics对象
+		/// @return 当前AppenderMetrics对象的引用
+		AppenderMetrics& operator=(const AppenderMetrics& other);
+
+		/// @brief 记录写出的日志
+		/// @param records [IN] 记录数
+		/// @param bytes [IN] 字节数
+		void AddRecords(uint64_t records, uint64_t bytes);
+
+		/// @brief 记录写调用（系统调用）次数
+		/// @param calls [IN] 次数
+		void AddWriteCalls(uint64_t calls);
+
+		/// @brief 记录写入错误
+		/// @param errors [IN] 错误次数
+		void AddWriteErrors(uint64_t errors);
+
+		/// @brief 记录一次刷新
+		/// @param latencyNs [IN] 刷新耗时（纳秒）
+		void RecordFlush(uint64_t latencyNs);
+
+		/// @brief 记录一次文件滚动
+		/// @param durationNs [IN] 滚动耗时（纳秒）
+		void RecordRoll(uint64_t durationNs);
+
+		/// @brief 更新队列深度的最高水位
+		/// @param depth [IN] 观察到的队列深度
+		void UpdateQueueHighWaterMark(uint64_t depth);
+
+		/// @brief 记录丢弃的日志
+		/// @param policyIndex [IN] 丢弃发生时的溢出策略序号，超出范围时忽略
+		/// @param count [IN] 丢弃数量
+		void AddDropped(size_t policyIndex, uint64_t count = 1);
+
+		/// @brief 重置所有指标
+		void Reset();
+
+		/// @brief 获取写出的记录数
+		/// @return 记录数
+		uint64_t GetRecords() const;
+
+		/// @brief 获取写出的字节数
+		/// @return 字节数
+		uint64_t GetBytes() const;
+
+		/// @brief 获取写调用次数
+		/// @return 次数
+		uint64_t GetWriteCalls() const;
+
+		/// @brief 获取写入错误次数
+		/// @return 次数
+		uint64_t GetWriteErrors() const;
+
+		/// @brief 获取刷新次数
+		/// @return 次数
+		uint64_t GetFlushes() const;
+
+		/// @brief 获取刷新耗时直方图快照
+		/// @return 刷新耗时直方图
+		LatencyHistogram GetFlushLatency() const;
+
+		/// @brief 获取滚动次数
+		/// @return 次数
+		uint64_t GetRollCount() const;
+
+		/// @brief 获取滚动总耗时
+		/// @return 总耗时（纳秒）
+		uint64_t GetTotalRollTimeNs() const;
+
+		/// @brief 获取单次滚动最大耗时
+		/// @return 最大耗时（纳秒）
+		uint64_t GetMaxRollTimeNs() const;
+
+		/// @brief 获取队列深度最高水位
+		/// @return 最高水位
+		uint64_t GetQueueHighWaterMark() const;
+
+		/// @brief 获取指定溢出策略下丢弃的日志数
+		/// @param policyIndex [IN] 溢出策略序号
+		/// @return 丢弃数量
+		uint64_t GetDropped(size_t policyIndex) const;
+
+		/// @brief 获取丢弃的日志总数
+		/// @return 丢弃数量
+		uint64_t GetTotalDropped() const;
+
+		/// @brief 将指标转换为字符串
+		/// @return 指标的字符串表示
+		std::string ToString() const;
+
+		/// @brief 将指标转换为JSON对象字符串
+		/// @return 指标的JSON字符串表示
+		std::string ToJson() const;
 
 	private:
-		Impl* m_pImpl; ///< 时间窗口实现指针
+		/// @brief 输出器指标实现结构体前向声明
+		struct Impl;
+	private:
+		Impl* m_pImpl; ///< 输出器指标实现指针
 	};
 
 	/// @brief 日志统计信息类
@@ -171,6 +452,17 @@ namespace IDLog
 		/// @return 丢弃的日志字节数
 		uint64_t GetDroppedBytes() const;
 
+		/// @brief 获取延迟直方图
+		/// @details 日志器统计只包含 LOG_CALL；队列等待与写入延迟与日志器无关，只出现在全局统计中
+		/// @param type [IN] 延迟类型
+		/// @return 延迟直方图引用
+		LatencyHistogram& GetLatencyHistogram(LatencyType type);
+
+		/// @brief 获取延迟直方图（常量版本）
+		/// @param type [IN] 延迟类型
+		/// @return 延迟直方图引用
+		const LatencyHistogram& GetLatencyHistogram(LatencyType type) const;
+
 		/// @brief 记录日志
 		/// @param level [IN] 日志级别
 		/// @param messageSize [IN] 日志消息大小（字节数）
@@ -181,8 +473,13 @@ namespace IDLog
 		/// @param messageSize [IN] 日志消息大小（字节数）
 		void RecordDroppedLog(size_t messageSize);
 
-		/// @brief 更新时间窗口统计信息
-		void UpdateTimeWindow();
+		/// @brief 获取速率窗口
+		/// @return 速率窗口引用
+		RateWindow& GetRateWindow();
+
+		/// @brief 获取速率窗口（常量版本）
+		/// @return 速率窗口引用
+		const RateWindow& GetRateWindow() const;
 
 		/// @brief 将统计信息转换为字符串
 		/// @return 统计信息的字符串表示
@@ -199,6 +496,9 @@ namespace IDLog
 		static void UpdateMax(std::atomic<uint64_t>& maxValue, uint64_t newValue);
 
 	private:
+		/// @brief 统计管理类汇总分片计数时直接填充统计数据
+		friend class StatisticsManager;
+
 		/// @brief 日志统计信息实现结构体前向声明
 		struct Impl;
 	private:
@@ -207,8 +507,15 @@ namespace IDLog
 
 	/// @brief 统计管理类
 	/// @details 提供日志统计信息的管理和查询功能
+	///			 计数按线程分片：每个线程只写自己的分片（relaxed 读+写，无锁、无共享缓存行），
+	///			 分片内按日志器编号索引；日志器名称只在注册时查一次表。
+	///			 查询统计或生成报告时才汇总所有分片，重置通过递增纪元实现，写端发现纪元变化时自行清零。
 	class IDLOG_API StatisticsManager
 	{
+	public:
+		/// @brief 无效的日志器编号
+		static constexpr uint32_t kInvalidLoggerId = 0xFFFFFFFFu;
+
 	public:
 		/// @brief 获取统计管理类单例实例
 		/// @return 统计管理类实例引用
@@ -222,7 +529,26 @@ namespace IDLog
 		/// @return 当前StatisticsManager对象的引用
 		StatisticsManager& operator=(const StatisticsManager&) = delete;
 
+		/// @brief 注册日志器，获取统计用的日志器编号
+		/// @details 同名日志器始终得到同一个编号，调用方应缓存编号，热路径上只使用编号
+		/// @param loggerName [IN] 日志器名称
+		/// @return 日志器编号，超出容量时返回 kInvalidLoggerId
+		uint32_t RegisterLogger(const std::string& loggerName);
+
+		/// @brief 获取日志器编号对应的名称
+		/// @param loggerId [IN] 日志器编号
+		/// @return 日志器名称，编号无效时返回空字符串
+		std::string GetLoggerName(uint32_t loggerId) const;
+
 		/// @brief 记录日志
+		/// @param loggerId [IN] 日志器编号
+		/// @param level [IN] 日志级别
+		/// @param messageSize [IN] 日志消息大小（字节数）
+		/// @param latencyNs [IN] Logger::Log 调用耗时（纳秒），计入 LOG_CALL 直方图，为0时不记录
+		void RecordLog(uint32_t loggerId, LogLevel level,
+			size_t messageSize, uint64_t latencyNs = 0);
+
+		/// @brief 记录日志（按名称，每次调用都会查表，热路径请使用编号版本）
 		/// @param loggerName [IN] 日志器名称
 		/// @param level [IN] 日志级别
 		/// @param messageSize [IN] 日志消息大小（字节数）
@@ -230,7 +556,25 @@ namespace IDLog
 		void RecordLog(const std::string& loggerName, LogLevel level,
 			size_t messageSize, uint64_t waitTimeUs = 0);
 
+		/// @brief 记录与日志器无关的延迟（队列等待、写入耗时等）
+		/// @param type [IN] 延迟类型
+		/// @param latencyNs [IN] 延迟（纳秒）
+		void RecordLatency(LatencyType type, uint64_t latencyNs);
+
+		/// @brief 获取单调时钟的当前纳秒数，用于计算延迟
+		/// @return 纳秒数
+		static uint64_t GetMonotonicNs()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
 		/// @brief 记录丢弃的日志
+		/// @param loggerId [IN] 日志器编号
+		/// @param messageSize [IN] 日志消息大小（字节数）
+		void RecordDroppedLog(uint32_t loggerId, size_t messageSize);
+
+		/// @brief 记录丢弃的日志（按名称）
 		/// @param loggerName [IN] 日志器名称
 		/// @param messageSize [IN] 日志消息大小（字节数）
 		void RecordDroppedLog(const std::string& loggerName, size_t messageSize);
@@ -248,6 +592,15 @@ namespace IDLog
 		/// @return 日志器名称到统计信息的映射
 		std::map<std::string, LogStatistics> GetAllLoggerStatistics() const;
 
+		/// @brief 注册输出器，使其指标可以通过统计管理类查询
+		/// @details 只保存弱引用，输出器销毁后自动移除；重复注册同一个输出器无效果
+		/// @param appender [IN] 输出器智能指针
+		void RegisterAppender(const std::shared_ptr<LogAppender>& appender);
+
+		/// @brief 获取所有存活输出器的指标快照
+		/// @return 输出器名称与指标的列表，按注册顺序排列
+		std::vector<std::pair<std::string, AppenderMetrics>> GetAllAppenderMetrics() const;
+
 		/// @brief 重置指定日志器的统计信息
 		/// @param loggerName [IN] 日志器名称
 		void ResetLoggerStatistics(const std::string& loggerName);
@@ -272,6 +625,8 @@ namespace IDLog
 		uint64_t GetStatisticsInterval() const;
 
 		/// @brief 注册统计报告回调函数
+		/// @details 回调由低优先级的统计服务线程按统计报告间隔调用（仅在启用统计时），记录日志的线程只累加计数。
+		///			 回调中可以记录日志或修改统计设置；传入空函数取消报告。
 		/// @param callback [IN] 回调函数
 		void RegisterReportCallback(const std::function<void(const std::string&)>& callback);
 
@@ -279,14 +634,27 @@ namespace IDLog
 		/// @return 统计报告字符串
 		std::string GenerateReport() const;
 
+		/// @brief 开始把统计发布到内存映射文件
+		/// @details 由统计服务线程按间隔汇总并写入 StatsFile，外部工具（idlog-stat）随时读取，日志路径上没有额外开销。
+		///			 已在发布时先停止旧的发布。
+		/// @param path [IN] 文件路径，为空时使用 StatsFile::GetDefaultPath()
+		/// @param intervalMs [IN] 发布间隔，单位毫秒，为0时按1000毫秒处理
+		/// @return 文件创建成功返回true
+		bool StartStatsFile(const std::string& path = "", uint64_t intervalMs = 1000);
+
+		/// @brief 停止发布（发布最后一次后删除文件）
+		void StopStatsFile();
+
+		/// @brief 获取正在发布的统计文件路径
+		/// @return 文件路径，未发布时为空
+		std::string GetStatsFilePath() const;
+
 	private:
 		/// @brief 构造函数
 		StatisticsManager();
 		/// @brief 析构函数
 		~StatisticsManager();
 
-		/// @brief 检查是否需要生成统计报告
-		void CheckReport();
 	private:
 		/// @brief 统计管理类实现结构体前向声明
 		struct Impl;
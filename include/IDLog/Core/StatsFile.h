@@ -0,0 +1,182 @@
+/**
+ * @Description: 统计共享内存文件头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 20:42:17
+ * @LastEditTime: 2026-10-18 21:03:55
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_CORE_STATSFILE_H
+#define IDLOG_CORE_STATSFILE_H
+
+#include "IDLog/Core/Statistics.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace IDLog
+{
+	/// @brief 统计共享内存文件
+	/// @details 以固定布局把汇总后的统计计数与延迟分位数发布到内存映射文件（Linux 默认为 /dev/shm/idlog.<pid>.stats），
+	///			 外部工具（如 idlog-stat）随时映射读取，不需要进程配合。文件布局依次为：
+	///			 - 序列号 u64（独占一个缓存行）：顺序锁，写入期间为奇数
+	///			 - Header：魔数、版本、容量、当前数量、进程号与更新时间
+	///			 - Counters：全局统计
+	///			 - Counters × loggerCapacity：各日志器统计
+	///			 - AppenderCounters × appenderCapacity：各输出器指标
+	///			 只有一个写者（统计服务线程），读者复制整块数据后校验序列号未变化，否则重试。
+	///			 所有字段为本机字节序，名称超长时截断。
+	class IDLOG_API StatsFile
+	{
+	public:
+		/// @brief 格式版本号
+		static constexpr uint32_t kVersion = 1;
+		/// @brief 名称字段长度（含结尾的'\0'）
+		static constexpr size_t kNameSize = 96;
+		/// @brief 日志级别数量（TRACE ~ FATAL）
+		static constexpr size_t kLevelCount = 6;
+		/// @brief 速率窗口数量（1秒、10秒、60秒）
+		static constexpr size_t kRateWindowCount = 3;
+		/// @brief 延迟类型数量
+		static constexpr size_t kLatencyTypeCount = 3;
+
+		/// @brief 延迟摘要（单位纳秒）
+		struct LatencySummary
+		{
+			uint64_t count; ///< 样本数
+			uint64_t mean;	///< 平均值
+			uint64_t p50;	///< 50分位
+			uint64_t p90;	///< 90分位
+			uint64_t p99;	///< 99分位
+			uint64_t p999;	///< 99.9分位
+			uint64_t max;	///< 最大值
+		};
+
+		/// @brief 文件头
+		struct Header
+		{
+			char magic[8];			   ///< 魔数 "IDLGSTAT"
+			uint32_t version;		   ///< 格式版本号
+			uint32_t headerSize;	   ///< 文件头长度
+			uint32_t loggerCapacity;   ///< 日志器槽位数
+			uint32_t appenderCapacity; ///< 输出器槽位数
+			uint32_t loggerCount;	   ///< 当前有效的日志器数量
+			uint32_t appenderCount;	   ///< 当前有效的输出器数量
+			uint64_t pid;			   ///< 写入进程号
+			uint64_t startTimeMs;	   ///< 文件创建时间（Unix毫秒）
+			uint64_t updateTimeMs;	   ///< 最近一次发布时间（Unix毫秒）
+			uint64_t publishCount;	   ///< 发布次数
+		};
+
+		/// @brief 全局/日志器统计
+		struct Counters
+		{
+			char name[kNameSize];						 ///< 名称（全局统计为空）
+			uint64_t totalLogs;							 ///< 日志总数
+			uint64_t totalBytes;						 ///< 日志总字节数
+			uint64_t droppedLogs;						 ///< 丢弃的日志数
+			uint64_t droppedBytes;						 ///< 丢弃的字节数
+			uint64_t levelCount[kLevelCount];			 ///< 各级别日志数
+			uint64_t levelBytes[kLevelCount];			 ///< 各级别字节数
+			double logsPerSecond[kRateWindowCount];		 ///< 最近1/10/60秒的每秒日志数
+			double bytesPerSecond[kRateWindowCount];	 ///< 最近1/10/60秒的每秒字节数
+			LatencySummary latency[kLatencyTypeCount]; ///< 各类型延迟摘要，按 LatencyType 索引
+		};
+
+		/// @brief 输出器指标
+		struct AppenderCounters
+		{
+			char name[kNameSize];							 ///< 输出器名称
+			uint64_t records;								 ///< 写入的记录数
+			uint64_t bytes;									 ///< 写入的字节数
+			uint64_t writeCalls;							 ///< 系统写调用次数
+			uint64_t writeErrors;							 ///< 写错误次数
+			uint64_t flushes;								 ///< 刷新次数
+			uint64_t rollCount;								 ///< 滚动次数
+			uint64_t totalRollTimeNs;						 ///< 滚动总耗时
+			uint64_t maxRollTimeNs;							 ///< 滚动最大耗时
+			uint64_t queueHighWaterMark;					 ///< 队列深度高水位
+			uint64_t dropped[AppenderMetrics::kDropPolicyCount]; ///< 各溢出策略的丢弃数
+			LatencySummary flushLatency;					 ///< 刷新延迟摘要
+		};
+
+		/// @brief 读取到的快照
+		struct Snapshot
+		{
+			Header header;						   ///< 文件头
+			Counters global;					   ///< 全局统计
+			std::vector<Counters> loggers;		   ///< 日志器统计
+			std::vector<AppenderCounters> appenders; ///< 输出器指标
+		};
+
+	public:
+		/// @brief 构造函数
+		StatsFile();
+
+		/// @brief 析构函数（写者会删除文件）
+		~StatsFile();
+
+		/// @brief 拷贝构造函数(禁用)
+		StatsFile(const StatsFile &) = delete;
+
+		/// @brief 拷贝赋值运算符(禁用)
+		StatsFile &operator=(const StatsFile &) = delete;
+
+		/// @brief 创建统计文件并以写者身份映射
+		/// @param path [IN] 文件路径，为空时使用 GetDefaultPath()
+		/// @param loggerCapacity [IN] 日志器槽位数，超出部分不发布
+		/// @param appenderCapacity [IN] 输出器槽位数，超出部分不发布
+		/// @return 成功返回true
+		bool Create(const std::string &path = "", uint32_t loggerCapacity = 256, uint32_t appenderCapacity = 64);
+
+		/// @brief 以只读方式映射已有的统计文件
+		/// @param path [IN] 文件路径
+		/// @return 文件存在且格式正确时返回true
+		bool Open(const std::string &path);
+
+		/// @brief 解除映射；写者同时删除文件
+		void Close();
+
+		/// @brief 检查是否已映射
+		/// @return 已映射返回true
+		bool IsOpen() const;
+
+		/// @brief 获取文件路径
+		/// @return 文件路径
+		std::string GetPath() const;
+
+		/// @brief 发布一次统计（仅写者）
+		/// @param global [IN] 全局统计
+		/// @param loggers [IN] 各日志器名称与统计
+		/// @param appenders [IN] 各输出器名称与指标
+		/// @return 成功返回true
+		bool Publish(const LogStatistics &global,
+			const std::vector<std::pair<std::string, LogStatistics>> &loggers,
+			const std::vector<std::pair<std::string, AppenderMetrics>> &appenders);
+
+		/// @brief 读取一致的快照
+		/// @param snapshot [OUT] 快照
+		/// @return 成功返回true；写者持续更新导致多次重试仍不一致时返回false
+		bool Read(Snapshot &snapshot) const;
+
+		/// @brief 获取当前进程的默认统计文件路径
+		/// @return 默认路径
+		static std::string GetDefaultPath();
+
+		/// @brief 获取指定进程的默认统计文件路径
+		/// @param pid [IN] 进程号
+		/// @return 默认路径
+		static std::string GetDefaultPath(uint64_t pid);
+
+	private:
+		/// @brief 统计共享内存文件实现结构体前向声明
+		struct Impl;
+
+	private:
+		Impl *m_pImpl; ///< 统计共享内存文件实现指针
+	};
+
+} // namespace IDLog
+
+#endif // !IDLOG_CORE_STATSFILE_H
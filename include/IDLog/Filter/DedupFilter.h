@@ -0,0 +1,78 @@
+/**
+ * @Description: 重复日志抑制过滤器头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-19 01:03:26
+ * @LastEditTime: 2026-10-19 12:38:45
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_FILTER_DEDUPFILTER_H
+#define IDLOG_FILTER_DEDUPFILTER_H
+
+#include "IDLog/Filter/Filter.h"
+
+#include <chrono>
+#include <cstdint>
+
+namespace IDLog
+{
+	/// @brief 重复日志抑制过滤器
+	/// @details 按 日志器名称、级别、消息内容 计算哈希，记录在一张小的直接映射表中。
+	///			 同一条日志首次出现后的时间窗口内，完全相同的日志被拒绝，只累加次数与最后出现的时间；
+	///			 窗口结束后同一条日志再次出现，或表项被其他日志占用时，
+	///			 提交一条 "last message repeated N times ... in logger <name>" 说明（含首次与最后一次出现的时间），
+	///			 由日志器紧跟在当前日志之后输出（过滤器被多个日志器共享时可能由其他日志器输出，说明中附带原日志器名称）；重复停止后，窗口已结束的次数由之后的任意一条日志带出，
+	///			 移除过滤器时由日志器取出全部剩余说明。
+	///			 重复日志在进入输出目标之前被拒绝，不会占用异步输出器的队列
+	class IDLOG_API DedupFilter : public Filter
+	{
+	public:
+		/// @brief 构造函数
+		/// @param window [IN] 时间窗口，不大于0时不抑制
+		/// @param slotCount [IN] 表项数量，即能同时跟踪的不同日志条数，至少为1
+		explicit DedupFilter(std::chrono::milliseconds window = std::chrono::milliseconds(1000), size_t slotCount = 64);
+
+		/// @brief 析构函数
+		~DedupFilter() override;
+
+		/// @brief 拷贝构造函数(禁用)
+		DedupFilter(const DedupFilter &) = delete;
+
+		/// @brief 拷贝赋值运算符(禁用)
+		DedupFilter &operator=(const DedupFilter &) = delete;
+
+		/// @brief 过滤日志事件
+		/// @param event [IN] 日志事件智能指针
+		/// @return 窗口内的重复日志返回拒绝，否则中立
+		FilterDecision Decide(const LogEventPtr &event) override;
+
+		/// @brief 取出所有表项中尚未输出的重复次数说明
+		/// @param notices [OUT] 说明追加到末尾
+		void Flush(std::vector<Notice> &notices) override;
+
+		/// @brief 获取过滤器名称
+		/// @return 过滤器名称
+		std::string GetName() const override;
+
+		/// @brief 克隆过滤器（只复制配置，表为空；不影响本过滤器的表与尚未输出的说明）
+		/// @return 过滤器智能指针
+		Pointer Clone() const override;
+
+		/// @brief 获取时间窗口
+		/// @return 时间窗口
+		std::chrono::milliseconds GetWindow() const;
+
+		/// @brief 获取表项数量
+		/// @return 表项数量
+		size_t GetSlotCount() const;
+
+		/// @brief 获取累计被抑制的日志条数
+		/// @return 累计被抑制的日志条数
+		uint64_t GetSuppressedCount() const;
+
+	private:
+		struct Impl;
+		Impl *m_pImpl; ///< 实现指针
+	};
+} // namespace IDLog
+
+#endif // !IDLOG_FILTER_DEDUPFILTER_H
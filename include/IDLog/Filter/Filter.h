@@ -2,7 +2,7 @@
  * @Description: 过滤器基类头文件
  * @Author: InverseDark
  * @Date: 2025-12-18 20:36:25
- * @LastEditTime: 2025-12-18 20:37:38
+ * @LastEditTime: 2026-10-19 12:04:31
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_FILTER_FILTER_H
@@ -10,6 +10,7 @@
 
 #include "IDLog/Core/LogEvent.h"
 
+#include <cstdint>
 #include <vector>
 
 namespace IDLog
@@ -24,13 +25,22 @@ namespace IDLog
 
 	/// @brief 过滤器基类
 	/// @details 提供比日志级别更精细的日志控制
-	///			 支持链式过滤器
+	///			 支持链式过滤器。
+	///			 只依据级别、日志器编号与源文件位置就能决策的过滤器可以重写 CanPreDecide/PreDecide，
+	///			 日志器在创建日志事件之前调用它们，被拒绝的日志不会分配事件、读取时钟或复制消息
 	class IDLOG_API Filter
 	{
 	public:
 		using Pointer = std::shared_ptr<Filter>;
 		using LogEventPtr = LogEvent::Pointer;
 
+		/// @brief 过滤器附加的说明（如限流摘要），由日志器在当前日志之后输出到同一组输出目标
+		struct Notice
+		{
+			LogLevel level;		 ///< 日志级别
+			std::string message; ///< 说明内容
+		};
+
 	public:
 		/// @brief 析构函数
 		virtual ~Filter() = default;
@@ -40,6 +50,20 @@ namespace IDLog
 		/// @return 过滤决策
 		virtual FilterDecision Decide(const LogEventPtr &event) = 0;
 
+		/// @brief 检查是否能在创建日志事件之前决策
+		/// @details 返回true时日志器对每条日志只调用 PreDecide，不再调用 Decide。
+		///			 日志器在过滤器加入时读取一次，返回值不能在之后改变
+		/// @return 能提前决策返回true，默认false
+		virtual bool CanPreDecide() const;
+
+		/// @brief 创建日志事件之前的决策
+		/// @param level [IN] 日志级别
+		/// @param loggerId [IN] 日志器编号（Logger::GetId），可用 Logger::GetNameById 查询名称；
+		///						 编号会被回收复用，按编号缓存结果时需同时比较 Logger::GetIdGeneration
+		/// @param location [IN] 源文件位置
+		/// @return 过滤决策，默认中立
+		virtual FilterDecision PreDecide(LogLevel level, uint32_t loggerId, const SourceLocation &location);
+
 		/// @brief 获取过滤器名称
 		/// @return 过滤器名称
 		virtual std::string GetName() const = 0;
@@ -58,6 +82,20 @@ namespace IDLog
 
 		/// @brief 清空子过滤器
 		virtual void ClearFilters();
+
+		/// @brief 取出尚未提交的说明（如窗口内被抑制的条数），之后不再重复输出
+		/// @details 日志器在移除过滤器或析构时调用，把说明输出到自身的输出目标
+		/// @param notices [OUT] 说明追加到末尾
+		virtual void Flush(std::vector<Notice> &notices);
+
+		/// @brief 提交一条说明，由当前线程正在记录日志的日志器在本条日志之后输出
+		/// @param notice [IN] 说明
+		static void PostNotice(Notice notice);
+
+		/// @brief 取出当前线程待输出的说明（由日志器调用）
+		/// @param notices [OUT] 说明列表，原内容被替换
+		/// @return 有说明返回true
+		static bool TakeNotices(std::vector<Notice> &notices);
 	};
 
 	/// @brief 组合过滤器
@@ -85,6 +123,10 @@ namespace IDLog
 		/// @brief 清空子过滤器
 		void ClearFilters() override;
 
+		/// @brief 取出所有子过滤器尚未提交的说明
+		/// @param notices [OUT] 说明追加到末尾
+		void Flush(std::vector<Notice> &notices) override;
+
 	protected:
 		/// @brief 组合过滤器实现结构体前向声明
 		struct Impl;
@@ -2,7 +2,7 @@
  * @Description: 级别过滤器头文件
  * @Author: InverseDark
  * @Date: 2025-12-18 23:28:22
- * @LastEditTime: 2025-12-18 23:29:48
+ * @LastEditTime: 2026-10-19 01:21:37
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_FILTER_LEVELFILTER_H
@@ -30,6 +30,17 @@ namespace IDLog
 		/// @return 过滤决策
 		FilterDecision Decide(const LogEventPtr &event) override;
 
+		/// @brief 检查是否能在创建日志事件之前决策（只依据级别，总是可以）
+		/// @return true
+		bool CanPreDecide() const override { return true; }
+
+		/// @brief 创建日志事件之前的决策
+		/// @param level [IN] 日志级别
+		/// @param loggerId [IN] 日志器编号
+		/// @param location [IN] 源文件位置
+		/// @return 过滤决策
+		FilterDecision PreDecide(LogLevel level, uint32_t loggerId, const SourceLocation &location) override;
+
 		/// @brief 获取过滤器名称
 		/// @return 过滤器名称
 		std::string GetName() const override;
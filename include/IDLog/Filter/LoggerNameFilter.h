@@ -0,0 +1,86 @@
+/**
+ * @Description: 日志器名称过滤器头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-19 01:27:52
+ * @LastEditTime: 2026-10-19 12:09:15
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_FILTER_LOGGERNAMEFILTER_H
+#define IDLOG_FILTER_LOGGERNAMEFILTER_H
+
+#include "IDLog/Filter/Filter.h"
+
+#include <string>
+#include <vector>
+
+namespace IDLog
+{
+	/// @brief 日志器名称过滤器
+	/// @details 根据日志器名称进行过滤。名称规则：
+	///			 1. "name" 只匹配同名日志器
+	///			 2. "name.*" 匹配 name 及其所有子日志器（按'.'分级）
+	///			 3. "*" 匹配所有日志器
+	///			 匹配时按 acceptOnMatch 接受或拒绝，不匹配时中立，交给后续过滤器。
+	///			 在创建日志事件之前决策：匹配结果按日志器编号缓存在按需分配的分块表中，记录编号的代数，
+	///			 每个日志器只在首次记录时查询一次名称，之后读取两个原子变量（代数与缓存项），不加锁
+	class IDLOG_API LoggerNameFilter : public Filter
+	{
+	public:
+		/// @brief 构造函数
+		/// @param names [IN] 名称规则列表
+		/// @param acceptOnMatch [IN] 匹配时是否接受，false时拒绝
+		explicit LoggerNameFilter(const std::vector<std::string> &names, bool acceptOnMatch = true);
+
+		/// @brief 析构函数
+		~LoggerNameFilter() override;
+
+		/// @brief 拷贝构造函数(禁用)
+		LoggerNameFilter(const LoggerNameFilter &) = delete;
+
+		/// @brief 拷贝赋值运算符(禁用)
+		LoggerNameFilter &operator=(const LoggerNameFilter &) = delete;
+
+		/// @brief 过滤日志事件
+		/// @param event [IN] 日志事件智能指针
+		/// @return 过滤决策
+		FilterDecision Decide(const LogEventPtr &event) override;
+
+		/// @brief 检查是否能在创建日志事件之前决策（只依据日志器，总是可以）
+		/// @return true
+		bool CanPreDecide() const override { return true; }
+
+		/// @brief 创建日志事件之前的决策
+		/// @param level [IN] 日志级别
+		/// @param loggerId [IN] 日志器编号
+		/// @param location [IN] 源文件位置
+		/// @return 过滤决策
+		FilterDecision PreDecide(LogLevel level, uint32_t loggerId, const SourceLocation &location) override;
+
+		/// @brief 获取过滤器名称
+		/// @return 过滤器名称
+		std::string GetName() const override;
+
+		/// @brief 克隆过滤器
+		/// @return 过滤器智能指针
+		Pointer Clone() const override;
+
+		/// @brief 获取名称规则列表
+		/// @return 名称规则列表
+		const std::vector<std::string> &GetNames() const;
+
+		/// @brief 获取匹配时是否接受
+		/// @return 匹配时是否接受
+		bool GetAcceptOnMatch() const;
+
+		/// @brief 检查日志器名称是否匹配规则
+		/// @param loggerName [IN] 日志器名称
+		/// @return 匹配返回true
+		bool Matches(const std::string &loggerName) const;
+
+	private:
+		struct Impl;
+		Impl *m_pImpl; ///< 实现指针
+	};
+} // namespace IDLog
+
+#endif // !IDLOG_FILTER_LOGGERNAMEFILTER_H
@@ -0,0 +1,119 @@
+/**
+ * @Description: 限流过滤器头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-19 00:48:05
+ * @LastEditTime: 2026-10-19 11:31:50
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_FILTER_RATELIMITFILTER_H
+#define IDLOG_FILTER_RATELIMITFILTER_H
+
+#include "IDLog/Filter/Filter.h"
+
+#include <cstdint>
+
+namespace IDLog
+{
+	/// @brief 限流过滤器
+	/// @details 按日志器、级别和/或源文件位置分桶，每个桶是一个令牌桶：
+	///			 平均每秒放行 rate 条，最多连续放行 burst 条，超出的日志被拒绝。
+	///			 桶状态保存在固定大小的开放寻址表中，用原子操作更新，不加锁；
+	///			 表满或哈希冲突时多个键共用一个桶（限流更严格，不会放过更多日志）。
+	///			 桶恢复放行时，提交一条 "suppressed N messages" 说明（附带级别与源文件位置），
+	///			 由同一个日志器紧跟在放行的日志之后输出。
+	///			 只依据级别、日志器编号与源文件位置决策，被拒绝的日志不会创建日志事件
+	class IDLOG_API RateLimitFilter : public Filter
+	{
+	public:
+		/// @brief 分桶依据
+		enum KeyField : unsigned
+		{
+			KEY_LOGGER = 1u << 0,	///< 日志器
+			KEY_LEVEL = 1u << 1,	///< 日志级别
+			KEY_LOCATION = 1u << 2, ///< 源文件位置（调用点）
+			KEY_ALL = KEY_LOGGER | KEY_LEVEL | KEY_LOCATION
+		};
+
+	public:
+		/// @brief 构造函数
+		/// @param rate [IN] 每个桶每秒放行的日志条数，不大于0时不限流
+		/// @param burst [IN] 每个桶最多连续放行的日志条数，至少为1
+		/// @param keyFields [IN] 分桶依据（KeyField 的组合）
+		/// @param bucketCount [IN] 桶的数量，向上取整为2的幂
+		/// @param summaryEnabled [IN] 桶恢复放行时是否输出被抑制条数的说明
+		explicit RateLimitFilter(double rate = 10.0, uint32_t burst = 10, unsigned keyFields = KEY_ALL,
+								 size_t bucketCount = 1024, bool summaryEnabled = true);
+
+		/// @brief 析构函数
+		~RateLimitFilter() override;
+
+		/// @brief 拷贝构造函数(禁用)
+		RateLimitFilter(const RateLimitFilter &) = delete;
+
+		/// @brief 拷贝赋值运算符(禁用)
+		RateLimitFilter &operator=(const RateLimitFilter &) = delete;
+
+		/// @brief 过滤日志事件
+		/// @param event [IN] 日志事件智能指针
+		/// @return 超出限制返回拒绝，否则中立
+		FilterDecision Decide(const LogEventPtr &event) override;
+
+		/// @brief 检查是否能在创建日志事件之前决策
+		/// @return true
+		bool CanPreDecide() const override { return true; }
+
+		/// @brief 创建日志事件之前的决策
+		/// @param level [IN] 日志级别
+		/// @param loggerId [IN] 日志器编号
+		/// @param location [IN] 源文件位置
+		/// @return 超出限制返回拒绝，否则中立
+		FilterDecision PreDecide(LogLevel level, uint32_t loggerId, const SourceLocation &location) override;
+
+		/// @brief 取出所有桶中尚未输出的被抑制条数说明
+		/// @param notices [OUT] 说明追加到末尾
+		void Flush(std::vector<Notice> &notices) override;
+
+		/// @brief 获取过滤器名称
+		/// @return 过滤器名称
+		std::string GetName() const override;
+
+		/// @brief 克隆过滤器（配置相同，桶状态为初始状态）
+		/// @return 过滤器智能指针
+		Pointer Clone() const override;
+
+		/// @brief 获取每秒放行条数
+		/// @return 每秒放行条数
+		double GetRate() const;
+
+		/// @brief 获取最多连续放行条数
+		/// @return 最多连续放行条数
+		uint32_t GetBurst() const;
+
+		/// @brief 获取分桶依据
+		/// @return KeyField 的组合
+		unsigned GetKeyFields() const;
+
+		/// @brief 获取桶的数量
+		/// @return 桶的数量
+		size_t GetBucketCount() const;
+
+		/// @brief 是否输出被抑制条数的说明
+		/// @return 输出返回true
+		bool IsSummaryEnabled() const;
+
+		/// @brief 获取累计被拒绝的日志条数
+		/// @return 累计被拒绝的日志条数
+		uint64_t GetSuppressedCount() const;
+
+		/// @brief 解析分桶依据
+		/// @param text [IN] 逗号分隔的 logger、level、location，或 all
+		/// @return KeyField 的组合，无法识别时为 KEY_ALL
+		static unsigned ParseKeyFields(const std::string &text);
+
+	private:
+		struct Impl;
+		Impl *m_pImpl; ///< 实现指针
+	};
+} // namespace IDLog
+
+#endif // !IDLOG_FILTER_RATELIMITFILTER_H
@@ -0,0 +1,137 @@
+/**
+ * @Description: 二进制格式化器头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 14:10:26
+ * @LastEditTime: 2026-10-18 14:10:26
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_FORMATTER_BINARYFORMATTER_H
+#define IDLOG_FORMATTER_BINARYFORMATTER_H
+
+#include "IDLog/Formatter/Formatter.h"
+
+#include <functional>
+#include <vector>
+
+namespace IDLog
+{
+	/// @brief 二进制格式化器
+	/// @details 将日志事件编码为紧凑的自描述二进制流，由 idlog-decode 工具离线还原为文本。
+	///			 流由若干帧组成，每帧为 [类型 u8][负载长度 varint][负载]：
+	///			 - SEGMENT(0x01)：段头，负载为 "IDLB" + 版本号 u8 + 基准时间（纳秒 varint），清空字典
+	///			 - DICT(0x02)：字典项，负载为 种类 u8 + 编号 varint + 字符串字节；
+	///			   日志器名、文件名、函数名、线程ID、线程名在段内首次出现时各写出一次
+	///			 - RECORD(0x03)：日志记录，负载为 时间增量（纳秒，zigzag varint）+ 级别 u8 +
+	///			   线程ID编号 + 线程名编号 + 日志器编号 + 文件编号 + 函数编号 + 行号（均为 varint）+ 消息原始字节
+	///			 每个段都可独立解码，编码器每隔 segmentRecords 条记录开始新段，便于并行解码。
+	///			 编码器是有状态的，同一个实例输出的字节必须按 Format 调用顺序写入同一个流。
+	class IDLOG_API BinaryFormatter : public Formatter
+	{
+	public:
+		/// @brief 帧类型枚举
+		enum class FrameType : unsigned char
+		{
+			SEGMENT = 0x01, ///< 段头
+			DICT = 0x02,	///< 字典项
+			RECORD = 0x03	///< 日志记录
+		};
+
+		/// @brief 字典种类枚举
+		enum class DictKind : unsigned char
+		{
+			LOGGER = 1,		 ///< 日志器名称
+			FILE = 2,		 ///< 源文件名
+			FUNCTION = 3,	 ///< 函数名
+			THREAD_ID = 4,	 ///< 线程ID
+			THREAD_NAME = 5	 ///< 线程名称
+		};
+
+		/// @brief 格式版本号
+		static constexpr unsigned char kVersion = 1;
+
+	public:
+		/// @brief 构造函数
+		/// @param segmentRecords [IN] 每段最多包含的记录数，为0时不主动分段
+		explicit BinaryFormatter(size_t segmentRecords = 8192);
+
+		/// @brief 析构函数
+		~BinaryFormatter() override;
+
+		/// @brief 拷贝构造函数(禁用)
+		BinaryFormatter(const BinaryFormatter &) = delete;
+
+		/// @brief 拷贝赋值运算符(禁用)
+		BinaryFormatter &operator=(const BinaryFormatter &) = delete;
+
+		/// @brief 编码日志事件
+		/// @param event [IN] 日志事件
+		/// @return 编码后的字节（可能包含段头与字典项）
+		std::string Format(const LogEventPtr &event) override;
+
+		/// @brief 编码日志事件并追加到输出缓冲区
+		/// @param event [IN] 日志事件
+		/// @param out [OUT] 输出缓冲区
+		void FormatTo(const LogEventPtr &event, std::string &out) override;
+
+		/// @brief 克隆格式化器（新实例从新段开始编码）
+		/// @return 新的格式化器实例
+		Pointer Clone() const override;
+
+		/// @brief 获取格式化器名称
+		/// @return 格式化器名称
+		std::string GetName() const override { return "BinaryFormatter"; }
+
+		/// @brief 重置编码状态，下一条记录将开始新段
+		/// @details 开始写入新文件（包括滚动后的新文件）时必须调用
+		void Reset();
+
+		/// @brief 设置每段最多包含的记录数
+		/// @param segmentRecords [IN] 记录数，为0时不主动分段
+		void SetSegmentRecords(size_t segmentRecords);
+
+		/// @brief 获取每段最多包含的记录数
+		/// @return 记录数
+		size_t GetSegmentRecords() const;
+
+	private:
+		/// @brief 二进制格式化器实现结构体前向声明
+		struct Impl;
+
+	private:
+		Impl *m_pImpl; ///< 二进制格式化器实现指针
+	};
+
+	/// @brief 二进制日志解码器
+	/// @details 解析 BinaryFormatter 输出的二进制流，还原为日志事件
+	class IDLOG_API BinaryLogDecoder
+	{
+	public:
+		/// @brief 段描述
+		struct Segment
+		{
+			size_t offset; ///< 段在流中的起始偏移
+			size_t size;   ///< 段长度（字节）
+		};
+
+		/// @brief 事件回调类型
+		/// @details 事件的源文件位置指向解码器内部的字典，仅在回调期间有效
+		using EventCallback = std::function<void(const LogEvent::Pointer &)>;
+
+	public:
+		/// @brief 按段切分二进制流（只解析帧头，不解码记录）
+		/// @param data [IN] 数据指针
+		/// @param size [IN] 数据长度
+		/// @return 段列表；流首部没有段头的数据不属于任何段
+		static std::vector<Segment> SplitSegments(const char *data, size_t size);
+
+		/// @brief 解码二进制流（可包含多个段）
+		/// @param data [IN] 数据指针
+		/// @param size [IN] 数据长度
+		/// @param callback [IN] 每还原一条日志事件调用一次
+		/// @return 流完整且格式正确时返回true；遇到截断或损坏的数据时返回false（之前的事件已回调）
+		static bool Decode(const char *data, size_t size, const EventCallback &callback);
+	};
+
+} // namespace IDLog
+
+#endif // !IDLOG_FORMATTER_BINARYFORMATTER_H
@@ -2,7 +2,7 @@
  * @Description: 格式化器基类头文件
  * @Author: InverseDark
  * @Date: 2025-12-18 20:27:47
- * @LastEditTime: 2025-12-18 20:28:56
+ * @LastEditTime: 2026-10-18 13:20:05
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_FORMATTER_FORMATTER_H
@@ -28,6 +28,15 @@ namespace IDLog
 		/// @return 格式化后的字符串
 		virtual std::string Format(const LogEventPtr& event) = 0;
 
+		/// @brief 格式化日志事件并追加到输出缓冲区
+		/// @param event [IN] 日志事件
+		/// @param out [OUT] 输出缓冲区
+		/// @details 默认实现转调 Format；子类可重写以直接写入调用方复用的缓冲区，避免临时字符串
+		virtual void FormatTo(const LogEventPtr& event, std::string& out)
+		{
+			out += Format(event);
+		}
+
 		/// @brief 克隆格式化器
 		/// @return 新的格式化器实例
 		virtual Pointer Clone() const = 0;
@@ -1,8 +1,8 @@
-/** 
+/**
  * @Description: JSON 格式化器头文件
  * @Author: InverseDark
  * @Date: 2025-12-22 13:54:00
- * @LastEditTime: 2025-12-22 21:11:48
+ * @LastEditTime: 2026-10-19 12:33:27
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_FORMATTER_JSONFORMATTER_H
@@ -14,12 +14,16 @@ namespace IDLog
 {
 	/// @brief JSON 格式化器类
 	/// @details 将日志事件格式化为JSON格式，便于结构化处理
-	///			 示例输出：
+	///			 输出字段由字段列表（schema）决定，键名可自定义，可附加静态字段，
+	///			 键名片段在设置 schema 时预先计算好，格式化时直接写入输出缓冲区。
+	///			 设置方法采用写时复制：编译出新的 schema 后原子地替换，正在格式化的线程继续使用旧的 schema，
+	///			 因此可以在输出器与异步线程使用它时重新配置。
+	///			 默认 schema 的示例输出：
 	///			 {
 	///				 "timestamp": "2025-12-13 22:00:00.000",
 	///				 "level": "INFO",
 	///				 "logger": "main",
-	///				 "thread_id": "12345",
+	///				 "thread": "12345",
 	///				 "thread_name": "main",
 	///				 "file": "main.cpp",
 	///				 "function": "main",
@@ -28,16 +32,53 @@ namespace IDLog
 	///			 }
 	class IDLOG_API JsonFormatter : public Formatter
 	{
+	public:
+		/// @brief 字段枚举
+		enum class Field
+		{
+			TIMESTAMP,	 ///< 时间戳
+			LEVEL,		 ///< 日志级别
+			LOGGER,		 ///< 日志器名称
+			THREAD,		 ///< 线程ID
+			THREAD_NAME, ///< 线程名称
+			FILE,		 ///< 源文件名
+			FUNCTION,	 ///< 函数名
+			LINE,		 ///< 行号
+			MESSAGE		 ///< 日志消息
+		};
+
+		/// @brief 时间戳格式枚举
+		enum class TimestampFormat
+		{
+			TEXT,	  ///< 文本格式 "YYYY-mm-dd HH:MM:SS.mmm"
+			EPOCH_MS, ///< 自 Unix 纪元起的毫秒数（数值）
+			EPOCH_NS  ///< 自 Unix 纪元起的纳秒数（数值）
+		};
+
 	public:
 		/// @brief 构造函数
 		/// @param prettyPrint [IN] 是否美化输出（添加缩进和换行）
 		explicit JsonFormatter(bool prettyPrint = false);
 
+		/// @brief 析构函数
+		~JsonFormatter() override;
+
+		/// @brief 拷贝构造函数(禁用)
+		JsonFormatter(const JsonFormatter &) = delete;
+
+		/// @brief 拷贝赋值运算符(禁用)
+		JsonFormatter &operator=(const JsonFormatter &) = delete;
+
 		/// @brief 格式化日志事件
 		/// @param event [IN] 日志事件
 		/// @return 格式化后的字符串
 		std::string Format(const LogEventPtr &event) override;
 
+		/// @brief 格式化日志事件并追加到输出缓冲区
+		/// @param event [IN] 日志事件
+		/// @param out [OUT] 输出缓冲区
+		void FormatTo(const LogEventPtr &event, std::string &out) override;
+
 		/// @brief 克隆格式化器
 		/// @return 新的格式化器实例
 		Pointer Clone() const override;
@@ -48,22 +89,66 @@ namespace IDLog
 
 		/// @brief 设置是否美化输出
 		/// @param pretty [IN] 是否美化输出
-		void SetPrettyPrint(bool pretty) { m_prettyPrint = pretty; }
+		void SetPrettyPrint(bool pretty);
 
 		/// @brief 获取是否美化输出
 		/// @return 是否美化输出
-		bool GetPrettyPrint() const { return m_prettyPrint; }
+		bool GetPrettyPrint() const;
+
+		/// @brief 设置是否校验 UTF-8
+		/// @param validate [IN] 是否校验，开启后非法字节替换为 U+FFFD，保证输出为合法 JSON
+		void SetValidateUtf8(bool validate);
+
+		/// @brief 获取是否校验 UTF-8
+		/// @return 是否校验 UTF-8
+		bool GetValidateUtf8() const;
+
+		/// @brief 设置时间戳格式
+		/// @param format [IN] 时间戳格式
+		void SetTimestampFormat(TimestampFormat format);
+
+		/// @brief 获取时间戳格式
+		/// @return 时间戳格式
+		TimestampFormat GetTimestampFormat() const;
+
+		/// @brief 通过字段描述字符串设置字段列表
+		/// @param spec [IN] 逗号分隔的字段描述，每项形如 name[:key][?]
+		///				 name 为 timestamp/level/logger/thread/thread_name/file/function/line/message，
+		///				 key 为输出键名（缺省与 name 相同），结尾的 ? 表示值为空时省略该字段，
+		///				 如 "timestamp:@timestamp,level,message:msg,thread_name?"
+		/// @return 是否全部解析成功；有无法识别的字段时返回false，字段列表保持不变
+		bool SetFields(const std::string &spec);
+
+		/// @brief 追加字段
+		/// @param field [IN] 字段
+		/// @param key [IN] 输出键名，为空时使用默认键名
+		/// @param optional [IN] 值为空时是否省略该字段
+		void AddField(Field field, const std::string &key = "", bool optional = false);
+
+		/// @brief 清空字段列表
+		void ClearFields();
+
+		/// @brief 添加静态字段（如 service、host），追加在动态字段之后
+		/// @param key [IN] 键名
+		/// @param value [IN] 字符串值
+		void AddStaticField(const std::string &key, const std::string &value);
+
+		/// @brief 清空静态字段
+		void ClearStaticFields();
+
+		/// @brief 获取字段的默认键名
+		/// @param field [IN] 字段
+		/// @return 默认键名
+		static const char *GetDefaultKey(Field field);
 
 	private:
-		/// @brief 转义JSON字符串中的特殊字符
-		/// @param str [IN] 待转义的字符串
-		/// @return 转义后的字符串
-		std::string EscapeJson(const std::string &str) const;
+		/// @brief JSON 格式化器实现结构体前向声明
+		struct Impl;
 
 	private:
-		bool m_prettyPrint; ///< 是否美化输出
+		Impl *m_pImpl; ///< JSON 格式化器实现指针
 	};
 
 } // namespace IDLog
 
-#endif // !IDLOG_FORMATTER_JSONFORMATTER_H
\ No newline at end of file
+#endif // !IDLOG_FORMATTER_JSONFORMATTER_H
@@ -2,7 +2,7 @@
  * @Description: 模式格式化器头文件
  * @Author: InverseDark
  * @Date: 2025-12-18 21:46:30
- * @LastEditTime: 2025-12-18 21:49:45
+ * @LastEditTime: 2026-10-19 10:06:12
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_FORMATTER_PATTERNFORMATTER_H
@@ -90,6 +90,12 @@ namespace IDLog
 		/// @return 默认模式字符串
 		static std::string defaultPattern();
 
+		/// @brief 获取使用默认模式的共享格式化器
+		/// @details 进程内只解析一次，由所有未指定格式化器的输出器共享。
+		///			 SetPattern 对它同样安全（写时复制），但会影响所有共享它的输出器，需要定制时先 Clone()
+		/// @return 共享的默认格式化器
+		static const Pointer &GetDefault();
+
 		/// @brief 格式化日志事件
 		/// @param event [IN] 日志事件
 		/// @return 格式化后的字符串
@@ -108,13 +114,11 @@ namespace IDLog
 		const std::string &GetPattern() const;
 
 		/// @brief 设置新的模式字符串
+		/// @details 解析出新的格式化项列表后原子地替换，可以与 Format 并发调用；
+		///			 旧的解析结果在格式化器析构前保留，模式字符串不应频繁修改
 		/// @param pattern [IN] 新的模式字符串
 		void SetPattern(const std::string &pattern);
 
-	private:
-		/// @brief 解析模式字符串
-		void ParsePattern();
-
 	private:
 		/// @brief 模式格式化器实现结构体前向声明
 		struct Impl;
@@ -2,7 +2,7 @@
  * @Description: IDLog 日志库主头文件
  * @Author: InverseDark
  * @Date: 2025-12-18 23:23:17
- * @LastEditTime: 2026-01-01 15:49:23
+ * @LastEditTime: 2026-10-19 01:31:05
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_IDLOG_H
@@ -12,32 +12,47 @@
 #include "IDLog/Core/Macro.h"
 #include "IDLog/Core/Version.h"
 #include "IDLog/Core/LogLevel.h"
+#include "IDLog/Core/LogMessage.h"
 #include "IDLog/Core/LogEvent.h"
 #include "IDLog/Core/Logger.h"
+#include "IDLog/Core/LogStream.h"
 #include "IDLog/Core/LoggerManager.h"
+#include "IDLog/Core/LogThrottle.h"
 #include "IDLog/Core/Configuration.h"
 #include "IDLog/Core/LogFactory.h"
 #include "IDLog/Core/Statistics.h"
+#include "IDLog/Core/CallSite.h"
+#include "IDLog/Core/StatsFile.h"
 
 // 包含输出器头文件
 #include "IDLog/Appender/LogAppender.h"
 #include "IDLog/Appender/ConsoleAppender.h"
 #include "IDLog/Appender/FileAppender.h"
 #include "IDLog/Appender/AsyncAppender.h"
+#include "IDLog/Appender/BinaryFileAppender.h"
 
 // 包含格式化器头文件
 #include "IDLog/Formatter/Formatter.h"
 #include "IDLog/Formatter/PatternFormatter.h"
 #include "IDLog/Formatter/JsonFormatter.h"
+#include "IDLog/Formatter/BinaryFormatter.h"
 
 // 包含过滤器头文件
 #include "IDLog/Filter/Filter.h"
 #include "IDLog/Filter/LevelFilter.h"
+#include "IDLog/Filter/RateLimitFilter.h"
+#include "IDLog/Filter/DedupFilter.h"
+#include "IDLog/Filter/LoggerNameFilter.h"
 
 // 包含工具头文件
 #include "IDLog/Utils/StringUtil.h"
+#include "IDLog/Utils/Format.h"
+#include "IDLog/Utils/JsonUtil.h"
 #include "IDLog/Utils/ThreadUtil.h"
 #include "IDLog/Utils/ConfigParseUtil.h"
 #include "IDLog/Utils/AsyncQueue.h"
+#include "IDLog/Utils/LogReader.h"
+#include "IDLog/Utils/FileWatcher.h"
+#include "IDLog/Utils/EpochReclaimer.h"
 
 #endif // !IDLOG_IDLOG_H
\ No newline at end of file
@@ -2,7 +2,7 @@
  * @Description: 异步队列头文件
  * @Author: InverseDark
  * @Date: 2025-12-24 09:36:02
- * @LastEditTime: 2025-12-24 13:59:00
+ * @LastEditTime: 2026-10-18 19:46:02
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_UTILS_ASYNCQUEUE_H
@@ -93,6 +93,13 @@ namespace IDLog
 			/// @return 如果已停止返回true，否则返回false
 			bool IsStopped() const;
 
+			/// @brief 获取队列深度的最高水位（自创建或上次重置以来）
+			/// @return 最高水位
+			size_t GetHighWaterMark() const;
+
+			/// @brief 重置最高水位为当前队列大小
+			void ResetHighWaterMark();
+
 		private:
 			/// @brief 等待队列非满
 			/// @param lock [IN] 互斥锁的引用
@@ -106,6 +113,9 @@ namespace IDLog
 			/// @return 如果队列非空返回true，否则返回false
 			bool WaitForNotEmpty(std::unique_lock<std::mutex>& lock, uint64_t timeoutMs);
 
+			/// @brief 入队后更新最高水位（调用方需持有 m_mutex）
+			void UpdateHighWaterMark();
+
 		private:
 			mutable std::mutex m_mutex;					///< 互斥锁，保护队列数据
 			std::condition_variable m_notEmptyCondVar;	///< 非空条件变量
@@ -113,6 +123,7 @@ namespace IDLog
 			std::atomic<bool> m_stopped;				///< 队列停止标志
 			QueueType m_queue;							///< 队列容器
 			size_t m_capacity;							///< 队列容量
+			std::atomic<size_t> m_highWaterMark;		///< 队列深度最高水位
 		};
 	} // namespace Utils
 } // namespace IDLog
@@ -2,7 +2,7 @@
  * @Description: 异步队列内联实现文件
  * @Author: InverseDark
  * @Date: 2025-12-24 10:29:36
- * @LastEditTime: 2025-12-27 12:47:31
+ * @LastEditTime: 2026-10-18 19:46:02
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_UTILS_ASYNCQUEUE_INL
@@ -14,7 +14,7 @@ namespace IDLog
 	{
 		template <typename T>
 		AsyncQueue<T>::AsyncQueue(size_t capacity)
-			: m_capacity(capacity), m_stopped(false)
+			: m_stopped(false), m_capacity(capacity), m_highWaterMark(0)
 		{
 		}
 
@@ -44,6 +44,7 @@ namespace IDLog
 
             bool wasEmpty = m_queue.empty();
             m_queue.push(element);
+            UpdateHighWaterMark();
             
             // 只有当队列之前为空时，才需要唤醒消费者
             if (wasEmpty)
@@ -73,6 +74,7 @@ namespace IDLog
 
             bool wasEmpty = m_queue.empty();
             m_queue.push(std::move(element));
+            UpdateHighWaterMark();
             
             // 只有当队列之前为空时，才需要唤醒消费者
             if (wasEmpty)
@@ -95,6 +97,7 @@ namespace IDLog
 
             bool wasEmpty = m_queue.empty();
             m_queue.push(element);
+            UpdateHighWaterMark();
             
             // 只有当队列之前为空时，才需要唤醒消费者
             if (wasEmpty)
@@ -221,6 +224,29 @@ namespace IDLog
 			return m_stopped.load();
 		}
 
+		template <typename T>
+		size_t AsyncQueue<T>::GetHighWaterMark() const
+		{
+			return m_highWaterMark.load(std::memory_order_relaxed);
+		}
+
+		template <typename T>
+		void AsyncQueue<T>::ResetHighWaterMark()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_highWaterMark.store(m_queue.size(), std::memory_order_relaxed);
+		}
+
+		template <typename T>
+		void AsyncQueue<T>::UpdateHighWaterMark()
+		{
+			size_t size = m_queue.size();
+			if (size > m_highWaterMark.load(std::memory_order_relaxed))
+			{
+				m_highWaterMark.store(size, std::memory_order_relaxed);
+			}
+		}
+
 		template <typename T>
 		bool AsyncQueue<T>::WaitForNotFull(std::unique_lock<std::mutex> &lock, uint64_t timeoutMs)
 		{
@@ -0,0 +1,100 @@
+/**
+ * @Description: 读者纪元延迟释放头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-19 11:48:36
+ * @LastEditTime: 2026-10-19 11:48:36
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_UTILS_EPOCHRECLAIMER_H
+#define IDLOG_UTILS_EPOCHRECLAIMER_H
+
+#include "IDLog/Core/Macro.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace IDLog
+{
+	namespace Utils
+	{
+		/// @brief 读者纪元
+		/// @details 无锁读取的共享对象被写者替换后，旧对象可能仍被并发读者访问。
+		///			 读者在读取期间把进入时的全局纪元登记在本线程的槽中（ReaderGuard）；
+		///			 写者替换对象后推进全局纪元作为旧对象的退役纪元，等所有读者的登记纪元都不小于它时再释放（RetiredList）。
+		///			 读取路径只有两次原子存储，不修改共享的引用计数
+		class IDLOG_API EpochReclaimer
+		{
+		public:
+			/// @brief 读取期间登记纪元，阻止写者释放可能正在读取的对象
+			/// @details 可以嵌套，只有最外层登记与撤销（内层读取的对象退役纪元更大，同样受保护）
+			class IDLOG_API ReaderGuard
+			{
+			public:
+				/// @brief 构造函数，登记当前全局纪元
+				ReaderGuard();
+
+				/// @brief 析构函数，撤销登记
+				~ReaderGuard();
+
+				/// @brief 拷贝构造函数(禁用)
+				ReaderGuard(const ReaderGuard &) = delete;
+
+				/// @brief 拷贝赋值运算符(禁用)
+				ReaderGuard &operator=(const ReaderGuard &) = delete;
+
+			private:
+				void *m_slot; ///< 本线程的读者槽，嵌套时为空
+			};
+
+			/// @brief 推进全局纪元（写者发布新对象之后调用）
+			/// @return 推进后的纪元，之后登记的读者一定读到新对象
+			static uint64_t Advance();
+
+			/// @brief 获取正在读取的读者中最早的登记纪元
+			/// @param limit [IN] 上限，没有读者时返回它
+			/// @return 最早的登记纪元
+			static uint64_t OldestReader(uint64_t limit);
+		};
+
+		/// @brief 已退役、可能仍有读者的对象列表（只由写者访问，调用方负责同步）
+		/// @tparam T 对象类型
+		template <typename T>
+		class RetiredList
+		{
+		public:
+			/// @brief 退役对象（发布替代它的新对象之后调用），并释放已没有读者的退役对象
+			/// @param object [IN] 旧对象，可以为空
+			void Retire(std::unique_ptr<T> object)
+			{
+				const uint64_t epoch = EpochReclaimer::Advance();
+				if (object)
+				{
+					m_retired.push_back({std::move(object), epoch});
+				}
+				if (m_retired.empty())
+				{
+					return;
+				}
+
+				const uint64_t oldest = EpochReclaimer::OldestReader(epoch);
+				m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(), [oldest](const Retired &retired)
+											   { return retired.epoch <= oldest; }),
+								m_retired.end());
+			}
+
+		private:
+			/// @brief 已退役的对象
+			struct Retired
+			{
+				std::unique_ptr<T> object; ///< 对象
+				uint64_t epoch;			   ///< 退役纪元，登记纪元不小于它的读者看不到这个对象
+			};
+
+			std::vector<Retired> m_retired; ///< 可能仍有读者的退役对象
+		};
+	} // namespace Utils
+} // namespace IDLog
+
+#endif // !IDLOG_UTILS_EPOCHRECLAIMER_H
@@ -0,0 +1,79 @@
+/**
+ * @Description: 文件监视工具头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 21:26:40
+ * @LastEditTime: 2026-10-18 21:26:40
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_UTILS_FILEWATCHER_H
+#define IDLOG_UTILS_FILEWATCHER_H
+
+#include "IDLog/Core/Macro.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace IDLog
+{
+	namespace Utils
+	{
+		/// @brief 文件监视工具类
+		/// @details 在后台线程中监视单个文件的变化，变化平息 debounce 毫秒后回调一次。
+		///			 Linux 下使用 inotify 监视文件所在目录（原子重命名替换文件也能感知），毫秒级响应；
+		///			 其他平台或 inotify 不可用时退化为按间隔比较修改时间与大小。
+		///			 停止时立即唤醒后台线程，不需要等待一个轮询周期。
+		class IDLOG_API FileWatcher
+		{
+		public:
+			/// @brief 变化回调类型，参数为被监视的文件路径
+			using Callback = std::function<void(const std::string &)>;
+
+		public:
+			/// @brief 构造函数
+			FileWatcher();
+
+			/// @brief 析构函数（会停止监视）
+			~FileWatcher();
+
+			/// @brief 拷贝构造函数(禁用)
+			FileWatcher(const FileWatcher &) = delete;
+
+			/// @brief 拷贝赋值运算符(禁用)
+			FileWatcher &operator=(const FileWatcher &) = delete;
+
+			/// @brief 开始监视（已在监视时先停止）
+			/// @param path [IN] 文件路径，文件可以暂不存在
+			/// @param callback [IN] 变化回调，在后台线程中调用；回调中不能调用 Stop/Start
+			/// @param debounceMs [IN] 去抖时间，单位毫秒，最后一次变化后静默这么久才回调
+			/// @param pollIntervalMs [IN] 退化为轮询时的检查间隔，单位毫秒
+			/// @return 成功启动返回true
+			bool Start(const std::string &path, const Callback &callback,
+				uint64_t debounceMs = 50, uint64_t pollIntervalMs = 1000);
+
+			/// @brief 停止监视并等待后台线程退出（正在执行的回调结束后立即返回）
+			void Stop();
+
+			/// @brief 检查是否正在监视
+			/// @return 正在监视返回true
+			bool IsRunning() const;
+
+			/// @brief 检查是否使用系统通知（而非轮询）
+			/// @return 使用 inotify 返回true
+			bool IsNative() const;
+
+			/// @brief 获取被监视的文件路径
+			/// @return 文件路径，未监视时为空
+			std::string GetPath() const;
+
+		private:
+			/// @brief 文件监视工具实现结构体前向声明
+			struct Impl;
+
+		private:
+			Impl *m_pImpl; ///< 文件监视工具实现指针
+		};
+	} // namespace Utils
+} // namespace IDLog
+
+#endif // !IDLOG_UTILS_FILEWATCHER_H
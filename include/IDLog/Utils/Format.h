@@ -0,0 +1,452 @@
+/**
+ * @Description: 类型安全的格式化工具头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 23:20:15
+ * @LastEditTime: 2026-10-18 23:20:15
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_UTILS_FORMAT_H
+#define IDLOG_UTILS_FORMAT_H
+
+#include "IDLog/Core/Macro.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/// @brief 格式字符串语法（与 std::format 的常用子集一致）：
+///		   "{}" 依次引用下一个参数，"{0}" 按下标引用参数，"{{" 与 "}}" 输出花括号本身；
+///		   冒号后为格式说明 [[fill]align][sign][#][0][width][.precision][type]：
+///		   align 为 '<' '>' '^'，sign 为 '+' '-' ' '，type 为 b B c d o x X e E f F g G s p 之一。
+///		   例如 "{:>8}"、"{:08.3f}"、"{:#x}"、"{1:.2e}"。
+namespace IDLog
+{
+	namespace Utils
+	{
+		/// @brief 格式说明
+		struct FormatSpec
+		{
+			char fill = ' ';		///< 填充字符
+			char align = '\0';		///< 对齐方式，'\0' 表示按类型默认（数字右对齐，其他左对齐）
+			char sign = '-';		///< 符号显示方式
+			bool alternate = false; ///< '#'：整数输出进制前缀
+			bool zeroPad = false;	///< '0'：数字在符号与前缀之后补零
+			int width = 0;			///< 最小宽度（按字符计，UTF-8 多字节字符算一个）
+			int precision = -1;		///< 精度，-1 表示未指定；字符串为最大长度
+			char type = '\0';		///< 类型字符，'\0' 表示按类型默认
+		};
+
+		/// @brief 格式字符串无效时 CountFormatArgs 的返回值
+		constexpr std::size_t kInvalidFormat = static_cast<std::size_t>(-1);
+
+		/// @brief 解析格式说明（冒号之后、右花括号之前的部分）
+		/// @param text [IN] 格式说明文本
+		/// @param spec [OUT] 解析结果
+		/// @return 语法正确返回true
+		constexpr bool ParseFormatSpec(std::string_view text, FormatSpec &spec)
+		{
+			std::size_t pos = 0;
+			auto isAlign = [](char c)
+			{ return c == '<' || c == '>' || c == '^'; };
+
+			if (text.size() >= 2 && isAlign(text[1]) && text[0] != '{' && text[0] != '}')
+			{
+				spec.fill = text[0];
+				spec.align = text[1];
+				pos = 2;
+			}
+			else if (!text.empty() && isAlign(text[0]))
+			{
+				spec.align = text[0];
+				pos = 1;
+			}
+
+			if (pos < text.size() && (text[pos] == '+' || text[pos] == '-' || text[pos] == ' '))
+			{
+				spec.sign = text[pos++];
+			}
+			if (pos < text.size() && text[pos] == '#')
+			{
+				spec.alternate = true;
+				++pos;
+			}
+			if (pos < text.size() && text[pos] == '0')
+			{
+				spec.zeroPad = true;
+				++pos;
+			}
+
+			while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9')
+			{
+				spec.width = spec.width * 10 + (text[pos++] - '0');
+				if (spec.width > 4096)
+				{
+					return false;
+				}
+			}
+
+			if (pos < text.size() && text[pos] == '.')
+			{
+				++pos;
+				if (pos >= text.size() || text[pos] < '0' || text[pos] > '9')
+				{
+					return false;
+				}
+				spec.precision = 0;
+				while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9')
+				{
+					spec.precision = spec.precision * 10 + (text[pos++] - '0');
+					if (spec.precision > 4096)
+					{
+						return false;
+					}
+				}
+			}
+
+			if (pos < text.size())
+			{
+				constexpr std::string_view kTypes = "bBcdoxXeEfFgGsp";
+				if (kTypes.find(text[pos]) == std::string_view::npos)
+				{
+					return false;
+				}
+				spec.type = text[pos++];
+			}
+			return pos == text.size();
+		}
+
+		/// @brief 统计格式字符串需要的参数个数，同时检查语法
+		/// @param format [IN] 格式字符串
+		/// @return 需要的参数个数（"{}" 的个数与最大显式下标 + 1 中的较大者），语法错误返回 kInvalidFormat
+		constexpr std::size_t CountFormatArgs(std::string_view format)
+		{
+			std::size_t autoCount = 0;
+			std::size_t indexedCount = 0;
+			for (std::size_t i = 0; i < format.size(); ++i)
+			{
+				if (format[i] == '}')
+				{
+					// 单独的 '}' 必须写成 "}}"
+					if (i + 1 >= format.size() || format[i + 1] != '}')
+					{
+						return kInvalidFormat;
+					}
+					++i;
+					continue;
+				}
+				if (format[i] != '{')
+				{
+					continue;
+				}
+				if (i + 1 < format.size() && format[i + 1] == '{')
+				{
+					++i;
+					continue;
+				}
+
+				std::size_t close = format.find('}', i + 1);
+				if (close == std::string_view::npos)
+				{
+					return kInvalidFormat;
+				}
+				std::string_view field = format.substr(i + 1, close - i - 1);
+				std::size_t colon = field.find(':');
+				std::string_view index = field.substr(0, colon);
+				if (index.find('{') != std::string_view::npos)
+				{
+					return kInvalidFormat;
+				}
+
+				if (index.empty())
+				{
+					++autoCount;
+				}
+				else
+				{
+					std::size_t value = 0;
+					for (char c : index)
+					{
+						if (c < '0' || c > '9')
+						{
+							return kInvalidFormat;
+						}
+						value = value * 10 + static_cast<std::size_t>(c - '0');
+					}
+					indexedCount = value + 1 > indexedCount ? value + 1 : indexedCount;
+				}
+
+				FormatSpec spec;
+				if (colon != std::string_view::npos && !ParseFormatSpec(field.substr(colon + 1), spec))
+				{
+					return kInvalidFormat;
+				}
+				i = close;
+			}
+			return autoCount > indexedCount ? autoCount : indexedCount;
+		}
+
+		/// @brief 检查格式字符串语法正确且引用的参数个数与实际参数个数一致
+		/// @param format [IN] 格式字符串
+		/// @param argCount [IN] 实际参数个数
+		/// @return 一致返回true
+		constexpr bool CheckFormat(std::string_view format, std::size_t argCount)
+		{
+			return CountFormatArgs(format) == argCount;
+		}
+
+		namespace detail
+		{
+			/// @brief 输出整数（绝对值与符号分开传入，避免有符号最小值取反溢出）
+			IDLOG_API void FormatInteger(std::string &out, unsigned long long absValue, bool negative, const FormatSpec &spec);
+
+			/// @brief 输出浮点数
+			IDLOG_API void FormatFloat(std::string &out, double value, const FormatSpec &spec);
+			IDLOG_API void FormatFloat(std::string &out, float value, const FormatSpec &spec);
+			IDLOG_API void FormatFloat(std::string &out, long double value, const FormatSpec &spec);
+
+			/// @brief 输出字符串
+			IDLOG_API void FormatString(std::string &out, std::string_view value, const FormatSpec &spec);
+
+			/// @brief 输出指针地址（十六进制）
+			IDLOG_API void FormatPointer(std::string &out, const void *value, const FormatSpec &spec);
+
+			/// @brief 类型擦除后的参数：值的地址与对应的输出函数
+			struct FormatArg
+			{
+				const void *value;											  ///< 参数地址
+				void (*format)(std::string &, const void *, const FormatSpec &); ///< 输出函数
+			};
+
+			/// @brief 按参数列表格式化（非模板部分，所有参数类型共用）
+			IDLOG_API void VFormatTo(std::string &out, std::string_view format, const FormatArg *args, std::size_t count);
+
+			/// @brief 统计参数个数（仅用于 decltype，不求值）
+			template <typename... Args>
+			std::integral_constant<std::size_t, sizeof...(Args)> CountArgs(const Args &...);
+
+			/// @brief 检查类型是否支持 operator<<
+			template <typename T, typename = void>
+			struct IsStreamable : std::false_type
+			{
+			};
+			template <typename T>
+			struct IsStreamable<T, std::void_t<decltype(std::declval<std::ostream &>() << std::declval<const T &>())>>
+				: std::true_type
+			{
+			};
+		} // namespace detail
+
+		/// @brief 类型格式化器，用户类型通过特化它接入格式化：
+		/// @code
+		///		template <> struct IDLog::Utils::TypeFormatter<Point>
+		///		{
+		///			static void Format(std::string &out, const Point &p, const IDLog::Utils::FormatSpec &spec)
+		///			{
+		///				IDLog::Utils::FormatTo(out, "({}, {})", p.x, p.y);
+		///			}
+		///		};
+		/// @endcode
+		/// @details 未特化的类型如果支持 operator<<，通过 ostringstream 输出；两者都没有时编译报错
+		template <typename T, typename Enable = void>
+		struct TypeFormatter
+		{
+			static void Format(std::string &out, const T &value, const FormatSpec &spec)
+			{
+				static_assert(detail::IsStreamable<T>::value,
+							  "IDLog: 参数类型既没有 TypeFormatter 特化，也不支持 operator<<");
+				std::ostringstream oss;
+				oss << value;
+				detail::FormatString(out, oss.str(), spec);
+			}
+		};
+
+		/// @brief 整数
+		template <typename T>
+		struct TypeFormatter<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>>>
+		{
+			static void Format(std::string &out, T value, const FormatSpec &spec)
+			{
+				using Unsigned = std::make_unsigned_t<T>;
+				bool negative = false;
+				unsigned long long absValue = static_cast<Unsigned>(value);
+				if constexpr (std::is_signed_v<T>)
+				{
+					if (value < 0)
+					{
+						negative = true;
+						absValue = 0ULL - static_cast<unsigned long long>(static_cast<long long>(value));
+					}
+				}
+				detail::FormatInteger(out, absValue, negative, spec);
+			}
+		};
+
+		/// @brief 浮点数
+		template <typename T>
+		struct TypeFormatter<T, std::enable_if_t<std::is_floating_point_v<T>>>
+		{
+			static void Format(std::string &out, T value, const FormatSpec &spec)
+			{
+				detail::FormatFloat(out, value, spec);
+			}
+		};
+
+		/// @brief 布尔值，默认输出 true/false，指定整数类型时输出 1/0
+		template <>
+		struct TypeFormatter<bool>
+		{
+			static void Format(std::string &out, bool value, const FormatSpec &spec)
+			{
+				if (spec.type != '\0' && spec.type != 's')
+				{
+					detail::FormatInteger(out, value ? 1 : 0, false, spec);
+					return;
+				}
+				detail::FormatString(out, value ? "true" : "false", spec);
+			}
+		};
+
+		/// @brief 字符，默认输出字符本身，指定整数类型时输出编码
+		template <>
+		struct TypeFormatter<char>
+		{
+			static void Format(std::string &out, char value, const FormatSpec &spec)
+			{
+				if (spec.type != '\0' && spec.type != 'c' && spec.type != 's')
+				{
+					detail::FormatInteger(out, static_cast<unsigned char>(value), false, spec);
+					return;
+				}
+				detail::FormatString(out, std::string_view(&value, 1), spec);
+			}
+		};
+
+		/// @brief C 字符串，空指针输出 "(null)"
+		template <>
+		struct TypeFormatter<const char *>
+		{
+			static void Format(std::string &out, const char *value, const FormatSpec &spec)
+			{
+				detail::FormatString(out, value ? std::string_view(value) : std::string_view("(null)"), spec);
+			}
+		};
+		template <>
+		struct TypeFormatter<char *> : TypeFormatter<const char *>
+		{
+		};
+
+		/// @brief 字符数组（字符串字面量），遇到 '\0' 结束
+		template <std::size_t N>
+		struct TypeFormatter<char[N]>
+		{
+			static void Format(std::string &out, const char (&value)[N], const FormatSpec &spec)
+			{
+				const void *end = std::memchr(value, '\0', N);
+				std::size_t length = end ? static_cast<std::size_t>(static_cast<const char *>(end) - value) : N;
+				detail::FormatString(out, std::string_view(value, length), spec);
+			}
+		};
+
+		/// @brief std::string
+		template <>
+		struct TypeFormatter<std::string>
+		{
+			static void Format(std::string &out, const std::string &value, const FormatSpec &spec)
+			{
+				detail::FormatString(out, value, spec);
+			}
+		};
+
+		/// @brief std::string_view
+		template <>
+		struct TypeFormatter<std::string_view>
+		{
+			static void Format(std::string &out, std::string_view value, const FormatSpec &spec)
+			{
+				detail::FormatString(out, value, spec);
+			}
+		};
+
+		/// @brief 其他指针，输出十六进制地址
+		template <typename T>
+		struct TypeFormatter<T *, std::enable_if_t<!std::is_same_v<std::remove_cv_t<T>, char>>>
+		{
+			static void Format(std::string &out, const T *value, const FormatSpec &spec)
+			{
+				detail::FormatPointer(out, static_cast<const void *>(value), spec);
+			}
+		};
+
+		/// @brief 空指针常量
+		template <>
+		struct TypeFormatter<std::nullptr_t>
+		{
+			static void Format(std::string &out, std::nullptr_t, const FormatSpec &spec)
+			{
+				detail::FormatPointer(out, nullptr, spec);
+			}
+		};
+
+		namespace detail
+		{
+			/// @brief 把擦除类型的参数还原并交给对应的 TypeFormatter
+			template <typename T>
+			void FormatErased(std::string &out, const void *value, const FormatSpec &spec)
+			{
+				TypeFormatter<T>::Format(out, *static_cast<const T *>(value), spec);
+			}
+		} // namespace detail
+
+		/// @brief 按格式字符串格式化参数，直接追加到输出缓冲区末尾
+		/// @details 参数按引用传递，不产生临时字符串；运行时遇到无效的占位符或缺少的参数时原样输出该占位符，
+		///			 多余的参数被忽略。使用 IDLOG_*_FMT 宏时这些错误在编译期就会报出。
+		/// @tparam Args 参数类型
+		/// @param out [IN/OUT] 输出缓冲区
+		/// @param format [IN] 格式字符串
+		/// @param args [IN] 参数
+		template <typename... Args>
+		void FormatTo(std::string &out, std::string_view format, const Args &...args)
+		{
+			if constexpr (sizeof...(Args) == 0)
+			{
+				detail::VFormatTo(out, format, nullptr, 0);
+			}
+			else
+			{
+				const detail::FormatArg argArray[] = {
+					{static_cast<const void *>(std::addressof(args)), &detail::FormatErased<std::remove_cv_t<Args>>}...};
+				detail::VFormatTo(out, format, argArray, sizeof...(Args));
+			}
+		}
+
+		/// @brief 按格式字符串格式化参数
+		/// @tparam Args 参数类型
+		/// @param format [IN] 格式字符串
+		/// @param args [IN] 参数
+		/// @return 格式化后的字符串
+		template <typename... Args>
+		std::string Format(std::string_view format, const Args &...args)
+		{
+			std::string out;
+			out.reserve(format.size() + sizeof...(Args) * 8);
+			FormatTo(out, format, args...);
+			return out;
+		}
+	} // namespace Utils
+} // namespace IDLog
+
+/// @brief 计算宏参数个数（参数不会被求值），可以为空
+#define IDLOG_FORMAT_ARG_COUNT(...) decltype(IDLog::Utils::detail::CountArgs(__VA_ARGS__))::value
+
+/// @brief 编译期检查格式字符串（必须是字符串字面量）与参数个数是否一致
+#define IDLOG_CHECK_FORMAT(format, argCount)                      \
+	static_assert(IDLog::Utils::CheckFormat(format, argCount), \
+				  "IDLog: 格式字符串语法错误，或占位符个数与参数个数不一致")
+
+#endif // !IDLOG_UTILS_FORMAT_H
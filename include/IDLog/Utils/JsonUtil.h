@@ -0,0 +1,77 @@
+/**
+ * @Description: JSON 工具头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 11:02:15
+ * @LastEditTime: 2026-10-18 11:02:15
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_UTILS_JSONUTIL_H
+#define IDLOG_UTILS_JSONUTIL_H
+
+#include "IDLog/Core/Macro.h"
+
+#include <cstddef>
+#include <string>
+
+namespace IDLog
+{
+	namespace Utils
+	{
+
+		/// @brief JSON 工具类
+		/// @details 提供向量化的 JSON 字符串转义与 UTF-8 校验
+		///			 运行时根据 CPU 能力选择 AVX2 / SSE2 / 标量实现：
+		///			 每次扫描 16~32 字节查找 '"'、'\\' 与控制字符，无需转义的连续片段整段拷贝
+		class IDLOG_API JsonUtil
+		{
+		public:
+			/// @brief 指令集级别枚举
+			enum class SimdLevel
+			{
+				SCALAR, ///< 标量实现
+				SSE2,	///< SSE2 实现（16 字节）
+				AVX2	///< AVX2 实现（32 字节）
+			};
+
+		public:
+			/// @brief 将转义后的 JSON 字符串内容追加到输出缓冲区（不含两侧引号）
+			/// @param out [OUT] 输出缓冲区
+			/// @param data [IN] 待转义数据
+			/// @param size [IN] 数据长度
+			/// @param validateUtf8 [IN] 是否校验 UTF-8，非法字节替换为 �
+			static void AppendEscaped(std::string &out, const char *data, size_t size, bool validateUtf8 = false);
+
+			/// @brief 将转义后的 JSON 字符串内容追加到输出缓冲区（不含两侧引号）
+			/// @param out [OUT] 输出缓冲区
+			/// @param str [IN] 待转义字符串
+			/// @param validateUtf8 [IN] 是否校验 UTF-8，非法字节替换为 �
+			static void AppendEscaped(std::string &out, const std::string &str, bool validateUtf8 = false)
+			{
+				AppendEscaped(out, str.data(), str.size(), validateUtf8);
+			}
+
+			/// @brief 转义 JSON 字符串内容
+			/// @param str [IN] 待转义字符串
+			/// @param validateUtf8 [IN] 是否校验 UTF-8，非法字节替换为 �
+			/// @return 转义后的字符串
+			static std::string Escape(const std::string &str, bool validateUtf8 = false);
+
+			/// @brief 校验数据是否为合法的 UTF-8 编码
+			/// @param data [IN] 待校验数据
+			/// @param size [IN] 数据长度
+			/// @return 是否为合法 UTF-8
+			static bool IsValidUtf8(const char *data, size_t size);
+
+			/// @brief 获取当前使用的指令集级别
+			/// @return 指令集级别
+			static SimdLevel GetSimdLevel();
+
+			/// @brief 强制指定指令集级别（用于测试与基准对比）
+			/// @param level [IN] 指令集级别，超出 CPU 能力时自动降级
+			static void SetSimdLevel(SimdLevel level);
+		};
+
+	} // namespace Utils
+} // namespace IDLog
+
+#endif // !IDLOG_UTILS_JSONUTIL_H
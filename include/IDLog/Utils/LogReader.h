@@ -0,0 +1,133 @@
+/**
+ * @Description: 日志文件读取器头文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 15:10:08
+ * @LastEditTime: 2026-10-19 12:42:20
+ * @LastEditors: InverseDark
+ */
+#ifndef IDLOG_UTILS_LOGREADER_H
+#define IDLOG_UTILS_LOGREADER_H
+
+#include "IDLog/Formatter/BinaryFormatter.h"
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace IDLog
+{
+	namespace Utils
+	{
+
+		/// @brief 日志文件读取器
+		/// @details 借助 FileAppender 维护的 <文件名>.idx 稀疏时间索引，按时间范围只读取日志文件的相关部分。
+		///			 索引文件格式：8 字节文件头 "IDLX" + 版本 u8 + 3 字节保留，
+		///			 之后为定长 16 字节的索引项（时间戳纳秒 int64 + 文件偏移 uint64，均为小端）。
+		///			 索引粒度为一个索引间隔，返回的范围可能包含区间两端少量范围外的记录；
+		///			 二进制日志可通过 ReadEvents 精确过滤。没有索引时退化为读取整个文件。
+		class IDLOG_API LogReader
+		{
+		public:
+			/// @brief 时间点类型
+			using TimePoint = std::chrono::system_clock::time_point;
+
+			/// @brief 索引项
+			struct IndexEntry
+			{
+				int64_t timeNs;	 ///< 该位置第一条记录的时间戳（自 Unix 纪元起的纳秒数）
+				uint64_t offset; ///< 记录在日志文件中的起始偏移
+			};
+
+			/// @brief 索引文件版本号
+			static constexpr unsigned char kIndexVersion = 1;
+
+		public:
+			/// @brief 构造函数，加载日志文件对应的索引
+			/// @param filename [IN] 日志文件名
+			explicit LogReader(const std::string &filename);
+
+			/// @brief 析构函数
+			~LogReader();
+
+			/// @brief 拷贝构造函数(禁用)
+			LogReader(const LogReader &) = delete;
+
+			/// @brief 拷贝赋值运算符(禁用)
+			LogReader &operator=(const LogReader &) = delete;
+
+			/// @brief 日志文件是否存在
+			/// @return 是否存在
+			bool IsOpen() const;
+
+			/// @brief 是否加载到了索引
+			/// @return 是否有索引
+			bool HasIndex() const;
+
+			/// @brief 日志文件是否为 BinaryFormatter 输出的二进制格式
+			/// @return 是否为二进制格式
+			bool IsBinary() const;
+
+			/// @brief 获取日志文件大小
+			/// @return 文件大小（字节）
+			uint64_t GetFileSize() const;
+
+			/// @brief 获取索引项列表（时间戳已按偏移顺序单调化处理）
+			/// @return 索引项列表
+			const std::vector<IndexEntry> &GetIndex() const;
+
+			/// @brief 二分查找时间范围对应的文件字节范围
+			/// @param from [IN] 起始时间（含）
+			/// @param to [IN] 结束时间（含）
+			/// @return 字节范围 [first, second)
+			std::pair<uint64_t, uint64_t> FindRange(TimePoint from, TimePoint to) const;
+
+			/// @brief 将时间范围对应的原始字节写入输出流
+			/// @param from [IN] 起始时间（含）
+			/// @param to [IN] 结束时间（含）
+			/// @param out [OUT] 输出流
+			/// @return 写出的字节数
+			uint64_t ReadRange(TimePoint from, TimePoint to, std::ostream &out) const;
+
+			/// @brief 解码二进制日志中时间范围内的事件（按事件时间精确过滤）
+			/// @details 按块读取范围内的字节，每读到一个完整的段就解码并释放，内存占用约为一个段
+			/// @param from [IN] 起始时间（含）
+			/// @param to [IN] 结束时间（含）
+			/// @param callback [IN] 每个范围内的事件调用一次
+			/// @return 回调的事件数，文本日志返回0
+			size_t ReadEvents(TimePoint from, TimePoint to, const BinaryLogDecoder::EventCallback &callback) const;
+
+			/// @brief 获取日志文件对应的索引文件名
+			/// @param filename [IN] 日志文件名
+			/// @return 索引文件名
+			static std::string GetIndexFilename(const std::string &filename);
+
+			/// @brief 写入索引文件头
+			/// @param out [OUT] 索引文件流
+			static void WriteIndexHeader(std::ostream &out);
+
+			/// @brief 写入一个索引项
+			/// @param out [OUT] 索引文件流
+			/// @param entry [IN] 索引项
+			static void WriteIndexEntry(std::ostream &out, const IndexEntry &entry);
+
+			/// @brief 加载索引文件（末尾不完整的索引项被忽略）
+			/// @param indexFilename [IN] 索引文件名
+			/// @param entries [OUT] 索引项列表
+			/// @return 索引文件存在且文件头正确时返回true
+			static bool LoadIndex(const std::string &indexFilename, std::vector<IndexEntry> &entries);
+
+		private:
+			/// @brief 日志文件读取器实现结构体前向声明
+			struct Impl;
+
+		private:
+			Impl *m_pImpl; ///< 日志文件读取器实现指针
+		};
+
+	} // namespace Utils
+} // namespace IDLog
+
+#endif // !IDLOG_UTILS_LOGREADER_H
@@ -2,7 +2,7 @@
  * @Description: 字符串工具头文件
  * @Author: InverseDark
  * @Date: 2025-12-18 21:51:54
- * @LastEditTime: 2025-12-18 21:51:57
+ * @LastEditTime: 2026-10-18 22:31:05
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_UTILS_STRINGUTIL_H
@@ -121,6 +121,17 @@ namespace IDLog
 			/// @param times [IN] 重复次数
 			/// @return 重复后的字符串
 			static std::string Repeat(const std::string &str, int times);
+
+			/// @brief 通配符匹配
+			/// @param str [IN] 待匹配字符串
+			/// @param pattern [IN] 模式，'*' 匹配任意长度（含空）的字符序列，'?' 匹配单个字符
+			/// @return 整个字符串与模式匹配返回true，否则返回false
+			static bool WildcardMatch(const std::string &str, const std::string &pattern);
+
+			/// @brief 检查字符串是否包含通配符
+			/// @param str [IN] 待检查字符串
+			/// @return 包含 '*' 或 '?' 返回true，否则返回false
+			static bool HasWildcard(const std::string &str);
 		};
 
 	} // namespace Utils
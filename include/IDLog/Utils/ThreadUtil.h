@@ -2,7 +2,7 @@
  * @Description: 线程工具头文件
  * @Author: InverseDark
  * @Date: 2025-12-18 19:01:25
- * @LastEditTime: 2025-12-18 19:02:18
+ * @LastEditTime: 2026-10-18 21:03:55
  * @LastEditors: InverseDark
  */
 #ifndef IDLOG_UTILS_THREADUTIL_H
@@ -39,6 +39,10 @@ namespace IDLog
 			/// @param name [IN] 线程名称
 			static void SetThreadName(const std::string &name);
 
+			/// @brief 降低当前线程的调度优先级
+			/// @details 用于统计报告等后台线程，避免与业务线程争抢CPU；失败时忽略
+			static void SetThreadLowPriority();
+
 			/// @brief 休眠当前线程
 			/// @param milliseconds [IN] 休眠毫秒数
 			static void Sleep(uint64_t milliseconds);
@@ -2,21 +2,44 @@
  * @Description: 异步输出器源文件
  * @Author: InverseDark
  * @Date: 2025-12-24 11:05:12
- * @LastEditTime: 2025-12-24 11:51:13
+ * @LastEditTime: 2026-10-18 23:48:52
  * @LastEditors: InverseDark
  */
 #include "IDLog/Appender/AsyncAppender.h"
 #include "IDLog/Utils/AsyncQueue.h"
 #include "IDLog/Core/Statistics.h"
+#include "IDLog/Core/CallSite.h"
+
+#include <thread>
 
 namespace IDLog
 {
+	namespace
+	{
+		/// @brief 队列元素：日志事件及其入队时间
+		struct QueuedEvent
+		{
+			LogEvent::Pointer event; ///< 日志事件
+			uint64_t enqueueNs; ///< 入队时的单调时钟（纳秒），未启用统计时为0
+		};
+
+		/// @brief 将被丢弃的事件计入其调用点
+		/// @param event [IN] 被丢弃的日志事件
+		void RecordCallSiteDropped(const LogEvent::Pointer &event)
+		{
+			CallSite *callSite = event ? event->GetSourceLocation().callSite : nullptr;
+			if (callSite && CallSiteProfiler::GetInstance().IsEnabled())
+			{
+				callSite->RecordDropped(event->GetLogMessageView().size());
+			}
+		}
+	} // namespace
 
 	/// @brief 异步输出器实现结构体
 	struct AsyncAppender::Impl
 	{
 		Pointer backendAppender;					   ///< 后端日志输出器
-		Utils::AsyncQueue<LogEventPtr>::Pointer queue; ///< 日志事件异步队列
+		Utils::AsyncQueue<QueuedEvent>::Pointer queue; ///< 日志事件异步队列
 		std::vector<std::thread> threads;			   ///< 异步处理线程数组
 		std::atomic<bool> running;					   ///< 异步处理线程运行标志
 		std::atomic<bool> stopped;					   ///< 异步处理线程停止标志
@@ -26,6 +49,18 @@ namespace IDLog
 		std::atomic<uint64_t> droppedCount;			   ///< 丢弃的日志数量
 		mutable std::mutex backendMutex;			   ///< 后端输出器互斥锁
 
+		/// @brief 刷新后端输出器并记录耗时（调用方需持有 backendMutex）
+		/// @param metrics [IN/OUT] 异步输出器指标
+		void FlushBackendNoLock(AppenderMetrics &metrics)
+		{
+			if (backendAppender)
+			{
+				uint64_t startNs = StatisticsManager::GetMonotonicNs();
+				backendAppender->Flush();
+				metrics.RecordFlush(StatisticsManager::GetMonotonicNs() - startNs);
+			}
+		}
+
 		/// @brief 构造函数
 		/// @param backendAppender [IN] 后端日志输出器智能指针
 		/// @param queueCapacity [IN] 队列容量
@@ -38,7 +73,7 @@ namespace IDLog
 			 uint64_t flushIntervalMs,
 			 OverflowPolicy policy)
 			: backendAppender(backendAppender),
-			  queue(std::make_shared<Utils::AsyncQueue<LogEventPtr>>(queueCapacity)),
+			  queue(std::make_shared<Utils::AsyncQueue<QueuedEvent>>(queueCapacity)),
 			  running(false),
 			  stopped(false),
 			  batchSize(batchSize),
@@ -56,6 +91,8 @@ namespace IDLog
 								 OverflowPolicy policy)
 		: m_pImpl(new Impl(backendAppender, queueCapacity, batchSize, flushIntervalMs, policy))
 	{
+		// 后端输出器不直接挂在日志器上，在此注册以便查询其指标
+		StatisticsManager::GetInstance().RegisterAppender(backendAppender);
 	}
 
 	AsyncAppender::~AsyncAppender()
@@ -80,6 +117,13 @@ namespace IDLog
 			}
 		}
 
+		// 仅在启用统计时记录入队时间，用于计算排队延迟
+		QueuedEvent item{event, 0};
+		if (StatisticsManager::GetInstance().IsStatisticsEnabled())
+		{
+			item.enqueueNs = StatisticsManager::GetMonotonicNs();
+		}
+
 		// 尝试将事件放入队列
 		bool success = false;
 		switch (m_pImpl->overflowPolicy)
@@ -87,17 +131,21 @@ namespace IDLog
 		case OverflowPolicy::BLOCK:
 		{
 			// 阻塞直到成功
-			success = m_pImpl->queue->Push(event);
+			success = m_pImpl->queue->Push(std::move(item));
 			break;
 		}
 		case OverflowPolicy::DROP_OLDEST:
 		{
 			// 尝试放入队列，失败则丢弃最旧的日志再尝试一次
-			if (!m_pImpl->queue->TryPush(event))
+			if (!m_pImpl->queue->TryPush(item))
 			{
-				LogEventPtr discardedEvent;
-				m_pImpl->queue->TryPop(discardedEvent);
-				success = m_pImpl->queue->TryPush(event);
+				QueuedEvent discardedEvent;
+				if (m_pImpl->queue->TryPop(discardedEvent))
+				{
+					GetMetrics().AddDropped(static_cast<size_t>(OverflowPolicy::DROP_OLDEST));
+					RecordCallSiteDropped(discardedEvent.event);
+				}
+				success = m_pImpl->queue->TryPush(item);
 			}
 			else
 			{
@@ -108,18 +156,24 @@ namespace IDLog
 		case OverflowPolicy::DROP_NEWEST:
 		{
 			// 尝试放入队列，失败则丢弃最新的日志
-			success = m_pImpl->queue->TryPush(event);
+			success = m_pImpl->queue->TryPush(item);
 			break;
 		}
 		};
 
 		// 记录丢弃的日志
-		if (!success)
+		if (success)
 		{
+			GetMetrics().AddRecords(1, event->GetLogMessageView().size());
+		}
+		else
+		{
+			GetMetrics().AddDropped(static_cast<size_t>(m_pImpl->overflowPolicy));
+			RecordCallSiteDropped(event);
 			m_pImpl->droppedCount.fetch_add(1);
 			if (StatisticsManager::GetInstance().IsStatisticsEnabled())
 			{
-				StatisticsManager::GetInstance().RecordDroppedLog(event->GetLoggerName(), event->GetLogMessage().size());
+				StatisticsManager::GetInstance().RecordDroppedLog(event->GetLoggerName(), event->GetLogMessageView().size());
 			}
 		}
 	}
@@ -153,10 +207,7 @@ namespace IDLog
 
 		// 刷新后端输出器
 		std::lock_guard<std::mutex> lock(m_pImpl->backendMutex);
-		if (m_pImpl->backendAppender)
-		{
-			m_pImpl->backendAppender->Flush();
-		}
+		m_pImpl->FlushBackendNoLock(GetMetrics());
 	}
 
 	bool AsyncAppender::SetBackendAppender(const Pointer &appender)
@@ -166,6 +217,7 @@ namespace IDLog
 			return false;
 		}
 
+		StatisticsManager::GetInstance().RegisterAppender(appender);
 		std::lock_guard<std::mutex> lock(m_pImpl->backendMutex);
 		m_pImpl->backendAppender = appender;
 		return true;
@@ -320,11 +372,21 @@ namespace IDLog
 			}
 
 
-			LogEventPtr event;
+			QueuedEvent item;
 
 			// 从队列中获取事件
-			if (m_pImpl->queue->Pop(event, 100)) // 100ms超时
+			if (m_pImpl->queue->Pop(item, 100)) // 100ms超时
 			{
+				// 记录排队延迟
+				if (item.enqueueNs != 0)
+				{
+					uint64_t nowNs = StatisticsManager::GetMonotonicNs();
+					StatisticsManager::GetInstance().RecordLatency(LatencyType::QUEUE_WAIT,
+						nowNs > item.enqueueNs ? nowNs - item.enqueueNs : 0);
+				}
+
+				GetMetrics().UpdateQueueHighWaterMark(m_pImpl->queue->GetHighWaterMark());
+				LogEventPtr event = std::move(item.event);
 				if (m_pImpl->batchSize > 0)
 				{
 					// 批处理模式
@@ -364,10 +426,7 @@ namespace IDLog
 
 				// 刷新后端输出器
 				std::lock_guard<std::mutex> lock(m_pImpl->backendMutex);
-				if (m_pImpl->backendAppender)
-				{
-					m_pImpl->backendAppender->Flush();
-				}
+				m_pImpl->FlushBackendNoLock(GetMetrics());
 
 				lastFlushTime = now;
 			}
@@ -382,10 +441,7 @@ namespace IDLog
 
 		// 最后刷新一次
 		std::lock_guard<std::mutex> lock(m_pImpl->backendMutex);
-		if (m_pImpl->backendAppender)
-		{
-			m_pImpl->backendAppender->Flush();
-		}
+		m_pImpl->FlushBackendNoLock(GetMetrics());
 	}
 
 	void AsyncAppender::ProcessEvent(const LogEventPtr &event)
@@ -0,0 +1,70 @@
+/**
+ * @Description: 二进制文件输出器源文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 14:27:15
+ * @LastEditTime: 2026-10-18 15:24:37
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/Appender/BinaryFileAppender.h"
+
+namespace IDLog
+{
+	BinaryFileAppender::BinaryFileAppender(const std::string &filename,
+										   size_t segmentRecords,
+										   RollPolicy rollPolicy,
+										   size_t maxSize)
+		: FileAppender(filename, std::make_shared<BinaryFormatter>(segmentRecords), rollPolicy, maxSize)
+	{
+		// 基类构造时以文本模式打开，这里切换为二进制模式并重新打开（此时虚函数 OnFileOpened 已指向本类）
+		SetBinaryMode(true);
+	}
+
+	BinaryFileAppender::~BinaryFileAppender() = default;
+
+	void BinaryFileAppender::Append(const LogEventPtr &event)
+	{
+		if (!event)
+		{
+			return;
+		}
+
+		// 复用线程局部缓冲区，避免每条日志分配临时字符串
+		static thread_local std::string t_encodeBuffer;
+		std::string &encoded = t_encodeBuffer;
+		encoded.clear();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		// 滚动会重置编码状态，必须在编码之前进行
+		if (ShouldRoll(event))
+		{
+			RollFile(event);
+		}
+
+		if (auto formatter = GetFormatterNoLock())
+		{
+			formatter->FormatTo(event, encoded);
+		}
+
+		// 只有段头处可以独立解码，时间索引项只写在新段开始的位置
+		if (!encoded.empty() && encoded[0] == static_cast<char>(BinaryFormatter::FrameType::SEGMENT))
+		{
+			WriteIndexEntryNoLock(event);
+		}
+		WriteNoLock(encoded.data(), encoded.size());
+	}
+
+	std::string BinaryFileAppender::GetName() const
+	{
+		return "Binary" + FileAppender::GetName();
+	}
+
+	void BinaryFileAppender::OnFileOpened()
+	{
+		if (auto formatter = std::dynamic_pointer_cast<BinaryFormatter>(GetFormatterNoLock()))
+		{
+			formatter->Reset();
+		}
+	}
+
+} // namespace IDLog
@@ -2,30 +2,295 @@
  * @Description: 控制台输出器源文件
  * @Author: InverseDark
  * @Date: 2025-12-18 21:21:37
- * @LastEditTime: 2025-12-18 21:34:57
+ * @LastEditTime: 2026-10-19 09:12:40
  * @LastEditors: InverseDark
  */
 #include "IDLog/Appender/ConsoleAppender.h"
 #include "IDLog/Formatter/PatternFormatter.h"
+#include "IDLog/Core/Statistics.h"
 
-#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifdef IDLOG_PLATFORM_WINDOWS
+#include <io.h>
+#else
+#include <cerrno>
+#include <climits>
+#include <poll.h>
+#include <unistd.h>
+#endif
 
 namespace IDLog
 {
+	namespace
+	{
+		/// @brief 预计算的颜色转义序列
+		struct ColorCode
+		{
+			const char *data; ///< 转义序列
+			size_t size;	  ///< 转义序列长度
+		};
+
+		/// @brief 各日志级别对应的 ANSI 颜色前缀，按 LogLevel 数值索引
+		const ColorCode kLevelColors[] = {
+			{"\033[37m", 5}, // TRACE 白色
+			{"\033[36m", 5}, // DEBUG 青色
+			{"\033[32m", 5}, // INFO 绿色
+			{"\033[33m", 5}, // WARN 黄色
+			{"\033[31m", 5}, // ERROR 红色
+			{"\033[35m", 5}, // FATAL 洋红色
+		};
+
+		/// @brief 颜色重置序列
+		const ColorCode kResetColor = {"\033[0m", 4};
+
+		/// @brief 默认写缓冲区大小
+		constexpr size_t kDefaultBufferSize = 16 * 1024;
+
+		/// @brief 默认定时刷新间隔（毫秒）
+		constexpr uint64_t kDefaultFlushIntervalMs = 200;
+
+		/// @brief 获取输出目标对应的文件描述符
+		/// @param target [IN] 输出目标
+		/// @return 文件描述符
+		int TargetToFd(ConsoleAppender::Target target)
+		{
+#ifdef IDLOG_PLATFORM_WINDOWS
+			return (target == ConsoleAppender::Target::STDOUT) ? _fileno(stdout) : _fileno(stderr);
+#else
+			return (target == ConsoleAppender::Target::STDOUT) ? STDOUT_FILENO : STDERR_FILENO;
+#endif
+		}
+
+		/// @brief 判断文件描述符是否为终端
+		/// @param fd [IN] 文件描述符
+		/// @return 是否为终端
+		bool IsTerminalFd(int fd)
+		{
+#ifdef IDLOG_PLATFORM_WINDOWS
+			return _isatty(fd) != 0;
+#else
+			return ::isatty(fd) != 0;
+#endif
+		}
+	} // namespace
+
+	/// @brief 控制台输出器实现结构体
+	struct ConsoleAppender::Impl
+	{
+		Target target;					   ///< 输出目标
+		int fd;							   ///< 输出文件描述符
+		bool isTerminal;				   ///< 输出目标是否为终端
+		ColorMode colorMode;			   ///< 颜色模式
+		bool useColor;					   ///< 实际是否着色（由颜色模式与终端检测决定）
+		bool nonBlocking;				   ///< 是否为非阻塞模式
+		std::string buffer;				   ///< 写缓冲区
+		size_t bufferSize;				   ///< 写缓冲区容量
+		std::vector<size_t> recordEnds;	   ///< 缓冲区中尚未写出的每条日志的结束位置
+		uint64_t flushIntervalMs;		   ///< 定时刷新间隔（毫秒）
+		std::chrono::steady_clock::time_point lastFlushTime; ///< 上次刷新时间
+		std::atomic<uint64_t> droppedCount; ///< 丢弃的日志数量
+
+		std::thread flushThread;		   ///< 定时刷新线程
+		std::mutex flushThreadMutex;	   ///< 定时刷新线程的等待锁
+		std::condition_variable flushCond; ///< 定时刷新线程的条件变量
+		bool flushThreadStop;			   ///< 定时刷新线程停止标志
+
+		/// @brief 构造函数
+		/// @param t [IN] 输出目标
+		explicit Impl(Target t)
+			: target(t), fd(-1), isTerminal(false), colorMode(ColorMode::AUTO), useColor(false),
+			  nonBlocking(false), bufferSize(kDefaultBufferSize),
+			  flushIntervalMs(kDefaultFlushIntervalMs), lastFlushTime(std::chrono::steady_clock::now()),
+			  droppedCount(0), flushThreadStop(false)
+		{
+			ResolveTarget();
+		}
+
+		/// @brief 根据输出目标更新文件描述符与终端检测结果
+		void ResolveTarget()
+		{
+			fd = TargetToFd(target);
+			isTerminal = IsTerminalFd(fd);
+			ResolveColor();
+		}
+
+		/// @brief 根据颜色模式计算实际是否着色
+		void ResolveColor()
+		{
+			useColor = (colorMode == ColorMode::ALWAYS) ||
+					   (colorMode == ColorMode::AUTO && isTerminal);
+		}
+
+		/// @brief 将数据完整写入文件描述符，输出端暂时不可写时等待
+		/// @param data [IN] 数据指针
+		/// @param size [IN] 数据长度
+		/// @param metrics [IN/OUT] 输出器指标，记录写调用与写入错误
+		/// @return 实际写出的字节数，写入出错时小于 size
+		size_t WriteFd(const char *data, size_t size, AppenderMetrics &metrics)
+		{
+			size_t written = 0;
+#ifdef IDLOG_PLATFORM_WINDOWS
+			while (written < size)
+			{
+				int ret = _write(fd, data + written, static_cast<unsigned int>(size - written));
+				metrics.AddWriteCalls(1);
+				if (ret <= 0)
+				{
+					metrics.AddWriteErrors(1);
+					break;
+				}
+				written += static_cast<size_t>(ret);
+			}
+#else
+			while (written < size)
+			{
+				ssize_t ret = ::write(fd, data + written, size - written);
+				metrics.AddWriteCalls(1);
+				if (ret < 0)
+				{
+					if (errno == EINTR)
+					{
+						continue;
+					}
+					if (errno == EAGAIN || errno == EWOULDBLOCK)
+					{
+						// 文件描述符本身是非阻塞的：等到可写再继续，不留下半条日志
+						struct pollfd pfd;
+						pfd.fd = fd;
+						pfd.events = POLLOUT;
+						pfd.revents = 0;
+						if (::poll(&pfd, 1, -1) > 0)
+						{
+							continue;
+						}
+					}
+					metrics.AddWriteErrors(1);
+					break;
+				}
+				written += static_cast<size_t>(ret);
+			}
+#endif
+			return written;
+		}
+
+#ifndef IDLOG_PLATFORM_WINDOWS
+		/// @brief 非阻塞模式下按日志边界写出缓冲区
+		/// @details 每次探测输出端是否可写，可写时写出一组总长不超过 PIPE_BUF 的完整日志
+		///			 （对管道是原子写，要么全部写入要么一个字节都不写）；
+		///			 输出端不可写时停在日志边界，剩余日志整体丢弃。
+		///			 超过 PIPE_BUF 的单条日志一旦开始写，会等待写完，保证不输出半条日志
+		/// @param metrics [IN/OUT] 输出器指标
+		/// @return 实际写出的字节数，总是某条日志的结束位置
+		size_t WriteRecordsNonBlocking(AppenderMetrics &metrics)
+		{
+			size_t offset = 0;
+			size_t next = 0;
+			while (next < recordEnds.size())
+			{
+				struct pollfd pfd;
+				pfd.fd = fd;
+				pfd.events = POLLOUT;
+				pfd.revents = 0;
+				if (::poll(&pfd, 1, 0) <= 0 || !(pfd.revents & POLLOUT))
+				{
+					break;
+				}
+
+				// 尽量多的完整日志组成一次写调用，至少包含一条
+				size_t end = recordEnds[next++];
+				while (next < recordEnds.size() && recordEnds[next] - offset <= PIPE_BUF)
+				{
+					end = recordEnds[next++];
+				}
+
+				ssize_t ret = ::write(fd, buffer.data() + offset, std::min<size_t>(end - offset, PIPE_BUF));
+				metrics.AddWriteCalls(1);
+				if (ret < 0)
+				{
+					if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+					{
+						metrics.AddWriteErrors(1);
+					}
+					break;
+				}
+
+				// 已写出部分内容：写完这一组，失败时以实际写出的位置为准
+				size_t written = static_cast<size_t>(ret);
+				if (written < end - offset)
+				{
+					written += WriteFd(buffer.data() + offset + written, end - offset - written, metrics);
+				}
+				offset += written;
+				if (offset < end)
+				{
+					break;
+				}
+			}
+			return offset;
+		}
+#endif
+
+		/// @brief 写出缓冲区中的日志
+		/// @param metrics [IN/OUT] 输出器指标
+		/// @return 完整写出的日志条数
+		size_t WriteRecords(AppenderMetrics &metrics)
+		{
+			size_t written = 0;
+#ifndef IDLOG_PLATFORM_WINDOWS
+			if (nonBlocking)
+			{
+				written = WriteRecordsNonBlocking(metrics);
+			}
+			else
+#endif
+			{
+				written = WriteFd(buffer.data(), buffer.size(), metrics);
+			}
+			return static_cast<size_t>(std::upper_bound(recordEnds.begin(), recordEnds.end(), written) - recordEnds.begin());
+		}
+	};
+
 	ConsoleAppender::ConsoleAppender(Target target, FormatterPtr formatter)
-		: m_target(target), m_useColor(true)
+		: m_pImpl(new Impl(target))
 	{
+		m_pImpl->buffer.reserve(m_pImpl->bufferSize);
+
 		if (formatter)
 		{
 			SetFormatter(formatter);
 		}
 		else
 		{
-			// 如果没有提供格式化器，使用默认的模式格式化器
-			FormatterPtr defaultFormatter = std::make_shared<PatternFormatter>(
-				PatternFormatter::defaultPattern());
-			SetFormatter(defaultFormatter);
+			// 如果没有提供格式化器，使用共享的默认模式格式化器（避免每个输出器重复解析模式）
+			SetFormatter(PatternFormatter::GetDefault());
+		}
+	}
+
+	ConsoleAppender::~ConsoleAppender()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->flushThreadMutex);
+			m_pImpl->flushThreadStop = true;
+		}
+		m_pImpl->flushCond.notify_all();
+		if (m_pImpl->flushThread.joinable())
+		{
+			m_pImpl->flushThread.join();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			FlushNoLock();
 		}
+		delete m_pImpl;
 	}
 
 	void ConsoleAppender::Append(const LogEventPtr &event)
@@ -35,108 +300,240 @@ namespace IDLog
 			return;
 		}
 
-		// 线程安全输出
-		std::lock_guard<std::mutex> lock(m_mutex);
-
-		// 格式化日志消息
-		std::string formattedMessage;
-		if (auto formatter = GetFormatterNoLock())
+		// 在锁外格式化到线程局部缓冲区，缩短临界区且避免每条日志分配临时字符串
+		static thread_local std::string t_formatBuffer;
+		std::string &formattedMessage = t_formatBuffer;
+		formattedMessage.clear();
+		if (auto formatter = GetFormatter())
 		{
-			formattedMessage = formatter->Format(event);
+			formatter->FormatTo(event, formattedMessage);
 		}
 		else
 		{
-			formattedMessage = event->GetLogMessage();
+			formattedMessage.assign(event->GetLogMessageView());
 		}
 
-		// 添加颜色
-		if (m_useColor)
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		// 拼接到写缓冲区（颜色前缀已预先计算好）
+		size_t levelIndex = static_cast<size_t>(event->GetLevel());
+		bool colored = m_pImpl->useColor && levelIndex < sizeof(kLevelColors) / sizeof(kLevelColors[0]);
+		if (colored)
+		{
+			m_pImpl->buffer.append(kLevelColors[levelIndex].data, kLevelColors[levelIndex].size);
+		}
+		m_pImpl->buffer.append(formattedMessage);
+		if (colored)
 		{
-			formattedMessage = GetLevelColor(event->GetLevel()) +
-							   formattedMessage +
-							   GetResetColor();
+			m_pImpl->buffer.append(kResetColor.data, kResetColor.size);
 		}
+		m_pImpl->recordEnds.push_back(m_pImpl->buffer.size());
+		GetMetrics().AddRecords(1, formattedMessage.size());
 
-		// 输出到对应的流
-		std::ostream &os = (m_target == Target::STDOUT) ? std::cout : std::cerr;
-		os << formattedMessage;
+		// 终端：遇到换行即刷新；管道/文件：缓冲区满才刷新；两者都有定时刷新兜底
+		bool lineComplete = !formattedMessage.empty() && formattedMessage.back() == '\n';
+		if ((m_pImpl->isTerminal && lineComplete) || m_pImpl->buffer.size() >= m_pImpl->bufferSize)
+		{
+			FlushNoLock();
+			return;
+		}
 
-		// 确保立即输出
-		os.flush();
+		if (m_pImpl->flushIntervalMs > 0)
+		{
+			auto now = std::chrono::steady_clock::now();
+			if (now - m_pImpl->lastFlushTime >= std::chrono::milliseconds(m_pImpl->flushIntervalMs))
+			{
+				FlushNoLock();
+				return;
+			}
+			StartFlushThreadNoLock();
+		}
 	}
 
 	std::string ConsoleAppender::GetName() const
 	{
-		return (m_target == Target::STDOUT) ? "ConsoleAppender(stdout)" : "ConsoleAppender(stderr)";
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return (m_pImpl->target == Target::STDOUT) ? "ConsoleAppender(stdout)" : "ConsoleAppender(stderr)";
 	}
 
 	void ConsoleAppender::Flush()
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
-		if (m_target == Target::STDOUT)
+		FlushNoLock();
+	}
+
+	void ConsoleAppender::SetTarget(Target target)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_pImpl->target == target)
 		{
-			std::cout.flush();
+			return;
 		}
-		else
+		FlushNoLock();
+		m_pImpl->target = target;
+		m_pImpl->ResolveTarget();
+	}
+
+	ConsoleAppender::Target ConsoleAppender::GetTarget() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_pImpl->target;
+	}
+
+	void ConsoleAppender::SetUseColor(bool useColor)
+	{
+		SetColorMode(useColor ? ColorMode::ALWAYS : ColorMode::NEVER);
+	}
+
+	bool ConsoleAppender::GetUseColor() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_pImpl->useColor;
+	}
+
+	void ConsoleAppender::SetColorMode(ColorMode mode)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pImpl->colorMode = mode;
+		m_pImpl->ResolveColor();
+	}
+
+	ConsoleAppender::ColorMode ConsoleAppender::GetColorMode() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_pImpl->colorMode;
+	}
+
+	void ConsoleAppender::SetBufferSize(size_t bufferSize)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pImpl->bufferSize = bufferSize;
+		if (m_pImpl->buffer.size() >= bufferSize)
 		{
-			std::cerr.flush();
+			FlushNoLock();
 		}
+		m_pImpl->buffer.reserve(bufferSize);
 	}
 
-	void ConsoleAppender::SetTarget(Target target)
+	size_t ConsoleAppender::GetBufferSize() const
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
-		m_target = target;
+		return m_pImpl->bufferSize;
 	}
 
-	ConsoleAppender::Target ConsoleAppender::GetTarget() const
+	void ConsoleAppender::SetFlushInterval(uint64_t flushIntervalMs)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_pImpl->flushIntervalMs = flushIntervalMs;
+		}
+		m_pImpl->flushCond.notify_all();
+	}
+
+	uint64_t ConsoleAppender::GetFlushInterval() const
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
-		return m_target;
+		return m_pImpl->flushIntervalMs;
 	}
 
-	void ConsoleAppender::SetUseColor(bool useColor)
+	void ConsoleAppender::SetNonBlocking(bool nonBlocking)
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
-		m_useColor = useColor;
+		m_pImpl->nonBlocking = nonBlocking;
 	}
 
-	bool ConsoleAppender::GetUseColor() const
+	bool ConsoleAppender::IsNonBlocking() const
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
-		return m_useColor;
+		return m_pImpl->nonBlocking;
+	}
+
+	uint64_t ConsoleAppender::GetDroppedCount() const
+	{
+		return m_pImpl->droppedCount.load(std::memory_order_relaxed);
 	}
 
-	std::string ConsoleAppender::GetLevelColor(LogLevel level) const
+	bool ConsoleAppender::IsTerminal() const
 	{
-		if (!m_useColor)
-			return "";
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_pImpl->isTerminal;
+	}
 
-		// ANSI颜色代码
-		switch (level)
+	void ConsoleAppender::FlushNoLock()
+	{
+		m_pImpl->lastFlushTime = std::chrono::steady_clock::now();
+		if (m_pImpl->buffer.empty())
 		{
-		case LogLevel::TRACE:
-			return "\033[37m"; // 白色
-		case LogLevel::DBG:
-			return "\033[36m"; // 青色
-		case LogLevel::INFO:
-			return "\033[32m"; // 绿色
-		case LogLevel::WARN:
-			return "\033[33m"; // 黄色
-		case LogLevel::ERR:
-			return "\033[31m"; // 红色
-		case LogLevel::FATAL:
-			return "\033[35m"; // 洋红色
-		default:
-			return "";
+			return;
 		}
+
+		// 先刷出 stdio 中尚未写出的内容，保证与 printf/std::cout 的输出顺序一致
+		std::fflush(m_pImpl->target == Target::STDOUT ? stdout : stderr);
+
+		AppenderMetrics &metrics = GetMetrics();
+		uint64_t startNs = StatisticsManager::GetMonotonicNs();
+		size_t writtenRecords = m_pImpl->WriteRecords(metrics);
+		uint64_t latencyNs = StatisticsManager::GetMonotonicNs() - startNs;
+		metrics.RecordFlush(latencyNs);
+		StatisticsManager &statsMgr = StatisticsManager::GetInstance();
+		if (statsMgr.IsStatisticsEnabled())
+		{
+			statsMgr.RecordLatency(LatencyType::SINK_WRITE, latencyNs);
+		}
+		if (writtenRecords < m_pImpl->recordEnds.size())
+		{
+			// 未写出的日志整条丢弃
+			m_pImpl->droppedCount.fetch_add(m_pImpl->recordEnds.size() - writtenRecords, std::memory_order_relaxed);
+		}
+
+		m_pImpl->buffer.clear();
+		m_pImpl->recordEnds.clear();
 	}
 
-	std::string ConsoleAppender::GetResetColor() const
+	void ConsoleAppender::StartFlushThreadNoLock()
 	{
-		if (!m_useColor)
-			return "";
-		return "\033[0m";
+		if (m_pImpl->flushThread.joinable())
+		{
+			return;
+		}
+		m_pImpl->flushThread = std::thread(&ConsoleAppender::FlushThreadFunc, this);
+	}
+
+	void ConsoleAppender::FlushThreadFunc()
+	{
+		std::unique_lock<std::mutex> waitLock(m_pImpl->flushThreadMutex);
+		while (!m_pImpl->flushThreadStop)
+		{
+			uint64_t intervalMs = 0;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				intervalMs = m_pImpl->flushIntervalMs;
+			}
+			if (intervalMs == 0)
+			{
+				// 定时刷新被关闭，等待重新设置或停止
+				m_pImpl->flushCond.wait(waitLock);
+				continue;
+			}
+
+			m_pImpl->flushCond.wait_for(waitLock, std::chrono::milliseconds(intervalMs));
+			if (m_pImpl->flushThreadStop)
+			{
+				break;
+			}
+
+			waitLock.unlock();
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				auto now = std::chrono::steady_clock::now();
+				if (!m_pImpl->buffer.empty() &&
+					now - m_pImpl->lastFlushTime >= std::chrono::milliseconds(m_pImpl->flushIntervalMs))
+				{
+					FlushNoLock();
+				}
+			}
+			waitLock.lock();
+		}
 	}
 
-} // namespace IDLog
\ No newline at end of file
+} // namespace IDLog
@@ -2,13 +2,16 @@
  * @Description:
  * @Author: InverseDark
  * @Date: 2025-12-19 12:13:16
- * @LastEditTime: 2025-12-19 12:46:27
+ * @LastEditTime: 2026-10-18 23:48:52
  * @LastEditors: InverseDark
  */
 #include "IDLog/Appender/FileAppender.h"
 #include "IDLog/Formatter/PatternFormatter.h"
+#include "IDLog/Utils/LogReader.h"
+#include "IDLog/Core/Statistics.h"
 
 #include <fstream>
+#include <vector>
 #include <iomanip>
 #include <ctime>
 
@@ -30,14 +33,74 @@ namespace IDLog
 		size_t maxSize;		 ///< 最大文件大小
 		size_t currentFileSize;	 ///< 当前文件大小
 		int lastRollTime;		 ///< 上次滚动的时间
+		bool binaryMode;		 ///< 是否以二进制模式打开文件
+		std::ofstream indexStream; ///< 时间索引文件流
+		size_t indexRecords;	 ///< 每隔多少条记录写一个索引项
+		size_t indexBytes;		 ///< 每隔多少字节写一个索引项
+		size_t recordsSinceIndex; ///< 距上一个索引项的记录数
+		size_t lastIndexOffset;	 ///< 上一个索引项的文件偏移
+		bool hasIndexEntry;		 ///< 当前文件是否已写过索引项
+		size_t bufferedBytes;	 ///< 文件缓冲区中尚未写出的字节数（用于估算写调用次数）
 
 		/// @brief 构造函数
 		Impl()
-			: currentFileSize(0), lastRollTime(0)
+			: currentFileSize(0), lastRollTime(0), binaryMode(false),
+			  indexRecords(0), indexBytes(0), recordsSinceIndex(0), lastIndexOffset(0), hasIndexEntry(false),
+			  bufferedBytes(0)
 		{
 			// 初始化文件缓冲区为64KB
 			fileBuffer.resize(64 * 1024);
 		}
+
+		/// @brief 缓冲区内容被写出（刷新或关闭文件）时计入一次写调用
+		/// @param metrics [IN/OUT] 输出器指标
+		void SettleBuffered(AppenderMetrics& metrics)
+		{
+			if (bufferedBytes > 0)
+			{
+				metrics.AddWriteCalls(1);
+				bufferedBytes = 0;
+			}
+		}
+
+		/// @brief 检查文件流错误，计入写入错误并清除错误状态以便继续写入
+		/// @param metrics [IN/OUT] 输出器指标
+		void CheckStream(AppenderMetrics& metrics)
+		{
+			if (!fstream)
+			{
+				metrics.AddWriteErrors(1);
+				fstream.clear();
+			}
+		}
+
+		/// @brief 是否启用了时间索引
+		/// @return 是否启用
+		bool IndexEnabled() const
+		{
+			return indexRecords > 0 || indexBytes > 0;
+		}
+
+		/// @brief 打开当前日志文件对应的索引文件
+		void OpenIndex()
+		{
+			if (indexStream.is_open())
+			{
+				indexStream.close();
+			}
+			recordsSinceIndex = 0;
+			lastIndexOffset = currentFileSize;
+			hasIndexEntry = false;
+
+			// 日志文件为空时，残留的索引一定已失效，截断重建
+			std::ios::openmode mode = std::ios::out | std::ios::binary;
+			mode |= currentFileSize == 0 ? std::ios::trunc : std::ios::app;
+			indexStream.open(Utils::LogReader::GetIndexFilename(filename), mode);
+			if (indexStream.is_open() && indexStream.tellp() == 0)
+			{
+				Utils::LogReader::WriteIndexHeader(indexStream);
+			}
+		}
 	};
 
 	FileAppender::FileAppender(const std::string& filename,
@@ -56,10 +119,8 @@ namespace IDLog
 		}
 		else
 		{
-			// 如果没有提供格式化器，使用默认的模式格式化器
-			FormatterPtr defaultFormatter = std::make_shared<PatternFormatter>(
-				PatternFormatter::defaultPattern());
-			SetFormatter(defaultFormatter);
+			// 如果没有提供格式化器，使用共享的默认模式格式化器（避免每个输出器重复解析模式）
+			SetFormatter(PatternFormatter::GetDefault());
 		}
 
 		Open();
@@ -79,14 +140,17 @@ namespace IDLog
 		}
 
 		// 格式化日志消息
-		std::string formattedMessage;
+		// 复用线程局部缓冲区，避免每条日志分配临时字符串
+		static thread_local std::string t_formatBuffer;
+		std::string &formattedMessage = t_formatBuffer;
+		formattedMessage.clear();
 		if (auto formatter = GetFormatter())
 		{
-			formattedMessage = formatter->Format(event);
+			formatter->FormatTo(event, formattedMessage);
 		}
 		else
 		{
-			formattedMessage = event->GetLogMessage();
+			formattedMessage.assign(event->GetLogMessageView());
 		}
 
 		std::lock_guard<std::mutex> lock(m_mutex);
@@ -104,8 +168,8 @@ namespace IDLog
 		}
 
 		// 写入文件
-		m_pImpl->fstream << formattedMessage;
-		m_pImpl->currentFileSize += formattedMessage.size();
+		MaybeIndexNoLock(event);
+		WriteNoLock(formattedMessage.data(), formattedMessage.size());
 	}
 
 	std::string FileAppender::GetName() const
@@ -119,7 +183,23 @@ namespace IDLog
 		std::lock_guard<std::mutex> lock(m_mutex);
 		if (m_pImpl->fstream.is_open())
 		{
+			StatisticsManager& statsMgr = StatisticsManager::GetInstance();
+			uint64_t startNs = StatisticsManager::GetMonotonicNs();
 			m_pImpl->fstream.flush();
+			uint64_t latencyNs = StatisticsManager::GetMonotonicNs() - startNs;
+
+			AppenderMetrics& metrics = GetMetrics();
+			metrics.RecordFlush(latencyNs);
+			m_pImpl->SettleBuffered(metrics);
+			m_pImpl->CheckStream(metrics);
+			if (statsMgr.IsStatisticsEnabled())
+			{
+				statsMgr.RecordLatency(LatencyType::SINK_WRITE, latencyNs);
+			}
+		}
+		if (m_pImpl->indexStream.is_open())
+		{
+			m_pImpl->indexStream.flush();
 		}
 	}
 
@@ -188,7 +268,37 @@ namespace IDLog
 		return m_pImpl->maxSize;
 	}
 
-	bool FileAppender::ShouldRoll(const LogEventPtr& event)
+	void FileAppender::SetIndexInterval(size_t records, size_t bytes)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pImpl->indexRecords = records;
+		m_pImpl->indexBytes = bytes;
+		if (!m_pImpl->IndexEnabled())
+		{
+			if (m_pImpl->indexStream.is_open())
+			{
+				m_pImpl->indexStream.close();
+			}
+		}
+		else if (m_pImpl->fstream.is_open() && !m_pImpl->indexStream.is_open())
+		{
+			m_pImpl->OpenIndex();
+		}
+	}
+
+	size_t FileAppender::GetIndexRecords() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_pImpl->indexRecords;
+	}
+
+	size_t FileAppender::GetIndexBytes() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_pImpl->indexBytes;
+	}
+
+	bool FileAppender::ShouldRoll(const LogEventPtr& /*event*/)
 	{
 		if (m_pImpl->rollPolicy == RollPolicy::NONE)
 		{
@@ -213,10 +323,17 @@ namespace IDLog
 
 	void FileAppender::RollFile(const LogEventPtr& event)
 	{
+		uint64_t startNs = StatisticsManager::GetMonotonicNs();
+
 		// 关闭当前文件
 		if (m_pImpl->fstream.is_open())
 		{
 			m_pImpl->fstream.close();
+			m_pImpl->SettleBuffered(GetMetrics());
+		}
+		if (m_pImpl->indexStream.is_open())
+		{
+			m_pImpl->indexStream.close();
 		}
 
 		// 生成新的文件名
@@ -230,10 +347,21 @@ namespace IDLog
 			{
 				// TODO: 处理重命名失败的情况
 			}
+			else
+			{
+				// 索引跟随日志文件一起重命名
+				std::string indexFilename = Utils::LogReader::GetIndexFilename(m_pImpl->filename);
+				if (std::filesystem::exists(indexFilename, ec))
+				{
+					std::filesystem::rename(indexFilename, Utils::LogReader::GetIndexFilename(rolledFilename), ec);
+				}
+			}
 		}
 
 		// 打开新文件
 		OpenNoLock();
+
+		GetMetrics().RecordRoll(StatisticsManager::GetMonotonicNs() - startNs);
 	}
 
 	std::string FileAppender::GenerateRolledFilename(const LogEventPtr& event)
@@ -386,7 +514,12 @@ namespace IDLog
 		m_pImpl->fstream.rdbuf()->pubsetbuf(m_pImpl->fileBuffer.data(), m_pImpl->fileBuffer.size());
 
 		// 打开文件
-		m_pImpl->fstream.open(m_pImpl->filename, std::ios::app | std::ios::out);
+		std::ios::openmode mode = std::ios::app | std::ios::out;
+		if (m_pImpl->binaryMode)
+		{
+			mode |= std::ios::binary;
+		}
+		m_pImpl->fstream.open(m_pImpl->filename, mode);
 		if (!m_pImpl->fstream.is_open())
 		{
 			return false;
@@ -398,6 +531,14 @@ namespace IDLog
 
 		// 初始化滚动时间
 		m_pImpl->lastRollTime = GetCurrentTimeMarker();
+
+		// 打开时间索引
+		if (m_pImpl->IndexEnabled())
+		{
+			m_pImpl->OpenIndex();
+		}
+
+		OnFileOpened();
 		return true;
 	}
 
@@ -406,9 +547,90 @@ namespace IDLog
 		if (m_pImpl->fstream.is_open())
 		{
 			m_pImpl->fstream.close();
+			m_pImpl->SettleBuffered(GetMetrics());
+		}
+		if (m_pImpl->indexStream.is_open())
+		{
+			m_pImpl->indexStream.close();
 		}
 		m_pImpl->currentFileSize = 0;
 		m_pImpl->lastRollTime = 0;
 	}
 
+	void FileAppender::WriteNoLock(const char* data, size_t size)
+	{
+		if (!m_pImpl->fstream.is_open())
+		{
+			return;
+		}
+		// 仅在启用统计时计时
+		StatisticsManager& statsMgr = StatisticsManager::GetInstance();
+		const bool timed = statsMgr.IsStatisticsEnabled();
+		uint64_t startNs = timed ? StatisticsManager::GetMonotonicNs() : 0;
+
+		m_pImpl->fstream.write(data, static_cast<std::streamsize>(size));
+		m_pImpl->currentFileSize += size;
+
+		// 文件缓冲区每写满一次，流就向系统发出一次写调用
+		AppenderMetrics& metrics = GetMetrics();
+		metrics.AddRecords(1, size);
+		m_pImpl->bufferedBytes += size;
+		if (m_pImpl->bufferedBytes >= m_pImpl->fileBuffer.size())
+		{
+			metrics.AddWriteCalls(m_pImpl->bufferedBytes / m_pImpl->fileBuffer.size());
+			m_pImpl->bufferedBytes %= m_pImpl->fileBuffer.size();
+		}
+		m_pImpl->CheckStream(metrics);
+
+		if (timed)
+		{
+			statsMgr.RecordLatency(LatencyType::SINK_WRITE, StatisticsManager::GetMonotonicNs() - startNs);
+		}
+	}
+
+	void FileAppender::MaybeIndexNoLock(const LogEventPtr& event)
+	{
+		if (!m_pImpl->indexStream.is_open())
+		{
+			return;
+		}
+		bool due = !m_pImpl->hasIndexEntry ||
+				   (m_pImpl->indexRecords > 0 && m_pImpl->recordsSinceIndex >= m_pImpl->indexRecords) ||
+				   (m_pImpl->indexBytes > 0 && m_pImpl->currentFileSize - m_pImpl->lastIndexOffset >= m_pImpl->indexBytes);
+		if (due)
+		{
+			WriteIndexEntryNoLock(event);
+		}
+		++m_pImpl->recordsSinceIndex;
+	}
+
+	void FileAppender::WriteIndexEntryNoLock(const LogEventPtr& event)
+	{
+		if (!m_pImpl->indexStream.is_open() || !event)
+		{
+			return;
+		}
+		int64_t timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+							 event->GetTime().time_since_epoch())
+							 .count();
+		Utils::LogReader::WriteIndexEntry(m_pImpl->indexStream, {timeNs, m_pImpl->currentFileSize});
+		m_pImpl->hasIndexEntry = true;
+		m_pImpl->recordsSinceIndex = 0;
+		m_pImpl->lastIndexOffset = m_pImpl->currentFileSize;
+	}
+
+	void FileAppender::OnFileOpened()
+	{
+	}
+
+	void FileAppender::SetBinaryMode(bool binary)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_pImpl->binaryMode != binary)
+		{
+			m_pImpl->binaryMode = binary;
+			OpenNoLock();
+		}
+	}
+
 } // namespace IDLog
\ No newline at end of file
@@ -2,10 +2,11 @@
  * @Description: 日志输出器基类源文件
  * @Author: InverseDark
  * @Date: 2025-12-18 20:27:29
- * @LastEditTime: 2025-12-18 21:33:52
+ * @LastEditTime: 2026-10-18 19:25:33
  * @LastEditors: InverseDark
  */
 #include "IDLog/Appender/LogAppender.h"
+#include "IDLog/Core/Statistics.h"
 
 namespace IDLog
 {
@@ -13,6 +14,7 @@ namespace IDLog
 	struct LogAppender::Impl
 	{
 		FormatterPtr formatter; ///< 日志格式化器
+		AppenderMetrics metrics; ///< 输出器指标
 
 		/// @brief 构造函数
 		Impl() : formatter(nullptr) {}
@@ -45,4 +47,14 @@ namespace IDLog
 		return m_pImpl->formatter;
 	}
 
+	AppenderMetrics &LogAppender::GetMetrics()
+	{
+		return m_pImpl->metrics;
+	}
+
+	const AppenderMetrics &LogAppender::GetMetrics() const
+	{
+		return m_pImpl->metrics;
+	}
+
 } // namespace IDLog
\ No newline at end of file
@@ -0,0 +1,155 @@
+/**
+ * @Description: 调用点统计源文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 20:21:36
+ * @LastEditTime: 2026-10-18 20:21:36
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/Core/CallSite.h"
+#include "IDLog/Core/LogEvent.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace IDLog
+{
+	CallSite::CallSite(const char *fileName, const char *functionName, int lineNumber)
+		: m_fileName(fileName ? fileName : ""),
+		  m_functionName(functionName ? functionName : ""),
+		  m_lineNumber(lineNumber),
+		  m_calls(0),
+		  m_bytes(0),
+		  m_droppedCalls(0),
+		  m_droppedBytes(0),
+		  m_next(nullptr)
+	{
+		CallSiteProfiler::GetInstance().Register(this);
+	}
+
+	void CallSite::Reset()
+	{
+		m_calls.store(0, std::memory_order_relaxed);
+		m_bytes.store(0, std::memory_order_relaxed);
+		m_droppedCalls.store(0, std::memory_order_relaxed);
+		m_droppedBytes.store(0, std::memory_order_relaxed);
+	}
+
+	CallSiteProfiler::CallSiteProfiler()
+		: m_enabled(false), m_head(nullptr), m_count(0)
+	{
+	}
+
+	CallSiteProfiler &CallSiteProfiler::GetInstance()
+	{
+		static CallSiteProfiler instance;
+		return instance;
+	}
+
+	void CallSiteProfiler::Enable(bool enabled)
+	{
+		m_enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	void CallSiteProfiler::Register(CallSite *callSite)
+	{
+		if (!callSite)
+		{
+			return;
+		}
+		// 头插，链表只增不减，读者从头遍历即可
+		CallSite *head = m_head.load(std::memory_order_relaxed);
+		do
+		{
+			callSite->m_next = head;
+		} while (!m_head.compare_exchange_weak(head, callSite, std::memory_order_release, std::memory_order_relaxed));
+		m_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	size_t CallSiteProfiler::GetCallSiteCount() const
+	{
+		return m_count.load(std::memory_order_relaxed);
+	}
+
+	std::vector<CallSiteStats> CallSiteProfiler::GetAllCallSites() const
+	{
+		std::vector<CallSiteStats> result;
+		for (const CallSite *site = m_head.load(std::memory_order_acquire); site; site = site->GetNext())
+		{
+			CallSiteStats stats;
+			stats.calls = site->GetCalls();
+			stats.bytes = site->GetBytes();
+			stats.droppedCalls = site->GetDroppedCalls();
+			stats.droppedBytes = site->GetDroppedBytes();
+			if (stats.calls == 0 && stats.droppedCalls == 0)
+			{
+				continue;
+			}
+			stats.fileName = site->GetFileName();
+			stats.functionName = site->GetFunctionName();
+			stats.lineNumber = site->GetLineNumber();
+			result.push_back(std::move(stats));
+		}
+		return result;
+	}
+
+	std::vector<CallSiteStats> CallSiteProfiler::GetTopCallSites(size_t count, SortKey key) const
+	{
+		std::vector<CallSiteStats> sites = GetAllCallSites();
+		auto value = [key](const CallSiteStats &stats) -> uint64_t
+		{
+			switch (key)
+			{
+			case SortKey::CALLS:
+				return stats.calls;
+			case SortKey::DROPPED_BYTES:
+				return stats.droppedBytes;
+			case SortKey::BYTES:
+			default:
+				return stats.bytes;
+			}
+		};
+
+		count = std::min(count, sites.size());
+		std::partial_sort(sites.begin(), sites.begin() + static_cast<std::ptrdiff_t>(count), sites.end(),
+						  [&value](const CallSiteStats &lhs, const CallSiteStats &rhs)
+						  { return value(lhs) > value(rhs); });
+		sites.resize(count);
+		return sites;
+	}
+
+	void CallSiteProfiler::Reset()
+	{
+		for (CallSite *site = m_head.load(std::memory_order_acquire); site; site = site->m_next)
+		{
+			site->Reset();
+		}
+	}
+
+	std::string CallSiteProfiler::GenerateReport(size_t count) const
+	{
+		std::vector<CallSiteStats> sites = GetAllCallSites();
+		uint64_t totalBytes = 0;
+		for (const auto &site : sites)
+		{
+			totalBytes += site.bytes;
+		}
+
+		std::vector<CallSiteStats> top = GetTopCallSites(count);
+		std::stringstream ss;
+		ss << "Top Call Sites(" << top.size() << " of " << sites.size() << ", by bytes):\n";
+		size_t rank = 0;
+		for (const auto &site : top)
+		{
+			double share = totalBytes > 0 ? 100.0 * static_cast<double>(site.bytes) / static_cast<double>(totalBytes) : 0.0;
+			ss << "  #" << ++rank << " " << SourceLocation(site.fileName.c_str(), site.functionName.c_str(), site.lineNumber).ToString()
+			   << ": Calls=" << site.calls
+			   << ", Bytes=" << site.bytes
+			   << " (" << std::fixed << std::setprecision(1) << share << "%)"
+			   << ", DroppedCalls=" << site.droppedCalls
+			   << ", DroppedBytes=" << site.droppedBytes << "\n";
+		}
+		return ss.str();
+	}
+
+} // namespace IDLog
@@ -2,23 +2,27 @@
  * @Description: 配置源文件
  * @Author: InverseDark
  * @Date: 2025-12-21 11:55:37
- * @LastEditTime: 2025-12-21 11:57:23
+ * @LastEditTime: 2026-10-19 10:21:33
  * @LastEditors: InverseDark
  */
 #include "IDLog/Core/Configuration.h"
 #include "IDLog/Core/Statistics.h"
+#include "IDLog/Core/StatsFile.h"
 #include "IDLog/Core/LoggerManager.h"
 #include "IDLog/Utils/ConfigParseUtil.h"
+#include "IDLog/Utils/FileWatcher.h"
 
-#include <thread>
 #include <atomic>
-#include <filesystem>
-#include <chrono>
-
-namespace fs = std::filesystem;
+#include <set>
 
 namespace IDLog
 {
+	namespace
+	{
+		/// @brief 自动重新加载的去抖时间（毫秒），合并编辑器保存产生的多次写入
+		constexpr uint64_t kAutoReloadDebounceMs = 50;
+	} // namespace
+
 	bool Configuration::Options::Validate() const
 	{
 		// 验证全局配置选项
@@ -67,6 +71,7 @@ namespace IDLog
 		filters.clear();
 		appenders.clear();
 		formatters.clear();
+		levels.clear();
 		global = Options::Global();
 	}
 
@@ -79,20 +84,37 @@ namespace IDLog
 		std::mutex mutex;					 ///< 互斥锁
 
 		// 自动重新加载
-		std::thread autoReloadThread;		 ///< 自动重新加载线程
+		Utils::FileWatcher watcher;			 ///< 配置文件监视器
+		std::mutex watcherMutex;			 ///< 串行化监视器的启动与停止
+		std::string watchedPath;			 ///< 监视器启动时使用的文件路径，受 mutex 保护
 		std::atomic<bool> autoReloadEnabled; ///< 是否启用自动重新加载
-		std::atomic<bool> stopAutoReload;	 ///< 停止自动重新加载标志
-		uint64_t reloadInterval;			 ///< 重新加载间隔(秒)
-		std::time_t lastModTime;			 ///< 上次修改时间
+		uint64_t reloadInterval;			 ///< 退化为轮询时的检查间隔(秒)
+
+		/// @brief 已创建的输出器实例及创建它的配置
+		struct AppenderInstance
+		{
+			Options::AppenderConfig config;		///< 输出器配置
+			Options::FormatterConfig formatter; ///< 创建时使用的格式化器配置
+			LogAppender::Pointer appender;		///< 输出器实例
+		};
+
+		/// @brief 已创建的过滤器实例及创建它的配置
+		struct FilterInstance
+		{
+			Options::FilterConfig config; ///< 过滤器配置
+			Filter::Pointer filter;		  ///< 过滤器实例
+		};
+
+		std::map<std::string, AppenderInstance> appenderInstances; ///< 上次应用的输出器实例，键为输出器名称
+		std::map<std::string, FilterInstance> filterInstances;	   ///< 上次应用的过滤器实例，键为过滤器名称
+		std::set<std::string> configuredLevels;					   ///< 上次应用时由配置单独设置级别的日志器名称
 
 		bool applied; ///< 标记配置是否已应用
 
 		Impl()
 			: factory(std::make_shared<LogFactory>()),
 			  autoReloadEnabled(false),
-			  stopAutoReload(false),
 			  reloadInterval(60),
-			  lastModTime(0),
 			  applied(false)
 		{
 		}
@@ -117,26 +139,28 @@ namespace IDLog
 
 	bool Configuration::LoadFromFile(const std::string& filename)
 	{
-		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
-		try
+		bool result = false;
+		bool restartWatcher = false;
 		{
+			std::lock_guard<std::mutex> lock(m_pImpl->mutex);
 			// 使用配置解析工具加载配置文件
 			if (!m_pImpl->configParser.LoadFromFile(filename))
 			{
 				return false;
 			}
-			// 获取文件修改时间
-			auto ftime = fs::last_write_time(filename);
-			auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-				ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now());
-			m_pImpl->lastModTime = std::chrono::system_clock::to_time_t(sctp);
+			result = UpdateOptionsFromParser();
+
+			// 已启用自动重新加载且换了配置文件时改为监视新文件（监视线程内的重新加载路径不变，不会走到这里）。
+			// 在配置锁内比较 RestartWatcher 记录的路径：不能获取 watcherMutex，它在停止监视线程时被持有，
+			// 而监视线程可能正在这里等待
+			restartWatcher = m_pImpl->autoReloadEnabled && m_pImpl->watchedPath != filename;
 		}
-		catch (...)
+
+		if (restartWatcher)
 		{
-			m_pImpl->lastModTime = 0;
+			RestartWatcher();
 		}
-
-		return UpdateOptionsFromParser();
+		return result;
 	}
 
 	bool Configuration::LoadFromString(const std::string& content)
@@ -148,9 +172,6 @@ namespace IDLog
 			return false;
 		}
 
-		// 重置修改时间
-		m_pImpl->lastModTime = 0;
-
 		return UpdateOptionsFromParser();
 	}
 
@@ -191,9 +212,16 @@ namespace IDLog
 			return false;
 		}
 		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+		// 先应用候选配置，成功后才更新配置解析器；失败时恢复原配置选项
+		Options previous = std::move(m_pImpl->options);
 		m_pImpl->options = options;
+		if (!ApplyOptions())
+		{
+			m_pImpl->options = std::move(previous);
+			return false;
+		}
 		UpdateParserFromOptions();
-		return ApplyOptions();
+		return true;
 	}
 
 	void Configuration::SetFactory(const LogFactory::Pointer& factory)
@@ -248,20 +276,14 @@ namespace IDLog
 
 	void Configuration::EnableAutoReload(bool enable, uint64_t intervalSeconds)
 	{
-		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
-		m_pImpl->autoReloadEnabled = enable;
-		m_pImpl->reloadInterval = intervalSeconds;
-
-		if (enable && !m_pImpl->autoReloadThread.joinable())
 		{
-			m_pImpl->stopAutoReload = false;
-			m_pImpl->autoReloadThread = std::thread(&Configuration::AutoReloadThread, this);
-		}
-		else if (!enable && m_pImpl->autoReloadThread.joinable())
-		{
-			m_pImpl->stopAutoReload = true;
-			m_pImpl->autoReloadThread.join();
+			std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+			m_pImpl->autoReloadEnabled = enable;
+			m_pImpl->reloadInterval = intervalSeconds;
 		}
+
+		// 启停监视器不能持有配置锁：监视线程的回调会获取配置锁重新加载
+		RestartWatcher();
 	}
 
 	bool Configuration::IsAutoReloadEnabled() const
@@ -276,40 +298,32 @@ namespace IDLog
 		return m_pImpl->applied;
 	}
 
-	void Configuration::AutoReloadThread()
+	void Configuration::RestartWatcher()
 	{
-		while (!m_pImpl->stopAutoReload)
-		{
-			std::this_thread::sleep_for(std::chrono::seconds(m_pImpl->reloadInterval));
-
-			std::string filename;
-			{
-				std::lock_guard<std::mutex> lock(m_pImpl->mutex);
-				filename = m_pImpl->configParser.GetFilename();
-				if (filename.empty())
-				{
-					continue; // 无配置文件名，跳过
-				}
-			}
+		std::lock_guard<std::mutex> watcherLock(m_pImpl->watcherMutex);
+		m_pImpl->watcher.Stop();
 
-			try
-			{
-				auto ftime = fs::last_write_time(filename);
-				auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-					ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now());
-				std::time_t modTime = std::chrono::system_clock::to_time_t(sctp);
-
-				if (modTime > m_pImpl->lastModTime)
-				{
-					// 文件已修改，重新加载配置
-					LoadFromFile(filename);
-				}
-			}
-			catch (...)
+		std::string filename;
+		uint64_t intervalMs = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+			m_pImpl->watchedPath.clear();
+			if (!m_pImpl->autoReloadEnabled)
 			{
-				// 文件可能被删除或无法访问，忽略错误
+				return;
 			}
+			filename = m_pImpl->configParser.GetFilename();
+			intervalMs = m_pImpl->reloadInterval * 1000;
+			m_pImpl->watchedPath = filename;
 		}
+		if (filename.empty())
+		{
+			return; // 尚未加载配置文件，加载时再启动
+		}
+
+		// 文件变化平息后重新加载；inotify 不可用时按 intervalMs 轮询
+		m_pImpl->watcher.Start(filename, [this](const std::string&)
+			{ Reload(); }, kAutoReloadDebounceMs, intervalMs);
 	}
 
 	void Configuration::UpdateParserFromOptions()
@@ -321,6 +335,13 @@ namespace IDLog
 		parser.SetString("global", "rootLevel", LevelToString(m_pImpl->options.global.rootLevel));
 		parser.SetBool("global", "enableStatistics", m_pImpl->options.global.enableStatistics);
 		parser.SetInt("global", "statisticsInterval", static_cast<int>(m_pImpl->options.global.statisticsInterval));
+		parser.SetString("global", "statisticsFile", m_pImpl->options.global.statisticsFile);
+
+		// 级别规则
+		for (const auto& [pattern, level] : m_pImpl->options.levels)
+		{
+			parser.SetString("levels", pattern, LevelToString(level));
+		}
 
 		// Filter 配置
 		for (const auto& [name, filterOpts] : m_pImpl->options.filters)
@@ -414,11 +435,20 @@ namespace IDLog
 		newOptions.global.rootLevel = parser.GetLogLevel("global", "rootLevel", LogLevel::INFO);
 		newOptions.global.enableStatistics = parser.GetBool("global", "enableStatistics", false);
 		newOptions.global.statisticsInterval = static_cast<uint64_t>(parser.GetInt("global", "statisticsInterval", 60));
+		newOptions.global.statisticsFile = parser.GetString("global", "statisticsFile", "");
 
 		for (const auto& section : parser.GetSections())
 		{
+			// 解析级别规则
+			if (section == "levels")
+			{
+				for (const auto& pattern : parser.GetKeys(section))
+				{
+					newOptions.levels[pattern] = parser.GetLogLevel(section, pattern, LogLevel::INFO);
+				}
+			}
 			// 解析 Filter 配置
-			if (Utils::StringUtil::StartsWith(section, "filter."))
+			else if (Utils::StringUtil::StartsWith(section, "filter."))
 			{
 				std::string filterName = section.substr(7); // 去掉"filter."前缀
 				Options::FilterConfig filterConfig;
@@ -522,110 +552,149 @@ namespace IDLog
 	bool Configuration::ApplyOptions()
 	{
 		auto& loggerMgr = LoggerManager::GetInstance();
-		std::map<std::string, LoggerManager::LoggerPtr> oldLoggers; // 备份旧日志器指针
-		std::vector<std::string> newCreatedLoggers;					// 新创建的日志器名称列表
-		bool allSuccess = true;
+		const Options& options = m_pImpl->options;
 
-		// 设置统计启用
-		StatisticsManager::GetInstance().EnableStatistics(m_pImpl->options.global.enableStatistics);
-		// 设置统计间隔
-		StatisticsManager::GetInstance().SetStatisticsInterval(m_pImpl->options.global.statisticsInterval);
+		// 先准备全部输出器实例：配置（含格式化器配置）未变化的沿用旧实例，其余新建
+		std::map<std::string, Impl::AppenderInstance> appenderInstances;
+		for (const auto& [appenderName, appenderOpts] : options.appenders)
+		{
+			Impl::AppenderInstance instance;
+			instance.config = appenderOpts;
+			auto formatterIt = options.formatters.find(appenderOpts.formatter);
+			if (!appenderOpts.formatter.empty() && formatterIt != options.formatters.end())
+			{
+				instance.formatter = formatterIt->second;
+			}
 
-		// 设置根日志级别
-		loggerMgr.SetRootLevel(m_pImpl->options.global.rootLevel);
-		loggerMgr.GetRootLogger()->EnableStatistics(m_pImpl->options.global.enableStatistics);
+			auto oldIt = m_pImpl->appenderInstances.find(appenderName);
+			if (oldIt != m_pImpl->appenderInstances.end() &&
+				oldIt->second.config == instance.config && oldIt->second.formatter == instance.formatter)
+			{
+				instance.appender = oldIt->second.appender;
+			}
+			else
+			{
+				instance.appender = CreateAppenderFromConfig(appenderOpts);
+				if (!instance.appender)
+				{
+					return false; // 尚未修改任何日志器，新建的实例随局部变量释放
+				}
+			}
+			appenderInstances.emplace(appenderName, std::move(instance));
+		}
 
-		for (const auto& [loggerName, loggerOpts] : m_pImpl->options.loggers)
+		// 同样准备全部过滤器实例
+		std::map<std::string, Impl::FilterInstance> filterInstances;
+		for (const auto& [filterName, filterOpts] : options.filters)
 		{
-			// 检查日志器是否已存在
-			if (loggerMgr.HasLogger(loggerName))
+			Impl::FilterInstance instance;
+			instance.config = filterOpts;
+
+			auto oldIt = m_pImpl->filterInstances.find(filterName);
+			if (oldIt != m_pImpl->filterInstances.end() && oldIt->second.config == filterOpts)
 			{
-				oldLoggers[loggerName] = loggerMgr.GetLogger(loggerName);
+				instance.filter = oldIt->second.filter;
 			}
 			else
 			{
-				newCreatedLoggers.push_back(loggerName); // 记录新创建的日志器名称
+				instance.filter = CreateFilterFromConfig(filterOpts);
+				if (!instance.filter)
+				{
+					return false;
+				}
 			}
+			filterInstances.emplace(filterName, std::move(instance));
+		}
 
+		// 统计开关只在变化时切换，避免每次重新加载都清零统计
+		auto& statisticsMgr = StatisticsManager::GetInstance();
+		const bool enableStatistics = options.global.enableStatistics;
+		if (statisticsMgr.IsStatisticsEnabled() != enableStatistics)
+		{
+			statisticsMgr.EnableStatistics(enableStatistics);
+		}
+		// 设置统计间隔
+		statisticsMgr.SetStatisticsInterval(options.global.statisticsInterval);
+		// 发布统计文件（路径未变时保持现有发布）
+		const std::string& statisticsFile = options.global.statisticsFile;
+		if (!statisticsFile.empty())
+		{
+			std::string statsPath = statisticsFile == "default" ? StatsFile::GetDefaultPath() : statisticsFile;
+			if (statisticsMgr.GetStatsFilePath() != statsPath)
+			{
+				statisticsMgr.StartStatsFile(statsPath);
+			}
+		}
+
+		// 设置根日志级别与级别规则
+		loggerMgr.SetRootLevel(options.global.rootLevel);
+		loggerMgr.SetLevelRules(options.levels);
+		loggerMgr.GetRootLogger()->EnableStatistics(enableStatistics);
+
+		// 新配置中已删除的日志器节不再固定级别，恢复从规则或父日志器继承
+		for (const std::string& loggerName : m_pImpl->configuredLevels)
+		{
+			if (options.loggers.find(loggerName) == options.loggers.end())
+			{
+				loggerMgr.ResetLoggerLevel(loggerName);
+			}
+		}
+		m_pImpl->configuredLevels.clear();
+		for (const auto& entry : options.loggers)
+		{
+			m_pImpl->configuredLevels.insert(entry.first);
+		}
+
+		for (const auto& [loggerName, loggerOpts] : options.loggers)
+		{
 			auto logger = loggerMgr.GetLogger(loggerName);
 			if (!logger)
 			{
-				allSuccess = false;
-				break;
+				return false;
 			}
 
-			// 设置日志级别
-			logger->SetLevel(loggerOpts.level);
+			// 设置日志级别（下发到未单独设置级别的子日志器）
+			loggerMgr.SetLoggerLevel(loggerName, loggerOpts.level);
 
-			// 清除现有的Appender和Filter
-			logger->ClearAppenders();
-			logger->ClearFilters();
-
-			// 添加新的Appender
+			std::vector<Logger::AppenderPtr> appenders;
 			for (const auto& appenderName : loggerOpts.appenders)
 			{
-				auto appenderIt = m_pImpl->options.appenders.find(appenderName);
-				if (appenderIt != m_pImpl->options.appenders.end())
+				auto it = appenderInstances.find(appenderName);
+				if (it != appenderInstances.end())
 				{
-					auto appender = CreateAppenderFromConfig(appenderIt->second);
-					if (appender)
-					{
-						logger->AddAppender(appender);
-					}
-					else
-					{
-						allSuccess = false;
-						break;
-					}
+					appenders.push_back(it->second.appender);
 				}
 			}
-			if (!allSuccess)
-			{
-				break;
-			}
-
-			// 添加新的Filter
+			std::vector<Logger::FilterPtr> filters;
 			for (const auto& filterName : loggerOpts.filters)
 			{
-				auto filterIt = m_pImpl->options.filters.find(filterName);
-				if (filterIt != m_pImpl->options.filters.end())
+				auto it = filterInstances.find(filterName);
+				if (it != filterInstances.end())
 				{
-					auto filter = CreateFilterFromConfig(filterIt->second);
-					if (filter)
-					{
-						logger->AddFilter(filter);
-					}
-					else
-					{
-						allSuccess = false;
-						break;
-					}
+					filters.push_back(it->second.filter);
 				}
 			}
-			if (!allSuccess)
-			{
-				break;
-			}
 
-			// 设置统计开关
-			logger->EnableStatistics(m_pImpl->options.global.enableStatistics);
-		}
-
-		if (!allSuccess)
-		{
-			// 回滚已创建的日志器
-			for (const auto& loggerName : newCreatedLoggers)
+			// 列表中的实例完全相同时不替换，正在写入的日志不受影响
+			if (logger->GetAppenders() != appenders)
 			{
-				loggerMgr.RemoveLogger(loggerName);
+				logger->SetAppenders(appenders);
 			}
-			// 恢复旧日志器
-			for (const auto& [loggerName, loggerPtr] : oldLoggers)
+			if (logger->GetFilters() != filters)
 			{
-				loggerMgr.AddLogger(loggerName, loggerPtr);
+				logger->SetFilters(filters);
 			}
+
+			// 是否叠加父日志器的输出器
+			logger->SetAdditive(loggerOpts.additive);
+
+			// 设置统计开关
+			logger->EnableStatistics(enableStatistics);
 		}
 
-		return allSuccess;
+		m_pImpl->appenderInstances.swap(appenderInstances);
+		m_pImpl->filterInstances.swap(filterInstances);
+		return true;
 	}
 
 } // namespace IDLog
\ No newline at end of file
@@ -2,13 +2,14 @@
  * @Description: 日志事件源文件
  * @Author: InverseDark
  * @Date: 2025-12-18 19:00:16
- * @LastEditTime: 2025-12-18 19:00:16
+ * @LastEditTime: 2026-10-18 23:48:52
  * @LastEditors: InverseDark
  */
 #include "IDLog/Core/LogEvent.h"
 #include "IDLog/Utils/ThreadUtil.h"
 
 #include <iomanip>
+#include <mutex>
 
 namespace IDLog
 {
@@ -40,7 +41,9 @@ namespace IDLog
 		std::string loggerName;  ///< 日志器名称
 		SourceLocation location; ///< 源文件位置
 		TimePoint time;		   ///< 时间戳
-		std::string message;	   ///< 日志消息
+		std::string message;	   ///< 日志消息（静态消息时按需生成）
+		std::string_view literal;  ///< 静态消息，非空指针时事件不持有消息内容
+		std::once_flag messageOnce; ///< 静态消息生成 message 的一次性标志
 		std::string threadId;	   ///< 线程ID
 		std::string threadName;  ///< 线程名称
 
@@ -48,18 +51,38 @@ namespace IDLog
 		Impl() {}
 	};
 
-	LogEvent::LogEvent(LogLevel level, const std::string& loggerName, const std::string& message, const SourceLocation& location)
+	LogEvent::LogEvent(LogLevel level, const std::string& loggerName, LogMessage message, const SourceLocation& location)
 		: m_pImpl(new Impl)
 	{
 		m_pImpl->level = level;
 		m_pImpl->loggerName = loggerName;
 		m_pImpl->location = location;
 		m_pImpl->time = std::chrono::system_clock::now();
-		m_pImpl->message = message;
+		if (message.GetKind() == LogMessage::Kind::STATIC)
+		{
+			m_pImpl->literal = message.View();
+		}
+		else
+		{
+			m_pImpl->message = message.Take();
+		}
 		m_pImpl->threadId = Utils::ThreadUtil::GetThreadId();
 		m_pImpl->threadName = Utils::ThreadUtil::GetThreadName();
 	}
 
+	LogEvent::LogEvent(LogLevel level, const std::string& loggerName, const std::string& message, const SourceLocation& location,
+					   TimePoint time, const std::string& threadId, const std::string& threadName)
+		: m_pImpl(new Impl)
+	{
+		m_pImpl->level = level;
+		m_pImpl->loggerName = loggerName;
+		m_pImpl->location = location;
+		m_pImpl->time = time;
+		m_pImpl->message = message;
+		m_pImpl->threadId = threadId;
+		m_pImpl->threadName = threadName;
+	}
+
 	LogEvent::~LogEvent()
 	{
 		delete m_pImpl;
@@ -87,6 +110,21 @@ namespace IDLog
 
 	const std::string& LogEvent::GetLogMessage() const
 	{
+		if (m_pImpl->literal.data())
+		{
+			// 事件可能同时被多个输出器线程读取，只生成一次
+			std::call_once(m_pImpl->messageOnce, [this]()
+						   { m_pImpl->message.assign(m_pImpl->literal.data(), m_pImpl->literal.size()); });
+		}
+		return m_pImpl->message;
+	}
+
+	std::string_view LogEvent::GetLogMessageView() const
+	{
+		if (m_pImpl->literal.data())
+		{
+			return m_pImpl->literal;
+		}
 		return m_pImpl->message;
 	}
 
@@ -102,6 +140,7 @@ namespace IDLog
 
 	void LogEvent::SetLogMessage(const std::string& message)
 	{
+		m_pImpl->literal = std::string_view();
 		m_pImpl->message = message;
 	}
 
@@ -143,7 +182,7 @@ namespace IDLog
 			<< ", time=" << GetFormattedTime()
 			<< ", thread=" << m_pImpl->threadId << "(" << m_pImpl->threadName << ")"
 			<< ", location=" << m_pImpl->location.ToString()
-			<< ", message=" << m_pImpl->message
+			<< ", message=" << GetLogMessageView()
 			<< "}";
 		return ss.str();
 	}
@@ -2,23 +2,77 @@
  * @Description: Log 工厂源文件
  * @Author: InverseDark
  * @Date: 2025-12-21 13:04:37
- * @LastEditTime: 2025-12-25 22:14:19
+ * @LastEditTime: 2026-10-19 12:35:10
  * @LastEditors: InverseDark
  */
 #include "IDLog/Core/LogFactory.h"
 
 #include "IDLog/Appender/ConsoleAppender.h"
 #include "IDLog/Appender/FileAppender.h"
+#include "IDLog/Appender/BinaryFileAppender.h"
 #include "IDLog/Appender/AsyncAppender.h"
 #include "IDLog/Formatter/PatternFormatter.h"
 #include "IDLog/Formatter/JsonFormatter.h"
+#include "IDLog/Formatter/BinaryFormatter.h"
 #include "IDLog/Filter/LevelFilter.h"
+#include "IDLog/Filter/RateLimitFilter.h"
+#include "IDLog/Filter/DedupFilter.h"
+#include "IDLog/Filter/LoggerNameFilter.h"
 
 #include "IDLog/Utils/ConfigParseUtil.h"
 #include "IDLog/Utils/StringUtil.h"
 
 namespace IDLog
 {
+	namespace
+	{
+		/// @brief 解析文件滚动策略参数
+		/// @param params [IN] 输出器参数
+		/// @return 滚动策略，缺省或无法识别时为不滚动
+		FileAppender::RollPolicy ParseRollPolicy(const std::map<std::string, std::string> &params)
+		{
+			std::string policyStr = Utils::ConfigParseUtil::GetString(params, "rollPolicy", "none");
+			if (policyStr == "yearly")
+			{
+				return FileAppender::RollPolicy::YEARLY;
+			}
+			else if (policyStr == "monthly")
+			{
+				return FileAppender::RollPolicy::MONTHLY;
+			}
+			else if (policyStr == "daily")
+			{
+				return FileAppender::RollPolicy::DAILY;
+			}
+			else if (policyStr == "hourly")
+			{
+				return FileAppender::RollPolicy::HOURLY;
+			}
+			else if (policyStr == "minutely")
+			{
+				return FileAppender::RollPolicy::MINUTELY;
+			}
+			else if (policyStr == "size")
+			{
+				return FileAppender::RollPolicy::SIZE;
+			}
+			return FileAppender::RollPolicy::NONE;
+		}
+
+		/// @brief 应用时间索引参数
+		/// @param appender [IN] 文件输出器
+		/// @param params [IN] 输出器参数，indexRecords / indexBytes 均缺省为0（不生成索引）
+		void ApplyIndexInterval(FileAppender &appender, const std::map<std::string, std::string> &params)
+		{
+			size_t indexRecords = Utils::ConfigParseUtil::GetInt(params, "indexRecords", 0);
+			size_t indexBytes = Utils::ConfigParseUtil::GetInt(params, "indexBytes", 0);
+			if (indexRecords > 0 || indexBytes > 0)
+			{
+				appender.SetIndexInterval(indexRecords, indexBytes);
+			}
+		}
+	} // namespace
+
 	LogFactory::LogFactory() = default;
 
 	LogFactory::~LogFactory() = default;
@@ -35,6 +89,10 @@ namespace IDLog
 			if (!formatter.empty())
 			{
 				fmtPtr = CreateFormatter(formatter, formatterParams);
+				if (!fmtPtr)
+				{
+					return nullptr; // 格式化器配置错误
+				}
 			}
 			ConsoleAppender::Target target = ConsoleAppender::Target::STDOUT;	// 默认输出到标准输出
 			if (params.find("target") != params.end())
@@ -47,9 +105,20 @@ namespace IDLog
 			}
 			auto appenderPtr = std::make_shared<ConsoleAppender>(target, fmtPtr);
 
-			bool useColor = Utils::ConfigParseUtil::GetBool(params, "useColor", true);	// 默认使用颜色
-			appenderPtr->SetUseColor(useColor);
-			
+			// 颜色模式：auto（默认，仅终端着色）/ true / false
+			std::string useColorStr = Utils::StringUtil::ToLower(Utils::ConfigParseUtil::GetString(params, "useColor", "auto"));
+			if (useColorStr != "auto")
+			{
+				appenderPtr->SetUseColor(Utils::ConfigParseUtil::GetBool(params, "useColor", true));
+			}
+
+			size_t bufferSize = Utils::ConfigParseUtil::GetInt(params, "bufferSize", 16 * 1024);	// 默认缓冲区16KB
+			appenderPtr->SetBufferSize(bufferSize);
+			uint64_t flushIntervalMs = static_cast<uint64_t>(Utils::ConfigParseUtil::GetInt(params, "flushIntervalMs", 200)); // 默认刷新间隔200毫秒
+			appenderPtr->SetFlushInterval(flushIntervalMs);
+			bool nonBlocking = Utils::ConfigParseUtil::GetBool(params, "nonBlocking", false);	// 默认阻塞写
+			appenderPtr->SetNonBlocking(nonBlocking);
+
 			return appenderPtr;
 		}
 		else if (type == "file")	// 创建文件输出器
@@ -58,39 +127,27 @@ namespace IDLog
 			if (!formatter.empty())
 			{
 				fmtPtr = CreateFormatter(formatter, formatterParams);
-			}
-			std::string filename = Utils::ConfigParseUtil::GetString(params, "filename", "default.log"); // 默认文件名default.log
-			FileAppender::RollPolicy rollPolicy = FileAppender::RollPolicy::NONE; // 默认不滚动
-			if (params.find("rollPolicy") != params.end())
-			{
-				std::string policyStr = params.at("rollPolicy");
-				if (policyStr == "yearly")
+				if (!fmtPtr)
 				{
-					rollPolicy = FileAppender::RollPolicy::YEARLY;
-				}
-				else if (policyStr == "monthly")
-				{
-					rollPolicy = FileAppender::RollPolicy::MONTHLY;
-				}
-				else if (policyStr == "daily")
-				{
-					rollPolicy = FileAppender::RollPolicy::DAILY;
-				}
-				else if (policyStr == "hourly")
-				{
-					rollPolicy = FileAppender::RollPolicy::HOURLY;
-				}
-				else if (policyStr == "minutely")
-				{
-					rollPolicy = FileAppender::RollPolicy::MINUTELY;
-				}
-				else if (policyStr == "size")
-				{
-					rollPolicy = FileAppender::RollPolicy::SIZE;
+					return nullptr; // 格式化器配置错误
 				}
 			}
+			std::string filename = Utils::ConfigParseUtil::GetString(params, "filename", "default.log"); // 默认文件名default.log
+			FileAppender::RollPolicy rollPolicy = ParseRollPolicy(params); // 默认不滚动
 			size_t maxSize = Utils::ConfigParseUtil::GetInt(params, "maxSize", 10 * 1024 * 1024); // 默认最大文件大小10MB
-			return std::make_shared<FileAppender>(filename, fmtPtr, rollPolicy, maxSize);
+			auto appenderPtr = std::make_shared<FileAppender>(filename, fmtPtr, rollPolicy, maxSize);
+			ApplyIndexInterval(*appenderPtr, params);
+			return appenderPtr;
+		}
+		else if (type == "binaryfile")	// 创建二进制文件输出器（格式化器固定为二进制编码，忽略formatter配置）
+		{
+			std::string filename = Utils::ConfigParseUtil::GetString(params, "filename", "default.idlb"); // 默认文件名default.idlb
+			size_t segmentRecords = Utils::ConfigParseUtil::GetInt(params, "segmentRecords", 8192); // 默认每段8192条记录
+			FileAppender::RollPolicy rollPolicy = ParseRollPolicy(params); // 默认不滚动
+			size_t maxSize = Utils::ConfigParseUtil::GetInt(params, "maxSize", 10 * 1024 * 1024); // 默认最大文件大小10MB
+			auto appenderPtr = std::make_shared<BinaryFileAppender>(filename, segmentRecords, rollPolicy, maxSize);
+			ApplyIndexInterval(*appenderPtr, params);
+			return appenderPtr;
 		}
 		else if (type == "async")	// 创建异步输出器
 		{
@@ -161,7 +218,41 @@ namespace IDLog
 		else if (type == "json")
 		{
 			bool prettyPrint = Utils::ConfigParseUtil::GetBool(params, "pretty", true);	// 默认美化输出
-			return std::make_shared<JsonFormatter>(prettyPrint);
+			auto jsonFormatter = std::make_shared<JsonFormatter>(prettyPrint);
+			jsonFormatter->SetValidateUtf8(Utils::ConfigParseUtil::GetBool(params, "validateUtf8", false));	// 默认不校验UTF-8
+
+			// 字段列表，如 fields=timestamp:@timestamp,level,message:msg,thread_name?
+			std::string fields = Utils::ConfigParseUtil::GetString(params, "fields", "");
+			if (!fields.empty() && !jsonFormatter->SetFields(fields))
+			{
+				return nullptr; // 有无法识别的字段，视为配置错误，不输出残缺的结构
+			}
+
+			// 时间戳格式：text（默认）/ epoch_ms / epoch_ns
+			std::string timestampFormat = Utils::StringUtil::ToLower(Utils::ConfigParseUtil::GetString(params, "timestampFormat", "text"));
+			if (timestampFormat == "epoch_ns")
+			{
+				jsonFormatter->SetTimestampFormat(JsonFormatter::TimestampFormat::EPOCH_NS);
+			}
+			else if (timestampFormat == "epoch_ms")
+			{
+				jsonFormatter->SetTimestampFormat(JsonFormatter::TimestampFormat::EPOCH_MS);
+			}
+
+			// 静态字段，如 static.service=order-api
+			for (const auto& [key, value] : params)
+			{
+				if (Utils::StringUtil::StartsWith(key, "static.") && key.size() > 7)
+				{
+					jsonFormatter->AddStaticField(key.substr(7), value);
+				}
+			}
+			return jsonFormatter;
+		}
+		else if (type == "binary")
+		{
+			size_t segmentRecords = Utils::ConfigParseUtil::GetInt(params, "segmentRecords", 8192);	// 默认每段8192条记录
+			return std::make_shared<BinaryFormatter>(segmentRecords);
 		}
 		return nullptr;
 	}
@@ -178,6 +269,36 @@ namespace IDLog
 			bool acceptOnMatch = Utils::ConfigParseUtil::GetBool(params, "acceptOnMatch", true);	// 默认匹配时接受
 			return std::make_shared<LevelFilter>(minLevel, maxLevel, acceptOnMatch);
 		}
+		else if (type == "ratelimit")
+		{
+			double rate = Utils::ConfigParseUtil::GetDouble(params, "rate", 10.0);	// 默认每秒10条
+			int burst = Utils::ConfigParseUtil::GetInt(params, "burst", 10);	// 默认最多连续10条
+			unsigned keyFields = RateLimitFilter::ParseKeyFields(Utils::ConfigParseUtil::GetString(params, "key", "all"));	// 默认按日志器、级别与调用点分桶
+			int buckets = Utils::ConfigParseUtil::GetInt(params, "buckets", 1024);	// 默认1024个桶
+			bool summary = Utils::ConfigParseUtil::GetBool(params, "summary", true);	// 默认输出被抑制条数的说明
+			return std::make_shared<RateLimitFilter>(rate, static_cast<uint32_t>(std::max(burst, 1)), keyFields,
+													 static_cast<size_t>(std::max(buckets, 1)), summary);
+		}
+		else if (type == "dedup")
+		{
+			int window = Utils::ConfigParseUtil::GetInt(params, "window", 1000);	// 默认窗口1000毫秒
+			int slots = Utils::ConfigParseUtil::GetInt(params, "slots", 64);	// 默认跟踪64条不同的日志
+			return std::make_shared<DedupFilter>(std::chrono::milliseconds(window), static_cast<size_t>(std::max(slots, 1)));
+		}
+		else if (type == "loggername")
+		{
+			std::vector<std::string> names;
+			for (std::string name : Utils::StringUtil::Split(Utils::ConfigParseUtil::GetString(params, "names", ""), ","))	// 逗号分隔的名称规则
+			{
+				Utils::StringUtil::Trim(name);
+				if (!name.empty())
+				{
+					names.push_back(name);
+				}
+			}
+			bool acceptOnMatch = Utils::ConfigParseUtil::GetBool(params, "acceptOnMatch", true);	// 默认匹配时接受
+			return std::make_shared<LoggerNameFilter>(names, acceptOnMatch);
+		}
 		return nullptr;
 	}
 
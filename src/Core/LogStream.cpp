@@ -0,0 +1,127 @@
+/**
+ * @Description: 流式日志源文件
+ * @Author: InverseDark
+ * @Date: 2026-10-19 00:05:31
+ * @LastEditTime: 2026-10-19 00:05:31
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/Core/LogStream.h"
+
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace IDLog
+{
+	namespace detail
+	{
+		namespace
+		{
+			/// @brief 缓冲区保留的最大容量，偶尔出现的超长消息结束后释放
+			constexpr size_t kMaxRetainedCapacity = 64 * 1024;
+
+			/// @brief 直接追加到 std::string 的流缓冲
+			class StringAppendBuf : public std::streambuf
+			{
+			public:
+				/// @brief 构造函数
+				/// @param out [IN] 输出字符串
+				explicit StringAppendBuf(std::string &out) : m_out(out) {}
+
+			protected:
+				int_type overflow(int_type ch) override
+				{
+					if (!traits_type::eq_int_type(ch, traits_type::eof()))
+					{
+						m_out.push_back(traits_type::to_char_type(ch));
+					}
+					return traits_type::not_eof(ch);
+				}
+
+				std::streamsize xsputn(const char *data, std::streamsize count) override
+				{
+					m_out.append(data, static_cast<size_t>(count));
+					return count;
+				}
+
+			private:
+				std::string &m_out; ///< 输出字符串
+			};
+		} // namespace
+
+		/// @brief 线程局部的流缓冲槽
+		struct LogStreamSlot
+		{
+			std::string buffer;	   ///< 消息缓冲区
+			StringAppendBuf streambuf; ///< 追加到 buffer 的流缓冲
+			std::ostream stream;	   ///< 输出流
+
+			LogStreamSlot() : streambuf(buffer), stream(&streambuf) {}
+
+			/// @brief 归还前清理：重置格式状态，释放过大的缓冲区
+			void Reset()
+			{
+				stream.clear();
+				stream.flags(std::ios_base::dec | std::ios_base::skipws);
+				stream.precision(6);
+				stream.width(0);
+				stream.fill(' ');
+				if (buffer.capacity() > kMaxRetainedCapacity)
+				{
+					std::string().swap(buffer);
+				}
+				else
+				{
+					buffer.clear();
+				}
+			}
+		};
+
+		namespace
+		{
+			/// @brief 当前线程的缓冲槽，按嵌套深度使用
+			struct SlotPool
+			{
+				std::vector<std::unique_ptr<LogStreamSlot>> slots; ///< 缓冲槽
+				size_t depth = 0;									///< 正在使用的槽数
+
+				LogStreamSlot *Acquire()
+				{
+					if (depth == slots.size())
+					{
+						slots.push_back(std::make_unique<LogStreamSlot>());
+					}
+					return slots[depth++].get();
+				}
+
+				void Release(LogStreamSlot *slot)
+				{
+					slot->Reset();
+					--depth;
+				}
+			};
+
+			thread_local SlotPool t_slotPool;
+		} // namespace
+	} // namespace detail
+
+	LogStream::LogStream(Logger &logger, LogLevel level, const SourceLocation &location)
+		: m_logger(logger), m_location(location), m_slot(detail::t_slotPool.Acquire()),
+		  m_stream(&m_slot->stream), m_level(level)
+	{
+	}
+
+	LogStream::~LogStream()
+	{
+		try
+		{
+			m_logger.Log(m_level, std::string_view(m_slot->buffer), m_location);
+		}
+		catch (...)
+		{
+			// 析构函数中不能抛出异常，丢弃这条日志
+		}
+		detail::t_slotPool.Release(m_slot);
+	}
+} // namespace IDLog
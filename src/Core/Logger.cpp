@@ -2,46 +2,186 @@
  * @Description: 日志记录器源文件
  * @Author: InverseDark
  * @Date: 2025-12-18 18:22:41
- * @LastEditTime: 2025-12-18 18:22:44
+ * @LastEditTime: 2026-10-19 12:04:31
  * @LastEditors: InverseDark
  */
 #include "IDLog/Core/Logger.h"
+#include "IDLog/Core/LoggerManager.h"
 #include "IDLog/Core/Statistics.h"
+#include "IDLog/Core/CallSite.h"
 #include "IDLog/Appender/ConsoleAppender.h"
+#include "IDLog/Utils/EpochReclaimer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <vector>
 #include <mutex>
 
 namespace IDLog
 {
+	namespace
+	{
+		/// @brief 每个代数块的编号个数
+		constexpr uint32_t kIdsPerChunk = 4096;
+
+		/// @brief 代数块目录容量（同时存在的日志器个数上限为 kIdsPerChunk * kMaxIdChunks）
+		constexpr uint32_t kMaxIdChunks = 1024;
+
+		/// @brief 代数块
+		struct GenerationChunk
+		{
+			std::atomic<uint32_t> generations[kIdsPerChunk]; ///< 按编号保存的代数
+
+			/// @brief 构造函数
+			GenerationChunk()
+			{
+				for (auto& generation : generations)
+				{
+					generation.store(0, std::memory_order_relaxed);
+				}
+			}
+		};
+
+		/// @brief 日志器名称登记表，编号即下标
+		/// @details 日志器析构时释放编号与名称，编号被再次分配前代数递增，
+		///			 过滤器按编号缓存的结果需同时记录代数，代数不同时重新计算
+		struct LoggerRegistry
+		{
+			std::mutex mutex;								///< 互斥锁
+			std::vector<std::string> names;					///< 按编号保存的日志器名称
+			std::vector<uint32_t> freeIds;					///< 已释放、可以再分配的编号
+			std::atomic<GenerationChunk*> chunks[kMaxIdChunks]; ///< 代数块目录，按需分配，无锁读取
+
+			/// @brief 构造函数
+			LoggerRegistry()
+			{
+				for (auto& chunk : chunks)
+				{
+					chunk.store(nullptr, std::memory_order_relaxed);
+				}
+			}
+		};
+
+		/// @brief 获取日志器名称登记表
+		/// @details 不析构：静态对象中的日志器可能晚于登记表析构，析构时仍要释放编号
+		/// @return 登记表
+		LoggerRegistry& GetLoggerRegistry()
+		{
+			static LoggerRegistry* instance = new LoggerRegistry();
+			return *instance;
+		}
+
+		/// @brief 获取编号对应的代数
+		/// @param registry [IN] 登记表
+		/// @param id [IN] 日志器编号
+		/// @return 代数的原子变量，编号超出目录容量时为空
+		std::atomic<uint32_t>* FindGeneration(LoggerRegistry& registry, uint32_t id)
+		{
+			if (id / kIdsPerChunk >= kMaxIdChunks)
+			{
+				return nullptr;
+			}
+			GenerationChunk* chunk = registry.chunks[id / kIdsPerChunk].load(std::memory_order_acquire);
+			return chunk ? &chunk->generations[id % kIdsPerChunk] : nullptr;
+		}
+
+		/// @brief 登记日志器名称并分配编号（优先复用已释放的编号）
+		/// @param name [IN] 日志器名称
+		/// @return 日志器编号
+		uint32_t RegisterLoggerName(const std::string& name)
+		{
+			LoggerRegistry& registry = GetLoggerRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			if (!registry.freeIds.empty())
+			{
+				const uint32_t id = registry.freeIds.back();
+				registry.freeIds.pop_back();
+				registry.names[id] = name;
+				return id;
+			}
+
+			const uint32_t id = static_cast<uint32_t>(registry.names.size());
+			registry.names.push_back(name);
+			if (id / kIdsPerChunk < kMaxIdChunks && id % kIdsPerChunk == 0)
+			{
+				registry.chunks[id / kIdsPerChunk].store(new GenerationChunk(), std::memory_order_release);
+			}
+			return id;
+		}
+
+		/// @brief 释放日志器编号与名称，递增代数使按旧代数缓存的结果失效
+		/// @param id [IN] 日志器编号
+		void ReleaseLoggerName(uint32_t id)
+		{
+			LoggerRegistry& registry = GetLoggerRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			std::string().swap(registry.names[id]);
+			if (std::atomic<uint32_t>* generation = FindGeneration(registry, id))
+			{
+				generation->fetch_add(1, std::memory_order_release);
+				registry.freeIds.push_back(id);
+			}
+			// 超出目录容量的编号没有代数，不再复用
+		}
+	} // namespace
+
+	/// @brief 预先计算的过滤器链
+	/// @details 过滤器列表变化时整体替换，记录日志时登记读者纪元后无锁读取，旧链等读者离开后释放；
+	///			 开头连续的能提前决策的过滤器在创建日志事件之前应用
+	struct Logger::FilterChain
+	{
+		std::vector<FilterPtr> filters; ///< 过滤器列表
+		size_t preDecideCount;			///< 开头能提前决策的过滤器个数
+	};
+
+	/// @brief 日志器实现结构体
+	/// @details 成员按大小排列，小字段集中在末尾，减少填充
 	struct Logger::Impl
 	{
-		std::string name;					  ///< 日志器名称
-		std::atomic<LogLevel> level;		  ///< 当前日志级别
-		std::vector<AppenderPtr> appenders; ///< 输出目标列表
-		std::vector<FilterPtr> filters;	  ///< 过滤器列表
-		mutable std::mutex appenderMutex;	  ///< 输出器列表互斥锁
-		mutable std::mutex filterMutex;	  ///< 过滤器列表互斥锁
-		bool statisticsEnabled;	  ///< 是否启用统计功能
+		std::string name;							 ///< 日志器名称
+		std::vector<AppenderPtr> appenders;			 ///< 自身的输出目标列表
+		std::vector<AppenderPtr> effectiveAppenders; ///< 实际输出目标（含继承，已去重），记录日志时只遍历它
+		std::atomic<const FilterChain*> filterChain;	 ///< 过滤器链，没有过滤器时为空，读取期间需登记读者纪元
+		std::unique_ptr<const FilterChain> currentChain; ///< 持有当前过滤器链（受 listMutex 保护）
+		Utils::RetiredList<const FilterChain> retiredChains; ///< 可能仍有读者的旧过滤器链（受 listMutex 保护）
+		Pointer parent;								 ///< 父日志器
+		mutable std::mutex listMutex;				 ///< 输出器与过滤器列表互斥锁
+		std::atomic<uint32_t> statisticsId;			 ///< 统计用的日志器编号，首次记录时注册
+		uint32_t id;								 ///< 日志器编号，同时存在的日志器之间唯一
+		std::atomic<LogLevel> level;				 ///< 当前日志级别
+		std::atomic<bool> managed;					 ///< 是否由日志管理器管理
+		std::atomic<bool> hasFilters;				 ///< 是否有过滤器，没有时记录日志不读取过滤器链
+		bool additive;								 ///< 是否叠加父日志器的输出目标
+		bool statisticsEnabled;						 ///< 是否启用统计功能
 
 		/// @brief 构造函数
-		Impl()
-			: name(""), level(LogLevel::INFO), statisticsEnabled(false) {}
+		/// @param loggerName [IN] 日志器名称
+		/// @param loggerLevel [IN] 日志级别
+		Impl(const std::string& loggerName, LogLevel loggerLevel)
+			: name(loggerName), appenders(1, Logger::GetDefaultAppender()), effectiveAppenders(appenders),
+			  filterChain(nullptr), statisticsId(StatisticsManager::kInvalidLoggerId), id(RegisterLoggerName(loggerName)),
+			  level(loggerLevel), managed(false), hasFilters(false),
+			  additive(true), statisticsEnabled(false) {}
 	};
 
-	Logger::Logger(const std::string& name, LogLevel level)
-		: m_pImpl(new Impl)
+	const Logger::AppenderPtr& Logger::GetDefaultAppender()
 	{
-		m_pImpl->name = name;
-		m_pImpl->level.store(level);
+		// 每个日志器都持有一份引用，保证在最后一个日志器析构前默认输出器一直有效
+		// 先构造统计管理器，使它晚于默认输出器析构（输出器析构时会刷新并记录统计）
+		static const AppenderPtr instance = (StatisticsManager::GetInstance(), std::make_shared<ConsoleAppender>());
+		return instance;
+	}
 
-		// 默认添加一个控制台输出器
-		AppenderPtr consoleAppender = std::make_shared<ConsoleAppender>();
-		m_pImpl->appenders.push_back(consoleAppender);
+	Logger::Logger(const std::string& name, LogLevel level)
+		: m_pImpl(new Impl(name, level))
+	{
 	}
 
 	Logger::~Logger()
 	{
+		// 过滤器中尚未提交的说明（限流、去重摘要）在日志器析构前输出
+		FlushFilters(GetFiltersLocked());
+		ReleaseLoggerName(m_pImpl->id);
 		delete m_pImpl;
 	}
 
@@ -50,56 +190,274 @@ namespace IDLog
 		return m_pImpl->name;
 	}
 
+	uint32_t Logger::GetId() const
+	{
+		return m_pImpl->id;
+	}
+
+	std::string Logger::GetNameById(uint32_t id)
+	{
+		LoggerRegistry& registry = GetLoggerRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		return id < registry.names.size() ? registry.names[id] : std::string();
+	}
+
+	uint32_t Logger::GetIdGeneration(uint32_t id)
+	{
+		const std::atomic<uint32_t>* generation = FindGeneration(GetLoggerRegistry(), id);
+		return generation ? generation->load(std::memory_order_acquire) : 0;
+	}
+
 	LogLevel Logger::GetLevel() const
 	{
 		return m_pImpl->level.load();
 	}
 
 	void Logger::SetLevel(LogLevel level)
+	{
+		if (m_pImpl->managed.load())
+		{
+			// 由管理器记为单独设置的级别，避免被之后的规则或父级别变化覆盖
+			LoggerManager::GetInstance().SetExplicitLevel(*this, level);
+		}
+		else
+		{
+			StoreLevel(level);
+		}
+	}
+
+	void Logger::StoreLevel(LogLevel level)
 	{
 		m_pImpl->level.store(level);
 	}
 
+	bool Logger::IsLevelEnabled(LogLevel level) const
+	{
+		return ShouldLog(m_pImpl->level.load(std::memory_order_relaxed), level);
+	}
+
 	void Logger::AddAppender(const AppenderPtr& appender)
 	{
 		if (appender)
 		{
-			std::lock_guard<std::mutex> lock(m_pImpl->appenderMutex);
-			m_pImpl->appenders.push_back(appender);
+			StatisticsManager::GetInstance().RegisterAppender(appender);
+			{
+				std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+				m_pImpl->appenders.push_back(appender);
+			}
+			OnAppendersChanged();
 		}
 	}
 
 	void Logger::ClearAppenders()
 	{
-		std::lock_guard<std::mutex> lock(m_pImpl->appenderMutex);
-		m_pImpl->appenders.clear();
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+			m_pImpl->appenders.clear();
+		}
+		OnAppendersChanged();
 	}
 
 	std::vector<Logger::AppenderPtr> Logger::GetAppenders() const
 	{
-		std::lock_guard<std::mutex> lock(m_pImpl->appenderMutex);
+		std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
 		return m_pImpl->appenders;
 	}
 
+	std::vector<Logger::AppenderPtr> Logger::GetEffectiveAppenders() const
+	{
+		std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+		return m_pImpl->effectiveAppenders;
+	}
+
+	void Logger::SetAdditive(bool additive)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+			if (m_pImpl->additive == additive)
+			{
+				return;
+			}
+			m_pImpl->additive = additive;
+		}
+		OnAppendersChanged();
+	}
+
+	bool Logger::IsAdditive() const
+	{
+		std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+		return m_pImpl->additive;
+	}
+
+	Logger::Pointer Logger::GetParent() const
+	{
+		std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+		return m_pImpl->parent;
+	}
+
+	void Logger::SetParent(const Pointer& parent)
+	{
+		Pointer oldParent;
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+			oldParent.swap(m_pImpl->parent);
+			m_pImpl->parent = parent;
+		}
+		RebuildEffectiveAppenders();
+	}
+
+	void Logger::SetManaged(bool managed)
+	{
+		m_pImpl->managed.store(managed);
+	}
+
+	void Logger::RebuildEffectiveAppenders()
+	{
+		Pointer parent;
+		std::vector<AppenderPtr> effective;
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+			effective = m_pImpl->appenders;
+			if (m_pImpl->additive)
+			{
+				parent = m_pImpl->parent;
+			}
+		}
+
+		// 父日志器的实际输出目标已经包含了它的所有祖先，只需合并一层
+		if (parent)
+		{
+			for (const auto& appender : parent->GetEffectiveAppenders())
+			{
+				if (std::find(effective.begin(), effective.end(), appender) == effective.end())
+				{
+					effective.push_back(appender);
+				}
+			}
+		}
+
+		// 在锁外释放旧列表
+		std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+		m_pImpl->effectiveAppenders.swap(effective);
+	}
+
+	void Logger::OnAppendersChanged()
+	{
+		if (m_pImpl->managed.load())
+		{
+			// 由管理器按层次更新自身与整棵子树
+			LoggerManager::GetInstance().RebuildAppenders(*this);
+		}
+		else
+		{
+			RebuildEffectiveAppenders();
+		}
+	}
+
+	void Logger::SetAppenders(const std::vector<AppenderPtr>& appenders)
+	{
+		std::vector<AppenderPtr> newAppenders;
+		newAppenders.reserve(appenders.size());
+		for (const auto& appender : appenders)
+		{
+			if (appender)
+			{
+				StatisticsManager::GetInstance().RegisterAppender(appender);
+				newAppenders.push_back(appender);
+			}
+		}
+
+		// 在锁外释放旧列表，被替换的输出器析构（刷新、停止线程）不阻塞日志写入
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+			m_pImpl->appenders.swap(newAppenders);
+		}
+		OnAppendersChanged();
+	}
+
 	void Logger::AddFilter(const FilterPtr& filter)
 	{
 		if (filter)
 		{
-			std::lock_guard<std::mutex> lock(m_pImpl->filterMutex);
-			m_pImpl->filters.push_back(filter);
+			std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+			std::vector<FilterPtr> filters = GetFiltersLocked();
+			filters.push_back(filter);
+			PublishFilters(std::move(filters));
 		}
 	}
 
 	void Logger::ClearFilters()
 	{
-		std::lock_guard<std::mutex> lock(m_pImpl->filterMutex);
-		m_pImpl->filters.clear();
+		std::vector<FilterPtr> removed;
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+			removed = PublishFilters(std::vector<FilterPtr>());
+		}
+		FlushFilters(removed);
 	}
 
 	std::vector<Logger::FilterPtr> Logger::GetFilters() const
 	{
-		std::lock_guard<std::mutex> lock(m_pImpl->filterMutex);
-		return m_pImpl->filters;
+		std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+		return GetFiltersLocked();
+	}
+
+	void Logger::SetFilters(const std::vector<FilterPtr>& filters)
+	{
+		std::vector<FilterPtr> newFilters;
+		newFilters.reserve(filters.size());
+		for (const auto& filter : filters)
+		{
+			if (filter)
+			{
+				newFilters.push_back(filter);
+			}
+		}
+
+		std::vector<FilterPtr> removed;
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+			removed = PublishFilters(std::move(newFilters));
+		}
+		FlushFilters(removed);
+	}
+
+	std::vector<Logger::FilterPtr> Logger::GetFiltersLocked() const
+	{
+		return m_pImpl->currentChain ? m_pImpl->currentChain->filters : std::vector<FilterPtr>();
+	}
+
+	std::vector<Logger::FilterPtr> Logger::PublishFilters(std::vector<FilterPtr> filters)
+	{
+		std::vector<FilterPtr> removed;
+		for (const auto& filter : GetFiltersLocked())
+		{
+			if (std::find(filters.begin(), filters.end(), filter) == filters.end())
+			{
+				removed.push_back(filter);
+			}
+		}
+
+		std::unique_ptr<FilterChain> chain;
+		if (!filters.empty())
+		{
+			chain = std::make_unique<FilterChain>();
+			chain->filters = std::move(filters);
+			chain->preDecideCount = 0;
+			while (chain->preDecideCount < chain->filters.size() &&
+				   chain->filters[chain->preDecideCount]->CanPreDecide())
+			{
+				++chain->preDecideCount;
+			}
+		}
+		m_pImpl->filterChain.store(chain.get(), std::memory_order_seq_cst);
+		m_pImpl->hasFilters.store(chain != nullptr, std::memory_order_release);
+
+		// 旧链可能仍有读者，退役后等读者离开再释放
+		std::unique_ptr<const FilterChain> previous(std::move(chain));
+		previous.swap(m_pImpl->currentChain);
+		m_pImpl->retiredChains.Retire(std::move(previous));
+		return removed;
 	}
 
 	void Logger::EnableStatistics(bool enabled)
@@ -112,93 +470,146 @@ namespace IDLog
 		return m_pImpl->statisticsEnabled;
 	}
 
-	void Logger::Log(LogLevel level, const std::string& message,
+	void Logger::Log(LogLevel level, LogMessage message,
 		const SourceLocation& location)
 	{
-		// 记录开始时间
-		auto startTime = std::chrono::steady_clock::now();
-
 		// 检查是否需要记录
 		if (!ShouldLog(m_pImpl->level, level))
 		{
 			return;
 		}
 
-		// 创建日志事件
-		LogEventPtr event = std::make_shared<LogEvent>(level, GetName(), message, location);
-
-		// 应用过滤器
-		FilterDecision decision = ApplyFilters(event);
+		// 先应用不依赖日志事件的过滤器，被拒绝的日志不创建事件，也不读取时钟
+		const bool statisticsEnabled = m_pImpl->statisticsEnabled;
+		const size_t messageSize = message.View().size();
+		uint64_t startNs = 0;
+		FilterDecision decision = FilterDecision::ACCEPT;
+		LogEventPtr event;
+		if (m_pImpl->hasFilters.load(std::memory_order_acquire))
+		{
+			// 登记读者纪元期间过滤器链不会被释放
+			Utils::EpochReclaimer::ReaderGuard guard;
+			const FilterChain* chain = m_pImpl->filterChain.load(std::memory_order_seq_cst);
+			if (chain)
+			{
+				decision = PreApplyFilters(*chain, level, location);
+				if (decision == FilterDecision::NEUTRAL)
+				{
+					if (statisticsEnabled)
+					{
+						startNs = StatisticsManager::GetMonotonicNs();
+					}
+
+					// 创建日志事件（右值字符串被移动，之后不能再读取 message 的内容）
+					event = std::make_shared<LogEvent>(level, GetName(), message, location);
+
+					// 应用剩余的过滤器
+					decision = ApplyFilters(*chain, event);
+				}
+			}
+		}
 		if (decision == FilterDecision::DENY)
 		{
+			if (location.callSite && CallSiteProfiler::GetInstance().IsEnabled())
+			{
+				location.callSite->RecordDropped(messageSize);
+			}
+			AppendFilterNotices(location);
 			return; // 被拒绝，直接返回
 		}
+		if (!event)
+		{
+			// 记录开始时间（仅在启用统计时读取时钟）
+			if (statisticsEnabled)
+			{
+				startNs = StatisticsManager::GetMonotonicNs();
+			}
+			event = std::make_shared<LogEvent>(level, GetName(), message, location);
+		}
+
+		// 输出到所有实际输出目标（继承的输出目标已预先展开，不需要遍历父日志器）
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+			for (const auto& appender : m_pImpl->effectiveAppenders)
+			{
+				appender->Append(event);
+			}
+		}
+		AppendFilterNotices(location);
 
-		// 输出到所有附加的输出器
-		std::lock_guard<std::mutex> lock(m_pImpl->appenderMutex);
-		for (const auto& appender : m_pImpl->appenders)
+		// 记录调用点统计
+		if (location.callSite && CallSiteProfiler::GetInstance().IsEnabled())
 		{
-			appender->Append(event);
+			location.callSite->RecordEmitted(messageSize);
 		}
 
 		// 记录统计信息
-		if (m_pImpl->statisticsEnabled)
+		if (statisticsEnabled)
 		{
-			auto endTime = std::chrono::steady_clock::now();
-			auto waitTime = std::chrono::duration_cast<std::chrono::microseconds>(
-				endTime - startTime)
-				.count();
+			uint64_t latencyNs = StatisticsManager::GetMonotonicNs() - startNs;
 
-			StatisticsManager::GetInstance().RecordLog(
-				GetName(), level, message.size(), static_cast<uint64_t>(waitTime));
+			StatisticsManager& statsMgr = StatisticsManager::GetInstance();
+			uint32_t statsId = m_pImpl->statisticsId.load(std::memory_order_relaxed);
+			if (statsId == StatisticsManager::kInvalidLoggerId)
+			{
+				statsId = statsMgr.RegisterLogger(GetName());
+				m_pImpl->statisticsId.store(statsId, std::memory_order_relaxed);
+			}
+			statsMgr.RecordLog(statsId, level, messageSize, latencyNs);
 		}
 	}
 
-	void Logger::Trace(const std::string& message, const SourceLocation& location)
+	void Logger::Trace(LogMessage message, const SourceLocation& location)
 	{
 		Log(LogLevel::TRACE, message, location);
 	}
 
-	void Logger::Debug(const std::string& message, const SourceLocation& location)
+	void Logger::Debug(LogMessage message, const SourceLocation& location)
 	{
 		Log(LogLevel::DBG, message, location);
 	}
 
-	void Logger::Info(const std::string& message, const SourceLocation& location)
+	void Logger::Info(LogMessage message, const SourceLocation& location)
 	{
 		Log(LogLevel::INFO, message, location);
 	}
 
-	void Logger::Warn(const std::string& message, const SourceLocation& location)
+	void Logger::Warn(LogMessage message, const SourceLocation& location)
 	{
 		Log(LogLevel::WARN, message, location);
 	}
 
-	void Logger::Error(const std::string& message, const SourceLocation& location)
+	void Logger::Error(LogMessage message, const SourceLocation& location)
 	{
 		Log(LogLevel::ERR, message, location);
 	}
 
-	void Logger::Fatal(const std::string& message, const SourceLocation& location)
+	void Logger::Fatal(LogMessage message, const SourceLocation& location)
 	{
 		Log(LogLevel::FATAL, message, location);
 	}
 
-	FilterDecision Logger::ApplyFilters(const LogEventPtr& event) const
+	FilterDecision Logger::PreApplyFilters(const FilterChain& chain, LogLevel level, const SourceLocation& location) const
 	{
-		std::lock_guard<std::mutex> lock(m_pImpl->filterMutex);
-
-		// 没有过滤器，默认接受
-		if (m_pImpl->filters.empty())
+		for (size_t i = 0; i < chain.preDecideCount; ++i)
 		{
-			return FilterDecision::ACCEPT;
+			FilterDecision decision = chain.filters[i]->PreDecide(level, m_pImpl->id, location);
+			if (decision != FilterDecision::NEUTRAL)
+			{
+				return decision;
+			}
 		}
+		// 所有过滤器都已应用，默认接受；否则由剩余的过滤器决定
+		return chain.preDecideCount == chain.filters.size() ? FilterDecision::ACCEPT : FilterDecision::NEUTRAL;
+	}
 
-		// 依次应用过滤器
-		for (const auto& filter : m_pImpl->filters)
+	FilterDecision Logger::ApplyFilters(const FilterChain& chain, const LogEventPtr& event) const
+	{
+		// 从第一个不能提前决策的过滤器开始依次应用
+		for (size_t i = chain.preDecideCount; i < chain.filters.size(); ++i)
 		{
 			// 获取过滤决策
-			FilterDecision decision = filter->Decide(event);
+			FilterDecision decision = chain.filters[i]->Decide(event);
 			// 如果不是中立，直接返回决策结果
 			if (decision != FilterDecision::NEUTRAL)
 			{
@@ -208,4 +619,41 @@ namespace IDLog
 		return FilterDecision::ACCEPT;
 	}
 
+	void Logger::AppendFilterNotices(const SourceLocation& location)
+	{
+		std::vector<Filter::Notice> notices;
+		if (Filter::TakeNotices(notices))
+		{
+			WriteNotices(notices, location);
+		}
+	}
+
+	void Logger::FlushFilters(const std::vector<FilterPtr>& filters)
+	{
+		std::vector<Filter::Notice> notices;
+		for (const auto& filter : filters)
+		{
+			filter->Flush(notices);
+		}
+		if (!notices.empty())
+		{
+			WriteNotices(notices, SourceLocation());
+		}
+	}
+
+	void Logger::WriteNotices(std::vector<Filter::Notice>& notices, const SourceLocation& location)
+	{
+		// 说明不经过过滤器，直接输出到当前日志的输出目标
+		SourceLocation noticeLocation(location.fileName, location.functionName, location.lineNumber);
+		std::lock_guard<std::mutex> lock(m_pImpl->listMutex);
+		for (Filter::Notice& notice : notices)
+		{
+			LogEventPtr event = std::make_shared<LogEvent>(notice.level, m_pImpl->name, std::move(notice.message), noticeLocation);
+			for (const auto& appender : m_pImpl->effectiveAppenders)
+			{
+				appender->Append(event);
+			}
+		}
+	}
+
 } // namespace IDLog
\ No newline at end of file
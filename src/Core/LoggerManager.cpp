@@ -2,28 +2,408 @@
  * @Description: 日志管理器源文件
  * @Author: InverseDark
  * @Date: 2025-12-18 22:37:22
- * @LastEditTime: 2025-12-18 22:39:50
+ * @LastEditTime: 2026-10-19 11:52:20
  * @LastEditors: InverseDark
  */
 #include "IDLog/Core/LoggerManager.h"
+#include "IDLog/Core/Statistics.h"
+#include "IDLog/Utils/EpochReclaimer.h"
+#include "IDLog/Utils/StringUtil.h"
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace IDLog
 {
+	namespace
+	{
+		/// @brief 根日志器名称
+		const char *const kRootLoggerName = "ROOT";
+
+		/// @brief 日志器查找索引
+		/// @details 读取无锁的链式哈希表，供 GetLogger/HasLogger 查找已存在的日志器。
+		///			 只有一个写者（持有管理器互斥锁的线程）：插入时把新链节点原子地挂到桶头；
+		///			 删除时只给条目打上删除标记，删除标记超过存活条目数时才压缩成新表（均摊 O(1)）；
+		///			 扩容与压缩构建新表后原子地替换表指针。旧表可能仍被并发读者访问，
+		///			 退役时记下全局纪元，等所有读者都离开更早的纪元后再释放（条目随最后一张引用它的表释放）。
+		class LoggerIndex
+		{
+		public:
+			using LoggerPtr = Logger::Pointer;
+
+			LoggerIndex() { Publish(NewTable(kInitialBuckets)); }
+
+			LoggerIndex(const LoggerIndex &) = delete;
+			LoggerIndex &operator=(const LoggerIndex &) = delete;
+
+			/// @brief 查找日志器（无锁，可与写者并发）
+			/// @param name [IN] 日志器名称
+			/// @return 日志器，不存在时为空
+			LoggerPtr Find(const std::string &name) const
+			{
+				const size_t hash = std::hash<std::string>()(name);
+				Utils::EpochReclaimer::ReaderGuard guard;
+				const Table *table = m_table.load(std::memory_order_seq_cst);
+				const Entry *entry = FindIn(*table, hash, name);
+				return entry != nullptr ? entry->logger : LoggerPtr();
+			}
+
+			/// @brief 插入日志器（调用者持有写锁，且名称尚不存在）
+			/// @param name [IN] 日志器名称
+			/// @param logger [IN] 日志器
+			void Insert(const std::string &name, const LoggerPtr &logger)
+			{
+				auto entry = std::make_shared<Entry>();
+				entry->hash = std::hash<std::string>()(name);
+				entry->name = name;
+				entry->logger = logger;
+
+				Table *table = m_table.load(std::memory_order_relaxed);
+				if (++m_count + m_removed > table->mask + 1)
+				{
+					// 负载因子（含删除标记）超过1时重建：丢弃删除标记，存活条目仍超过桶数量时扩容一倍
+					size_t bucketCount = table->mask + 1;
+					if (m_count > bucketCount)
+					{
+						bucketCount *= 2;
+					}
+					Table *rebuilt = NewTable(bucketCount);
+					Rebuild(*table, *rebuilt);
+					Attach(*rebuilt, std::move(entry));
+					Publish(rebuilt);
+					return;
+				}
+				Attach(*table, std::move(entry));
+			}
+
+			/// @brief 删除日志器（调用者持有写锁）
+			/// @param name [IN] 日志器名称
+			void Remove(const std::string &name)
+			{
+				Table *table = m_table.load(std::memory_order_relaxed);
+				Entry *entry = FindIn(*table, std::hash<std::string>()(name), name);
+				if (entry == nullptr)
+				{
+					return;
+				}
+				entry->removed.store(true, std::memory_order_release);
+				--m_count;
+				if (++m_removed > std::max(m_count, kInitialBuckets))
+				{
+					Table *compacted = NewTable(table->mask + 1);
+					Rebuild(*table, *compacted);
+					Publish(compacted);
+				}
+			}
+
+			/// @brief 清空索引（调用者持有写锁）
+			void Clear()
+			{
+				m_count = 0;
+				Publish(NewTable(kInitialBuckets));
+			}
+
+		private:
+			static constexpr size_t kInitialBuckets = 64;
+
+			/// @brief 条目（发布后只会被打上删除标记）
+			struct Entry
+			{
+				size_t hash;					 ///< 名称哈希值
+				std::string name;				 ///< 日志器名称
+				LoggerPtr logger;				 ///< 日志器
+				std::atomic<bool> removed{false}; ///< 是否已删除
+			};
+
+			/// @brief 桶内链节点（发布后不再修改）
+			struct Link
+			{
+				Entry *entry;	  ///< 条目
+				const Link *next; ///< 下一个节点
+			};
+
+			/// @brief 哈希表
+			struct Table
+			{
+				size_t mask;											///< 桶数量减一（桶数量为2的幂）
+				std::unique_ptr<std::atomic<const Link *>[]> buckets; ///< 桶头指针
+				std::deque<Link> links;									///< 本表的链节点（地址稳定）
+				std::vector<std::shared_ptr<Entry>> entries;			///< 本表引用的条目
+			};
+
+			/// @brief 创建空表
+			/// @param bucketCount [IN] 桶数量，必须是2的幂
+			/// @return 新表（发布后由 m_current 持有）
+			static Table *NewTable(size_t bucketCount)
+			{
+				Table *table = new Table;
+				table->mask = bucketCount - 1;
+				table->buckets.reset(new std::atomic<const Link *>[bucketCount]);
+				for (size_t i = 0; i < bucketCount; ++i)
+				{
+					table->buckets[i].store(nullptr, std::memory_order_relaxed);
+				}
+				return table;
+			}
+
+			/// @brief 在表中查找未删除的条目
+			/// @param table [IN] 表
+			/// @param hash [IN] 名称哈希值
+			/// @param name [IN] 日志器名称
+			/// @return 条目，不存在时为空
+			static Entry *FindIn(const Table &table, size_t hash, const std::string &name)
+			{
+				for (const Link *link = table.buckets[hash & table.mask].load(std::memory_order_acquire);
+					 link != nullptr; link = link->next)
+				{
+					Entry *entry = link->entry;
+					if (entry->hash == hash && !entry->removed.load(std::memory_order_acquire) && entry->name == name)
+					{
+						return entry;
+					}
+				}
+				return nullptr;
+			}
+
+			/// @brief 把条目挂到表中对应桶的链头，先写好节点再发布
+			/// @param table [IN] 表
+			/// @param entry [IN] 条目
+			static void Attach(Table &table, std::shared_ptr<Entry> entry)
+			{
+				std::atomic<const Link *> &head = table.buckets[entry->hash & table.mask];
+				table.links.push_back({entry.get(), head.load(std::memory_order_relaxed)});
+				table.entries.push_back(std::move(entry));
+				head.store(&table.links.back(), std::memory_order_release);
+			}
+
+			/// @brief 把一张表中未删除的条目挂到另一张表
+			/// @param from [IN] 源表
+			/// @param to [IN] 目标表
+			static void Rebuild(const Table &from, Table &to)
+			{
+				for (const auto &entry : from.entries)
+				{
+					if (!entry->removed.load(std::memory_order_relaxed))
+					{
+						Attach(to, entry);
+					}
+				}
+			}
+
+			/// @brief 发布新表，之后的读者看到新表；旧表退役，释放已没有读者的退役表
+			/// @param table [IN] 新表
+			void Publish(Table *table)
+			{
+				m_table.store(table, std::memory_order_seq_cst);
+				std::unique_ptr<Table> previous(table);
+				previous.swap(m_current);
+				m_removed = 0;
+				if (previous)
+				{
+					m_retired.Retire(std::move(previous));
+				}
+			}
+
+		private:
+			std::atomic<Table *> m_table{nullptr};	///< 当前表
+			std::unique_ptr<Table> m_current;		///< 持有当前表
+			Utils::RetiredList<Table> m_retired;	///< 可能仍有读者的退役表
+			size_t m_count = 0;						///< 当前表中未删除的条目数
+			size_t m_removed = 0;					///< 当前表中带删除标记的条目数
+		};
+	} // namespace
+
 	/// @brief 日志管理器实现结构体
 	struct LoggerManager::Impl
 	{
-		LoggerPtr rootLogger;								///< 根日志器
-		std::unordered_map<std::string, LoggerPtr> loggers; ///< 日志器映射表
+		/// @brief 级别规则
+		struct LevelRule
+		{
+			std::string pattern; ///< 日志器名称或通配模式
+			LogLevel level;		 ///< 级别
+		};
+
+		LoggerPtr rootLogger;								  ///< 根日志器，创建后不再替换，GetRootLogger 无锁返回它的引用
+		LogLevel rootLevel = LogLevel::INFO;				  ///< 根日志级别
+		std::map<std::string, LoggerPtr> loggers;			  ///< 日志器映射表（有序，同一子树的日志器相邻）
+		LoggerIndex index;									  ///< 无锁查找索引，与 loggers 保持一致
+		std::unordered_map<std::string, LogLevel> levels;	  ///< 单独设置的级别，键为日志器名称（日志器可以尚未创建）
+		std::vector<LevelRule> rules;						  ///< 级别规则，按模式长度降序（越具体越靠前）
+
+		/// @brief 计算日志器的有效级别
+		/// @details 自身单独设置的级别 > 匹配自身名称的最具体规则 > 父日志器（按'.'截断名称）的有效级别 > 根日志级别
+		/// @param name [IN] 日志器名称
+		/// @return 有效级别
+		LogLevel ResolveLevel(const std::string &name) const
+		{
+			std::string current = name;
+			while (current != kRootLoggerName)
+			{
+				auto levelIt = levels.find(current);
+				if (levelIt != levels.end())
+				{
+					return levelIt->second;
+				}
+				for (const auto &rule : rules)
+				{
+					if (Utils::StringUtil::WildcardMatch(current, rule.pattern))
+					{
+						return rule.level;
+					}
+				}
+
+				size_t pos = current.find_last_of('.');
+				if (pos == std::string::npos)
+				{
+					break;
+				}
+				current.resize(pos);
+			}
+			return rootLevel;
+		}
+
+		/// @brief 重新计算并下发一棵子树的有效级别
+		/// @param name [IN] 子树根的日志器名称（可以尚未创建）
+		void PushDown(const std::string &name)
+		{
+			auto it = loggers.find(name);
+			if (it != loggers.end())
+			{
+				it->second->StoreLevel(ResolveLevel(name));
+			}
+
+			// 有序映射中 "name." 开头的键连续排列，只遍历这一段
+			const std::string prefix = name + ".";
+			for (it = loggers.lower_bound(prefix);
+				 it != loggers.end() && Utils::StringUtil::StartsWith(it->first, prefix); ++it)
+			{
+				it->second->StoreLevel(ResolveLevel(it->first));
+			}
+		}
+
+		/// @brief 重新计算并下发所有日志器的有效级别
+		void PushDownAll()
+		{
+			for (const auto &[loggerName, logger] : loggers)
+			{
+				logger->StoreLevel(ResolveLevel(loggerName));
+			}
+			if (rootLogger)
+			{
+				rootLogger->StoreLevel(rootLevel);
+			}
+		}
+
+		/// @brief 查找名称上最近的已创建祖先
+		/// @param name [IN] 日志器名称
+		/// @return 父日志器，没有时为根日志器（根日志器自身返回空）
+		LoggerPtr FindParent(const std::string &name) const
+		{
+			if (name == kRootLoggerName)
+			{
+				return nullptr;
+			}
+			std::string current = name;
+			size_t pos;
+			while ((pos = current.find_last_of('.')) != std::string::npos)
+			{
+				current.resize(pos);
+				auto it = loggers.find(current);
+				if (it != loggers.end())
+				{
+					return it->second;
+				}
+			}
+			return rootLogger;
+		}
+
+		/// @brief 重新链接一棵子树并展开实际输出目标
+		/// @details 有序映射中祖先总排在后代之前，按顺序处理即可保证父日志器先于子日志器完成
+		/// @param name [IN] 子树根的日志器名称（可以尚未创建或已被删除）
+		void Relink(const std::string &name)
+		{
+			if (name == kRootLoggerName)
+			{
+				RelinkAll();
+				return;
+			}
+
+			auto it = loggers.find(name);
+			if (it != loggers.end())
+			{
+				it->second->SetParent(FindParent(name));
+			}
+			const std::string prefix = name + ".";
+			for (it = loggers.lower_bound(prefix);
+				 it != loggers.end() && Utils::StringUtil::StartsWith(it->first, prefix); ++it)
+			{
+				it->second->SetParent(FindParent(it->first));
+			}
+		}
+
+		/// @brief 重新链接所有日志器并展开实际输出目标
+		void RelinkAll()
+		{
+			rootLogger->SetParent(nullptr);
+			for (const auto &[loggerName, logger] : loggers)
+			{
+				if (logger != rootLogger)
+				{
+					logger->SetParent(FindParent(loggerName));
+				}
+			}
+		}
+
+		/// @brief 按模式长度降序排列规则
+		void SortRules()
+		{
+			std::stable_sort(rules.begin(), rules.end(), [](const LevelRule &a, const LevelRule &b)
+							 { return a.pattern.size() > b.pattern.size(); });
+		}
+
+		/// @brief 重置为只有根日志器的初始状态
+		void Reset()
+		{
+			for (const auto &entry : loggers)
+			{
+				entry.second->SetManaged(false);
+			}
+			loggers.clear();
+			index.Clear();
+			levels.clear();
+			rules.clear();
+			rootLevel = LogLevel::INFO;
+			if (!rootLogger)
+			{
+				rootLogger = std::make_shared<Logger>(kRootLoggerName, rootLevel);
+			}
+			else
+			{
+				// 根日志器不替换，只恢复初始状态（此时不受管理，不会回调管理器）
+				rootLogger->SetAppenders({Logger::GetDefaultAppender()});
+				rootLogger->SetFilters({});
+				rootLogger->SetAdditive(true);
+				rootLogger->EnableStatistics(false);
+				rootLogger->StoreLevel(rootLevel);
+			}
+			rootLogger->SetManaged(true);
+			loggers[kRootLoggerName] = rootLogger;
+			index.Insert(kRootLoggerName, rootLogger);
+		}
 	};
 
 	LoggerManager::LoggerManager()
 		: m_pImpl(new Impl)
 	{
+		// 先构造统计管理器，使它晚于管理器析构：日志器释放的输出器析构时会刷新并记录统计
+		StatisticsManager::GetInstance();
 		// 创建根日志器
-		m_pImpl->rootLogger = std::make_shared<Logger>("ROOT");
-		m_pImpl->loggers["ROOT"] = m_pImpl->rootLogger;
+		m_pImpl->Reset();
 	}
 
 	LoggerManager::~LoggerManager()
@@ -39,101 +419,239 @@ namespace IDLog
 
 	LoggerManager::LoggerPtr LoggerManager::GetLogger(const std::string &name)
 	{
+		// 已存在的日志器无锁查找
+		if (LoggerPtr found = m_pImpl->index.Find(name))
+		{
+			return found;
+		}
+
 		std::lock_guard<std::mutex> lock(m_mutex);
 
-		// 查找已有的日志器
+		// 加锁后再查一次，其他线程可能刚创建
 		auto it = m_pImpl->loggers.find(name);
 		if (it != m_pImpl->loggers.end())
 		{
 			return it->second;
 		}
 
-		// 创建新的日志器
-		LoggerPtr newLogger = std::make_shared<Logger>(name);
+		// 创建新的日志器，级别取层次结构中的有效级别（父日志器无需已创建）
+		LoggerPtr newLogger = std::make_shared<Logger>(name, m_pImpl->ResolveLevel(name));
+		// 自身不带输出目标，从祖先继承（尚未受管理，只更新自身）
+		newLogger->SetAppenders({});
 
-		// 设置继承关系：如果有父级日志器，则继承其级别
-		size_t pos = name.find_last_of('.');
-		if (pos != std::string::npos)
+		// 存储新日志器，并把原先挂在祖先下的子日志器改挂到它下面
+		m_pImpl->loggers.emplace(name, newLogger);
+		m_pImpl->index.Insert(name, newLogger);
+		newLogger->SetManaged(true);
+		m_pImpl->Relink(name);
+		return newLogger;
+	}
+
+	void LoggerManager::AddLogger(const std::string &name, const LoggerPtr &logger)
+	{
+		if (!logger)
 		{
-			std::string parentName = name.substr(0, pos);
-			auto parentIt = m_pImpl->loggers.find(parentName);
-			if (parentIt != m_pImpl->loggers.end())
-			{
-				newLogger->SetLevel(parentIt->second->GetLevel());
-			}
+			return;
 		}
-		else
+		std::lock_guard<std::mutex> lock(m_mutex);
+		LoggerPtr &slot = m_pImpl->loggers[name];
+		if (slot && slot != logger)
 		{
-			// 没有父级，继承根日志器级别
-			newLogger->SetLevel(m_pImpl->rootLogger->GetLevel());
+			slot->SetManaged(false);
 		}
-		// 存储新日志器
-		m_pImpl->loggers[name] = newLogger;
-		return newLogger;
+		slot = logger;
+		// 替换已有日志器时重建索引中的条目
+		m_pImpl->index.Remove(name);
+		m_pImpl->index.Insert(name, logger);
+		logger->SetManaged(true);
+		m_pImpl->Relink(name);
 	}
 
-	void LoggerManager::AddLogger(const std::string &name, const LoggerPtr &logger)
+	void LoggerManager::RebuildAppenders(Logger &logger)
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
-		m_pImpl->loggers[name] = logger;
+		auto it = m_pImpl->loggers.find(logger.GetName());
+		if (it == m_pImpl->loggers.end() || it->second.get() != &logger)
+		{
+			// 以其他名称注册或已被移出管理器，只更新自身
+			logger.RebuildEffectiveAppenders();
+			return;
+		}
+		if (&logger == m_pImpl->rootLogger.get())
+		{
+			m_pImpl->RelinkAll();
+			return;
+		}
+		m_pImpl->Relink(it->first);
 	}
 
-	bool LoggerManager::HasLogger(const std::string &name)
+	void LoggerManager::SetExplicitLevel(Logger &logger, LogLevel level)
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
-		return m_pImpl->loggers.find(name) != m_pImpl->loggers.end();
+		if (&logger == m_pImpl->rootLogger.get())
+		{
+			m_pImpl->rootLevel = level;
+			m_pImpl->PushDownAll();
+			return;
+		}
+		auto it = m_pImpl->loggers.find(logger.GetName());
+		if (it == m_pImpl->loggers.end() || it->second.get() != &logger)
+		{
+			// 以其他名称注册或已被移出管理器，只更新自身
+			logger.StoreLevel(level);
+			return;
+		}
+		m_pImpl->levels[it->first] = level;
+		m_pImpl->PushDown(it->first);
+	}
+
+	bool LoggerManager::HasLogger(const std::string &name)
+	{
+		return m_pImpl->index.Find(name) != nullptr;
 	}
 
 	void LoggerManager::SetLoggerLevel(const std::string &name, LogLevel level)
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
-		auto it = m_pImpl->loggers.find(name);
-		if (it != m_pImpl->loggers.end())
+		if (name == kRootLoggerName)
 		{
-			it->second->SetLevel(level);
+			m_pImpl->rootLevel = level;
+			m_pImpl->PushDownAll();
+			return;
 		}
+		m_pImpl->levels[name] = level;
+		m_pImpl->PushDown(name);
 	}
 
-	void LoggerManager::RemoveLogger(const std::string &name)
+	void LoggerManager::ResetLoggerLevel(const std::string &name)
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
-		m_pImpl->loggers.erase(name);
+		if (m_pImpl->levels.erase(name) > 0)
+		{
+			m_pImpl->PushDown(name);
+		}
 	}
 
-	LoggerManager::LoggerPtr LoggerManager::GetRootLogger()
+	LogLevel LoggerManager::GetEffectiveLevel(const std::string &name)
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
-		return m_pImpl->rootLogger;
+		return m_pImpl->ResolveLevel(name);
 	}
 
-	void LoggerManager::SetRootLevel(LogLevel level)
+	void LoggerManager::SetLevelRule(const std::string &pattern, LogLevel level)
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
-		if (m_pImpl->rootLogger)
+		auto &rules = m_pImpl->rules;
+		auto it = std::find_if(rules.begin(), rules.end(), [&](const Impl::LevelRule &rule)
+							   { return rule.pattern == pattern; });
+		if (it != rules.end())
 		{
-			m_pImpl->rootLogger->SetLevel(level);
+			it->level = level;
 		}
+		else
+		{
+			rules.push_back({pattern, level});
+			m_pImpl->SortRules();
+		}
+		m_pImpl->PushDownAll();
+	}
+
+	bool LoggerManager::RemoveLevelRule(const std::string &pattern)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto &rules = m_pImpl->rules;
+		auto it = std::find_if(rules.begin(), rules.end(), [&](const Impl::LevelRule &rule)
+							   { return rule.pattern == pattern; });
+		if (it == rules.end())
+		{
+			return false;
+		}
+		rules.erase(it);
+		m_pImpl->PushDownAll();
+		return true;
+	}
+
+	void LoggerManager::SetLevelRules(const std::map<std::string, LogLevel> &rules)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pImpl->rules.clear();
+		for (const auto &[pattern, level] : rules)
+		{
+			m_pImpl->rules.push_back({pattern, level});
+		}
+		m_pImpl->SortRules();
+		m_pImpl->PushDownAll();
+	}
+
+	std::map<std::string, LogLevel> LoggerManager::GetLevelRules() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::map<std::string, LogLevel> rules;
+		for (const auto &rule : m_pImpl->rules)
+		{
+			rules[rule.pattern] = rule.level;
+		}
+		return rules;
+	}
+
+	void LoggerManager::RemoveLogger(const std::string &name)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_pImpl->loggers.find(name);
+		if (it == m_pImpl->loggers.end() || it->second == m_pImpl->rootLogger)
+		{
+			return;
+		}
+		it->second->SetManaged(false);
+		m_pImpl->loggers.erase(it);
+		m_pImpl->index.Remove(name);
+		// 子日志器改挂到更上层的祖先
+		m_pImpl->Relink(name);
+	}
+
+	const LoggerManager::LoggerPtr &LoggerManager::GetRootLogger()
+	{
+		// 根日志器在构造时创建后不再替换（Clear 只恢复它的初始状态），这里无需加锁
+		return m_pImpl->rootLogger;
+	}
+
+	void LoggerManager::SetRootLevel(LogLevel level)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pImpl->rootLevel = level;
+		m_pImpl->PushDownAll();
 	}
 
 	void LoggerManager::Clear()
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
-		m_pImpl->loggers.clear();
-		// 重新创建根日志器
-		m_pImpl->rootLogger = std::make_shared<Logger>("ROOT");
-		m_pImpl->loggers["ROOT"] = m_pImpl->rootLogger;
+		// 清空日志器与级别设置，重新创建根日志器
+		m_pImpl->Reset();
 	}
 
 	void LoggerManager::Shutdown()
 	{
-		std::lock_guard<std::mutex> lock(m_mutex);
+		std::map<std::string, LoggerPtr> loggers;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (auto &pair : m_pImpl->loggers)
+			{
+				pair.second->SetManaged(false);
+			}
+			loggers.swap(m_pImpl->loggers);
+			m_pImpl->index.Clear();
+			if (m_pImpl->rootLogger)
+			{
+				m_pImpl->rootLogger->SetManaged(false);
+			}
+		}
 
-		// 关闭所有普通 Logger
-		for (auto &pair : m_pImpl->loggers)
+		// 在锁外关闭所有普通 Logger（输出器析构可能刷新、停止线程），断开父链以释放继承的输出器
+		for (auto &pair : loggers)
 		{
+			pair.second->SetParent(nullptr);
 			pair.second->ClearAppenders();
 		}
-		m_pImpl->loggers.clear();
 
 		// 关闭 RootLogger
 		if (m_pImpl->rootLogger)
@@ -142,4 +660,4 @@ namespace IDLog
 		}
 	}
 
-} // namespace IDLog
\ No newline at end of file
+} // namespace IDLog
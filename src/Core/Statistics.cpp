@@ -2,12 +2,23 @@
  * @Description: 统计信息源文件
  * @Author: InverseDark
  * @Date: 2025-12-23 11:05:18
- * @LastEditTime: 2025-12-23 17:54:23
+ * @LastEditTime: 2026-10-19 12:24:10
  * @LastEditors: InverseDark
  */
 #include "IDLog/Core/Statistics.h"
-
+#include "IDLog/Core/CallSite.h"
+#include "IDLog/Core/StatsFile.h"
+#include "IDLog/Appender/LogAppender.h"
+#include "IDLog/Utils/ThreadUtil.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <memory>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace IDLog
 {
@@ -92,6 +103,11 @@ namespace IDLog
 		m_pImpl->count.fetch_sub(1, std::memory_order_relaxed);
 	}
 
+	void LevelStatistics::AddCount(uint64_t count)
+	{
+		m_pImpl->count.fetch_add(count, std::memory_order_relaxed);
+	}
+
 	void LevelStatistics::AddBytes(uint64_t bytes)
 	{
 		m_pImpl->bytes.fetch_add(bytes, std::memory_order_relaxed);
@@ -114,26 +130,103 @@ namespace IDLog
 		m_pImpl->maxMessageSize.store(0, std::memory_order_relaxed);
 	}
 
-	/// @brief 时间窗口实现结构体
-	struct TimeWindow::Impl
+	namespace
+	{
+		/// @brief 速率桶中计数所占的位数（低40位为计数，高24位为秒标签）
+		constexpr uint32_t kRateCountBits = 40;
+
+		/// @brief 速率桶计数掩码
+		constexpr uint64_t kRateCountMask = (uint64_t(1) << kRateCountBits) - 1;
+
+		/// @brief 速率桶秒标签掩码
+		constexpr uint64_t kRateTagMask = (uint64_t(1) << (64 - kRateCountBits)) - 1;
+
+		/// @brief 速率窗口统计的日志级别数量（TRACE ~ FATAL）
+		constexpr size_t kRateLevelCount = 6;
+
+		/// @brief 一个级别的速率桶环
+		using RateRing = std::atomic<uint64_t>[RateWindow::kSlotCount];
+
+		/// @brief 计算写入后的桶值：标签为当前秒时累加，否则从零开始（用掩码选择，无分支）
+		/// @param slot [IN] 桶的当前值
+		/// @param tag [IN] 当前秒的标签
+		/// @param delta [IN] 增量
+		/// @return 桶的新值
+		inline uint64_t AdvanceRateSlot(uint64_t slot, uint64_t tag, uint64_t delta)
+		{
+			uint64_t keep = uint64_t(0) - static_cast<uint64_t>((slot >> kRateCountBits) == tag);
+			return (tag << kRateCountBits) | (((slot & keep) + delta) & kRateCountMask);
+		}
+
+		/// @brief 汇总最近若干个完整秒的计数
+		/// @param ring [IN] 桶环
+		/// @param windowSeconds [IN] 窗口长度（秒）
+		/// @param nowSec [IN] 当前秒数
+		/// @return 计数之和
+		uint64_t SumRateRing(const RateRing& ring, uint32_t windowSeconds, uint64_t nowSec)
+		{
+			uint64_t window = std::min<uint64_t>(std::min<uint64_t>(windowSeconds, RateWindow::kMaxWindowSeconds), nowSec);
+			uint64_t sum = 0;
+			for (uint64_t sec = nowSec - window; sec < nowSec; ++sec)
+			{
+				uint64_t slot = ring[sec % RateWindow::kSlotCount].load(std::memory_order_relaxed);
+				if ((slot >> kRateCountBits) == (sec & kRateTagMask))
+				{
+					sum += slot & kRateCountMask;
+				}
+			}
+			return sum;
+		}
+
+		/// @brief 把桶环中最近 kSlotCount 秒内的桶合并到目标桶环（目标不能有并发写入）
+		/// @param source [IN] 源桶环
+		/// @param target [IN/OUT] 目标桶环
+		/// @param nowSec [IN] 当前秒数
+		void MergeRateRing(const RateRing& source, RateRing& target, uint64_t nowSec)
+		{
+			for (uint64_t i = 0; i < RateWindow::kSlotCount; ++i)
+			{
+				// 桶 i 在最近 kSlotCount 秒内对应的秒
+				uint64_t sec = nowSec - ((nowSec - i) % RateWindow::kSlotCount);
+				uint64_t tag = sec & kRateTagMask;
+				uint64_t slot = source[i].load(std::memory_order_relaxed);
+				if ((slot >> kRateCountBits) != tag || (slot & kRateCountMask) == 0)
+				{
+					continue;
+				}
+				uint64_t current = target[i].load(std::memory_order_relaxed);
+				target[i].store(AdvanceRateSlot(current, tag, slot & kRateCountMask), std::memory_order_relaxed);
+			}
+		}
+
+		/// @brief 日志级别转换为速率桶环序号，未知级别计入INFO
+		/// @param level [IN] 日志级别
+		/// @return 序号
+		inline size_t RateLevelIndex(LogLevel level)
+		{
+			size_t index = static_cast<size_t>(level);
+			return index < kRateLevelCount ? index : static_cast<size_t>(LogLevel::INFO);
+		}
+	} // namespace
+
+	/// @brief 速率窗口实现结构体
+	struct RateWindow::Impl
 	{
-		std::chrono::steady_clock::time_point startTime; ///< 窗口开始时间
-		uint64_t logsPerSecond; ///< 每秒日志数
-		uint64_t bytesPerSecond; ///< 每秒字节数
+		RateRing logs[kRateLevelCount];  ///< 各级别日志数桶环
+		RateRing bytes[kRateLevelCount]; ///< 各级别字节数桶环
 
 		/// @brief 构造函数
 		Impl()
-			: startTime(std::chrono::steady_clock::now()),
-			logsPerSecond(0), bytesPerSecond(0)
-		{}
+		{
+			Clear();
+		}
 
 		/// @brief 拷贝构造函数
 		/// @param other [IN] 另一个Impl对象
 		Impl(const Impl& other)
-			: startTime(other.startTime),
-			logsPerSecond(other.logsPerSecond),
-			bytesPerSecond(other.bytesPerSecond)
-		{}
+		{
+			CopyFrom(other);
+		}
 
 		/// @brief 拷贝赋值运算符
 		/// @param other [IN] 另一个Impl对象
@@ -142,30 +235,54 @@ namespace IDLog
 		{
 			if (this != &other)
 			{
-				startTime = other.startTime;
-				logsPerSecond = other.logsPerSecond;
-				bytesPerSecond = other.bytesPerSecond;
+				CopyFrom(other);
 			}
 			return *this;
 		}
 
+		/// @brief 复制所有桶
+		/// @param other [IN] 另一个Impl对象
+		void CopyFrom(const Impl& other)
+		{
+			for (size_t level = 0; level < kRateLevelCount; ++level)
+			{
+				for (uint32_t i = 0; i < kSlotCount; ++i)
+				{
+					logs[level][i].store(other.logs[level][i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+					bytes[level][i].store(other.bytes[level][i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/// @brief 清零所有桶
+		void Clear()
+		{
+			for (size_t level = 0; level < kRateLevelCount; ++level)
+			{
+				for (uint32_t i = 0; i < kSlotCount; ++i)
+				{
+					logs[level][i].store(0, std::memory_order_relaxed);
+					bytes[level][i].store(0, std::memory_order_relaxed);
+				}
+			}
+		}
 	};
 
-	TimeWindow::TimeWindow()
+	RateWindow::RateWindow()
 		: m_pImpl(new Impl)
 	{}
 
-	TimeWindow::~TimeWindow()
+	RateWindow::~RateWindow()
 	{
 		delete m_pImpl;
 	}
 
-	TimeWindow::TimeWindow(const TimeWindow& other)
+	RateWindow::RateWindow(const RateWindow& other)
 		: m_pImpl(new Impl(*other.m_pImpl))
 	{
 	}
 
-	TimeWindow& TimeWindow::operator=(const TimeWindow& other)
+	RateWindow& RateWindow::operator=(const RateWindow& other)
 	{
 		if (this != &other)
 		{
@@ -174,139 +291,115 @@ namespace IDLog
 		return *this;
 	}
 
-	std::chrono::steady_clock::time_point TimeWindow::GetStartTime() const
+	void RateWindow::Record(LogLevel level, uint64_t bytes, uint64_t nowSec)
 	{
-		return m_pImpl->startTime;
+		size_t index = RateLevelIndex(level);
+		size_t slotIndex = nowSec % kSlotCount;
+		uint64_t tag = nowSec & kRateTagMask;
+
+		// 单写者：relaxed 读+写，新值用掩码选择，没有循环和分支
+		std::atomic<uint64_t>& logSlot = m_pImpl->logs[index][slotIndex];
+		logSlot.store(AdvanceRateSlot(logSlot.load(std::memory_order_relaxed), tag, 1), std::memory_order_relaxed);
+		std::atomic<uint64_t>& byteSlot = m_pImpl->bytes[index][slotIndex];
+		byteSlot.store(AdvanceRateSlot(byteSlot.load(std::memory_order_relaxed), tag, bytes), std::memory_order_relaxed);
 	}
 
-	uint64_t TimeWindow::GetLogsPerSecond() const
+	void RateWindow::Merge(const RateWindow& other, uint64_t nowSec)
 	{
-		return m_pImpl->logsPerSecond;
+		for (size_t level = 0; level < kRateLevelCount; ++level)
+		{
+			MergeRateRing(other.m_pImpl->logs[level], m_pImpl->logs[level], nowSec);
+			MergeRateRing(other.m_pImpl->bytes[level], m_pImpl->bytes[level], nowSec);
+		}
 	}
 
-	uint64_t TimeWindow::GetBytesPerSecond() const
+	void RateWindow::Reset()
 	{
-		return m_pImpl->bytesPerSecond;
+		m_pImpl->Clear();
 	}
 
-	void TimeWindow::SetStartTime(const std::chrono::steady_clock::time_point& timePoint)
+	uint64_t RateWindow::GetLogCount(uint32_t windowSeconds, uint64_t nowSec) const
 	{
-		m_pImpl->startTime = timePoint;
+		uint64_t sum = 0;
+		for (size_t level = 0; level < kRateLevelCount; ++level)
+		{
+			sum += SumRateRing(m_pImpl->logs[level], windowSeconds, nowSec);
+		}
+		return sum;
 	}
 
-	void TimeWindow::SetLogsPerSecond(uint64_t logsPerSecond)
+	uint64_t RateWindow::GetLogCount(LogLevel level, uint32_t windowSeconds, uint64_t nowSec) const
 	{
-		m_pImpl->logsPerSecond = logsPerSecond;
+		return SumRateRing(m_pImpl->logs[RateLevelIndex(level)], windowSeconds, nowSec);
 	}
 
-	void TimeWindow::SetBytesPerSecond(uint64_t bytesPerSecond)
+	uint64_t RateWindow::GetByteCount(uint32_t windowSeconds, uint64_t nowSec) const
 	{
-		m_pImpl->bytesPerSecond = bytesPerSecond;
+		uint64_t sum = 0;
+		for (size_t level = 0; level < kRateLevelCount; ++level)
+		{
+			sum += SumRateRing(m_pImpl->bytes[level], windowSeconds, nowSec);
+		}
+		return sum;
 	}
 
-	void TimeWindow::Reset()
+	uint64_t RateWindow::GetByteCount(LogLevel level, uint32_t windowSeconds, uint64_t nowSec) const
 	{
-		m_pImpl->startTime = std::chrono::steady_clock::now();
-		m_pImpl->logsPerSecond = 0;
-		m_pImpl->bytesPerSecond = 0;
+		return SumRateRing(m_pImpl->bytes[RateLevelIndex(level)], windowSeconds, nowSec);
 	}
 
-	/// @brief 日志统计信息实现结构体
-	struct LogStatistics::Impl
+	double RateWindow::GetLogsPerSecond(uint32_t windowSeconds) const
 	{
-		LevelStatistics trace; ///< TRACE级别统计
-		LevelStatistics debug; ///< DEBUG级别统计
-		LevelStatistics info;  ///< INFO级别统计
-		LevelStatistics warn;  ///< WARN级别统计
-		LevelStatistics error; ///< ERROR级别统计
-		LevelStatistics fatal; ///< FATAL级别统计
-
-		/// 全局统计信息
-		std::atomic<uint64_t> totalLogs; ///< 总日志数量
-		std::atomic<uint64_t> totalBytes; ///< 总日志字节数
-		std::atomic<uint64_t> droppedLogs; ///< 丢弃的日志数量
-		std::atomic<uint64_t> droppedBytes; ///< 丢弃的日志字节数
+		uint32_t window = std::min(std::max(windowSeconds, 1u), kMaxWindowSeconds);
+		return static_cast<double>(GetLogCount(window)) / window;
+	}
 
-		/// 性能统计信息
-		std::atomic<uint64_t> totalWaitTimeUs; ///< 总等待时间（微秒）
-		std::atomic<uint64_t> maxWaitTimeUs; ///< 最大等待时间（微秒）
+	double RateWindow::GetLogsPerSecond(LogLevel level, uint32_t windowSeconds) const
+	{
+		uint32_t window = std::min(std::max(windowSeconds, 1u), kMaxWindowSeconds);
+		return static_cast<double>(GetLogCount(level, window)) / window;
+	}
 
-		mutable std::mutex timeWindowMutex; ///< 互斥锁，保护时间窗口数据
-		TimeWindow timeWindow; ///< 当前时间窗口
-		TimeWindow lastTimeWindow; ///< 上一个时间窗口
+	double RateWindow::GetBytesPerSecond(uint32_t windowSeconds) const
+	{
+		uint32_t window = std::min(std::max(windowSeconds, 1u), kMaxWindowSeconds);
+		return static_cast<double>(GetByteCount(window)) / window;
+	}
 
-		/// @brief 构造函数
-		Impl()
-			: totalLogs(0),
-			totalBytes(0),
-			droppedLogs(0),
-			droppedBytes(0),
-			totalWaitTimeUs(0),
-			maxWaitTimeUs(0)
-		{}
+	double RateWindow::GetBytesPerSecond(LogLevel level, uint32_t windowSeconds) const
+	{
+		uint32_t window = std::min(std::max(windowSeconds, 1u), kMaxWindowSeconds);
+		return static_cast<double>(GetByteCount(level, window)) / window;
+	}
 
-		/// @brief 拷贝构造函数
-		/// @param other [IN] 另一个Impl对象
-		Impl(const Impl& other)
-			: trace(other.trace),
-			debug(other.debug),
-			info(other.info),
-			warn(other.warn),
-			error(other.error),
-			fatal(other.fatal),
-			totalLogs(other.totalLogs.load()),
-			totalBytes(other.totalBytes.load()),
-			droppedLogs(other.droppedLogs.load()),
-			droppedBytes(other.droppedBytes.load()),
-			totalWaitTimeUs(other.totalWaitTimeUs.load()),
-			maxWaitTimeUs(other.maxWaitTimeUs.load()),
-			timeWindowMutex(),
-			timeWindow(other.timeWindow),
-			lastTimeWindow(other.lastTimeWindow)
-		{}
+	/// @brief 延迟直方图实现结构体
+	struct LatencyHistogram::Impl
+	{
+		uint64_t buckets[kBucketCount]; ///< 各桶计数
+		uint64_t count;				   ///< 记录的值数量
+		uint64_t sum;				   ///< 值的总和（纳秒）
+		uint64_t max;				   ///< 最大值（纳秒）
 
-		/// @brief 拷贝赋值运算符
-		/// @param other [IN] 另一个Impl对象
-		/// @return 当前对象引用
-		Impl& operator=(const Impl& other)
-		{
-			if (this != &other)
-			{
-				trace = other.trace;
-				debug = other.debug;
-				info = other.info;
-				warn = other.warn;
-				error = other.error;
-				fatal = other.fatal;
-				totalLogs.store(other.totalLogs.load());
-				totalBytes.store(other.totalBytes.load());
-				droppedLogs.store(other.droppedLogs.load());
-				droppedBytes.store(other.droppedBytes.load());
-				totalWaitTimeUs.store(other.totalWaitTimeUs.load());
-				maxWaitTimeUs.store(other.maxWaitTimeUs.load());
-				timeWindow = other.timeWindow;
-				lastTimeWindow = other.lastTimeWindow;
-			}
-			return *this;
-		}
+		/// @brief 构造函数
+		Impl() : buckets{}, count(0), sum(0), max(0) {}
 	};
 
-	LogStatistics::LogStatistics()
+	LatencyHistogram::LatencyHistogram()
 		: m_pImpl(new Impl)
 	{
 	}
 
-	LogStatistics::~LogStatistics()
+	LatencyHistogram::~LatencyHistogram()
 	{
 		delete m_pImpl;
 	}
 
-	LogStatistics::LogStatistics(const LogStatistics& other)
+	LatencyHistogram::LatencyHistogram(const LatencyHistogram& other)
 		: m_pImpl(new Impl(*other.m_pImpl))
 	{
 	}
 
-	LogStatistics& LogStatistics::operator=(const LogStatistics& other)
+	LatencyHistogram& LatencyHistogram::operator=(const LatencyHistogram& other)
 	{
 		if (this != &other)
 		{
@@ -315,150 +408,663 @@ namespace IDLog
 		return *this;
 	}
 
-	void LogStatistics::Reset()
-	{
-		m_pImpl->trace.Reset();
-		m_pImpl->debug.Reset();
-		m_pImpl->info.Reset();
-		m_pImpl->warn.Reset();
-		m_pImpl->error.Reset();
-		m_pImpl->fatal.Reset();
-
-		m_pImpl->totalLogs.store(0);
-		m_pImpl->totalBytes.store(0);
-		m_pImpl->droppedLogs.store(0);
-		m_pImpl->droppedBytes.store(0);
-
-		m_pImpl->totalWaitTimeUs.store(0);
-		m_pImpl->maxWaitTimeUs.store(0);
-
-		std::lock_guard<std::mutex> lock(m_pImpl->timeWindowMutex);
-		m_pImpl->timeWindow.Reset();
-		m_pImpl->lastTimeWindow.Reset();
-	}
-
-	LevelStatistics& LogStatistics::GetLevelStatistics(LogLevel level)
+	void LatencyHistogram::Record(uint64_t valueNs)
 	{
-		switch (level)
+		++m_pImpl->buckets[GetBucketIndex(valueNs)];
+		++m_pImpl->count;
+		m_pImpl->sum += valueNs;
+		if (valueNs > m_pImpl->max)
 		{
-		case LogLevel::TRACE:
-			return m_pImpl->trace;
-		case LogLevel::DBG:
-			return m_pImpl->debug;
-		case LogLevel::INFO:
-			return m_pImpl->info;
-		case LogLevel::WARN:
-			return m_pImpl->warn;
-		case LogLevel::ERR:
-			return m_pImpl->error;
-		case LogLevel::FATAL:
-			return m_pImpl->fatal;
-		default:
-			return m_pImpl->info; // 默认返回info级别统计
+			m_pImpl->max = valueNs;
 		}
 	}
 
-	const LevelStatistics& LogStatistics::GetLevelStatistics(LogLevel level) const
+	void LatencyHistogram::Merge(const LatencyHistogram& other)
 	{
-		switch (level)
+		for (size_t i = 0; i < kBucketCount; ++i)
 		{
-		case LogLevel::TRACE:
-			return m_pImpl->trace;
-		case LogLevel::DBG:
-			return m_pImpl->debug;
-		case LogLevel::INFO:
-			return m_pImpl->info;
-		case LogLevel::WARN:
-			return m_pImpl->warn;
-		case LogLevel::ERR:
-			return m_pImpl->error;
-		case LogLevel::FATAL:
-			return m_pImpl->fatal;
-		default:
-			return m_pImpl->info; // 默认返回info级别统计
+			m_pImpl->buckets[i] += other.m_pImpl->buckets[i];
+		}
+		m_pImpl->count += other.m_pImpl->count;
+		m_pImpl->sum += other.m_pImpl->sum;
+		if (other.m_pImpl->max > m_pImpl->max)
+		{
+			m_pImpl->max = other.m_pImpl->max;
 		}
 	}
 
-	uint64_t LogStatistics::GetTotalLogs() const
+	void LatencyHistogram::Reset()
 	{
-		return m_pImpl->totalLogs.load(std::memory_order_relaxed);
+		*m_pImpl = Impl();
 	}
 
-	uint64_t LogStatistics::GetTotalBytes() const
+	uint64_t LatencyHistogram::GetCount() const
 	{
-		return m_pImpl->totalBytes.load(std::memory_order_relaxed);
+		return m_pImpl->count;
 	}
 
-	uint64_t LogStatistics::GetDroppedLogs() const
+	uint64_t LatencyHistogram::GetMax() const
 	{
-		return m_pImpl->droppedLogs.load(std::memory_order_relaxed);
+		return m_pImpl->max;
 	}
 
-	uint64_t LogStatistics::GetDroppedBytes() const
+	uint64_t LatencyHistogram::GetMean() const
 	{
-		return m_pImpl->droppedBytes.load(std::memory_order_relaxed);
+		return m_pImpl->count ? m_pImpl->sum / m_pImpl->count : 0;
 	}
 
-	void LogStatistics::RecordLog(LogLevel level, size_t messageSize, uint64_t waitTimeUs)
+	uint64_t LatencyHistogram::GetPercentile(double percentile) const
 	{
-		// 更新级别统计
-		LevelStatistics& levelStats = GetLevelStatistics(level);
-		levelStats.IncrementCount();
-		levelStats.AddBytes(messageSize);
+		if (m_pImpl->count == 0)
+		{
+			return 0;
+		}
+		if (percentile >= 100.0)
+		{
+			return m_pImpl->max;
+		}
 
-		// 更新最大消息大小
-		if (messageSize > 0)
+		// 目标名次向上取整，至少为1
+		uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(m_pImpl->count) + 0.999999);
+		if (rank == 0)
 		{
-			levelStats.UpdateMaxMessageSize(messageSize);
+			rank = 1;
+		}
+		uint64_t seen = 0;
+		for (size_t i = 0; i < kBucketCount; ++i)
+		{
+			seen += m_pImpl->buckets[i];
+			if (seen >= rank)
+			{
+				return std::min(GetBucketUpperBound(i), m_pImpl->max);
+			}
 		}
+		return m_pImpl->max;
+	}
 
-		// 更新全局统计
-		m_pImpl->totalLogs.fetch_add(1, std::memory_order_relaxed);
-		m_pImpl->totalBytes.fetch_add(messageSize, std::memory_order_relaxed);
+	std::string LatencyHistogram::ToJson() const
+	{
+		std::stringstream ss;
+		ss << "{\"count\":" << GetCount()
+		   << ",\"p50\":" << GetPercentile(50.0)
+		   << ",\"p90\":" << GetPercentile(90.0)
+		   << ",\"p99\":" << GetPercentile(99.0)
+		   << ",\"p999\":" << GetPercentile(99.9)
+		   << ",\"max\":" << GetMax() << "}";
+		return ss.str();
+	}
 
-		// 更新等待时间统计
-		if (waitTimeUs > 0)
+	std::string LatencyHistogram::ToString() const
+	{
+		std::stringstream ss;
+		ss << "count=" << GetCount()
+		   << ", p50=" << GetPercentile(50.0) << "ns"
+		   << ", p90=" << GetPercentile(90.0) << "ns"
+		   << ", p99=" << GetPercentile(99.0) << "ns"
+		   << ", p99.9=" << GetPercentile(99.9) << "ns"
+		   << ", max=" << GetMax() << "ns";
+		return ss.str();
+	}
+
+	size_t LatencyHistogram::GetBucketIndex(uint64_t valueNs)
+	{
+		constexpr uint64_t kSubBucketCount = uint64_t(1) << kSubBucketBits;
+		constexpr uint64_t kMaxTrackable = (uint64_t(1) << kMaxValueBits) - 1;
+		if (valueNs < 2 * kSubBucketCount)
 		{
-			m_pImpl->totalWaitTimeUs.fetch_add(waitTimeUs, std::memory_order_relaxed);
-			UpdateMax(m_pImpl->maxWaitTimeUs, waitTimeUs);
+			return static_cast<size_t>(valueNs);
+		}
+		if (valueNs > kMaxTrackable)
+		{
+			valueNs = kMaxTrackable;
 		}
 
-		// 更新时间窗口
-		UpdateTimeWindow();
+		// 最高位决定段号，紧随其后的 kSubBucketBits 位决定段内子桶
+		uint32_t msb = 63;
+		while ((valueNs >> msb) == 0)
+		{
+			--msb;
+		}
+		uint32_t shift = msb - kSubBucketBits;
+		uint64_t sub = valueNs >> shift; // 位于 [kSubBucketCount, 2 * kSubBucketCount)
+		return static_cast<size_t>(2 * kSubBucketCount + (shift - 1) * kSubBucketCount + (sub - kSubBucketCount));
 	}
 
-	void LogStatistics::RecordDroppedLog(size_t messageSize)
+	uint64_t LatencyHistogram::GetBucketUpperBound(size_t index)
 	{
-		m_pImpl->droppedLogs.fetch_add(1, std::memory_order_relaxed);
-		m_pImpl->droppedBytes.fetch_add(messageSize, std::memory_order_relaxed);
+		constexpr uint64_t kSubBucketCount = uint64_t(1) << kSubBucketBits;
+		if (index < 2 * kSubBucketCount)
+		{
+			return index;
+		}
+		uint64_t offset = index - 2 * kSubBucketCount;
+		uint64_t shift = offset / kSubBucketCount + 1;
+		uint64_t sub = offset % kSubBucketCount + kSubBucketCount;
+		return ((sub + 1) << shift) - 1;
 	}
 
-	void LogStatistics::UpdateTimeWindow()
+	/// @brief 输出器指标实现结构体
+	struct AppenderMetrics::Impl
 	{
-		std::lock_guard<std::mutex> lock(m_pImpl->timeWindowMutex);
+		std::atomic<uint64_t> records;					///< 写出的记录数
+		std::atomic<uint64_t> bytes;					///< 写出的字节数
+		std::atomic<uint64_t> writeCalls;				///< 写调用次数
+		std::atomic<uint64_t> writeErrors;				///< 写入错误次数
+		std::atomic<uint64_t> flushes;					///< 刷新次数
+		std::atomic<uint64_t> rollCount;				///< 滚动次数
+		std::atomic<uint64_t> totalRollTimeNs;			///< 滚动总耗时（纳秒）
+		std::atomic<uint64_t> maxRollTimeNs;			///< 单次滚动最大耗时（纳秒）
+		std::atomic<uint64_t> queueHighWaterMark;		///< 队列深度最高水位
+		std::atomic<uint64_t> dropped[kDropPolicyCount]; ///< 各溢出策略下丢弃的日志数
+		mutable std::mutex flushMutex;					///< 互斥锁，保护刷新耗时直方图
+		LatencyHistogram flushLatency;					///< 刷新耗时直方图
 
-		auto now = std::chrono::steady_clock::now();
-		auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - m_pImpl->timeWindow.GetStartTime()).count();
+		/// @brief 构造函数
+		Impl()
+		{
+			Clear();
+		}
 
-		// 每秒钟更新一次时间窗口统计
-		if (elapsed >= 1)
+		/// @brief 拷贝构造函数
+		/// @param other [IN] 另一个Impl对象
+		Impl(const Impl& other)
 		{
-			// 更新时间窗口
-			m_pImpl->lastTimeWindow = m_pImpl->timeWindow;
-			m_pImpl->timeWindow.Reset();
+			CopyFrom(other);
+		}
 
-			// 计算当前时间窗口的日志速率
-			if (elapsed > 0)
+		/// @brief 拷贝赋值运算符
+		/// @param other [IN] 另一个Impl对象
+		/// @return 当前对象引用
+		Impl& operator=(const Impl& other)
+		{
+			if (this != &other)
 			{
-				m_pImpl->lastTimeWindow.SetLogsPerSecond(m_pImpl->totalLogs.load(std::memory_order_relaxed) / elapsed);
-				m_pImpl->lastTimeWindow.SetBytesPerSecond(m_pImpl->totalBytes.load(std::memory_order_relaxed) / elapsed);
+				CopyFrom(other);
 			}
+			return *this;
 		}
-	}
 
-	std::string LogStatistics::ToString() const
-	{
-		std::stringstream ss;
+		/// @brief 复制所有指标
+		/// @param other [IN] 另一个Impl对象
+		void CopyFrom(const Impl& other)
+		{
+			records.store(other.records.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			bytes.store(other.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			writeCalls.store(other.writeCalls.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			writeErrors.store(other.writeErrors.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			flushes.store(other.flushes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			rollCount.store(other.rollCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			totalRollTimeNs.store(other.totalRollTimeNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			maxRollTimeNs.store(other.maxRollTimeNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			queueHighWaterMark.store(other.queueHighWaterMark.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			for (size_t i = 0; i < kDropPolicyCount; ++i)
+			{
+				dropped[i].store(other.dropped[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+			LatencyHistogram histogram;
+			{
+				std::lock_guard<std::mutex> lock(other.flushMutex);
+				histogram = other.flushLatency;
+			}
+			std::lock_guard<std::mutex> lock(flushMutex);
+			flushLatency = histogram;
+		}
+
+		/// @brief 清零所有指标
+		void Clear()
+		{
+			records.store(0, std::memory_order_relaxed);
+			bytes.store(0, std::memory_order_relaxed);
+			writeCalls.store(0, std::memory_order_relaxed);
+			writeErrors.store(0, std::memory_order_relaxed);
+			flushes.store(0, std::memory_order_relaxed);
+			rollCount.store(0, std::memory_order_relaxed);
+			totalRollTimeNs.store(0, std::memory_order_relaxed);
+			maxRollTimeNs.store(0, std::memory_order_relaxed);
+			queueHighWaterMark.store(0, std::memory_order_relaxed);
+			for (auto& count : dropped)
+			{
+				count.store(0, std::memory_order_relaxed);
+			}
+			std::lock_guard<std::mutex> lock(flushMutex);
+			flushLatency.Reset();
+		}
+	};
+
+	AppenderMetrics::AppenderMetrics()
+		: m_pImpl(new Impl)
+	{
+	}
+
+	AppenderMetrics::~AppenderMetrics()
+	{
+		delete m_pImpl;
+	}
+
+	AppenderMetrics::AppenderMetrics(const AppenderMetrics& other)
+		: m_pImpl(new Impl(*other.m_pImpl))
+	{
+	}
+
+	AppenderMetrics& AppenderMetrics::operator=(const AppenderMetrics& other)
+	{
+		if (this != &other)
+		{
+			*m_pImpl = *other.m_pImpl;
+		}
+		return *this;
+	}
+
+	void AppenderMetrics::AddRecords(uint64_t records, uint64_t bytes)
+	{
+		m_pImpl->records.fetch_add(records, std::memory_order_relaxed);
+		m_pImpl->bytes.fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+	void AppenderMetrics::AddWriteCalls(uint64_t calls)
+	{
+		m_pImpl->writeCalls.fetch_add(calls, std::memory_order_relaxed);
+	}
+
+	void AppenderMetrics::AddWriteErrors(uint64_t errors)
+	{
+		m_pImpl->writeErrors.fetch_add(errors, std::memory_order_relaxed);
+	}
+
+	void AppenderMetrics::RecordFlush(uint64_t latencyNs)
+	{
+		m_pImpl->flushes.fetch_add(1, std::memory_order_relaxed);
+		std::lock_guard<std::mutex> lock(m_pImpl->flushMutex);
+		m_pImpl->flushLatency.Record(latencyNs);
+	}
+
+	void AppenderMetrics::RecordRoll(uint64_t durationNs)
+	{
+		m_pImpl->rollCount.fetch_add(1, std::memory_order_relaxed);
+		m_pImpl->totalRollTimeNs.fetch_add(durationNs, std::memory_order_relaxed);
+		LogStatistics::UpdateMax(m_pImpl->maxRollTimeNs, durationNs);
+	}
+
+	void AppenderMetrics::UpdateQueueHighWaterMark(uint64_t depth)
+	{
+		LogStatistics::UpdateMax(m_pImpl->queueHighWaterMark, depth);
+	}
+
+	void AppenderMetrics::AddDropped(size_t policyIndex, uint64_t count)
+	{
+		if (policyIndex < kDropPolicyCount)
+		{
+			m_pImpl->dropped[policyIndex].fetch_add(count, std::memory_order_relaxed);
+		}
+	}
+
+	void AppenderMetrics::Reset()
+	{
+		m_pImpl->Clear();
+	}
+
+	uint64_t AppenderMetrics::GetRecords() const
+	{
+		return m_pImpl->records.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AppenderMetrics::GetBytes() const
+	{
+		return m_pImpl->bytes.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AppenderMetrics::GetWriteCalls() const
+	{
+		return m_pImpl->writeCalls.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AppenderMetrics::GetWriteErrors() const
+	{
+		return m_pImpl->writeErrors.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AppenderMetrics::GetFlushes() const
+	{
+		return m_pImpl->flushes.load(std::memory_order_relaxed);
+	}
+
+	LatencyHistogram AppenderMetrics::GetFlushLatency() const
+	{
+		std::lock_guard<std::mutex> lock(m_pImpl->flushMutex);
+		return m_pImpl->flushLatency;
+	}
+
+	uint64_t AppenderMetrics::GetRollCount() const
+	{
+		return m_pImpl->rollCount.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AppenderMetrics::GetTotalRollTimeNs() const
+	{
+		return m_pImpl->totalRollTimeNs.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AppenderMetrics::GetMaxRollTimeNs() const
+	{
+		return m_pImpl->maxRollTimeNs.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AppenderMetrics::GetQueueHighWaterMark() const
+	{
+		return m_pImpl->queueHighWaterMark.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AppenderMetrics::GetDropped(size_t policyIndex) const
+	{
+		return policyIndex < kDropPolicyCount ? m_pImpl->dropped[policyIndex].load(std::memory_order_relaxed) : 0;
+	}
+
+	uint64_t AppenderMetrics::GetTotalDropped() const
+	{
+		uint64_t total = 0;
+		for (const auto& count : m_pImpl->dropped)
+		{
+			total += count.load(std::memory_order_relaxed);
+		}
+		return total;
+	}
+
+	std::string AppenderMetrics::ToString() const
+	{
+		std::stringstream ss;
+		ss << "  Records: " << GetRecords() << ", Bytes: " << GetBytes() << "\n";
+		ss << "  Write Calls: " << GetWriteCalls() << ", Write Errors: " << GetWriteErrors() << "\n";
+		ss << "  Flushes: " << GetFlushes();
+		LatencyHistogram flushLatency = GetFlushLatency();
+		if (flushLatency.GetCount() > 0)
+		{
+			ss << " (" << flushLatency.ToString() << ")";
+		}
+		ss << "\n";
+		if (GetRollCount() > 0)
+		{
+			ss << "  Rolls: " << GetRollCount() << ", Total Roll Time: " << GetTotalRollTimeNs()
+			   << " ns, Max Roll Time: " << GetMaxRollTimeNs() << " ns\n";
+		}
+		if (GetQueueHighWaterMark() > 0 || GetTotalDropped() > 0)
+		{
+			ss << "  Queue High Water Mark: " << GetQueueHighWaterMark() << "\n";
+			ss << "  Dropped: BLOCK=" << GetDropped(0) << ", DROP_OLDEST=" << GetDropped(1)
+			   << ", DROP_NEWEST=" << GetDropped(2) << "\n";
+		}
+		return ss.str();
+	}
+
+	std::string AppenderMetrics::ToJson() const
+	{
+		std::stringstream ss;
+		ss << "{\"records\":" << GetRecords()
+		   << ",\"bytes\":" << GetBytes()
+		   << ",\"write_calls\":" << GetWriteCalls()
+		   << ",\"write_errors\":" << GetWriteErrors()
+		   << ",\"flushes\":" << GetFlushes()
+		   << ",\"flush_latency_ns\":" << GetFlushLatency().ToJson()
+		   << ",\"roll_count\":" << GetRollCount()
+		   << ",\"total_roll_time_ns\":" << GetTotalRollTimeNs()
+		   << ",\"max_roll_time_ns\":" << GetMaxRollTimeNs()
+		   << ",\"queue_high_water_mark\":" << GetQueueHighWaterMark()
+		   << ",\"dropped\":{\"block\":" << GetDropped(0)
+		   << ",\"drop_oldest\":" << GetDropped(1)
+		   << ",\"drop_newest\":" << GetDropped(2) << "}}";
+		return ss.str();
+	}
+
+	/// @brief 日志统计信息实现结构体
+	struct LogStatistics::Impl
+	{
+		LevelStatistics trace; ///< TRACE级别统计
+		LevelStatistics debug; ///< DEBUG级别统计
+		LevelStatistics info;  ///< INFO级别统计
+		LevelStatistics warn;  ///< WARN级别统计
+		LevelStatistics error; ///< ERROR级别统计
+		LevelStatistics fatal; ///< FATAL级别统计
+
+		/// 全局统计信息
+		std::atomic<uint64_t> totalLogs; ///< 总日志数量
+		std::atomic<uint64_t> totalBytes; ///< 总日志字节数
+		std::atomic<uint64_t> droppedLogs; ///< 丢弃的日志数量
+		std::atomic<uint64_t> droppedBytes; ///< 丢弃的日志字节数
+
+		/// 性能统计信息
+		std::atomic<uint64_t> totalWaitTimeUs; ///< 总等待时间（微秒）
+		std::atomic<uint64_t> maxWaitTimeUs; ///< 最大等待时间（微秒）
+
+		RateWindow rates; ///< 滑动时间窗口速率
+
+		LatencyHistogram latency[3]; ///< 各类型的延迟直方图，按 LatencyType 索引
+
+		/// @brief 构造函数
+		Impl()
+			: totalLogs(0),
+			totalBytes(0),
+			droppedLogs(0),
+			droppedBytes(0),
+			totalWaitTimeUs(0),
+			maxWaitTimeUs(0)
+		{}
+
+		/// @brief 拷贝构造函数
+		/// @param other [IN] 另一个Impl对象
+		Impl(const Impl& other)
+			: trace(other.trace),
+			debug(other.debug),
+			info(other.info),
+			warn(other.warn),
+			error(other.error),
+			fatal(other.fatal),
+			totalLogs(other.totalLogs.load()),
+			totalBytes(other.totalBytes.load()),
+			droppedLogs(other.droppedLogs.load()),
+			droppedBytes(other.droppedBytes.load()),
+			totalWaitTimeUs(other.totalWaitTimeUs.load()),
+			maxWaitTimeUs(other.maxWaitTimeUs.load()),
+			rates(other.rates),
+			latency{other.latency[0], other.latency[1], other.latency[2]}
+		{}
+
+		/// @brief 拷贝赋值运算符
+		/// @param other [IN] 另一个Impl对象
+		/// @return 当前对象引用
+		Impl& operator=(const Impl& other)
+		{
+			if (this != &other)
+			{
+				trace = other.trace;
+				debug = other.debug;
+				info = other.info;
+				warn = other.warn;
+				error = other.error;
+				fatal = other.fatal;
+				totalLogs.store(other.totalLogs.load());
+				totalBytes.store(other.totalBytes.load());
+				droppedLogs.store(other.droppedLogs.load());
+				droppedBytes.store(other.droppedBytes.load());
+				totalWaitTimeUs.store(other.totalWaitTimeUs.load());
+				maxWaitTimeUs.store(other.maxWaitTimeUs.load());
+				rates = other.rates;
+				for (size_t i = 0; i < 3; ++i)
+				{
+					latency[i] = other.latency[i];
+				}
+			}
+			return *this;
+		}
+	};
+
+	LogStatistics::LogStatistics()
+		: m_pImpl(new Impl)
+	{
+	}
+
+	LogStatistics::~LogStatistics()
+	{
+		delete m_pImpl;
+	}
+
+	LogStatistics::LogStatistics(const LogStatistics& other)
+		: m_pImpl(new Impl(*other.m_pImpl))
+	{
+	}
+
+	LogStatistics& LogStatistics::operator=(const LogStatistics& other)
+	{
+		if (this != &other)
+		{
+			*m_pImpl = *other.m_pImpl;
+		}
+		return *this;
+	}
+
+	void LogStatistics::Reset()
+	{
+		m_pImpl->trace.Reset();
+		m_pImpl->debug.Reset();
+		m_pImpl->info.Reset();
+		m_pImpl->warn.Reset();
+		m_pImpl->error.Reset();
+		m_pImpl->fatal.Reset();
+
+		m_pImpl->totalLogs.store(0);
+		m_pImpl->totalBytes.store(0);
+		m_pImpl->droppedLogs.store(0);
+		m_pImpl->droppedBytes.store(0);
+
+		m_pImpl->totalWaitTimeUs.store(0);
+		m_pImpl->maxWaitTimeUs.store(0);
+
+		for (auto& histogram : m_pImpl->latency)
+		{
+			histogram.Reset();
+		}
+
+		m_pImpl->rates.Reset();
+	}
+
+	LevelStatistics& LogStatistics::GetLevelStatistics(LogLevel level)
+	{
+		switch (level)
+		{
+		case LogLevel::TRACE:
+			return m_pImpl->trace;
+		case LogLevel::DBG:
+			return m_pImpl->debug;
+		case LogLevel::INFO:
+			return m_pImpl->info;
+		case LogLevel::WARN:
+			return m_pImpl->warn;
+		case LogLevel::ERR:
+			return m_pImpl->error;
+		case LogLevel::FATAL:
+			return m_pImpl->fatal;
+		default:
+			return m_pImpl->info; // 默认返回info级别统计
+		}
+	}
+
+	const LevelStatistics& LogStatistics::GetLevelStatistics(LogLevel level) const
+	{
+		switch (level)
+		{
+		case LogLevel::TRACE:
+			return m_pImpl->trace;
+		case LogLevel::DBG:
+			return m_pImpl->debug;
+		case LogLevel::INFO:
+			return m_pImpl->info;
+		case LogLevel::WARN:
+			return m_pImpl->warn;
+		case LogLevel::ERR:
+			return m_pImpl->error;
+		case LogLevel::FATAL:
+			return m_pImpl->fatal;
+		default:
+			return m_pImpl->info; // 默认返回info级别统计
+		}
+	}
+
+	uint64_t LogStatistics::GetTotalLogs() const
+	{
+		return m_pImpl->totalLogs.load(std::memory_order_relaxed);
+	}
+
+	uint64_t LogStatistics::GetTotalBytes() const
+	{
+		return m_pImpl->totalBytes.load(std::memory_order_relaxed);
+	}
+
+	uint64_t LogStatistics::GetDroppedLogs() const
+	{
+		return m_pImpl->droppedLogs.load(std::memory_order_relaxed);
+	}
+
+	uint64_t LogStatistics::GetDroppedBytes() const
+	{
+		return m_pImpl->droppedBytes.load(std::memory_order_relaxed);
+	}
+
+	LatencyHistogram& LogStatistics::GetLatencyHistogram(LatencyType type)
+	{
+		return m_pImpl->latency[static_cast<size_t>(type)];
+	}
+
+	const LatencyHistogram& LogStatistics::GetLatencyHistogram(LatencyType type) const
+	{
+		return m_pImpl->latency[static_cast<size_t>(type)];
+	}
+
+	void LogStatistics::RecordLog(LogLevel level, size_t messageSize, uint64_t waitTimeUs)
+	{
+		// 更新级别统计
+		LevelStatistics& levelStats = GetLevelStatistics(level);
+		levelStats.IncrementCount();
+		levelStats.AddBytes(messageSize);
+
+		// 更新最大消息大小
+		if (messageSize > 0)
+		{
+			levelStats.UpdateMaxMessageSize(messageSize);
+		}
+
+		// 更新全局统计
+		m_pImpl->totalLogs.fetch_add(1, std::memory_order_relaxed);
+		m_pImpl->totalBytes.fetch_add(messageSize, std::memory_order_relaxed);
+
+		// 更新等待时间统计
+		if (waitTimeUs > 0)
+		{
+			m_pImpl->totalWaitTimeUs.fetch_add(waitTimeUs, std::memory_order_relaxed);
+			UpdateMax(m_pImpl->maxWaitTimeUs, waitTimeUs);
+			m_pImpl->latency[static_cast<size_t>(LatencyType::LOG_CALL)].Record(waitTimeUs * 1000);
+		}
+
+		// 更新速率窗口
+		m_pImpl->rates.Record(level, messageSize);
+	}
+
+	void LogStatistics::RecordDroppedLog(size_t messageSize)
+	{
+		m_pImpl->droppedLogs.fetch_add(1, std::memory_order_relaxed);
+		m_pImpl->droppedBytes.fetch_add(messageSize, std::memory_order_relaxed);
+	}
+
+	RateWindow& LogStatistics::GetRateWindow()
+	{
+		return m_pImpl->rates;
+	}
+
+	const RateWindow& LogStatistics::GetRateWindow() const
+	{
+		return m_pImpl->rates;
+	}
+
+	std::string LogStatistics::ToString() const
+	{
+		std::stringstream ss;
 
 		ss << "Log Statistics:\n";
 		ss << "  Total Logs: " << m_pImpl->totalLogs.load() << "\n";
@@ -470,6 +1076,15 @@ namespace IDLog
 		ss << "  Total Wait Time: " << m_pImpl->totalWaitTimeUs.load() << " us\n";
 		ss << "  Max Wait Time: " << m_pImpl->maxWaitTimeUs.load() << " us\n";
 
+		static const char* kLatencyNames[3] = {"Log Call", "Queue Wait", "Sink Write"};
+		for (size_t i = 0; i < 3; ++i)
+		{
+			if (m_pImpl->latency[i].GetCount() > 0)
+			{
+				ss << "  " << kLatencyNames[i] << " Latency: " << m_pImpl->latency[i].ToString() << "\n";
+			}
+		}
+
 		ss << "  By Level Statistics:\n";
 		ss << "    TRACE: Count=" << m_pImpl->trace.GetCount()
 			<< ", Bytes=" << m_pImpl->trace.GetBytes()
@@ -490,131 +1105,767 @@ namespace IDLog
 			<< ", Bytes=" << m_pImpl->fatal.GetBytes()
 			<< ", MaxMessageSize=" << m_pImpl->fatal.GetMaxMessageSize() << "\n";
 
+		uint64_t nowSec = RateWindow::GetCurrentSecond();
+		if (m_pImpl->rates.GetLogCount(RateWindow::kMaxWindowSeconds, nowSec) > 0)
+		{
+			ss << "  Recent Rates (1s / 10s / 60s):\n";
+			ss << "    Logs/Second: " << m_pImpl->rates.GetLogsPerSecond(1) << " / "
+				<< m_pImpl->rates.GetLogsPerSecond(10) << " / " << m_pImpl->rates.GetLogsPerSecond(60) << "\n";
+			ss << "    Bytes/Second: " << m_pImpl->rates.GetBytesPerSecond(1) << " / "
+				<< m_pImpl->rates.GetBytesPerSecond(10) << " / " << m_pImpl->rates.GetBytesPerSecond(60) << "\n";
+		}
+
+		return ss.str();
+	}
+
+	std::string LogStatistics::ToJson(bool pretty) const
+	{
+		std::stringstream ss;
+
+		if (pretty)
+		{
+			ss << "{\n";
+			ss << "  \"total_logs\": " << m_pImpl->totalLogs.load() << ",\n";
+			ss << "  \"total_bytes\": " << m_pImpl->totalBytes.load() << ",\n";
+			ss << "  \"dropped_logs\": " << m_pImpl->droppedLogs.load() << ",\n";
+			ss << "  \"dropped_bytes\": " << m_pImpl->droppedBytes.load() << ",\n";
+			ss << "  \"total_wait_time_us\": " << m_pImpl->totalWaitTimeUs.load() << ",\n";
+			ss << "  \"max_wait_time_us\": " << m_pImpl->maxWaitTimeUs.load() << ",\n";
+			ss << "  \"latency_ns\": {\n";
+			ss << "    \"log_call\": " << m_pImpl->latency[0].ToJson() << ",\n";
+			ss << "    \"queue_wait\": " << m_pImpl->latency[1].ToJson() << ",\n";
+			ss << "    \"sink_write\": " << m_pImpl->latency[2].ToJson() << "\n";
+			ss << "  },\n";
+			ss << "  \"levels\": {\n";
+			ss << "    \"TRACE\": {\"count\": " << m_pImpl->trace.GetCount() << ", \"bytes\": " << m_pImpl->trace.GetBytes()
+				<< ", \"max_message_size\": " << m_pImpl->trace.GetMaxMessageSize() << "},\n";
+			ss << "    \"DEBUG\": {\"count\": " << m_pImpl->debug.GetCount() << ", \"bytes\": " << m_pImpl->debug.GetBytes()
+				<< ", \"max_message_size\": " << m_pImpl->debug.GetMaxMessageSize() << "},\n";
+			ss << "    \"INFO\": {\"count\": " << m_pImpl->info.GetCount() << ", \"bytes\": " << m_pImpl->info.GetBytes()
+				<< ", \"max_message_size\": " << m_pImpl->info.GetMaxMessageSize() << "},\n";
+			ss << "    \"WARN\": {\"count\": " << m_pImpl->warn.GetCount() << ", \"bytes\": " << m_pImpl->warn.GetBytes()
+				<< ", \"max_message_size\": " << m_pImpl->warn.GetMaxMessageSize() << "},\n";
+			ss << "    \"ERROR\": {\"count\": " << m_pImpl->error.GetCount() << ", \"bytes\": " << m_pImpl->error.GetBytes()
+				<< ", \"max_message_size\": " << m_pImpl->error.GetMaxMessageSize() << "},\n";
+			ss << "    \"FATAL\": {\"count\": " << m_pImpl->fatal.GetCount() << ", \"bytes\": " << m_pImpl->fatal.GetBytes()
+				<< ", \"max_message_size\": " << m_pImpl->fatal.GetMaxMessageSize() << "}\n";
+			ss << "  },\n";
+
+			ss << "  \"recent_rates\": {\n";
+			ss << "    \"logs_per_second\": {\"1s\": " << m_pImpl->rates.GetLogsPerSecond(1)
+				<< ", \"10s\": " << m_pImpl->rates.GetLogsPerSecond(10)
+				<< ", \"60s\": " << m_pImpl->rates.GetLogsPerSecond(60) << "},\n";
+			ss << "    \"bytes_per_second\": {\"1s\": " << m_pImpl->rates.GetBytesPerSecond(1)
+				<< ", \"10s\": " << m_pImpl->rates.GetBytesPerSecond(10)
+				<< ", \"60s\": " << m_pImpl->rates.GetBytesPerSecond(60) << "}\n";
+			ss << "  }\n";
+			ss << "}";
+		}
+		else
+		{
+			ss << "{";
+			ss << "\"total_logs\":" << m_pImpl->totalLogs.load() << ",";
+			ss << "\"total_bytes\":" << m_pImpl->totalBytes.load() << ",";
+			ss << "\"dropped_logs\":" << m_pImpl->droppedLogs.load() << ",";
+			ss << "\"dropped_bytes\":" << m_pImpl->droppedBytes.load() << ",";
+			ss << "\"total_wait_time_us\":" << m_pImpl->totalWaitTimeUs.load() << ",";
+			ss << "\"max_wait_time_us\":" << m_pImpl->maxWaitTimeUs.load() << ",";
+			ss << "\"latency_ns\":{";
+			ss << "\"log_call\":" << m_pImpl->latency[0].ToJson() << ",";
+			ss << "\"queue_wait\":" << m_pImpl->latency[1].ToJson() << ",";
+			ss << "\"sink_write\":" << m_pImpl->latency[2].ToJson();
+			ss << "},";
+			ss << "\"levels\":{";
+			ss << "\"TRACE\":{\"count\":" << m_pImpl->trace.GetCount() << ",\"bytes\":" << m_pImpl->trace.GetBytes()
+				<< ",\"max_message_size\":" << m_pImpl->trace.GetMaxMessageSize() << "},";
+			ss << "\"DEBUG\":{\"count\":" << m_pImpl->debug.GetCount() << ",\"bytes\":" << m_pImpl->debug.GetBytes()
+				<< ",\"max_message_size\":" << m_pImpl->debug.GetMaxMessageSize() << "},";
+			ss << "\"INFO\":{\"count\":" << m_pImpl->info.GetCount() << ",\"bytes\":" << m_pImpl->info.GetBytes()
+				<< ",\"max_message_size\":" << m_pImpl->info.GetMaxMessageSize() << "},";
+			ss << "\"WARN\":{\"count\":" << m_pImpl->warn.GetCount() << ",\"bytes\":" << m_pImpl->warn.GetBytes()
+				<< ",\"max_message_size\":" << m_pImpl->warn.GetMaxMessageSize() << "},";
+			ss << "\"ERROR\":{\"count\":" << m_pImpl->error.GetCount() << ",\"bytes\":" << m_pImpl->error.GetBytes()
+				<< ",\"max_message_size\":" << m_pImpl->error.GetMaxMessageSize() << "},";
+			ss << "\"FATAL\":{\"count\":" << m_pImpl->fatal.GetCount() << ",\"bytes\":" << m_pImpl->fatal.GetBytes()
+				<< ",\"max_message_size\":" << m_pImpl->fatal.GetMaxMessageSize() << "}";
+			ss << "},";
+			ss << "\"recent_rates\":{";
+			ss << "\"logs_per_second\":{\"1s\":" << m_pImpl->rates.GetLogsPerSecond(1)
+				<< ",\"10s\":" << m_pImpl->rates.GetLogsPerSecond(10)
+				<< ",\"60s\":" << m_pImpl->rates.GetLogsPerSecond(60) << "},";
+			ss << "\"bytes_per_second\":{\"1s\":" << m_pImpl->rates.GetBytesPerSecond(1)
+				<< ",\"10s\":" << m_pImpl->rates.GetBytesPerSecond(10)
+				<< ",\"60s\":" << m_pImpl->rates.GetBytesPerSecond(60) << "}";
+			ss << "}";
+			ss << "}";
+		}
+
+		ss << '\n';
+
+		return ss.str();
+	}
+
+	void LogStatistics::UpdateMax(std::atomic<uint64_t>& maxValue, uint64_t newValue)
+	{
+		uint64_t currentMax = maxValue.load(std::memory_order_relaxed);
+		while (newValue > currentMax)
+		{
+			if (maxValue.compare_exchange_weak(currentMax, newValue, std::memory_order_relaxed, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+	}
+
+	namespace
+	{
+		/// @brief 统计的日志级别数量（TRACE ~ FATAL）
+		constexpr size_t kLevelCount = 6;
+
+		/// @brief 每个计数块容纳的日志器数量
+		constexpr uint32_t kLoggersPerChunk = 128;
+
+		/// @brief 计数块目录容量（日志器编号上限为 kLoggersPerChunk * kMaxChunks）
+		constexpr uint32_t kMaxChunks = 2048;
+
+		/// @brief 单写者计数器累加：只有所属线程写入，用 relaxed 读+写代替带锁前缀的原子加
+		/// @param counter [IN/OUT] 计数器
+		/// @param delta [IN] 增量
+		inline void Bump(std::atomic<uint64_t>& counter, uint64_t delta)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+		}
+
+		/// @brief 单写者最大值更新
+		/// @param maxValue [IN/OUT] 最大值
+		/// @param value [IN] 新值
+		inline void BumpMax(std::atomic<uint64_t>& maxValue, uint64_t value)
+		{
+			if (value > maxValue.load(std::memory_order_relaxed))
+			{
+				maxValue.store(value, std::memory_order_relaxed);
+			}
+		}
+
+		/// @brief 单写者延迟直方图（线程分片内使用）
+		struct AtomicHistogram
+		{
+			std::atomic<uint64_t> buckets[LatencyHistogram::kBucketCount]; ///< 各桶计数
+			std::atomic<uint64_t> count;								   ///< 记录的值数量
+			std::atomic<uint64_t> sum;									   ///< 值的总和（纳秒）
+			std::atomic<uint64_t> max;									   ///< 最大值（纳秒）
+
+			/// @brief 记录一个值（仅所属线程调用）
+			/// @param valueNs [IN] 延迟（纳秒）
+			void Record(uint64_t valueNs)
+			{
+				Bump(buckets[LatencyHistogram::GetBucketIndex(valueNs)], 1);
+				Bump(count, 1);
+				Bump(sum, valueNs);
+				BumpMax(max, valueNs);
+			}
+
+			/// @brief 清零（仅所属线程调用）
+			void Clear()
+			{
+				for (auto& bucket : buckets)
+				{
+					bucket.store(0, std::memory_order_relaxed);
+				}
+				count.store(0, std::memory_order_relaxed);
+				sum.store(0, std::memory_order_relaxed);
+				max.store(0, std::memory_order_relaxed);
+			}
+		};
+
+		/// @brief 单写者速率桶环（线程分片内使用）
+		struct AtomicRateRings
+		{
+			RateRing logs[kLevelCount];	 ///< 各级别日志数桶环
+			RateRing bytes[kLevelCount]; ///< 各级别字节数桶环
+
+			/// @brief 记录一条日志（仅所属线程调用）：只计算桶序号，新值用掩码选择，没有锁和分支
+			/// @param index [IN] 级别序号
+			/// @param messageSize [IN] 日志字节数
+			/// @param nowSec [IN] 当前秒数
+			void Record(size_t index, uint64_t messageSize, uint64_t nowSec)
+			{
+				size_t slotIndex = nowSec % RateWindow::kSlotCount;
+				uint64_t tag = nowSec & kRateTagMask;
+				std::atomic<uint64_t>& logSlot = logs[index][slotIndex];
+				logSlot.store(AdvanceRateSlot(logSlot.load(std::memory_order_relaxed), tag, 1), std::memory_order_relaxed);
+				std::atomic<uint64_t>& byteSlot = bytes[index][slotIndex];
+				byteSlot.store(AdvanceRateSlot(byteSlot.load(std::memory_order_relaxed), tag, messageSize), std::memory_order_relaxed);
+			}
+
+			/// @brief 清零（仅所属线程调用）
+			void Clear()
+			{
+				for (size_t level = 0; level < kLevelCount; ++level)
+				{
+					for (auto& slot : logs[level])
+					{
+						slot.store(0, std::memory_order_relaxed);
+					}
+					for (auto& slot : bytes[level])
+					{
+						slot.store(0, std::memory_order_relaxed);
+					}
+				}
+			}
+		};
+
+		/// @brief 单个线程分片内某个日志器的计数
+		struct LoggerCounters
+		{
+			std::atomic<uint32_t> epoch;						  ///< 计数所属的纪元
+			std::atomic<uint64_t> count[kLevelCount];		  ///< 各级别日志数量
+			std::atomic<uint64_t> bytes[kLevelCount];		  ///< 各级别日志字节数
+			std::atomic<uint64_t> maxMessageSize[kLevelCount]; ///< 各级别最大消息大小
+			std::atomic<uint64_t> droppedLogs;				  ///< 丢弃的日志数量
+			std::atomic<uint64_t> droppedBytes;				  ///< 丢弃的日志字节数
+			std::atomic<uint64_t> totalWaitTimeUs;			  ///< 总等待时间（微秒）
+			std::atomic<uint64_t> maxWaitTimeUs;			  ///< 最大等待时间（微秒）
+			std::atomic<AtomicHistogram*> callLatency;		  ///< 调用耗时直方图，首次记录时分配
+			std::atomic<AtomicRateRings*> rates;			  ///< 速率桶环，本线程首次记录该日志器时分配
+
+			/// @brief 析构函数
+			~LoggerCounters()
+			{
+				delete callLatency.load(std::memory_order_relaxed);
+				delete rates.load(std::memory_order_relaxed);
+			}
+
+			/// @brief 记录速率（仅所属线程调用）
+			/// @details 桶环只为本线程实际记录过的日志器分配，只丢弃日志或从未记录的日志器不占内存
+			/// @param index [IN] 级别序号
+			/// @param messageSize [IN] 日志字节数
+			/// @param nowSec [IN] 当前秒数
+			void RecordRate(size_t index, uint64_t messageSize, uint64_t nowSec)
+			{
+				AtomicRateRings* rings = rates.load(std::memory_order_relaxed);
+				if (!rings)
+				{
+					rings = new AtomicRateRings();
+					rates.store(rings, std::memory_order_release);
+				}
+				rings->Record(index, messageSize, nowSec);
+			}
+
+			/// @brief 记录调用耗时（仅所属线程调用）
+			/// @param latencyNs [IN] 耗时（纳秒）
+			void RecordLatency(uint64_t latencyNs)
+			{
+				AtomicHistogram* histogram = callLatency.load(std::memory_order_relaxed);
+				if (!histogram)
+				{
+					histogram = new AtomicHistogram();
+					callLatency.store(histogram, std::memory_order_release);
+				}
+				histogram->Record(latencyNs);
+			}
+
+			/// @brief 清零所有计数（由所属线程在纪元变化时调用）
+			void Clear()
+			{
+				if (AtomicHistogram* histogram = callLatency.load(std::memory_order_relaxed))
+				{
+					histogram->Clear();
+				}
+				if (AtomicRateRings* rings = rates.load(std::memory_order_relaxed))
+				{
+					rings->Clear();
+				}
+				for (size_t i = 0; i < kLevelCount; ++i)
+				{
+					count[i].store(0, std::memory_order_relaxed);
+					bytes[i].store(0, std::memory_order_relaxed);
+					maxMessageSize[i].store(0, std::memory_order_relaxed);
+				}
+				droppedLogs.store(0, std::memory_order_relaxed);
+				droppedBytes.store(0, std::memory_order_relaxed);
+				totalWaitTimeUs.store(0, std::memory_order_relaxed);
+				maxWaitTimeUs.store(0, std::memory_order_relaxed);
+			}
+		};
+
+		/// @brief 计数块
+		struct CounterChunk
+		{
+			LoggerCounters counters[kLoggersPerChunk]; ///< 日志器计数
+		};
+
+		/// @brief 线程分片
+		/// @details 只由一个线程写入；线程退出后分片保留（计数仍参与汇总），可被新线程复用
+		struct ThreadShard
+		{
+			std::atomic<bool> inUse;					///< 是否有线程正在使用
+			std::atomic<CounterChunk*> chunks[kMaxChunks]; ///< 计数块目录，按需分配
+			std::atomic<uint32_t> latencyEpoch;		///< 与日志器无关的延迟直方图所属的纪元
+			AtomicHistogram latency[3];				///< 与日志器无关的延迟直方图，按 LatencyType 索引
+
+			/// @brief 构造函数
+			ThreadShard()
+				: inUse(true), latencyEpoch(0), latency{}
+			{
+				for (auto& chunk : chunks)
+				{
+					chunk.store(nullptr, std::memory_order_relaxed);
+				}
+			}
+
+			/// @brief 析构函数
+			~ThreadShard()
+			{
+				for (auto& chunk : chunks)
+				{
+					delete chunk.load(std::memory_order_relaxed);
+				}
+			}
+
+			/// @brief 获取日志器计数，必要时分配计数块（仅所属线程调用）
+			/// @param loggerId [IN] 日志器编号
+			/// @return 日志器计数
+			LoggerCounters& Get(uint32_t loggerId)
+			{
+				std::atomic<CounterChunk*>& slot = chunks[loggerId / kLoggersPerChunk];
+				CounterChunk* chunk = slot.load(std::memory_order_relaxed);
+				if (!chunk)
+				{
+					chunk = new CounterChunk();
+					slot.store(chunk, std::memory_order_release);
+				}
+				return chunk->counters[loggerId % kLoggersPerChunk];
+			}
+
+			/// @brief 查找日志器计数（汇总时调用）
+			/// @param loggerId [IN] 日志器编号
+			/// @return 日志器计数，尚未分配时返回空指针
+			const LoggerCounters* Find(uint32_t loggerId) const
+			{
+				const CounterChunk* chunk = chunks[loggerId / kLoggersPerChunk].load(std::memory_order_acquire);
+				return chunk ? &chunk->counters[loggerId % kLoggersPerChunk] : nullptr;
+			}
+		};
+
+		/// @brief 已注册的日志器
+		struct LoggerSlot
+		{
+			std::string name;			 ///< 日志器名称
+			std::atomic<uint32_t> epoch; ///< 当前纪元，重置时递增
+		};
+
+		/// @brief 日志器注册块
+		struct LoggerSlotChunk
+		{
+			LoggerSlot slots[kLoggersPerChunk]; ///< 日志器
+		};
+
+		/// @brief 线程持有的分片句柄，线程退出时归还分片
+		struct ShardHandle
+		{
+			ThreadShard* shard = nullptr; ///< 分片指针
+
+			/// @brief 析构函数
+			~ShardHandle()
+			{
+				if (shard)
+				{
+					shard->inUse.store(false, std::memory_order_release);
+				}
+			}
+		};
+	} // namespace
+
+	/// @brief 统计管理器实现结构体
+	struct StatisticsManager::Impl
+	{
+		mutable std::mutex mutex; ///< 互斥锁，保护注册表、分片列表与报告设置
+		std::atomic<bool> enabled; ///< 是否启用统计
+
+		std::unordered_map<std::string, uint32_t> loggerIds;		///< 日志器名称到编号的映射
+		std::atomic<LoggerSlotChunk*> slotChunks[kMaxChunks];		///< 日志器注册块目录
+		std::atomic<uint32_t> loggerCount;						///< 已注册的日志器数量
+		std::vector<std::unique_ptr<ThreadShard>> shards;			///< 所有线程分片
+		std::atomic<uint32_t> globalEpoch;						///< 全局纪元，全部重置时递增
+		std::map<uint64_t, std::weak_ptr<LogAppender>> appenders; ///< 已注册的输出器（弱引用），按注册顺序编号
+		std::unordered_map<const LogAppender*, uint64_t> appenderIds; ///< 输出器地址到注册编号的索引
+		uint64_t nextAppenderId;								///< 下一个输出器注册编号
+		size_t appenderSweepThreshold;							///< 输出器数量达到此值时清理已销毁的输出器
+
+		mutable std::mutex serviceMutex;						///< 服务线程互斥锁，保护以下报告与发布设置
+		std::condition_variable serviceCv;						///< 服务线程条件变量，用于按间隔唤醒、设置变更与停止
+		std::thread serviceThread;								///< 统计服务线程（低优先级），负责报告回调与统计文件发布
+		bool serviceStop;										///< 服务线程停止标志
+		std::function<void(const std::string&)> reportCallback; ///< 统计报告回调函数
+		std::chrono::steady_clock::time_point lastReportTime;	///< 上次报告时间
+		uint64_t statisticsInterval;							///< 日志统计间隔，单位秒，默认60秒
+		std::unique_ptr<StatsFile> statsFile;					///< 统计共享内存文件
+		std::chrono::steady_clock::time_point lastPublishTime;	///< 上次发布统计文件的时间
+		uint64_t statsFileIntervalMs;							///< 统计文件发布间隔，单位毫秒
+
+		/// @brief 汇总缓冲区
+		/// @details 服务线程在每次报告/发布之间复用，日志器与输出器数量不变时不再分配内存
+		struct ReportBuffers
+		{
+			LogStatistics global;											///< 全局统计
+			std::vector<std::pair<std::string, LogStatistics>> loggers;	///< 各日志器统计，按日志器编号排列
+			std::vector<std::shared_ptr<LogAppender>> alive;				///< 存活输出器的临时列表
+			std::vector<std::pair<std::string, AppenderMetrics>> appenders; ///< 各输出器指标
+			std::string text;												///< 报告文本
+		};
+
+		/// @brief 构造函数
+		Impl()
+			: enabled(false), loggerCount(0), globalEpoch(0), nextAppenderId(0), appenderSweepThreshold(64), serviceStop(false),
+			  lastReportTime(std::chrono::steady_clock::now()), statisticsInterval(60),
+			  lastPublishTime(std::chrono::steady_clock::now()), statsFileIntervalMs(1000)
+		{
+			for (auto& chunk : slotChunks)
+			{
+				chunk.store(nullptr, std::memory_order_relaxed);
+			}
+		}
+
+		/// @brief 析构函数
+		~Impl()
+		{
+			for (auto& chunk : slotChunks)
+			{
+				delete chunk.load(std::memory_order_relaxed);
+			}
+		}
+
+		/// @brief 获取已注册的日志器
+		/// @param loggerId [IN] 日志器编号
+		/// @return 日志器，编号无效时返回空指针
+		LoggerSlot* Slot(uint32_t loggerId) const
+		{
+			if (loggerId >= loggerCount.load(std::memory_order_acquire))
+			{
+				return nullptr;
+			}
+			LoggerSlotChunk* chunk = slotChunks[loggerId / kLoggersPerChunk].load(std::memory_order_acquire);
+			return chunk ? &chunk->slots[loggerId % kLoggersPerChunk] : nullptr;
+		}
+
+		/// @brief 获取当前线程的分片
+		/// @return 线程分片
+		ThreadShard& LocalShard()
+		{
+			static thread_local ShardHandle t_handle;
+			if (!t_handle.shard)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				for (auto& shard : shards)
+				{
+					bool expected = false;
+					if (shard->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+					{
+						t_handle.shard = shard.get();
+						break;
+					}
+				}
+				if (!t_handle.shard)
+				{
+					shards.push_back(std::make_unique<ThreadShard>());
+					t_handle.shard = shards.back().get();
+				}
+			}
+			return *t_handle.shard;
+		}
+
+		/// @brief 从单写者直方图读取快照并合并到直方图
+		/// @param source [IN] 单写者直方图
+		/// @param target [IN/OUT] 目标直方图
+		static void MergeHistogram(const AtomicHistogram& source, LatencyHistogram& target)
+		{
+			LatencyHistogram::Impl& out = *target.m_pImpl;
+			for (size_t i = 0; i < LatencyHistogram::kBucketCount; ++i)
+			{
+				out.buckets[i] += source.buckets[i].load(std::memory_order_relaxed);
+			}
+			out.count += source.count.load(std::memory_order_relaxed);
+			out.sum += source.sum.load(std::memory_order_relaxed);
+			out.max = std::max(out.max, source.max.load(std::memory_order_relaxed));
+		}
+
+		/// @brief 汇总指定日志器在所有分片中的计数（调用方需持有 mutex）
+		/// @param loggerId [IN] 日志器编号
+		/// @param stats [IN/OUT] 累加到的统计信息
+		void AccumulateNoLock(uint32_t loggerId, LogStatistics& stats) const;
+
+		/// @brief 合并与日志器无关的延迟直方图（调用方需持有 mutex）
+		/// @param stats [IN/OUT] 累加到的统计信息
+		void AccumulateGlobalLatencyNoLock(LogStatistics& stats) const;
+
+		/// @brief 汇总全部统计到缓冲区（复用缓冲区中已有的对象）
+		/// @param buffers [IN/OUT] 汇总缓冲区
+		void Collect(ReportBuffers& buffers) const;
+
+		/// @brief 将汇总结果格式化为报告文本
+		/// @param buffers [IN] 汇总缓冲区
+		/// @param out [OUT] 报告文本（先清空，保留容量）
+		static void FormatReport(const ReportBuffers& buffers, std::string& out);
+
+		/// @brief 启动服务线程（调用方需持有 serviceMutex）
+		void StartServiceNoLock();
+
+		/// @brief 停止服务线程并等待退出
+		void StopService();
+
+		/// @brief 服务线程主循环
+		void ServiceLoop();
+	};
+
+	void StatisticsManager::Impl::AccumulateNoLock(uint32_t loggerId, LogStatistics& stats) const
+	{
+		const LoggerSlot* slot = Slot(loggerId);
+		if (!slot)
+		{
+			return;
+		}
+		uint32_t epoch = slot->epoch.load(std::memory_order_relaxed);
+		uint64_t nowSec = RateWindow::GetCurrentSecond();
+
+		static const LogLevel kLevels[kLevelCount] = {
+			LogLevel::TRACE, LogLevel::DBG, LogLevel::INFO, LogLevel::WARN, LogLevel::ERR, LogLevel::FATAL};
+		LogStatistics::Impl& out = *stats.m_pImpl;
+		for (const auto& shard : shards)
+		{
+			const LoggerCounters* counters = shard->Find(loggerId);
+			// 纪元不一致的计数属于重置之前，写端下次写入时才会清零
+			if (!counters || counters->epoch.load(std::memory_order_relaxed) != epoch)
+			{
+				continue;
+			}
+			for (size_t i = 0; i < kLevelCount; ++i)
+			{
+				uint64_t count = counters->count[i].load(std::memory_order_relaxed);
+				uint64_t bytes = counters->bytes[i].load(std::memory_order_relaxed);
+				LevelStatistics& levelStats = stats.GetLevelStatistics(kLevels[i]);
+				levelStats.AddCount(count);
+				levelStats.AddBytes(bytes);
+				levelStats.UpdateMaxMessageSize(counters->maxMessageSize[i].load(std::memory_order_relaxed));
+				out.totalLogs.fetch_add(count, std::memory_order_relaxed);
+				out.totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+			}
+			out.droppedLogs.fetch_add(counters->droppedLogs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			out.droppedBytes.fetch_add(counters->droppedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			out.totalWaitTimeUs.fetch_add(counters->totalWaitTimeUs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			LogStatistics::UpdateMax(out.maxWaitTimeUs, counters->maxWaitTimeUs.load(std::memory_order_relaxed));
+			if (const AtomicHistogram* histogram = counters->callLatency.load(std::memory_order_acquire))
+			{
+				MergeHistogram(*histogram, stats.GetLatencyHistogram(LatencyType::LOG_CALL));
+			}
+			if (const AtomicRateRings* rings = counters->rates.load(std::memory_order_acquire))
+			{
+				RateWindow::Impl& rates = *out.rates.m_pImpl;
+				for (size_t i = 0; i < kLevelCount; ++i)
+				{
+					MergeRateRing(rings->logs[i], rates.logs[i], nowSec);
+					MergeRateRing(rings->bytes[i], rates.bytes[i], nowSec);
+				}
+			}
+		}
+	}
+
+	void StatisticsManager::Impl::AccumulateGlobalLatencyNoLock(LogStatistics& stats) const
+	{
+		uint32_t epoch = globalEpoch.load(std::memory_order_relaxed);
+		for (const auto& shard : shards)
 		{
-			std::lock_guard<std::mutex> lock(m_pImpl->timeWindowMutex);
-			if (m_pImpl->lastTimeWindow.GetLogsPerSecond() > 0 || m_pImpl->lastTimeWindow.GetBytesPerSecond() > 0)
+			if (shard->latencyEpoch.load(std::memory_order_relaxed) != epoch)
+			{
+				continue;
+			}
+			for (size_t i = 0; i < 3; ++i)
 			{
-				ss << "  Recent Rates:\n";
-				ss << "    Logs/Second: " << m_pImpl->lastTimeWindow.GetLogsPerSecond() << "\n";
-				ss << "    Bytes/Second: " << m_pImpl->lastTimeWindow.GetBytesPerSecond() << "\n";
+				MergeHistogram(shard->latency[i], stats.GetLatencyHistogram(static_cast<LatencyType>(i)));
 			}
 		}
-
-		return ss.str();
 	}
 
-	std::string LogStatistics::ToJson(bool pretty) const
+	void StatisticsManager::Impl::Collect(ReportBuffers& buffers) const
 	{
-		std::stringstream ss;
+		buffers.global.Reset();
+		buffers.alive.clear();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			uint32_t count = loggerCount.load(std::memory_order_relaxed);
+			buffers.loggers.resize(count);
+			for (uint32_t id = 0; id < count; ++id)
+			{
+				auto& [name, stats] = buffers.loggers[id];
+				name = Slot(id)->name;
+				stats.Reset();
+				AccumulateNoLock(id, stats);
+				AccumulateNoLock(id, buffers.global);
+			}
+			AccumulateGlobalLatencyNoLock(buffers.global);
 
-		if (pretty)
+			for (const auto& entry : appenders)
+			{
+				if (auto appender = entry.second.lock())
+				{
+					buffers.alive.push_back(std::move(appender));
+				}
+			}
+		}
+
+		// 在锁外读取输出器名称与指标（GetName 会获取输出器自己的锁）
+		buffers.appenders.resize(buffers.alive.size());
+		for (size_t i = 0; i < buffers.alive.size(); ++i)
 		{
-			ss << "{\n";
-			ss << "  \"total_logs\": " << m_pImpl->totalLogs.load() << ",\n";
-			ss << "  \"total_bytes\": " << m_pImpl->totalBytes.load() << ",\n";
-			ss << "  \"dropped_logs\": " << m_pImpl->droppedLogs.load() << ",\n";
-			ss << "  \"dropped_bytes\": " << m_pImpl->droppedBytes.load() << ",\n";
-			ss << "  \"total_wait_time_us\": " << m_pImpl->totalWaitTimeUs.load() << ",\n";
-			ss << "  \"max_wait_time_us\": " << m_pImpl->maxWaitTimeUs.load() << ",\n";
-			ss << "  \"levels\": {\n";
-			ss << "    \"TRACE\": {\"count\": " << m_pImpl->trace.GetCount() << ", \"bytes\": " << m_pImpl->trace.GetBytes()
-				<< ", \"max_message_size\": " << m_pImpl->trace.GetMaxMessageSize() << "},\n";
-			ss << "    \"DEBUG\": {\"count\": " << m_pImpl->debug.GetCount() << ", \"bytes\": " << m_pImpl->debug.GetBytes()
-				<< ", \"max_message_size\": " << m_pImpl->debug.GetMaxMessageSize() << "},\n";
-			ss << "    \"INFO\": {\"count\": " << m_pImpl->info.GetCount() << ", \"bytes\": " << m_pImpl->info.GetBytes()
-				<< ", \"max_message_size\": " << m_pImpl->info.GetMaxMessageSize() << "},\n";
-			ss << "    \"WARN\": {\"count\": " << m_pImpl->warn.GetCount() << ", \"bytes\": " << m_pImpl->warn.GetBytes()
-				<< ", \"max_message_size\": " << m_pImpl->warn.GetMaxMessageSize() << "},\n";
-			ss << "    \"ERROR\": {\"count\": " << m_pImpl->error.GetCount() << ", \"bytes\": " << m_pImpl->error.GetBytes()
-				<< ", \"max_message_size\": " << m_pImpl->error.GetMaxMessageSize() << "},\n";
-			ss << "    \"FATAL\": {\"count\": " << m_pImpl->fatal.GetCount() << ", \"bytes\": " << m_pImpl->fatal.GetBytes()
-				<< ", \"max_message_size\": " << m_pImpl->fatal.GetMaxMessageSize() << "}\n";
-			ss << "  },\n";
+			buffers.appenders[i].first = buffers.alive[i]->GetName();
+			buffers.appenders[i].second = buffers.alive[i]->GetMetrics();
+		}
+		buffers.alive.clear();
+	}
 
+	void StatisticsManager::Impl::FormatReport(const ReportBuffers& buffers, std::string& out)
+	{
+		out.clear();
+		out += "=== IDLog Statistics Report ===\n\n";
+		out += "Global Statistics:\n";
+		out += buffers.global.ToString();
+		out += "\n";
+
+		if (!buffers.loggers.empty())
+		{
+			out += "Logger Statistics(" + std::to_string(buffers.loggers.size()) + " loggers):\n";
+			for (const auto& [name, stats] : buffers.loggers)
 			{
-				std::lock_guard<std::mutex> lock(m_pImpl->timeWindowMutex);
-				ss << "  \"recent_rates\": {\n";
-				ss << "    \"logs_per_second\": " << m_pImpl->lastTimeWindow.GetLogsPerSecond() << ",\n";
-				ss << "    \"bytes_per_second\": " << m_pImpl->lastTimeWindow.GetBytesPerSecond() << "\n";
-				ss << "  }\n";
+				if (stats.GetTotalLogs() > 0 || stats.GetDroppedLogs() > 0)
+				{
+					out += "Logger: ";
+					out += name;
+					out += "\n";
+					out += stats.ToString();
+					out += "\n";
+				}
 			}
-			ss << "}";
 		}
-		else
+
+		if (!buffers.appenders.empty())
 		{
-			ss << "{";
-			ss << "\"total_logs\":" << m_pImpl->totalLogs.load() << ",";
-			ss << "\"total_bytes\":" << m_pImpl->totalBytes.load() << ",";
-			ss << "\"dropped_logs\":" << m_pImpl->droppedLogs.load() << ",";
-			ss << "\"dropped_bytes\":" << m_pImpl->droppedBytes.load() << ",";
-			ss << "\"total_wait_time_us\":" << m_pImpl->totalWaitTimeUs.load() << ",";
-			ss << "\"max_wait_time_us\":" << m_pImpl->maxWaitTimeUs.load() << ",";
-			ss << "\"levels\":{";
-			ss << "\"TRACE\":{\"count\":" << m_pImpl->trace.GetCount() << ",\"bytes\":" << m_pImpl->trace.GetBytes()
-				<< ",\"max_message_size\":" << m_pImpl->trace.GetMaxMessageSize() << "},";
-			ss << "\"DEBUG\":{\"count\":" << m_pImpl->debug.GetCount() << ",\"bytes\":" << m_pImpl->debug.GetBytes()
-				<< ",\"max_message_size\":" << m_pImpl->debug.GetMaxMessageSize() << "},";
-			ss << "\"INFO\":{\"count\":" << m_pImpl->info.GetCount() << ",\"bytes\":" << m_pImpl->info.GetBytes()
-				<< ",\"max_message_size\":" << m_pImpl->info.GetMaxMessageSize() << "},";
-			ss << "\"WARN\":{\"count\":" << m_pImpl->warn.GetCount() << ",\"bytes\":" << m_pImpl->warn.GetBytes()
-				<< ",\"max_message_size\":" << m_pImpl->warn.GetMaxMessageSize() << "},";
-			ss << "\"ERROR\":{\"count\":" << m_pImpl->error.GetCount() << ",\"bytes\":" << m_pImpl->error.GetBytes()
-				<< ",\"max_message_size\":" << m_pImpl->error.GetMaxMessageSize() << "},";
-			ss << "\"FATAL\":{\"count\":" << m_pImpl->fatal.GetCount() << ",\"bytes\":" << m_pImpl->fatal.GetBytes()
-				<< ",\"max_message_size\":" << m_pImpl->fatal.GetMaxMessageSize() << "}";
-			ss << "},";
+			out += "Appender Statistics(" + std::to_string(buffers.appenders.size()) + " appenders):\n";
+			for (const auto& [name, metrics] : buffers.appenders)
 			{
-				std::lock_guard<std::mutex> lock(m_pImpl->timeWindowMutex);
-				ss << "\"recent_rates\":{";
-				ss << "\"logs_per_second\":" << m_pImpl->lastTimeWindow.GetLogsPerSecond() << ",";
-				ss << "\"bytes_per_second\":" << m_pImpl->lastTimeWindow.GetBytesPerSecond();
-				ss << "}";
+				out += "Appender: ";
+				out += name;
+				out += "\n";
+				out += metrics.ToString();
+				out += "\n";
 			}
-			ss << "}";
 		}
 
-		ss << '\n';
+		// 开启调用点统计时附上输出量最大的日志语句
+		const CallSiteProfiler& profiler = CallSiteProfiler::GetInstance();
+		if (profiler.IsEnabled())
+		{
+			out += profiler.GenerateReport(10);
+		}
+		out += "\n=== End of Report ===\n";
+	}
 
-		return ss.str();
+	void StatisticsManager::Impl::StartServiceNoLock()
+	{
+		if (serviceThread.joinable())
+		{
+			return;
+		}
+		serviceStop = false;
+		serviceThread = std::thread([this]() { ServiceLoop(); });
 	}
 
-	void LogStatistics::UpdateMax(std::atomic<uint64_t>& maxValue, uint64_t newValue)
+	void StatisticsManager::Impl::StopService()
 	{
-		uint64_t currentMax = maxValue.load(std::memory_order_relaxed);
-		while (newValue > currentMax)
+		std::thread thread;
 		{
-			if (maxValue.compare_exchange_weak(currentMax, newValue, std::memory_order_relaxed, std::memory_order_relaxed))
-			{
-				break;
-			}
+			std::lock_guard<std::mutex> lock(serviceMutex);
+			serviceStop = true;
+			thread = std::move(serviceThread);
+		}
+		serviceCv.notify_all();
+		if (thread.joinable())
+		{
+			thread.join();
 		}
 	}
 
-	/// @brief 统计管理器实现结构体
-	struct StatisticsManager::Impl
+	void StatisticsManager::Impl::ServiceLoop()
 	{
-		mutable std::mutex mutex; ///< 互斥锁，保护统计数据
-		std::atomic<bool> enabled; ///< 是否启用统计
+		Utils::ThreadUtil::SetThreadName("idlog-stats");
+		Utils::ThreadUtil::SetThreadLowPriority();
 
-		LogStatistics globalStats; ///< 全局统计数据
-		std::map<std::string, LogStatistics> loggerStats; ///< 日志器统计数据
+		using Clock = std::chrono::steady_clock;
+		ReportBuffers buffers;
+		std::unique_lock<std::mutex> lock(serviceMutex);
+		while (!serviceStop)
+		{
+			// 计算下一个报告或发布的时间点
+			Clock::time_point now = Clock::now();
+			Clock::time_point next = Clock::time_point::max();
+			const bool reporting = reportCallback && statisticsInterval > 0 && enabled.load(std::memory_order_relaxed);
+			if (reporting)
+			{
+				next = std::min(next, lastReportTime + std::chrono::seconds(statisticsInterval));
+			}
+			if (statsFile)
+			{
+				next = std::min(next, lastPublishTime + std::chrono::milliseconds(statsFileIntervalMs));
+			}
+			if (now < next)
+			{
+				// 设置变更与停止都会唤醒，醒来后重新计算
+				if (next == Clock::time_point::max())
+				{
+					serviceCv.wait(lock);
+				}
+				else
+				{
+					serviceCv.wait_until(lock, next);
+				}
+				continue;
+			}
 
-		std::function<void(const std::string&)> reportCallback; ///< 统计报告回调函数
-		std::chrono::steady_clock::time_point lastReportTime; ///< 上次报告时间
-		uint64_t statisticsInterval; ///< 日志统计间隔，单位秒，默认60秒
+			std::function<void(const std::string&)> callback;
+			if (reporting && now >= lastReportTime + std::chrono::seconds(statisticsInterval))
+			{
+				lastReportTime = now;
+				callback = reportCallback;
+			}
+			bool publish = statsFile && now >= lastPublishTime + std::chrono::milliseconds(statsFileIntervalMs);
+			if (publish)
+			{
+				lastPublishTime = now;
+			}
 
-		/// @brief 构造函数
-		Impl() : enabled(false), lastReportTime(std::chrono::steady_clock::now()), statisticsInterval(60) {}
-	};
+			// 汇总与回调期间不持有服务锁，回调中可以记录日志或修改设置
+			lock.unlock();
+			Collect(buffers);
+			if (callback)
+			{
+				FormatReport(buffers, buffers.text);
+				callback(buffers.text);
+			}
+			lock.lock();
+			if (publish && statsFile)
+			{
+				statsFile->Publish(buffers.global, buffers.loggers, buffers.appenders);
+			}
+		}
+	}
 
 	StatisticsManager::StatisticsManager()
 		: m_pImpl(new Impl)
 	{
-		m_pImpl->globalStats.Reset();
 	}
 
 	StatisticsManager::~StatisticsManager()
 	{
+		m_pImpl->StopService();
 		delete m_pImpl;
 	}
 
@@ -624,89 +1875,276 @@ namespace IDLog
 		return instance;
 	}
 
-	void StatisticsManager::RecordLog(const std::string& loggerName, LogLevel level,
-		size_t messageSize, uint64_t waitTimeUs)
+	uint32_t StatisticsManager::RegisterLogger(const std::string& loggerName)
+	{
+		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+		auto it = m_pImpl->loggerIds.find(loggerName);
+		if (it != m_pImpl->loggerIds.end())
+		{
+			return it->second;
+		}
+
+		uint32_t id = m_pImpl->loggerCount.load(std::memory_order_relaxed);
+		if (id >= kLoggersPerChunk * kMaxChunks)
+		{
+			return kInvalidLoggerId;
+		}
+		std::atomic<LoggerSlotChunk*>& chunkSlot = m_pImpl->slotChunks[id / kLoggersPerChunk];
+		LoggerSlotChunk* chunk = chunkSlot.load(std::memory_order_relaxed);
+		if (!chunk)
+		{
+			chunk = new LoggerSlotChunk();
+			chunkSlot.store(chunk, std::memory_order_release);
+		}
+		LoggerSlot& slot = chunk->slots[id % kLoggersPerChunk];
+		slot.name = loggerName;
+		// 纪元从1开始，使各分片首次写入时走清零路径
+		slot.epoch.store(1, std::memory_order_relaxed);
+		m_pImpl->loggerIds.emplace(loggerName, id);
+		m_pImpl->loggerCount.store(id + 1, std::memory_order_release);
+		return id;
+	}
+
+	std::string StatisticsManager::GetLoggerName(uint32_t loggerId) const
+	{
+		const LoggerSlot* slot = m_pImpl->Slot(loggerId);
+		return slot ? slot->name : std::string();
+	}
+
+	void StatisticsManager::RecordLog(uint32_t loggerId, LogLevel level,
+		size_t messageSize, uint64_t latencyNs)
 	{
-		if (!m_pImpl->enabled.load())
+		if (!m_pImpl->enabled.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+		LoggerSlot* slot = m_pImpl->Slot(loggerId);
+		if (!slot)
 		{
 			return;
 		}
 
-		// 更新全局统计
-		m_pImpl->globalStats.RecordLog(level, messageSize, waitTimeUs);
+		ThreadShard& shard = m_pImpl->LocalShard();
+		LoggerCounters& counters = shard.Get(loggerId);
+		uint32_t epoch = slot->epoch.load(std::memory_order_relaxed);
+		if (counters.epoch.load(std::memory_order_relaxed) != epoch)
+		{
+			counters.Clear();
+			counters.epoch.store(epoch, std::memory_order_relaxed);
+		}
 
+		size_t index = static_cast<size_t>(level);
+		if (index >= kLevelCount)
 		{
-			std::lock_guard<std::mutex> lock(m_pImpl->mutex);
-			// 更新日志器统计
-			auto& loggerStat = m_pImpl->loggerStats[loggerName];
-			loggerStat.RecordLog(level, messageSize, waitTimeUs);
+			index = static_cast<size_t>(LogLevel::INFO); // 与 GetLevelStatistics 一致，未知级别计入INFO
+		}
+		Bump(counters.count[index], 1);
+		Bump(counters.bytes[index], messageSize);
+		BumpMax(counters.maxMessageSize[index], messageSize);
+		counters.RecordRate(index, messageSize, RateWindow::GetCurrentSecond());
+		if (latencyNs > 0)
+		{
+			uint64_t waitTimeUs = latencyNs / 1000;
+			Bump(counters.totalWaitTimeUs, waitTimeUs);
+			BumpMax(counters.maxWaitTimeUs, waitTimeUs);
+			counters.RecordLatency(latencyNs);
 		}
+	}
 
-		// 检查是否需要报告统计信息
-		CheckReport();
+	void StatisticsManager::RecordLog(const std::string& loggerName, LogLevel level,
+		size_t messageSize, uint64_t waitTimeUs)
+	{
+		if (!m_pImpl->enabled.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+		RecordLog(RegisterLogger(loggerName), level, messageSize, waitTimeUs * 1000);
 	}
 
-	void StatisticsManager::RecordDroppedLog(const std::string& loggerName, size_t messageSize)
+	void StatisticsManager::RecordLatency(LatencyType type, uint64_t latencyNs)
 	{
-		if (!m_pImpl->enabled.load())
+		if (!m_pImpl->enabled.load(std::memory_order_relaxed))
 		{
 			return;
 		}
 
-		// 更新全局统计
-		m_pImpl->globalStats.RecordDroppedLog(messageSize);
+		ThreadShard& shard = m_pImpl->LocalShard();
+		uint32_t epoch = m_pImpl->globalEpoch.load(std::memory_order_relaxed);
+		if (shard.latencyEpoch.load(std::memory_order_relaxed) != epoch)
+		{
+			for (auto& histogram : shard.latency)
+			{
+				histogram.Clear();
+			}
+			shard.latencyEpoch.store(epoch, std::memory_order_relaxed);
+		}
+		shard.latency[static_cast<size_t>(type)].Record(latencyNs);
+	}
 
+	void StatisticsManager::RecordDroppedLog(uint32_t loggerId, size_t messageSize)
+	{
+		if (!m_pImpl->enabled.load(std::memory_order_relaxed))
 		{
-			std::lock_guard<std::mutex> lock(m_pImpl->mutex);
-			// 更新日志器统计
-			auto& loggerStat = m_pImpl->loggerStats[loggerName];
-			loggerStat.RecordDroppedLog(messageSize);
+			return;
+		}
+		LoggerSlot* slot = m_pImpl->Slot(loggerId);
+		if (!slot)
+		{
+			return;
+		}
+
+		LoggerCounters& counters = m_pImpl->LocalShard().Get(loggerId);
+		uint32_t epoch = slot->epoch.load(std::memory_order_relaxed);
+		if (counters.epoch.load(std::memory_order_relaxed) != epoch)
+		{
+			counters.Clear();
+			counters.epoch.store(epoch, std::memory_order_relaxed);
 		}
+		Bump(counters.droppedLogs, 1);
+		Bump(counters.droppedBytes, messageSize);
+	}
 
-		// 检查是否需要报告统计信息
-		CheckReport();
+	void StatisticsManager::RecordDroppedLog(const std::string& loggerName, size_t messageSize)
+	{
+		if (!m_pImpl->enabled.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+		RecordDroppedLog(RegisterLogger(loggerName), messageSize);
 	}
 
 	LogStatistics StatisticsManager::GetGlobalStatistics() const
 	{
-		return m_pImpl->globalStats;
+		LogStatistics stats;
+		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+		uint32_t count = m_pImpl->loggerCount.load(std::memory_order_relaxed);
+		for (uint32_t id = 0; id < count; ++id)
+		{
+			m_pImpl->AccumulateNoLock(id, stats);
+		}
+
+		// 合并与日志器无关的延迟
+		m_pImpl->AccumulateGlobalLatencyNoLock(stats);
+		return stats;
 	}
 
 	LogStatistics StatisticsManager::GetLoggerStatistics(const std::string& loggerName) const
 	{
+		LogStatistics stats;
 		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
-		auto it = m_pImpl->loggerStats.find(loggerName);
-		if (it != m_pImpl->loggerStats.end())
+		auto it = m_pImpl->loggerIds.find(loggerName);
+		if (it != m_pImpl->loggerIds.end())
 		{
-			return it->second;
+			m_pImpl->AccumulateNoLock(it->second, stats);
 		}
-		return LogStatistics();
+		return stats;
 	}
 
 	std::map<std::string, LogStatistics> StatisticsManager::GetAllLoggerStatistics() const
 	{
+		std::map<std::string, LogStatistics> result;
 		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
-		return m_pImpl->loggerStats;
+		for (const auto& [name, id] : m_pImpl->loggerIds)
+		{
+			m_pImpl->AccumulateNoLock(id, result[name]);
+		}
+		return result;
 	}
 
 	void StatisticsManager::ResetLoggerStatistics(const std::string& loggerName)
 	{
 		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
-		auto it = m_pImpl->loggerStats.find(loggerName);
-		if (it != m_pImpl->loggerStats.end())
+		auto it = m_pImpl->loggerIds.find(loggerName);
+		if (it != m_pImpl->loggerIds.end())
+		{
+			m_pImpl->Slot(it->second)->epoch.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void StatisticsManager::RegisterAppender(const std::shared_ptr<LogAppender>& appender)
+	{
+		if (!appender)
+		{
+			return;
+		}
+		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+		auto& appenders = m_pImpl->appenders;
+		auto& appenderIds = m_pImpl->appenderIds;
+
+		// 按地址查找：仍存活的同一输出器不重复注册；地址被新输出器复用时替换旧记录
+		auto found = appenderIds.find(appender.get());
+		if (found != appenderIds.end())
+		{
+			auto entry = appenders.find(found->second);
+			if (!entry->second.owner_before(appender) && !appender.owner_before(entry->second))
+			{
+				return;
+			}
+			appenders.erase(entry);
+			appenderIds.erase(found);
+		}
+
+		// 已销毁的输出器在数量翻倍时批量清理，注册的均摊开销为常数
+		if (appenders.size() >= m_pImpl->appenderSweepThreshold)
+		{
+			for (auto it = appenders.begin(); it != appenders.end();)
+			{
+				if (auto alive = it->second.lock())
+				{
+					++it;
+				}
+				else
+				{
+					// 输出器已销毁，取不到地址，对应的索引在下面按编号清理
+					it = appenders.erase(it);
+				}
+			}
+			for (auto it = appenderIds.begin(); it != appenderIds.end();)
+			{
+				it = appenders.count(it->second) ? std::next(it) : appenderIds.erase(it);
+			}
+			m_pImpl->appenderSweepThreshold = std::max<size_t>(64, appenders.size() * 2);
+		}
+
+		uint64_t id = m_pImpl->nextAppenderId++;
+		appenders.emplace(id, appender);
+		appenderIds.emplace(appender.get(), id);
+	}
+
+	std::vector<std::pair<std::string, AppenderMetrics>> StatisticsManager::GetAllAppenderMetrics() const
+	{
+		// 先在锁内取出存活的输出器，再在锁外读取名称（GetName 会获取输出器自己的锁）
+		std::vector<std::shared_ptr<LogAppender>> alive;
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+			alive.reserve(m_pImpl->appenders.size());
+			for (const auto& entry : m_pImpl->appenders)
+			{
+				if (auto appender = entry.second.lock())
+				{
+					alive.push_back(std::move(appender));
+				}
+			}
+		}
+
+		std::vector<std::pair<std::string, AppenderMetrics>> result;
+		result.reserve(alive.size());
+		for (const auto& appender : alive)
 		{
-			it->second.Reset();
+			result.emplace_back(appender->GetName(), appender->GetMetrics());
 		}
+		return result;
 	}
 
 	void StatisticsManager::ResetAllStatistics()
 	{
 		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
-		m_pImpl->globalStats.Reset();
-		for (auto& pair : m_pImpl->loggerStats)
+		uint32_t count = m_pImpl->loggerCount.load(std::memory_order_relaxed);
+		for (uint32_t id = 0; id < count; ++id)
 		{
-			pair.second.Reset();
+			m_pImpl->Slot(id)->epoch.fetch_add(1, std::memory_order_relaxed);
 		}
+		m_pImpl->globalEpoch.fetch_add(1, std::memory_order_relaxed);
 	}
 
 	void StatisticsManager::EnableStatistics(bool enabled)
@@ -716,6 +2154,11 @@ namespace IDLog
 		{
 			ResetAllStatistics();
 		}
+		// 唤醒服务线程重新计算报告时间
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->serviceMutex);
+		}
+		m_pImpl->serviceCv.notify_all();
 	}
 
 	bool StatisticsManager::IsStatisticsEnabled() const
@@ -725,70 +2168,76 @@ namespace IDLog
 
 	void StatisticsManager::SetStatisticsInterval(uint64_t intervalSeconds)
 	{
-		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
-		m_pImpl->statisticsInterval = intervalSeconds;
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->serviceMutex);
+			m_pImpl->statisticsInterval = intervalSeconds;
+		}
+		m_pImpl->serviceCv.notify_all();
 	}
 
 	uint64_t StatisticsManager::GetStatisticsInterval() const
 	{
-		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+		std::lock_guard<std::mutex> lock(m_pImpl->serviceMutex);
 		return m_pImpl->statisticsInterval;
 	}
 
 	void StatisticsManager::RegisterReportCallback(const std::function<void(const std::string&)>& callback)
 	{
-		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
-		m_pImpl->reportCallback = callback;
-	}
-
-	std::string StatisticsManager::GenerateReport() const
-	{
-		std::stringstream ss;
-		ss << "=== IDLog Statistics Report ===\n\n";
-		ss << "Global Statistics:\n";
 		{
-			std::lock_guard<std::mutex> lock(m_pImpl->mutex);
-			ss << m_pImpl->globalStats.ToString() << "\n";
-
-			if (!m_pImpl->loggerStats.empty())
+			std::lock_guard<std::mutex> lock(m_pImpl->serviceMutex);
+			m_pImpl->reportCallback = callback;
+			m_pImpl->lastReportTime = std::chrono::steady_clock::now();
+			if (callback)
 			{
-				ss << "Logger Statistics(" << m_pImpl->loggerStats.size() << " loggers):\n";
-				for (const auto& [name, stats] : m_pImpl->loggerStats)
-				{
-					if (stats.GetTotalLogs() > 0 || stats.GetDroppedLogs() > 0)
-					{
-						ss << "Logger: " << name << "\n";
-						ss << stats.ToString() << "\n";
-					}
-				}
+				m_pImpl->StartServiceNoLock();
 			}
 		}
-		ss << "\n=== End of Report ===\n";
+		m_pImpl->serviceCv.notify_all();
+	}
 
-		return ss.str();
+	std::string StatisticsManager::GenerateReport() const
+	{
+		Impl::ReportBuffers buffers;
+		m_pImpl->Collect(buffers);
+		Impl::FormatReport(buffers, buffers.text);
+		return std::move(buffers.text);
 	}
 
-	void StatisticsManager::CheckReport()
+	bool StatisticsManager::StartStatsFile(const std::string& path, uint64_t intervalMs)
 	{
-		if (!m_pImpl->enabled.load())
+		StopStatsFile();
+
+		auto statsFile = std::make_unique<StatsFile>();
+		if (!statsFile->Create(path))
 		{
-			return;
+			return false;
 		}
+		Impl::ReportBuffers buffers;
+		m_pImpl->Collect(buffers);
+		statsFile->Publish(buffers.global, buffers.loggers, buffers.appenders);
 
-		auto now = std::chrono::steady_clock::now();
-		auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - m_pImpl->lastReportTime).count();
-
-		// 检查是否达到报告间隔
-		if (static_cast<uint64_t>(elapsed) >= m_pImpl->statisticsInterval)
 		{
-			std::string report = GenerateReport();
-			std::lock_guard<std::mutex> lock(m_pImpl->mutex);
-			if (m_pImpl->reportCallback)
-			{
-				m_pImpl->reportCallback(report);
-				m_pImpl->lastReportTime = now;
-			}
+			std::lock_guard<std::mutex> lock(m_pImpl->serviceMutex);
+			m_pImpl->statsFile = std::move(statsFile);
+			m_pImpl->statsFileIntervalMs = intervalMs > 0 ? intervalMs : 1000;
+			m_pImpl->lastPublishTime = std::chrono::steady_clock::now();
+			m_pImpl->StartServiceNoLock();
 		}
+		m_pImpl->serviceCv.notify_all();
+		return true;
+	}
+
+	void StatisticsManager::StopStatsFile()
+	{
+		// 服务线程只在持有服务锁时发布，这里在锁内关闭即可
+		std::lock_guard<std::mutex> lock(m_pImpl->serviceMutex);
+		m_pImpl->statsFile.reset();
+	}
+
+	std::string StatisticsManager::GetStatsFilePath() const
+	{
+		std::lock_guard<std::mutex> lock(m_pImpl->serviceMutex);
+		return m_pImpl->statsFile ? m_pImpl->statsFile->GetPath() : std::string();
 	}
 
-} // namespace IDLog
\ No newline at end of file
+} // namespace IDLog
@@ -0,0 +1,515 @@
+/**
+ * @Description: 统计共享内存文件源文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 20:42:17
+ * @LastEditTime: 2026-10-18 21:03:55
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/Core/StatsFile.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace IDLog
+{
+	namespace
+	{
+		/// @brief 魔数
+		constexpr char kMagic[8] = {'I', 'D', 'L', 'G', 'S', 'T', 'A', 'T'};
+		/// @brief 序列号区域长度（独占一个缓存行，避免与数据区伪共享）
+		constexpr size_t kSequenceSize = 64;
+		/// @brief 读者遇到写入冲突时的最大重试次数
+		constexpr int kMaxReadRetries = 1000;
+
+		static_assert(std::atomic<uint64_t>::is_always_lock_free, "stats file requires lock-free 64-bit atomics");
+		static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "unexpected atomic layout");
+		static_assert(std::is_trivially_copyable<StatsFile::Header>::value, "header must be trivially copyable");
+		static_assert(std::is_trivially_copyable<StatsFile::Counters>::value, "counters must be trivially copyable");
+		static_assert(std::is_trivially_copyable<StatsFile::AppenderCounters>::value, "appender counters must be trivially copyable");
+
+		/// @brief 计算文件长度
+		/// @param loggerCapacity [IN] 日志器槽位数
+		/// @param appenderCapacity [IN] 输出器槽位数
+		/// @return 文件长度（字节）
+		size_t GetFileSize(uint32_t loggerCapacity, uint32_t appenderCapacity)
+		{
+			return kSequenceSize + sizeof(StatsFile::Header) + sizeof(StatsFile::Counters) * (size_t(1) + loggerCapacity) +
+				   sizeof(StatsFile::AppenderCounters) * appenderCapacity;
+		}
+
+		/// @brief 复制名称（超长截断，保证以'\0'结尾）
+		/// @param dest [OUT] 目标字段
+		/// @param name [IN] 名称
+		void CopyName(char (&dest)[StatsFile::kNameSize], const std::string &name)
+		{
+			size_t size = std::min(name.size(), StatsFile::kNameSize - 1);
+			std::memcpy(dest, name.data(), size);
+			std::memset(dest + size, 0, StatsFile::kNameSize - size);
+		}
+
+		/// @brief 填充延迟摘要
+		/// @param histogram [IN] 延迟直方图
+		/// @param summary [OUT] 延迟摘要
+		void FillLatency(const LatencyHistogram &histogram, StatsFile::LatencySummary &summary)
+		{
+			summary.count = histogram.GetCount();
+			summary.mean = histogram.GetMean();
+			summary.p50 = histogram.GetPercentile(50.0);
+			summary.p90 = histogram.GetPercentile(90.0);
+			summary.p99 = histogram.GetPercentile(99.0);
+			summary.p999 = histogram.GetPercentile(99.9);
+			summary.max = histogram.GetMax();
+		}
+
+		/// @brief 填充全局/日志器统计
+		/// @param name [IN] 名称
+		/// @param stats [IN] 统计信息
+		/// @param counters [OUT] 统计记录
+		void FillCounters(const std::string &name, const LogStatistics &stats, StatsFile::Counters &counters)
+		{
+			static const uint32_t kWindows[StatsFile::kRateWindowCount] = {1, 10, 60};
+
+			CopyName(counters.name, name);
+			counters.totalLogs = stats.GetTotalLogs();
+			counters.totalBytes = stats.GetTotalBytes();
+			counters.droppedLogs = stats.GetDroppedLogs();
+			counters.droppedBytes = stats.GetDroppedBytes();
+			for (size_t i = 0; i < StatsFile::kLevelCount; ++i)
+			{
+				const LevelStatistics &levelStats = stats.GetLevelStatistics(static_cast<LogLevel>(i));
+				counters.levelCount[i] = levelStats.GetCount();
+				counters.levelBytes[i] = levelStats.GetBytes();
+			}
+			const RateWindow &rates = stats.GetRateWindow();
+			for (size_t i = 0; i < StatsFile::kRateWindowCount; ++i)
+			{
+				counters.logsPerSecond[i] = rates.GetLogsPerSecond(kWindows[i]);
+				counters.bytesPerSecond[i] = rates.GetBytesPerSecond(kWindows[i]);
+			}
+			for (size_t i = 0; i < StatsFile::kLatencyTypeCount; ++i)
+			{
+				FillLatency(stats.GetLatencyHistogram(static_cast<LatencyType>(i)), counters.latency[i]);
+			}
+		}
+
+		/// @brief 填充输出器指标
+		/// @param name [IN] 输出器名称
+		/// @param metrics [IN] 输出器指标
+		/// @param counters [OUT] 指标记录
+		void FillAppender(const std::string &name, const AppenderMetrics &metrics, StatsFile::AppenderCounters &counters)
+		{
+			CopyName(counters.name, name);
+			counters.records = metrics.GetRecords();
+			counters.bytes = metrics.GetBytes();
+			counters.writeCalls = metrics.GetWriteCalls();
+			counters.writeErrors = metrics.GetWriteErrors();
+			counters.flushes = metrics.GetFlushes();
+			counters.rollCount = metrics.GetRollCount();
+			counters.totalRollTimeNs = metrics.GetTotalRollTimeNs();
+			counters.maxRollTimeNs = metrics.GetMaxRollTimeNs();
+			counters.queueHighWaterMark = metrics.GetQueueHighWaterMark();
+			for (size_t i = 0; i < AppenderMetrics::kDropPolicyCount; ++i)
+			{
+				counters.dropped[i] = metrics.GetDropped(i);
+			}
+			FillLatency(metrics.GetFlushLatency(), counters.flushLatency);
+		}
+
+		/// @brief 获取当前进程号
+		/// @return 进程号
+		uint64_t GetCurrentPid()
+		{
+#ifdef _WIN32
+			return static_cast<uint64_t>(::GetCurrentProcessId());
+#else
+			return static_cast<uint64_t>(::getpid());
+#endif
+		}
+
+		/// @brief 获取当前Unix时间（毫秒）
+		/// @return 毫秒数
+		uint64_t GetUnixTimeMs()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::system_clock::now().time_since_epoch()).count());
+		}
+	} // namespace
+
+	/// @brief 统计共享内存文件实现结构体
+	struct StatsFile::Impl
+	{
+		std::string path;	   ///< 文件路径
+		bool writer = false;   ///< 是否为写者
+		char *base = nullptr;  ///< 映射基址
+		size_t size = 0;	   ///< 映射长度
+#ifdef _WIN32
+		HANDLE file = INVALID_HANDLE_VALUE; ///< 文件句柄
+		HANDLE mapping = nullptr;			///< 映射句柄
+#else
+		int fd = -1; ///< 文件描述符
+#endif
+
+		/// @brief 获取序列号
+		/// @return 序列号引用
+		std::atomic<uint64_t> &Sequence() const { return *reinterpret_cast<std::atomic<uint64_t> *>(base); }
+
+		/// @brief 获取文件头
+		/// @return 文件头指针
+		Header *GetHeader() const { return reinterpret_cast<Header *>(base + kSequenceSize); }
+
+		/// @brief 获取第 index 个统计记录（0为全局统计）
+		/// @param index [IN] 索引
+		/// @return 统计记录指针
+		Counters *GetCounters(size_t index) const
+		{
+			return reinterpret_cast<Counters *>(base + kSequenceSize + sizeof(Header)) + index;
+		}
+
+		/// @brief 获取第 index 个输出器指标
+		/// @param index [IN] 索引
+		/// @return 指标记录指针
+		AppenderCounters *GetAppender(size_t index) const
+		{
+			return reinterpret_cast<AppenderCounters *>(GetCounters(size_t(1) + GetHeader()->loggerCapacity)) + index;
+		}
+
+		/// @brief 映射文件
+		/// @param filePath [IN] 文件路径
+		/// @param create [IN] 是否创建（写者）
+		/// @param length [IN] 创建时的文件长度
+		/// @return 成功返回true
+		bool Map(const std::string &filePath, bool create, size_t length);
+
+		/// @brief 解除映射并关闭文件
+		void Unmap();
+	};
+
+#ifdef _WIN32
+	bool StatsFile::Impl::Map(const std::string &filePath, bool create, size_t length)
+	{
+		file = ::CreateFileA(filePath.c_str(), create ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+							 FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+							 create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+		if (!create)
+		{
+			LARGE_INTEGER fileSize;
+			if (!::GetFileSizeEx(file, &fileSize))
+			{
+				Unmap();
+				return false;
+			}
+			length = static_cast<size_t>(fileSize.QuadPart);
+		}
+		if (length < kSequenceSize + sizeof(Header))
+		{
+			Unmap();
+			return false;
+		}
+		uint64_t length64 = static_cast<uint64_t>(length);
+		mapping = ::CreateFileMappingA(file, nullptr, create ? PAGE_READWRITE : PAGE_READONLY,
+									   static_cast<DWORD>(length64 >> 32), static_cast<DWORD>(length64 & 0xFFFFFFFFu), nullptr);
+		if (!mapping)
+		{
+			Unmap();
+			return false;
+		}
+		base = static_cast<char *>(::MapViewOfFile(mapping, create ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, length));
+		if (!base)
+		{
+			Unmap();
+			return false;
+		}
+		size = length;
+		return true;
+	}
+
+	void StatsFile::Impl::Unmap()
+	{
+		if (base)
+		{
+			::UnmapViewOfFile(base);
+			base = nullptr;
+		}
+		if (mapping)
+		{
+			::CloseHandle(mapping);
+			mapping = nullptr;
+		}
+		if (file != INVALID_HANDLE_VALUE)
+		{
+			::CloseHandle(file);
+			file = INVALID_HANDLE_VALUE;
+		}
+		size = 0;
+	}
+#else
+	bool StatsFile::Impl::Map(const std::string &filePath, bool create, size_t length)
+	{
+		fd = create ? ::open(filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)
+					: ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+		{
+			return false;
+		}
+		if (create)
+		{
+			if (::ftruncate(fd, static_cast<off_t>(length)) != 0)
+			{
+				Unmap();
+				return false;
+			}
+		}
+		else
+		{
+			struct stat st;
+			if (::fstat(fd, &st) != 0)
+			{
+				Unmap();
+				return false;
+			}
+			length = static_cast<size_t>(st.st_size);
+		}
+		if (length < kSequenceSize + sizeof(Header))
+		{
+			Unmap();
+			return false;
+		}
+		void *address = ::mmap(nullptr, length, create ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+		if (address == MAP_FAILED)
+		{
+			Unmap();
+			return false;
+		}
+		base = static_cast<char *>(address);
+		size = length;
+		return true;
+	}
+
+	void StatsFile::Impl::Unmap()
+	{
+		if (base)
+		{
+			::munmap(base, size);
+			base = nullptr;
+		}
+		if (fd >= 0)
+		{
+			::close(fd);
+			fd = -1;
+		}
+		size = 0;
+	}
+#endif
+
+	StatsFile::StatsFile()
+		: m_pImpl(new Impl)
+	{
+	}
+
+	StatsFile::~StatsFile()
+	{
+		Close();
+		delete m_pImpl;
+	}
+
+	bool StatsFile::Create(const std::string &path, uint32_t loggerCapacity, uint32_t appenderCapacity)
+	{
+		Close();
+		std::string filePath = path.empty() ? GetDefaultPath() : path;
+		if (!m_pImpl->Map(filePath, true, GetFileSize(loggerCapacity, appenderCapacity)))
+		{
+			return false;
+		}
+		m_pImpl->path = filePath;
+		m_pImpl->writer = true;
+
+		// 新文件内容全为0，序列号为偶数，先写好不变的头部字段
+		new (m_pImpl->base) std::atomic<uint64_t>(0);
+		Header *header = m_pImpl->GetHeader();
+		std::memcpy(header->magic, kMagic, sizeof(kMagic));
+		header->version = kVersion;
+		header->headerSize = static_cast<uint32_t>(sizeof(Header));
+		header->loggerCapacity = loggerCapacity;
+		header->appenderCapacity = appenderCapacity;
+		header->pid = GetCurrentPid();
+		header->startTimeMs = GetUnixTimeMs();
+		header->updateTimeMs = header->startTimeMs;
+		m_pImpl->Sequence().store(0, std::memory_order_release);
+		return true;
+	}
+
+	bool StatsFile::Open(const std::string &path)
+	{
+		Close();
+		if (!m_pImpl->Map(path, false, 0))
+		{
+			return false;
+		}
+		const Header *header = m_pImpl->GetHeader();
+		if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion ||
+			header->headerSize != sizeof(Header) ||
+			m_pImpl->size < GetFileSize(header->loggerCapacity, header->appenderCapacity))
+		{
+			m_pImpl->Unmap();
+			return false;
+		}
+		m_pImpl->path = path;
+		m_pImpl->writer = false;
+		return true;
+	}
+
+	void StatsFile::Close()
+	{
+		if (!m_pImpl->base)
+		{
+			return;
+		}
+		m_pImpl->Unmap();
+		if (m_pImpl->writer)
+		{
+			std::error_code ec;
+			std::filesystem::remove(m_pImpl->path, ec);
+		}
+		m_pImpl->writer = false;
+		m_pImpl->path.clear();
+	}
+
+	bool StatsFile::IsOpen() const
+	{
+		return m_pImpl->base != nullptr;
+	}
+
+	std::string StatsFile::GetPath() const
+	{
+		return m_pImpl->path;
+	}
+
+	bool StatsFile::Publish(const LogStatistics &global,
+		const std::vector<std::pair<std::string, LogStatistics>> &loggers,
+		const std::vector<std::pair<std::string, AppenderMetrics>> &appenders)
+	{
+		if (!m_pImpl->base || !m_pImpl->writer)
+		{
+			return false;
+		}
+
+		Header *header = m_pImpl->GetHeader();
+		std::atomic<uint64_t> &sequence = m_pImpl->Sequence();
+		uint64_t seq = sequence.load(std::memory_order_relaxed);
+
+		// 顺序锁：序列号置为奇数后写数据，写完再置为偶数
+		sequence.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		FillCounters(std::string(), global, *m_pImpl->GetCounters(0));
+		uint32_t loggerCount = 0;
+		for (const auto &[name, stats] : loggers)
+		{
+			if (loggerCount >= header->loggerCapacity)
+			{
+				break;
+			}
+			FillCounters(name, stats, *m_pImpl->GetCounters(size_t(1) + loggerCount));
+			++loggerCount;
+		}
+		uint32_t appenderCount = 0;
+		for (const auto &[name, metrics] : appenders)
+		{
+			if (appenderCount >= header->appenderCapacity)
+			{
+				break;
+			}
+			FillAppender(name, metrics, *m_pImpl->GetAppender(appenderCount));
+			++appenderCount;
+		}
+		header->loggerCount = loggerCount;
+		header->appenderCount = appenderCount;
+		header->updateTimeMs = GetUnixTimeMs();
+		++header->publishCount;
+
+		sequence.store(seq + 2, std::memory_order_release);
+		return true;
+	}
+
+	bool StatsFile::Read(Snapshot &snapshot) const
+	{
+		if (!m_pImpl->base)
+		{
+			return false;
+		}
+
+		const std::atomic<uint64_t> &sequence = m_pImpl->Sequence();
+		for (int attempt = 0; attempt < kMaxReadRetries; ++attempt)
+		{
+			uint64_t begin = sequence.load(std::memory_order_acquire);
+			if (begin & 1)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			std::memcpy(&snapshot.header, m_pImpl->GetHeader(), sizeof(Header));
+			uint32_t loggerCount = std::min(snapshot.header.loggerCount, snapshot.header.loggerCapacity);
+			uint32_t appenderCount = std::min(snapshot.header.appenderCount, snapshot.header.appenderCapacity);
+			std::memcpy(&snapshot.global, m_pImpl->GetCounters(0), sizeof(Counters));
+			snapshot.loggers.resize(loggerCount);
+			if (loggerCount > 0)
+			{
+				std::memcpy(snapshot.loggers.data(), m_pImpl->GetCounters(1), sizeof(Counters) * loggerCount);
+			}
+			snapshot.appenders.resize(appenderCount);
+			if (appenderCount > 0)
+			{
+				std::memcpy(snapshot.appenders.data(), m_pImpl->GetAppender(0), sizeof(AppenderCounters) * appenderCount);
+			}
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (sequence.load(std::memory_order_relaxed) == begin)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	std::string StatsFile::GetDefaultPath()
+	{
+		return GetDefaultPath(GetCurrentPid());
+	}
+
+	std::string StatsFile::GetDefaultPath(uint64_t pid)
+	{
+		std::string fileName = "idlog." + std::to_string(pid) + ".stats";
+		std::error_code ec;
+#ifndef _WIN32
+		if (std::filesystem::is_directory("/dev/shm", ec))
+		{
+			return "/dev/shm/" + fileName;
+		}
+#endif
+		std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+		if (ec)
+		{
+			return fileName;
+		}
+		return (dir / fileName).string();
+	}
+
+} // namespace IDLog
@@ -0,0 +1,229 @@
+/**
+ * @Description: 重复日志抑制过滤器源文件
+ * @Author: InverseDark
+ * @Date: 2026-10-19 01:03:26
+ * @LastEditTime: 2026-10-19 12:38:45
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/Filter/DedupFilter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+namespace IDLog
+{
+	namespace
+	{
+		/// @brief 说明中保留的消息长度上限
+		constexpr size_t kMaxSummaryMessage = 120;
+
+		/// @brief 表项
+		struct Slot
+		{
+			LogEvent::TimePoint firstTime; ///< 窗口内首次出现的时间
+			LogEvent::TimePoint lastTime;  ///< 最后一次出现的时间
+			std::string message;		   ///< 消息内容（截断），用于说明
+			std::string loggerName;		   ///< 日志器名称，过滤器被多个日志器共享时说明由其他日志器输出
+			uint64_t hash = 0;			   ///< 日志的哈希值，0表示空闲
+			uint64_t repeats = 0;		   ///< 窗口内被抑制的次数
+			size_t messageSize = 0;		   ///< 消息长度，与哈希一起比较以减少误判
+			LogLevel level = LogLevel::TRACE; ///< 日志级别
+		};
+
+		/// @brief 计算日志的哈希值
+		/// @param event [IN] 日志事件
+		/// @return 哈希值，不为0
+		uint64_t HashEvent(const LogEvent &event)
+		{
+			uint64_t hash = std::hash<std::string_view>()(event.GetLogMessageView());
+			hash ^= std::hash<std::string>()(event.GetLoggerName()) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+			hash ^= (static_cast<uint64_t>(event.GetLevel()) + 1) * 0xbf58476d1ce4e5b9ULL;
+			return hash != 0 ? hash : 1;
+		}
+
+		/// @brief 格式化时间（本地时间，精确到毫秒）
+		/// @param time [IN] 时间点
+		/// @return 时间字符串
+		std::string FormatTime(const LogEvent::TimePoint &time)
+		{
+			std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+			std::tm tm;
+
+#ifdef IDLOG_PLATFORM_WINDOWS
+			localtime_s(&tm, &seconds);
+#else
+			localtime_r(&seconds, &tm);
+#endif
+
+			auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000;
+			std::ostringstream ss;
+			ss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << '.' << std::setw(3) << std::setfill('0') << millis;
+			return ss.str();
+		}
+
+		/// @brief 表项中有被抑制的日志时生成说明并清零
+		/// @param slot [IN/OUT] 表项
+		/// @param notices [OUT] 说明追加到末尾
+		void CollectSummary(Slot &slot, std::vector<Filter::Notice> &notices)
+		{
+			if (slot.repeats == 0)
+			{
+				return;
+			}
+			std::string text = "last message repeated " + std::to_string(slot.repeats) + " times between " +
+							   FormatTime(slot.firstTime) + " and " + FormatTime(slot.lastTime) + ": " + slot.message;
+			if (slot.messageSize > slot.message.size())
+			{
+				text += "...";
+			}
+			text += " in logger " + slot.loggerName;
+			notices.push_back({slot.level, std::move(text)});
+			slot.repeats = 0;
+		}
+
+		/// @brief 提交说明，由当前线程正在记录日志的日志器在本条日志之后输出
+		/// @param notices [IN] 说明列表
+		void PostNotices(std::vector<Filter::Notice> &notices)
+		{
+			for (Filter::Notice &notice : notices)
+			{
+				Filter::PostNotice(std::move(notice));
+			}
+		}
+	} // namespace
+
+	/// @brief 重复日志抑制过滤器实现结构体
+	struct DedupFilter::Impl
+	{
+		std::vector<Slot> slots;			   ///< 直接映射表
+		std::mutex mutex;					   ///< 表互斥锁
+		std::atomic<uint64_t> totalSuppressed; ///< 累计被抑制的条数
+		std::chrono::milliseconds window;	   ///< 时间窗口
+		LogEvent::TimePoint nextSweep;		   ///< 下次检查已结束窗口的时间（受 mutex 保护）
+
+		/// @brief 构造函数
+		Impl(std::chrono::milliseconds windowMs, size_t slotCount)
+			: slots(std::max<size_t>(slotCount, 1)), totalSuppressed(0), window(windowMs) {}
+
+		/// @brief 每隔一个窗口，取出已结束窗口的重复次数（调用方需持有 mutex）
+		/// @details 重复日志停止后不会再命中同一表项，说明由之后的任意一条日志带出
+		/// @param time [IN] 当前日志的时间
+		/// @param notices [OUT] 说明追加到末尾
+		void SweepExpired(const LogEvent::TimePoint &time, std::vector<Filter::Notice> &notices)
+		{
+			if (time < nextSweep)
+			{
+				return;
+			}
+			nextSweep = time + window;
+			for (Slot &slot : slots)
+			{
+				if (slot.repeats != 0 && time - slot.firstTime >= window)
+				{
+					CollectSummary(slot, notices);
+				}
+			}
+		}
+
+		/// @brief 取出所有表项的重复次数
+		/// @param notices [OUT] 说明追加到末尾
+		void CollectAll(std::vector<Filter::Notice> &notices)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			for (Slot &slot : slots)
+			{
+				CollectSummary(slot, notices);
+			}
+		}
+	};
+
+	DedupFilter::DedupFilter(std::chrono::milliseconds window, size_t slotCount)
+		: m_pImpl(new Impl(window, slotCount))
+	{
+	}
+
+	DedupFilter::~DedupFilter()
+	{
+		delete m_pImpl;
+	}
+
+	FilterDecision DedupFilter::Decide(const LogEventPtr &event)
+	{
+		if (!event || m_pImpl->window.count() <= 0)
+		{
+			return FilterDecision::NEUTRAL;
+		}
+
+		// 锁外计算哈希，锁内只比较与更新表项
+		const uint64_t hash = HashEvent(*event);
+		const std::string_view message = event->GetLogMessageView();
+		const LogEvent::TimePoint time = event->GetTime();
+
+		std::vector<Notice> notices;
+		FilterDecision decision = FilterDecision::NEUTRAL;
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+			m_pImpl->SweepExpired(time, notices);
+			Slot &slot = m_pImpl->slots[hash % m_pImpl->slots.size()];
+			if (slot.hash == hash && slot.messageSize == message.size() && time - slot.firstTime < m_pImpl->window)
+			{
+				// 窗口内的重复日志
+				++slot.repeats;
+				slot.lastTime = std::max(slot.lastTime, time);
+				m_pImpl->totalSuppressed.fetch_add(1, std::memory_order_relaxed);
+				decision = FilterDecision::DENY;
+			}
+			else
+			{
+				// 窗口结束或表项被其他日志占用：先输出之前的重复次数，再开始新的窗口
+				CollectSummary(slot, notices);
+				slot.hash = hash;
+				slot.level = event->GetLevel();
+				slot.firstTime = time;
+				slot.lastTime = time;
+				slot.messageSize = message.size();
+				slot.message.assign(message.substr(0, kMaxSummaryMessage));
+				slot.loggerName = event->GetLoggerName();
+			}
+		}
+		PostNotices(notices);
+		return decision;
+	}
+
+	void DedupFilter::Flush(std::vector<Notice> &notices)
+	{
+		m_pImpl->CollectAll(notices);
+	}
+
+	std::string DedupFilter::GetName() const
+	{
+		return "DedupFilter[" + std::to_string(m_pImpl->window.count()) + "ms]";
+	}
+
+	Filter::Pointer DedupFilter::Clone() const
+	{
+		return std::make_shared<DedupFilter>(m_pImpl->window, m_pImpl->slots.size());
+	}
+
+	std::chrono::milliseconds DedupFilter::GetWindow() const
+	{
+		return m_pImpl->window;
+	}
+
+	size_t DedupFilter::GetSlotCount() const
+	{
+		return m_pImpl->slots.size();
+	}
+
+	uint64_t DedupFilter::GetSuppressedCount() const
+	{
+		return m_pImpl->totalSuppressed.load(std::memory_order_relaxed);
+	}
+} // namespace IDLog
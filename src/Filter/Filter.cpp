@@ -2,15 +2,51 @@
  * @Description: 过滤器基类源文件
  * @Author: InverseDark
  * @Date: 2025-12-18 20:36:52
- * @LastEditTime: 2025-12-18 20:46:58
+ * @LastEditTime: 2026-10-19 11:34:02
  * @LastEditors: InverseDark
  */
 #include "IDLog/Filter/Filter.h"
 
 namespace IDLog
 {
+	namespace
+	{
+		/// @brief 当前线程待输出的过滤器说明
+		thread_local std::vector<Filter::Notice> t_pendingNotices;
+	} // namespace
+
+	bool Filter::CanPreDecide() const
+	{
+		return false;
+	}
+
+	FilterDecision Filter::PreDecide(LogLevel /*level*/, uint32_t /*loggerId*/, const SourceLocation & /*location*/)
+	{
+		return FilterDecision::NEUTRAL;
+	}
+
+	void Filter::PostNotice(Notice notice)
+	{
+		t_pendingNotices.push_back(std::move(notice));
+	}
+
+	bool Filter::TakeNotices(std::vector<Notice> &notices)
+	{
+		if (t_pendingNotices.empty())
+		{
+			return false;
+		}
+		notices.clear();
+		notices.swap(t_pendingNotices);
+		return true;
+	}
+
+	void Filter::Flush(std::vector<Notice> & /*notices*/)
+	{
+		// 基类没有待提交的说明
+	}
 
-	void Filter::AddFilter(const Pointer &filter)
+	void Filter::AddFilter(const Pointer & /*filter*/)
 	{
 		// 基类实现为空，由子类重写
 	}
@@ -71,6 +107,14 @@ namespace IDLog
 		m_pImpl->filters.clear();
 	}
 
+	void CompositeFilter::Flush(std::vector<Notice> &notices)
+	{
+		for (const auto &filter : m_pImpl->filters)
+		{
+			filter->Flush(notices);
+		}
+	}
+
 	FilterDecision AndFilter::Decide(const LogEventPtr &event)
 	{
 		// 如果没有子过滤器，返回中立
@@ -2,7 +2,7 @@
  * @Description: 级别过滤器源文件
  * @Author: InverseDark
  * @Date: 2025-12-18 23:30:16
- * @LastEditTime: 2025-12-18 23:30:16
+ * @LastEditTime: 2026-10-19 01:21:37
  * @LastEditors: InverseDark
  */
 #include "IDLog/Filter/LevelFilter.h"
@@ -21,7 +21,11 @@ namespace IDLog
 			return FilterDecision::NEUTRAL;
 		}
 
-		LogLevel level = event->GetLevel();
+		return PreDecide(event->GetLevel(), 0, event->GetSourceLocation());
+	}
+
+	FilterDecision LevelFilter::PreDecide(LogLevel level, uint32_t /*loggerId*/, const SourceLocation & /*location*/)
+	{
 		bool match = (static_cast<int>(level) >= static_cast<int>(m_minLevel)) &&
 					 (static_cast<int>(level) <= static_cast<int>(m_maxLevel));
 
@@ -0,0 +1,201 @@
+/**
+ * @Description: 日志器名称过滤器源文件
+ * @Author: InverseDark
+ * @Date: 2026-10-19 01:27:52
+ * @LastEditTime: 2026-10-19 12:09:15
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/Filter/LoggerNameFilter.h"
+
+#include "IDLog/Core/Logger.h"
+#include "IDLog/Utils/StringUtil.h"
+
+#include <atomic>
+#include <memory>
+
+namespace IDLog
+{
+	namespace
+	{
+		/// @brief 每个缓存块的日志器个数
+		constexpr uint32_t kCacheChunkSize = 4096;
+
+		/// @brief 缓存块目录容量（与日志器编号的回收上限一致，同时存在的日志器不超过 4M 时都能缓存）
+		constexpr uint32_t kMaxCacheChunks = 1024;
+
+		/// @brief 缓存的匹配结果
+		enum CacheState : uint64_t
+		{
+			CACHE_UNKNOWN = 0, ///< 未计算
+			CACHE_MATCH,	   ///< 匹配
+			CACHE_MISMATCH	   ///< 不匹配
+		};
+
+		/// @brief 缓存块：按编号保存 代数左移2位后与 CacheState 组合 的结果
+		struct CacheChunk
+		{
+			std::atomic<uint64_t> entries[kCacheChunkSize]; ///< 缓存项
+
+			/// @brief 构造函数
+			CacheChunk()
+			{
+				for (auto &entry : entries)
+				{
+					entry.store(CACHE_UNKNOWN, std::memory_order_relaxed);
+				}
+			}
+		};
+	} // namespace
+
+	/// @brief 日志器名称过滤器实现结构体
+	struct LoggerNameFilter::Impl
+	{
+		std::vector<std::string> names;						   ///< 名称规则列表
+		std::unique_ptr<std::atomic<CacheChunk *>[]> chunks; ///< 缓存块目录，按需分配
+		bool acceptOnMatch;									   ///< 匹配时是否接受
+
+		/// @brief 构造函数
+		Impl(const std::vector<std::string> &nameList, bool accept)
+			: names(nameList), chunks(new std::atomic<CacheChunk *>[kMaxCacheChunks]), acceptOnMatch(accept)
+		{
+			for (uint32_t i = 0; i < kMaxCacheChunks; ++i)
+			{
+				chunks[i].store(nullptr, std::memory_order_relaxed);
+			}
+		}
+
+		/// @brief 析构函数
+		~Impl()
+		{
+			for (uint32_t i = 0; i < kMaxCacheChunks; ++i)
+			{
+				delete chunks[i].load(std::memory_order_relaxed);
+			}
+		}
+
+		/// @brief 获取编号对应的缓存项，必要时分配缓存块
+		/// @param loggerId [IN] 日志器编号
+		/// @return 缓存项，编号超出目录容量时为空
+		std::atomic<uint64_t> *Entry(uint32_t loggerId)
+		{
+			if (loggerId / kCacheChunkSize >= kMaxCacheChunks)
+			{
+				return nullptr;
+			}
+			std::atomic<CacheChunk *> &slot = chunks[loggerId / kCacheChunkSize];
+			CacheChunk *chunk = slot.load(std::memory_order_acquire);
+			if (chunk == nullptr)
+			{
+				// 多个线程同时分配时只保留一个
+				CacheChunk *created = new CacheChunk();
+				if (slot.compare_exchange_strong(chunk, created, std::memory_order_acq_rel))
+				{
+					chunk = created;
+				}
+				else
+				{
+					delete created;
+				}
+			}
+			return &chunk->entries[loggerId % kCacheChunkSize];
+		}
+	};
+
+	LoggerNameFilter::LoggerNameFilter(const std::vector<std::string> &names, bool acceptOnMatch)
+		: m_pImpl(new Impl(names, acceptOnMatch))
+	{
+	}
+
+	LoggerNameFilter::~LoggerNameFilter()
+	{
+		delete m_pImpl;
+	}
+
+	FilterDecision LoggerNameFilter::Decide(const LogEventPtr &event)
+	{
+		if (!event)
+		{
+			return FilterDecision::NEUTRAL;
+		}
+
+		if (!Matches(event->GetLoggerName()))
+		{
+			return FilterDecision::NEUTRAL;
+		}
+		return m_pImpl->acceptOnMatch ? FilterDecision::ACCEPT : FilterDecision::DENY;
+	}
+
+	FilterDecision LoggerNameFilter::PreDecide(LogLevel /*level*/, uint32_t loggerId, const SourceLocation & /*location*/)
+	{
+		bool match = false;
+		std::atomic<uint64_t> *entry = m_pImpl->Entry(loggerId);
+		if (entry != nullptr)
+		{
+			// 日志器名称不会改变，同一编号同一代数的结果重复计算也相同，不需要额外同步；
+			// 代数不同说明编号已回收给另一个日志器，缓存的结果作废
+			const uint64_t generation = Logger::GetIdGeneration(loggerId);
+			const uint64_t cached = entry->load(std::memory_order_relaxed);
+			uint64_t state = (cached >> 2) == generation ? (cached & 3) : CACHE_UNKNOWN;
+			if (state == CACHE_UNKNOWN)
+			{
+				// 每个日志器每一代只查询一次名称
+				state = Matches(Logger::GetNameById(loggerId)) ? CACHE_MATCH : CACHE_MISMATCH;
+				entry->store((generation << 2) | state, std::memory_order_relaxed);
+			}
+			match = state == CACHE_MATCH;
+		}
+		else
+		{
+			// 只有同时存在超过 kCacheChunkSize * kMaxCacheChunks 个日志器时才会走到这里
+			match = Matches(Logger::GetNameById(loggerId));
+		}
+
+		if (!match)
+		{
+			return FilterDecision::NEUTRAL;
+		}
+		return m_pImpl->acceptOnMatch ? FilterDecision::ACCEPT : FilterDecision::DENY;
+	}
+
+	std::string LoggerNameFilter::GetName() const
+	{
+		return "LoggerNameFilter[" + Utils::StringUtil::Join(m_pImpl->names, ",") + "]";
+	}
+
+	Filter::Pointer LoggerNameFilter::Clone() const
+	{
+		return std::make_shared<LoggerNameFilter>(m_pImpl->names, m_pImpl->acceptOnMatch);
+	}
+
+	const std::vector<std::string> &LoggerNameFilter::GetNames() const
+	{
+		return m_pImpl->names;
+	}
+
+	bool LoggerNameFilter::GetAcceptOnMatch() const
+	{
+		return m_pImpl->acceptOnMatch;
+	}
+
+	bool LoggerNameFilter::Matches(const std::string &loggerName) const
+	{
+		for (const std::string &name : m_pImpl->names)
+		{
+			if (name == "*" || name == loggerName)
+			{
+				return true;
+			}
+			// "parent.*" 匹配 parent 本身及 "parent." 开头的子日志器
+			if (Utils::StringUtil::EndsWith(name, ".*"))
+			{
+				const size_t prefixLength = name.size() - 2;
+				if (loggerName.compare(0, prefixLength, name, 0, prefixLength) == 0 &&
+					(loggerName.size() == prefixLength || loggerName[prefixLength] == '.'))
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+} // namespace IDLog
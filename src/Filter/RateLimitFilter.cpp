@@ -0,0 +1,423 @@
+/**
+ * @Description: 限流过滤器源文件
+ * @Author: InverseDark
+ * @Date: 2026-10-19 00:48:05
+ * @LastEditTime: 2026-10-19 12:04:31
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/Filter/RateLimitFilter.h"
+
+#include "IDLog/Core/Logger.h"
+#include "IDLog/Utils/StringUtil.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace IDLog
+{
+	namespace
+	{
+		/// @brief 线性探测的最大次数，超过后使用溢出桶
+		constexpr size_t kMaxProbe = 16;
+
+		/// @brief 汇总输出被抑制条数的最短间隔（纳秒）
+		constexpr int64_t kMinSweepNs = 100000000;
+
+		/// @brief 令牌桶（独占缓存行，不同桶之间没有伪共享）
+		struct alignas(64) Bucket
+		{
+			std::atomic<uint64_t> key{0};				///< 键的哈希值，0表示空闲
+			std::atomic<int64_t> tat{0};				///< 理论到达时间（纳秒）：下一条日志最早在此时按平均速率放行
+			std::atomic<uint64_t> suppressed{0};		///< 上次放行后被拒绝的条数
+			std::atomic<const char *> fileName{nullptr}; ///< 首条被拒绝日志的源文件名，用于生成说明
+			std::atomic<int> lineNumber{0};				///< 首条被拒绝日志的行号
+			std::atomic<uint64_t> loggerKey{0};			///< 首条被拒绝日志的日志器键（编号与代数）
+			std::atomic<LogLevel> level{LogLevel::TRACE}; ///< 首条被拒绝日志的级别
+			std::atomic<bool> hasLoggerId{false};		///< 日志器编号是否有效（提前决策时才有）
+		};
+
+		/// @brief 混合哈希值（splitmix64 的终结步骤）
+		/// @param value [IN] 输入
+		/// @return 混合后的值
+		uint64_t Mix(uint64_t value)
+		{
+			value ^= value >> 30;
+			value *= 0xbf58476d1ce4e5b9ULL;
+			value ^= value >> 27;
+			value *= 0x94d049bb133111ebULL;
+			value ^= value >> 31;
+			return value;
+		}
+
+		/// @brief 获取单调时钟的当前时间（纳秒）
+		/// @return 当前时间
+		int64_t NowNs()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+					   std::chrono::steady_clock::now().time_since_epoch())
+				.count();
+		}
+	} // namespace
+
+	/// @brief 限流过滤器实现结构体
+	struct RateLimitFilter::Impl
+	{
+		std::unique_ptr<Bucket[]> buckets;		///< 桶表
+		Bucket overflow;						///< 溢出桶，桶表探测失败的键共用
+		std::atomic<uint64_t> totalSuppressed;	///< 累计被拒绝的条数
+		std::atomic<int64_t> nextSweepNs;		///< 下次汇总输出被抑制条数的时间（纳秒）
+		double rate;							///< 每秒放行条数
+		int64_t intervalNs;						///< 放行一条日志消耗的时间（纳秒）
+		int64_t windowNs;						///< 最多可以预支的时间（纳秒），即 burst 条日志的时间
+		int64_t sweepNs;						///< 汇总输出被抑制条数的间隔（纳秒）
+		size_t mask;							///< 桶表下标掩码
+		uint32_t burst;							///< 最多连续放行条数
+		unsigned keyFields;						///< 分桶依据
+		bool summaryEnabled;					///< 是否输出被抑制条数的说明
+
+		/// @brief 构造函数
+		Impl(double limitRate, uint32_t limitBurst, unsigned fields, size_t bucketCount, bool summary)
+			: totalSuppressed(0), nextSweepNs(0), rate(limitRate), intervalNs(0), windowNs(0), sweepNs(kMinSweepNs), mask(0),
+			  burst(std::max<uint32_t>(limitBurst, 1)), keyFields(fields & KEY_ALL), summaryEnabled(summary)
+		{
+			size_t count = 1;
+			while (count < bucketCount && count < (size_t(1) << 20))
+			{
+				count <<= 1;
+			}
+			buckets.reset(new Bucket[count]);
+			mask = count - 1;
+
+			if (rate > 0)
+			{
+				intervalNs = std::max<int64_t>(static_cast<int64_t>(1e9 / rate), 1);
+				windowNs = intervalNs * static_cast<int64_t>(burst);
+				sweepNs = std::max(windowNs, kMinSweepNs);
+			}
+		}
+
+		/// @brief 计算键的哈希值
+		/// @param loggerKey [IN] 日志器的键：提前决策时为日志器编号与代数，否则为日志器名称的哈希值
+		uint64_t HashKey(uint64_t loggerKey, LogLevel level, const SourceLocation &location) const
+		{
+			uint64_t hash = 0x9e3779b97f4a7c15ULL;
+			if (keyFields & KEY_LOGGER)
+			{
+				hash = Mix(hash ^ loggerKey);
+			}
+			if (keyFields & KEY_LEVEL)
+			{
+				hash = Mix(hash ^ (static_cast<uint64_t>(level) + 1));
+			}
+			if (keyFields & KEY_LOCATION)
+			{
+				// 调用点对象与文件名字符串都是静态的，比较地址即可，不需要读取字符串
+				uint64_t site = location.callSite ? reinterpret_cast<uintptr_t>(location.callSite)
+												  : reinterpret_cast<uintptr_t>(location.fileName) ^
+														(static_cast<uint64_t>(location.lineNumber) << 1);
+				hash = Mix(hash ^ site);
+			}
+			return hash != 0 ? hash : 1;
+		}
+
+		/// @brief 检查桶是否可以让给其他键：令牌已补满（空闲超过补满所需的时间），且没有待输出的说明
+		static bool IsIdle(const Bucket &bucket, int64_t now)
+		{
+			return bucket.tat.load(std::memory_order_relaxed) <= now &&
+				   bucket.suppressed.load(std::memory_order_relaxed) == 0;
+		}
+
+		/// @brief 查找或占用键对应的桶
+		/// @details 探测序列中遇到空闲桶前没有找到键时，优先接管序列中第一个空闲已久的桶，
+		///			 因此不再使用的键不会一直占着桶表。令牌补满的桶与新桶状态相同，接管不影响限流结果；
+		///			 与并发的查找竞争时，个别日志可能计入被接管的桶
+		Bucket &FindBucket(uint64_t hash, int64_t now)
+		{
+			Bucket *idle = nullptr;
+			uint64_t idleKey = 0;
+			for (size_t probe = 0; probe < kMaxProbe; ++probe)
+			{
+				Bucket &bucket = buckets[(hash + probe) & mask];
+				uint64_t key = bucket.key.load(std::memory_order_acquire);
+				if (key == hash)
+				{
+					return bucket;
+				}
+				if (key == 0)
+				{
+					// 键不会出现在空闲桶之后
+					if (idle != nullptr)
+					{
+						break;
+					}
+					if (bucket.key.compare_exchange_strong(key, hash, std::memory_order_acq_rel) || key == hash)
+					{
+						return bucket;
+					}
+				}
+				if (idle == nullptr && IsIdle(bucket, now))
+				{
+					idle = &bucket;
+					idleKey = key;
+				}
+			}
+			if (idle != nullptr &&
+				(idle->key.compare_exchange_strong(idleKey, hash, std::memory_order_acq_rel) || idleKey == hash))
+			{
+				return *idle;
+			}
+			return overflow;
+		}
+
+		/// @brief 从桶中取一个令牌（GCRA 算法，单个原子变量即可表示令牌桶）
+		/// @return 取到返回true
+		bool TryAcquire(Bucket &bucket, int64_t now)
+		{
+			int64_t tat = bucket.tat.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				int64_t next = std::max(tat, now) + intervalNs;
+				if (next - now > windowNs)
+				{
+					return false;
+				}
+				if (bucket.tat.compare_exchange_weak(tat, next, std::memory_order_relaxed))
+				{
+					return true;
+				}
+			}
+		}
+
+		/// @brief 生成说明（日志器名称由输出说明的日志器记录，不重复写入）
+		std::string Summarize(uint64_t suppressed, LogLevel level, const SourceLocation &location) const
+		{
+			std::string text = "suppressed " + std::to_string(suppressed) + " messages";
+			if (keyFields & KEY_LEVEL)
+			{
+				text += " at level ";
+				text += LevelToString(level);
+			}
+			if (keyFields & KEY_LOCATION)
+			{
+				text += " from " + location.GetShortFileName() + ":" + std::to_string(location.lineNumber);
+			}
+			return text;
+		}
+
+		/// @brief 取出桶中被抑制的条数，生成说明（按首条被拒绝日志的信息，可能由其他日志器输出，因此附带日志器名称）
+		/// @param bucket [IN] 桶
+		/// @param now [IN] 当前时间
+		/// @param idleOnly [IN] 是否只处理令牌已补满的桶（仍在限流的桶会在下次放行时输出说明）
+		/// @param notices [OUT] 说明追加到末尾
+		void CollectSummary(Bucket &bucket, int64_t now, bool idleOnly, std::vector<Notice> &notices)
+		{
+			if (bucket.suppressed.load(std::memory_order_relaxed) == 0 ||
+				(idleOnly && bucket.tat.load(std::memory_order_relaxed) > now))
+			{
+				return;
+			}
+			uint64_t suppressed = bucket.suppressed.exchange(0, std::memory_order_relaxed);
+			if (suppressed == 0)
+			{
+				return;
+			}
+			const char *fileName = bucket.fileName.load(std::memory_order_relaxed);
+			SourceLocation location(fileName ? fileName : "", "", bucket.lineNumber.load(std::memory_order_relaxed));
+			const LogLevel level = bucket.level.load(std::memory_order_relaxed);
+			std::string text = Summarize(suppressed, level, location);
+			if ((keyFields & KEY_LOGGER) && bucket.hasLoggerId.load(std::memory_order_relaxed))
+			{
+				// 编号已回收时不附带名称，避免写成另一个日志器
+				const uint64_t loggerKey = bucket.loggerKey.load(std::memory_order_relaxed);
+				const uint32_t loggerId = static_cast<uint32_t>(loggerKey);
+				if (Logger::GetIdGeneration(loggerId) == static_cast<uint32_t>(loggerKey >> 32))
+				{
+					text += " in logger " + Logger::GetNameById(loggerId);
+				}
+			}
+			notices.push_back({level, std::move(text)});
+		}
+
+		/// @brief 取出所有桶中被抑制的条数，生成说明
+		/// @param now [IN] 当前时间
+		/// @param idleOnly [IN] 是否只处理令牌已补满的桶
+		/// @param notices [OUT] 说明追加到末尾
+		void CollectSummaries(int64_t now, bool idleOnly, std::vector<Notice> &notices)
+		{
+			for (size_t i = 0; i <= mask; ++i)
+			{
+				CollectSummary(buckets[i], now, idleOnly, notices);
+			}
+			CollectSummary(overflow, now, idleOnly, notices);
+		}
+
+		/// @brief 每隔 sweepNs 由一条日志汇总输出已停止的键被抑制的条数，否则这些说明要等同一个键再次放行
+		/// @param now [IN] 当前时间
+		void MaybeSweep(int64_t now)
+		{
+			int64_t next = nextSweepNs.load(std::memory_order_relaxed);
+			if (now < next || !nextSweepNs.compare_exchange_strong(next, now + sweepNs, std::memory_order_relaxed))
+			{
+				return;
+			}
+			std::vector<Notice> notices;
+			CollectSummaries(now, true, notices);
+			for (Notice &notice : notices)
+			{
+				PostNotice(std::move(notice));
+			}
+		}
+
+		/// @brief 对一条日志做出限流决策
+		/// @param loggerKey [IN] 日志器的键
+		/// @param hasLoggerId [IN] 日志器的键是否为日志器编号与代数
+		FilterDecision Decide(uint64_t loggerKey, bool hasLoggerId, LogLevel level, const SourceLocation &location)
+		{
+			if (rate <= 0)
+			{
+				return FilterDecision::NEUTRAL;
+			}
+
+			const int64_t now = NowNs();
+			Bucket &bucket = FindBucket(HashKey(loggerKey, level, location), now);
+			if (!TryAcquire(bucket, now))
+			{
+				// 只在需要输出说明时按桶计数，否则桶不会因为计数而无法被接管
+				if (summaryEnabled && bucket.suppressed.fetch_add(1, std::memory_order_relaxed) == 0)
+				{
+					bucket.fileName.store(location.fileName, std::memory_order_relaxed);
+					bucket.lineNumber.store(location.lineNumber, std::memory_order_relaxed);
+					bucket.level.store(level, std::memory_order_relaxed);
+					bucket.loggerKey.store(loggerKey, std::memory_order_relaxed);
+					bucket.hasLoggerId.store(hasLoggerId, std::memory_order_relaxed);
+				}
+				totalSuppressed.fetch_add(1, std::memory_order_relaxed);
+				if (summaryEnabled)
+				{
+					MaybeSweep(now);
+				}
+				return FilterDecision::DENY;
+			}
+
+			// 桶恢复放行：只有一个线程能取走被抑制的条数，说明不会重复
+			if (bucket.suppressed.load(std::memory_order_relaxed) != 0)
+			{
+				uint64_t suppressed = bucket.suppressed.exchange(0, std::memory_order_relaxed);
+				if (suppressed != 0)
+				{
+					PostNotice({level, Summarize(suppressed, level, location)});
+				}
+			}
+			if (summaryEnabled)
+			{
+				MaybeSweep(now);
+			}
+			return FilterDecision::NEUTRAL;
+		}
+	};
+
+	RateLimitFilter::RateLimitFilter(double rate, uint32_t burst, unsigned keyFields, size_t bucketCount, bool summaryEnabled)
+		: m_pImpl(new Impl(rate, burst, keyFields, bucketCount, summaryEnabled))
+	{
+	}
+
+	RateLimitFilter::~RateLimitFilter()
+	{
+		delete m_pImpl;
+	}
+
+	FilterDecision RateLimitFilter::Decide(const LogEventPtr &event)
+	{
+		if (!event)
+		{
+			return FilterDecision::NEUTRAL;
+		}
+
+		return m_pImpl->Decide(std::hash<std::string>()(event->GetLoggerName()), false, event->GetLevel(),
+							   event->GetSourceLocation());
+	}
+
+	FilterDecision RateLimitFilter::PreDecide(LogLevel level, uint32_t loggerId, const SourceLocation &location)
+	{
+		// 键包含编号的代数，编号被回收给新日志器后不会沿用旧日志器的桶
+		const uint64_t loggerKey = (static_cast<uint64_t>(Logger::GetIdGeneration(loggerId)) << 32) | loggerId;
+		return m_pImpl->Decide(loggerKey, true, level, location);
+	}
+
+	void RateLimitFilter::Flush(std::vector<Notice> &notices)
+	{
+		m_pImpl->CollectSummaries(NowNs(), false, notices);
+	}
+
+	std::string RateLimitFilter::GetName() const
+	{
+		return "RateLimitFilter[" + Utils::StringUtil::Format("%g", m_pImpl->rate) + "/s, burst " +
+			   std::to_string(m_pImpl->burst) + "]";
+	}
+
+	Filter::Pointer RateLimitFilter::Clone() const
+	{
+		return std::make_shared<RateLimitFilter>(m_pImpl->rate, m_pImpl->burst, m_pImpl->keyFields,
+												 m_pImpl->mask + 1, m_pImpl->summaryEnabled);
+	}
+
+	double RateLimitFilter::GetRate() const
+	{
+		return m_pImpl->rate;
+	}
+
+	uint32_t RateLimitFilter::GetBurst() const
+	{
+		return m_pImpl->burst;
+	}
+
+	unsigned RateLimitFilter::GetKeyFields() const
+	{
+		return m_pImpl->keyFields;
+	}
+
+	size_t RateLimitFilter::GetBucketCount() const
+	{
+		return m_pImpl->mask + 1;
+	}
+
+	bool RateLimitFilter::IsSummaryEnabled() const
+	{
+		return m_pImpl->summaryEnabled;
+	}
+
+	uint64_t RateLimitFilter::GetSuppressedCount() const
+	{
+		return m_pImpl->totalSuppressed.load(std::memory_order_relaxed);
+	}
+
+	unsigned RateLimitFilter::ParseKeyFields(const std::string &text)
+	{
+		unsigned fields = 0;
+		for (std::string item : Utils::StringUtil::Split(text, ","))
+		{
+			item = Utils::StringUtil::ToLower(Utils::StringUtil::Trim(item));
+			if (item == "logger")
+			{
+				fields |= KEY_LOGGER;
+			}
+			else if (item == "level")
+			{
+				fields |= KEY_LEVEL;
+			}
+			else if (item == "location" || item == "callsite")
+			{
+				fields |= KEY_LOCATION;
+			}
+			else if (item == "all")
+			{
+				fields |= KEY_ALL;
+			}
+		}
+		return fields != 0 ? fields : KEY_ALL;
+	}
+} // namespace IDLog
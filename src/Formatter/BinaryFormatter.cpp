@@ -0,0 +1,476 @@
+/**
+ * @Description: 二进制格式化器源文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 14:18:03
+ * @LastEditTime: 2026-10-19 09:24:18
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/Formatter/BinaryFormatter.h"
+
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace IDLog
+{
+	namespace
+	{
+		/// @brief 段头魔数
+		const char kMagic[4] = {'I', 'D', 'L', 'B'};
+
+		/// @brief 字典种类数量（种类编号从1开始）
+		constexpr size_t kDictKindCount = 6;
+
+		/// @brief 追加无符号 varint
+		/// @param out [OUT] 输出缓冲区
+		/// @param value [IN] 数值
+		void PutVarint(std::string &out, uint64_t value)
+		{
+			char buf[10];
+			size_t n = 0;
+			while (value >= 0x80)
+			{
+				buf[n++] = static_cast<char>((value & 0x7F) | 0x80);
+				value >>= 7;
+			}
+			buf[n++] = static_cast<char>(value);
+			out.append(buf, n);
+		}
+
+		/// @brief 追加有符号 zigzag varint
+		/// @param out [OUT] 输出缓冲区
+		/// @param value [IN] 数值
+		void PutZigzag(std::string &out, int64_t value)
+		{
+			PutVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+		}
+
+		/// @brief 追加一帧
+		/// @param out [OUT] 输出缓冲区
+		/// @param type [IN] 帧类型
+		/// @param payload [IN] 负载
+		void PutFrame(std::string &out, BinaryFormatter::FrameType type, const std::string &payload)
+		{
+			out.push_back(static_cast<char>(type));
+			PutVarint(out, payload.size());
+			out.append(payload);
+		}
+
+		/// @brief 字节读取器
+		struct ByteReader
+		{
+			const unsigned char *data; ///< 数据指针
+			size_t size;			   ///< 数据长度
+			size_t pos;				   ///< 当前位置
+
+			/// @brief 读取无符号 varint
+			/// @param value [OUT] 数值
+			/// @return 是否读取成功
+			bool GetVarint(uint64_t &value)
+			{
+				value = 0;
+				for (unsigned shift = 0; shift < 64; shift += 7)
+				{
+					if (pos >= size)
+					{
+						return false;
+					}
+					unsigned char byte = data[pos++];
+					value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+					if ((byte & 0x80) == 0)
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+
+			/// @brief 读取有符号 zigzag varint
+			/// @param value [OUT] 数值
+			/// @return 是否读取成功
+			bool GetZigzag(int64_t &value)
+			{
+				uint64_t raw = 0;
+				if (!GetVarint(raw))
+				{
+					return false;
+				}
+				value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+				return true;
+			}
+
+			/// @brief 读取单字节
+			/// @param value [OUT] 字节
+			/// @return 是否读取成功
+			bool GetByte(unsigned char &value)
+			{
+				if (pos >= size)
+				{
+					return false;
+				}
+				value = data[pos++];
+				return true;
+			}
+
+			/// @brief 读取帧头
+			/// @param type [OUT] 帧类型
+			/// @param payloadOffset [OUT] 负载起始偏移
+			/// @param payloadSize [OUT] 负载长度
+			/// @return 是否读取到完整的帧
+			bool GetFrame(unsigned char &type, size_t &payloadOffset, size_t &payloadSize)
+			{
+				uint64_t length = 0;
+				if (!GetByte(type) || !GetVarint(length) || length > size - pos)
+				{
+					return false;
+				}
+				payloadOffset = pos;
+				payloadSize = static_cast<size_t>(length);
+				pos += payloadSize;
+				return true;
+			}
+		};
+
+		/// @brief 编码器字典表
+		struct EncoderDict
+		{
+			std::unordered_map<std::string, uint32_t> ids; ///< 字符串到编号的映射
+			std::unordered_map<const void *, uint32_t> pointerCache; ///< 指针到编号的缓存（用于源码位置中的字面量）
+			std::vector<std::string> names;				   ///< 编号到字符串的映射
+
+			/// @brief 清空字典
+			void Clear()
+			{
+				ids.clear();
+				pointerCache.clear();
+				names.clear();
+			}
+		};
+	} // namespace
+
+	/// @brief 二进制格式化器实现结构体
+	struct BinaryFormatter::Impl
+	{
+		std::mutex mutex;			  ///< 编码状态互斥锁
+		size_t segmentRecords;		  ///< 每段最多记录数
+		size_t recordsInSegment;	  ///< 当前段已写记录数
+		bool needSegment;			  ///< 下一条记录前是否需要写段头
+		int64_t lastTimeNs;			  ///< 上一条记录的时间戳（纳秒）
+		EncoderDict dicts[kDictKindCount]; ///< 各种类的字典
+		std::string payload;		  ///< 负载临时缓冲区
+
+		/// @brief 构造函数
+		/// @param records [IN] 每段最多记录数
+		explicit Impl(size_t records)
+			: segmentRecords(records), recordsInSegment(0), needSegment(true), lastTimeNs(0)
+		{
+		}
+
+		/// @brief 写出段头并清空字典
+		/// @param out [OUT] 输出缓冲区
+		/// @param baseTimeNs [IN] 段的基准时间
+		void StartSegment(std::string &out, int64_t baseTimeNs)
+		{
+			for (auto &dict : dicts)
+			{
+				dict.Clear();
+			}
+			payload.assign(kMagic, sizeof(kMagic));
+			payload.push_back(static_cast<char>(kVersion));
+			PutVarint(payload, static_cast<uint64_t>(baseTimeNs));
+			PutFrame(out, FrameType::SEGMENT, payload);
+
+			lastTimeNs = baseTimeNs;
+			recordsInSegment = 0;
+			needSegment = false;
+		}
+
+		/// @brief 写出字典项
+		/// @param out [OUT] 输出缓冲区
+		/// @param kind [IN] 字典种类
+		/// @param id [IN] 编号
+		/// @param data [IN] 字符串数据
+		/// @param size [IN] 字符串长度
+		void PutDict(std::string &out, DictKind kind, uint32_t id, const char *data, size_t size)
+		{
+			payload.clear();
+			payload.push_back(static_cast<char>(kind));
+			PutVarint(payload, id);
+			payload.append(data, size);
+			PutFrame(out, FrameType::DICT, payload);
+		}
+
+		/// @brief 查询字符串编号，首次出现时写出字典项
+		/// @param out [OUT] 输出缓冲区
+		/// @param kind [IN] 字典种类
+		/// @param str [IN] 字符串
+		/// @return 编号
+		uint32_t Intern(std::string &out, DictKind kind, const std::string &str)
+		{
+			EncoderDict &dict = dicts[static_cast<size_t>(kind)];
+			auto it = dict.ids.find(str);
+			if (it != dict.ids.end())
+			{
+				return it->second;
+			}
+			uint32_t id = static_cast<uint32_t>(dict.names.size());
+			dict.names.push_back(str);
+			dict.ids.emplace(str, id);
+			PutDict(out, kind, id, str.data(), str.size());
+			return id;
+		}
+
+		/// @brief 查询 C 字符串编号（先按指针查缓存并校验内容），首次出现时写出字典项
+		/// @param out [OUT] 输出缓冲区
+		/// @param kind [IN] 字典种类
+		/// @param str [IN] C 字符串（可为空指针）
+		/// @return 编号
+		uint32_t InternCString(std::string &out, DictKind kind, const char *str)
+		{
+			if (!str)
+			{
+				str = "";
+			}
+			EncoderDict &dict = dicts[static_cast<size_t>(kind)];
+			auto cached = dict.pointerCache.find(str);
+			if (cached != dict.pointerCache.end() && dict.names[cached->second] == str)
+			{
+				return cached->second;
+			}
+			uint32_t id = Intern(out, kind, std::string(str));
+			dict.pointerCache[str] = id;
+			return id;
+		}
+	};
+
+	BinaryFormatter::BinaryFormatter(size_t segmentRecords)
+		: m_pImpl(new Impl(segmentRecords))
+	{
+	}
+
+	BinaryFormatter::~BinaryFormatter()
+	{
+		delete m_pImpl;
+	}
+
+	std::string BinaryFormatter::Format(const LogEventPtr &event)
+	{
+		std::string out;
+		FormatTo(event, out);
+		return out;
+	}
+
+	void BinaryFormatter::FormatTo(const LogEventPtr &event, std::string &out)
+	{
+		if (!event)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+
+		int64_t timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+							 event->GetTime().time_since_epoch())
+							 .count();
+		if (m_pImpl->needSegment ||
+			(m_pImpl->segmentRecords > 0 && m_pImpl->recordsInSegment >= m_pImpl->segmentRecords))
+		{
+			m_pImpl->StartSegment(out, timeNs);
+		}
+
+		// 字典项必须先于引用它的记录写出
+		const SourceLocation &location = event->GetSourceLocation();
+		uint32_t threadId = m_pImpl->Intern(out, DictKind::THREAD_ID, event->GetThreadId());
+		uint32_t threadName = m_pImpl->Intern(out, DictKind::THREAD_NAME, event->GetThreadName());
+		uint32_t logger = m_pImpl->Intern(out, DictKind::LOGGER, event->GetLoggerName());
+		uint32_t file = m_pImpl->InternCString(out, DictKind::FILE, location.fileName);
+		uint32_t function = m_pImpl->InternCString(out, DictKind::FUNCTION, location.functionName);
+
+		std::string &payload = m_pImpl->payload;
+		payload.clear();
+		PutZigzag(payload, timeNs - m_pImpl->lastTimeNs);
+		payload.push_back(static_cast<char>(event->GetLevel()));
+		PutVarint(payload, threadId);
+		PutVarint(payload, threadName);
+		PutVarint(payload, logger);
+		PutVarint(payload, file);
+		PutVarint(payload, function);
+		PutVarint(payload, static_cast<uint64_t>(location.lineNumber < 0 ? 0 : location.lineNumber));
+		payload.append(event->GetLogMessageView());
+		PutFrame(out, FrameType::RECORD, payload);
+
+		m_pImpl->lastTimeNs = timeNs;
+		++m_pImpl->recordsInSegment;
+	}
+
+	Formatter::Pointer BinaryFormatter::Clone() const
+	{
+		return std::make_shared<BinaryFormatter>(GetSegmentRecords());
+	}
+
+	void BinaryFormatter::Reset()
+	{
+		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+		m_pImpl->needSegment = true;
+	}
+
+	void BinaryFormatter::SetSegmentRecords(size_t segmentRecords)
+	{
+		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+		m_pImpl->segmentRecords = segmentRecords;
+	}
+
+	size_t BinaryFormatter::GetSegmentRecords() const
+	{
+		std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+		return m_pImpl->segmentRecords;
+	}
+
+	std::vector<BinaryLogDecoder::Segment> BinaryLogDecoder::SplitSegments(const char *data, size_t size)
+	{
+		std::vector<Segment> segments;
+		ByteReader reader{reinterpret_cast<const unsigned char *>(data), size, 0};
+
+		size_t frameStart = 0;
+		unsigned char type = 0;
+		size_t payloadOffset = 0;
+		size_t payloadSize = 0;
+		while (reader.GetFrame(type, payloadOffset, payloadSize))
+		{
+			if (type == static_cast<unsigned char>(BinaryFormatter::FrameType::SEGMENT))
+			{
+				segments.push_back({frameStart, 0});
+			}
+			if (!segments.empty())
+			{
+				segments.back().size = reader.pos - segments.back().offset;
+			}
+			frameStart = reader.pos;
+		}
+		return segments;
+	}
+
+	bool BinaryLogDecoder::Decode(const char *data, size_t size, const EventCallback &callback)
+	{
+		ByteReader reader{reinterpret_cast<const unsigned char *>(data), size, 0};
+		std::deque<std::string> dicts[kDictKindCount]; // deque 追加元素时不移动已有元素，源码位置指针保持有效
+		bool inSegment = false;
+		int64_t lastTimeNs = 0;
+
+		unsigned char type = 0;
+		size_t payloadOffset = 0;
+		size_t payloadSize = 0;
+		while (reader.pos < size)
+		{
+			if (!reader.GetFrame(type, payloadOffset, payloadSize))
+			{
+				return false; // 帧被截断
+			}
+			ByteReader payload{reader.data + payloadOffset, payloadSize, 0};
+
+			switch (static_cast<BinaryFormatter::FrameType>(type))
+			{
+			case BinaryFormatter::FrameType::SEGMENT:
+			{
+				unsigned char version = 0;
+				uint64_t baseTimeNs = 0;
+				if (payloadSize < sizeof(kMagic) + 1 ||
+					std::memcmp(payload.data, kMagic, sizeof(kMagic)) != 0)
+				{
+					return false;
+				}
+				payload.pos = sizeof(kMagic);
+				if (!payload.GetByte(version) || version > BinaryFormatter::kVersion || !payload.GetVarint(baseTimeNs))
+				{
+					return false;
+				}
+				for (auto &dict : dicts)
+				{
+					dict.clear();
+				}
+				lastTimeNs = static_cast<int64_t>(baseTimeNs);
+				inSegment = true;
+				break;
+			}
+			case BinaryFormatter::FrameType::DICT:
+			{
+				unsigned char kind = 0;
+				uint64_t id = 0;
+				if (!inSegment || !payload.GetByte(kind) || kind == 0 || kind >= kDictKindCount || !payload.GetVarint(id))
+				{
+					return false;
+				}
+				// 编码器按顺序分配编号，只接受已有编号或下一个编号，损坏的编号不会导致超大分配
+				std::deque<std::string> &dict = dicts[kind];
+				if (id > dict.size())
+				{
+					return false;
+				}
+				if (id == dict.size())
+				{
+					dict.emplace_back();
+				}
+				dict[static_cast<size_t>(id)].assign(reinterpret_cast<const char *>(payload.data + payload.pos), payloadSize - payload.pos);
+				break;
+			}
+			case BinaryFormatter::FrameType::RECORD:
+			{
+				int64_t delta = 0;
+				unsigned char level = 0;
+				uint64_t ids[5] = {0};
+				uint64_t line = 0;
+				if (!inSegment || !payload.GetZigzag(delta) || !payload.GetByte(level))
+				{
+					return false;
+				}
+				for (auto &id : ids)
+				{
+					if (!payload.GetVarint(id))
+					{
+						return false;
+					}
+				}
+				if (!payload.GetVarint(line))
+				{
+					return false;
+				}
+
+				// 按记录中的顺序：线程ID、线程名、日志器、文件、函数
+				static const BinaryFormatter::DictKind kinds[5] = {
+					BinaryFormatter::DictKind::THREAD_ID, BinaryFormatter::DictKind::THREAD_NAME,
+					BinaryFormatter::DictKind::LOGGER, BinaryFormatter::DictKind::FILE,
+					BinaryFormatter::DictKind::FUNCTION};
+				const std::string *values[5] = {nullptr};
+				for (size_t i = 0; i < 5; ++i)
+				{
+					const std::deque<std::string> &dict = dicts[static_cast<size_t>(kinds[i])];
+					if (ids[i] >= dict.size())
+					{
+						return false;
+					}
+					values[i] = &dict[static_cast<size_t>(ids[i])];
+				}
+
+				lastTimeNs += delta;
+				LogEvent::TimePoint time{std::chrono::duration_cast<LogEvent::TimePoint::duration>(
+					std::chrono::nanoseconds(lastTimeNs))};
+				SourceLocation location(values[3]->c_str(), values[4]->c_str(), static_cast<int>(line));
+				std::string message(reinterpret_cast<const char *>(payload.data + payload.pos), payloadSize - payload.pos);
+				auto event = std::make_shared<LogEvent>(static_cast<LogLevel>(level), *values[2], message, location,
+														time, *values[0], *values[1]);
+				if (callback)
+				{
+					callback(event);
+				}
+				break;
+			}
+			default:
+				// 未知帧类型：跳过，保持向前兼容
+				break;
+			}
+		}
+		return true;
+	}
+
+} // namespace IDLog
@@ -1,72 +1,494 @@
-/** 
+/**
  * @Description: JSON 格式化器源文件
  * @Author: InverseDark
  * @Date: 2025-12-22 13:56:52
- * @LastEditTime: 2025-12-22 15:37:11
+ * @LastEditTime: 2026-10-19 12:33:27
  * @LastEditors: InverseDark
  */
 #include "IDLog/Formatter/JsonFormatter.h"
+#include "IDLog/Utils/JsonUtil.h"
 #include "IDLog/Utils/StringUtil.h"
 
-#include <iomanip>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace IDLog
 {
+	namespace
+	{
+		/// @brief 追加整数
+		/// @param out [OUT] 输出缓冲区
+		/// @param value [IN] 整数值
+		template <typename T>
+		void AppendInteger(std::string &out, T value)
+		{
+			char buf[24];
+			auto result = std::to_chars(buf, buf + sizeof(buf), value);
+			out.append(buf, static_cast<size_t>(result.ptr - buf));
+		}
+
+		/// @brief 追加转义后的 C 字符串
+		/// @param out [OUT] 输出缓冲区
+		/// @param str [IN] C 字符串（可为空指针）
+		/// @param validateUtf8 [IN] 是否校验 UTF-8
+		void AppendEscapedCString(std::string &out, const char *str, bool validateUtf8)
+		{
+			if (str)
+			{
+				Utils::JsonUtil::AppendEscaped(out, str, std::strlen(str), validateUtf8);
+			}
+		}
+
+		/// @brief 获取去掉路径的文件名
+		/// @param fileName [IN] 文件路径（可为空指针）
+		/// @return 文件名起始位置
+		const char *ShortFileName(const char *fileName)
+		{
+			if (!fileName)
+			{
+				return "";
+			}
+			const char *shortName = fileName;
+			for (const char *p = fileName; *p; ++p)
+			{
+				if (*p == '/' || *p == '\\')
+				{
+					shortName = p + 1;
+				}
+			}
+			return shortName;
+		}
+
+		/// @brief 追加文本时间戳 "YYYY-mm-dd HH:MM:SS.mmm"（按秒缓存日期部分）
+		/// @param out [OUT] 输出缓冲区
+		/// @param time [IN] 时间点
+		void AppendTextTimestamp(std::string &out, const LogEvent::TimePoint &time)
+		{
+			static thread_local time_t t_lastSecond = -1;
+			static thread_local char t_timeCache[32] = {0};
+			static thread_local size_t t_timeCacheSize = 0;
+
+			time_t currentSecond = std::chrono::system_clock::to_time_t(time);
+			if (currentSecond != t_lastSecond)
+			{
+				t_lastSecond = currentSecond;
+				std::tm tm;
+#ifdef IDLOG_PLATFORM_WINDOWS
+				localtime_s(&tm, &currentSecond);
+#else
+				localtime_r(&currentSecond, &tm);
+#endif
+				t_timeCacheSize = std::strftime(t_timeCache, sizeof(t_timeCache), "%Y-%m-%d %H:%M:%S", &tm);
+			}
+
+			auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000;
+			if (ms < 0)
+			{
+				ms += 1000;
+			}
+			char msBuf[4] = {'.', static_cast<char>('0' + ms / 100), static_cast<char>('0' + (ms / 10) % 10), static_cast<char>('0' + ms % 10)};
+			out.append(t_timeCache, t_timeCacheSize);
+			out.append(msBuf, sizeof(msBuf));
+		}
+
+		/// @brief 字段名与枚举的对应表
+		struct FieldName
+		{
+			const char *name;		   ///< 字段名
+			JsonFormatter::Field field; ///< 字段枚举
+		};
+
+		const FieldName kFieldNames[] = {
+			{"timestamp", JsonFormatter::Field::TIMESTAMP},
+			{"level", JsonFormatter::Field::LEVEL},
+			{"logger", JsonFormatter::Field::LOGGER},
+			{"thread", JsonFormatter::Field::THREAD},
+			{"thread_name", JsonFormatter::Field::THREAD_NAME},
+			{"file", JsonFormatter::Field::FILE},
+			{"function", JsonFormatter::Field::FUNCTION},
+			{"line", JsonFormatter::Field::LINE},
+			{"message", JsonFormatter::Field::MESSAGE},
+		};
+	} // namespace
+
+	/// @brief 编译后的字段
+	struct CompiledJsonField
+	{
+		JsonFormatter::Field field; ///< 字段
+		std::string key;			///< 输出键名
+		bool optional;				///< 值为空时是否省略
+		std::string keyFragment;	///< 预计算的键名片段，如 "key": 或   "key":
+	};
+
+	/// @brief JSON 格式化器实现结构体
+	struct JsonFormatter::Impl
+	{
+		/// @brief 编译后的输出结构（发布后不再修改）
+		struct Schema
+		{
+			bool prettyPrint = false;				///< 是否美化输出
+			bool validateUtf8 = false;				///< 是否校验 UTF-8
+			TimestampFormat timestampFormat = TimestampFormat::TEXT; ///< 时间戳格式
+			std::vector<CompiledJsonField> fields;	///< 字段列表
+			std::vector<std::pair<std::string, std::string>> staticFields; ///< 静态字段
+			std::string staticFragment;				///< 预计算的静态字段片段（含前导分隔符）
+			std::string openFragment;				///< 对象起始片段
+			std::string closeFragment;				///< 对象结束片段
+			std::string separator;					///< 字段分隔符
+
+			/// @brief 根据当前设置重新计算键名片段
+			void Compile()
+			{
+				const char *indent = prettyPrint ? "  " : "";
+				const char *colon = prettyPrint ? ": " : ":";
+
+				openFragment = prettyPrint ? "{\n" : "{";
+				closeFragment = prettyPrint ? "\n}\n" : "}\n";
+				separator = prettyPrint ? ",\n" : ",";
+
+				for (auto &field : fields)
+				{
+					field.keyFragment = indent;
+					field.keyFragment += '"';
+					Utils::JsonUtil::AppendEscaped(field.keyFragment, field.key);
+					field.keyFragment += '"';
+					field.keyFragment += colon;
+				}
+
+				staticFragment.clear();
+				for (const auto &[key, value] : staticFields)
+				{
+					staticFragment += separator;
+					staticFragment += indent;
+					staticFragment += '"';
+					Utils::JsonUtil::AppendEscaped(staticFragment, key);
+					staticFragment += '"';
+					staticFragment += colon;
+					staticFragment += '"';
+					Utils::JsonUtil::AppendEscaped(staticFragment, value);
+					staticFragment += '"';
+				}
+			}
+		};
+
+		std::atomic<const Schema *> schema;			 ///< 当前输出结构，格式化时无锁读取
+		std::vector<std::unique_ptr<Schema>> schemas; ///< 发布过的全部输出结构，其他线程可能仍在读取旧结构，析构时释放
+		std::mutex mutex;							 ///< 串行化修改
+
+		/// @brief 构造函数
+		Impl() : schema(nullptr) {}
+
+		/// @brief 复制当前输出结构，修改后编译并发布（写时复制：正在格式化的线程继续使用旧结构）
+		/// @param modify [IN] 修改函数
+		template <typename Modify>
+		void Update(Modify modify)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			const Schema *current = schema.load(std::memory_order_relaxed);
+			auto next = current ? std::make_unique<Schema>(*current) : std::make_unique<Schema>();
+			modify(*next);
+			next->Compile();
+			schemas.push_back(std::move(next));
+			schema.store(schemas.back().get(), std::memory_order_release);
+		}
+
+		/// @brief 获取当前输出结构
+		/// @return 当前输出结构
+		const Schema &Current() const
+		{
+			return *schema.load(std::memory_order_acquire);
+		}
+	};
 
 	JsonFormatter::JsonFormatter(bool prettyPrint)
-		: m_prettyPrint(prettyPrint)
+		: m_pImpl(new Impl)
 	{
+		// 默认 schema：全部字段，键名与字段名相同
+		m_pImpl->Update([prettyPrint](Impl::Schema &schema)
+						{
+							schema.prettyPrint = prettyPrint;
+							for (const auto &entry : kFieldNames)
+							{
+								schema.fields.push_back({entry.field, entry.name, false, ""});
+							}
+						});
+	}
+
+	JsonFormatter::~JsonFormatter()
+	{
+		delete m_pImpl;
 	}
 
 	std::string JsonFormatter::Format(const LogEventPtr &event)
+	{
+		std::string out;
+		out.reserve(256);
+		FormatTo(event, out);
+		return out;
+	}
+
+	void JsonFormatter::FormatTo(const LogEventPtr &event, std::string &out)
 	{
 		if (!event)
-			return "{}";
+		{
+			out.append("{}");
+			return;
+		}
+
+		// 整条日志使用同一份输出结构，并发修改只影响之后的日志
+		const Impl::Schema &schema = m_pImpl->Current();
+		const bool validate = schema.validateUtf8;
+		const SourceLocation &location = event->GetSourceLocation();
+		bool first = true;
+
+		out.append(schema.openFragment);
+		for (const auto &field : schema.fields)
+		{
+			// 可选字段在值为空时省略
+			if (field.optional)
+			{
+				bool empty = false;
+				switch (field.field)
+				{
+				case Field::LOGGER:
+					empty = event->GetLoggerName().empty();
+					break;
+				case Field::THREAD_NAME:
+					empty = event->GetThreadName().empty();
+					break;
+				case Field::FILE:
+					empty = !location.fileName || *location.fileName == '\0';
+					break;
+				case Field::FUNCTION:
+					empty = !location.functionName || *location.functionName == '\0';
+					break;
+				case Field::LINE:
+					empty = location.lineNumber == 0;
+					break;
+				case Field::MESSAGE:
+					empty = event->GetLogMessageView().empty();
+					break;
+				default:
+					break;
+				}
+				if (empty)
+				{
+					continue;
+				}
+			}
 
-		std::stringstream ss;
+			if (!first)
+			{
+				out.append(schema.separator);
+			}
+			first = false;
+			out.append(field.keyFragment);
 
-		if (m_prettyPrint)
+			switch (field.field)
+			{
+			case Field::TIMESTAMP:
+				if (schema.timestampFormat == TimestampFormat::TEXT)
+				{
+					out.push_back('"');
+					AppendTextTimestamp(out, event->GetTime());
+					out.push_back('"');
+				}
+				else
+				{
+					auto sinceEpoch = event->GetTime().time_since_epoch();
+					long long value = (schema.timestampFormat == TimestampFormat::EPOCH_NS)
+										  ? std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count()
+										  : std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch).count();
+					AppendInteger(out, value);
+				}
+				break;
+			case Field::LEVEL:
+				out.push_back('"');
+				out.append(LevelToString(event->GetLevel()));
+				out.push_back('"');
+				break;
+			case Field::LOGGER:
+				out.push_back('"');
+				Utils::JsonUtil::AppendEscaped(out, event->GetLoggerName(), validate);
+				out.push_back('"');
+				break;
+			case Field::THREAD:
+				out.push_back('"');
+				out.append(event->GetThreadId());
+				out.push_back('"');
+				break;
+			case Field::THREAD_NAME:
+				out.push_back('"');
+				Utils::JsonUtil::AppendEscaped(out, event->GetThreadName(), validate);
+				out.push_back('"');
+				break;
+			case Field::FILE:
+				out.push_back('"');
+				AppendEscapedCString(out, ShortFileName(location.fileName), validate);
+				out.push_back('"');
+				break;
+			case Field::FUNCTION:
+				out.push_back('"');
+				AppendEscapedCString(out, location.functionName, validate);
+				out.push_back('"');
+				break;
+			case Field::LINE:
+				AppendInteger(out, location.lineNumber);
+				break;
+			case Field::MESSAGE:
+				out.push_back('"');
+				{
+					std::string_view message = event->GetLogMessageView();
+					Utils::JsonUtil::AppendEscaped(out, message.data(), message.size(), validate);
+				}
+				out.push_back('"');
+				break;
+			}
+		}
+
+		if (!schema.staticFragment.empty())
 		{
-			ss << "{\n";
-			ss << "  \"timestamp\": \"" << event->GetFormattedTime() << "."
-			   << std::setfill('0') << std::setw(3) << event->GetMilliseconds() << "\",\n";
-			ss << "  \"level\": \"" << LevelToString(event->GetLevel()) << "\",\n";
-			ss << "  \"logger\": \"" << EscapeJson(event->GetLoggerName()) << "\",\n";
-			ss << "  \"thread\": \"" << event->GetThreadId() << "\",\n";
-			ss << "  \"thread_name\": \"" << EscapeJson(event->GetThreadName()) << "\",\n";
-			ss << "  \"file\": \"" << EscapeJson(event->GetSourceLocation().GetShortFileName()) << "\",\n";
-			ss << "  \"function\": \"" << EscapeJson(event->GetSourceLocation().functionName) << "\",\n";
-			ss << "  \"line\": " << event->GetSourceLocation().lineNumber << ",\n";
-			ss << "  \"message\": \"" << EscapeJson(event->GetLogMessage()) << "\"\n";
-			ss << "}\n";
+			// 静态片段以分隔符开头，没有动态字段时跳过该分隔符
+			size_t skip = first ? schema.separator.size() : 0;
+			out.append(schema.staticFragment, skip, std::string::npos);
 		}
-		else
+		out.append(schema.closeFragment);
+	}
+
+	Formatter::Pointer JsonFormatter::Clone() const
+	{
+		const Impl::Schema &schema = m_pImpl->Current();
+		auto formatter = std::make_shared<JsonFormatter>(schema.prettyPrint);
+		formatter->m_pImpl->Update([&schema](Impl::Schema &target)
+								   { target = schema; });
+		return formatter;
+	}
+
+	void JsonFormatter::SetPrettyPrint(bool pretty)
+	{
+		m_pImpl->Update([pretty](Impl::Schema &schema)
+						{ schema.prettyPrint = pretty; });
+	}
+
+	bool JsonFormatter::GetPrettyPrint() const
+	{
+		return m_pImpl->Current().prettyPrint;
+	}
+
+	void JsonFormatter::SetValidateUtf8(bool validate)
+	{
+		m_pImpl->Update([validate](Impl::Schema &schema)
+						{ schema.validateUtf8 = validate; });
+	}
+
+	bool JsonFormatter::GetValidateUtf8() const
+	{
+		return m_pImpl->Current().validateUtf8;
+	}
+
+	void JsonFormatter::SetTimestampFormat(TimestampFormat format)
+	{
+		m_pImpl->Update([format](Impl::Schema &schema)
+						{ schema.timestampFormat = format; });
+	}
+
+	JsonFormatter::TimestampFormat JsonFormatter::GetTimestampFormat() const
+	{
+		return m_pImpl->Current().timestampFormat;
+	}
+
+	bool JsonFormatter::SetFields(const std::string &spec)
+	{
+		bool ok = true;
+		std::vector<CompiledJsonField> fields;
+
+		for (std::string item : Utils::StringUtil::Split(spec, ","))
 		{
-			ss << "{";
-			ss << "\"timestamp\":\"" << event->GetFormattedTime() << "."
-			   << std::setfill('0') << std::setw(3) << event->GetMilliseconds() << "\",";
-			ss << "\"level\":\"" << LevelToString(event->GetLevel()) << "\",";
-			ss << "\"logger\":\"" << EscapeJson(event->GetLoggerName()) << "\",";
-			ss << "\"thread\":\"" << event->GetThreadId() << "\",";
-			ss << "\"thread_name\":\"" << EscapeJson(event->GetThreadName()) << "\",";
-			ss << "\"file\":\"" << EscapeJson(event->GetSourceLocation().GetShortFileName()) << "\",";
-			ss << "\"function\":\"" << EscapeJson(event->GetSourceLocation().functionName) << "\",";
-			ss << "\"line\":" << event->GetSourceLocation().lineNumber << ",";
-			ss << "\"message\":\"" << EscapeJson(event->GetLogMessage()) << "\"";
-			ss << "}\n";
+			Utils::StringUtil::Trim(item);
+			if (item.empty())
+			{
+				continue;
+			}
+
+			bool optional = false;
+			if (item.back() == '?')
+			{
+				optional = true;
+				item.pop_back();
+			}
+
+			std::string name = item;
+			std::string key;
+			size_t colon = item.find(':');
+			if (colon != std::string::npos)
+			{
+				name = item.substr(0, colon);
+				key = item.substr(colon + 1);
+				Utils::StringUtil::Trim(name);
+				Utils::StringUtil::Trim(key);
+			}
+
+			bool found = false;
+			for (const auto &entry : kFieldNames)
+			{
+				if (name == entry.name)
+				{
+					fields.push_back({entry.field, key.empty() ? entry.name : key, optional, ""});
+					found = true;
+					break;
+				}
+			}
+			ok = ok && found;
 		}
 
-		return ss.str();
+		// 有无法识别的字段时保留原来的字段列表，避免输出残缺的结构
+		if (ok)
+		{
+			m_pImpl->Update([&fields](Impl::Schema &schema)
+							{ schema.fields = std::move(fields); });
+		}
+		return ok;
 	}
 
-	Formatter::Pointer JsonFormatter::Clone() const
+	void JsonFormatter::AddField(Field field, const std::string &key, bool optional)
 	{
-		return std::make_shared<JsonFormatter>(m_prettyPrint);
+		m_pImpl->Update([&](Impl::Schema &schema)
+						{ schema.fields.push_back({field, key.empty() ? GetDefaultKey(field) : key, optional, ""}); });
 	}
 
-	std::string JsonFormatter::EscapeJson(const std::string &str) const
+	void JsonFormatter::ClearFields()
 	{
-		return Utils::StringUtil::Escape(str);
+		m_pImpl->Update([](Impl::Schema &schema)
+						{ schema.fields.clear(); });
+	}
+
+	void JsonFormatter::AddStaticField(const std::string &key, const std::string &value)
+	{
+		m_pImpl->Update([&](Impl::Schema &schema)
+						{ schema.staticFields.emplace_back(key, value); });
+	}
+
+	void JsonFormatter::ClearStaticFields()
+	{
+		m_pImpl->Update([](Impl::Schema &schema)
+						{ schema.staticFields.clear(); });
+	}
+
+	const char *JsonFormatter::GetDefaultKey(Field field)
+	{
+		for (const auto &entry : kFieldNames)
+		{
+			if (entry.field == field)
+			{
+				return entry.name;
+			}
+		}
+		return "";
 	}
 
-} // namespace IDLog
\ No newline at end of file
+} // namespace IDLog
@@ -2,13 +2,16 @@
  * @Description: 模式格式化器源文件
  * @Author: InverseDark
  * @Date: 2025-12-18 21:50:31
- * @LastEditTime: 2025-12-18 22:01:25
+ * @LastEditTime: 2026-10-19 10:06:12
  * @LastEditors: InverseDark
  */
 #include "IDLog/Formatter/PatternFormatter.h"
 #include "IDLog/Utils/StringUtil.h"
 
+#include <atomic>
 #include <iomanip>
+#include <memory>
+#include <mutex>
 
 namespace IDLog
 {
@@ -44,8 +47,20 @@ namespace IDLog
 		public:
 			void Format(const LogEventPtr &event, std::ostream &os) override
 			{
-				if (event)
-					os << m_options.Apply(event->GetLogMessage());
+				if (!event)
+				{
+					return;
+				}
+				// 没有宽度设置时直接输出视图，静态消息不生成字符串
+				std::string_view message = event->GetLogMessageView();
+				if (m_options.width <= 0)
+				{
+					os.write(message.data(), static_cast<std::streamsize>(message.size()));
+				}
+				else
+				{
+					os << m_options.Apply(std::string(message));
+				}
 			}
 		};
 
@@ -252,21 +267,270 @@ namespace IDLog
 				os << '\t';
 			}
 		};
+
+		/// @brief 解析模式字符串
+		/// @param pattern [IN] 模式字符串
+		/// @param items [OUT] 解析后的格式化项列表
+		void ParsePattern(const std::string &pattern, std::vector<PatternItem::Pointer> &items)
+		{
+			size_t pos = 0;								 // 当前解析位置
+			const size_t len = pattern.length(); // 模式字符串长度
+
+			// 解析循环
+			while (pos < len)
+			{
+				// 处理转义字符
+				if (pattern[pos] == '%')
+				{
+					if (pos + 1 >= len)
+					{
+						// 单独的 '%'，作为字面文本处理
+						items.push_back(std::make_shared<LiteralItem>("%"));
+						break;
+					}
+
+					// 解析格式化选项
+					FormatOptions options;
+					char next = pattern[++pos];
+
+					// 处理对齐和宽度
+					if (next == '-')
+					{
+						options.leftAlign = true;
+						if (pos + 1 >= len)
+							break;
+						next = pattern[++pos];
+					}
+
+					// 检查是否有宽度数字
+					if (std::isdigit(next))
+					{
+						std::string widthStr;
+						while (pos < len && std::isdigit(pattern[pos]))
+						{
+							widthStr.push_back(pattern[pos++]);
+						}
+						options.width = std::stoi(widthStr);
+
+						if (pos >= len)
+							break;
+						next = pattern[pos];
+					}
+
+					// 根据格式字符创建对应的模式项
+					PatternItem::Pointer item;
+					switch (next)
+					{
+					case 'd':
+					{
+						// 日期时间
+						if (pos + 1 < len && pattern[pos + 1] == '{')
+						{
+							// 提取日期格式
+							size_t endBrace = pattern.find('}', pos + 2);
+							if (endBrace != std::string::npos)
+							{
+								std::string dateFormat = pattern.substr(pos + 2, endBrace - (pos + 2));
+								auto datetimeItem = std::make_shared<DateTimeItem>(dateFormat);
+								datetimeItem->SetOptions(options);
+								item = datetimeItem;
+								pos = endBrace + 1; // 更新位置到右括号后
+							}
+							else
+							{
+								auto datetimeItem = std::make_shared<DateTimeItem>();
+								datetimeItem->SetOptions(options);
+								item = datetimeItem;
+								pos++; // 没有找到右括号，继续解析
+							}
+						}
+						else
+						{
+							// 默认日期时间格式
+							auto datetimeItem = std::make_shared<DateTimeItem>();
+							datetimeItem->SetOptions(options);
+							item = datetimeItem;
+							pos++;
+						}
+						break;
+					}
+					case 'm':
+					{
+						// 消息或毫秒
+						if (pos + 1 < len && pattern[pos + 1] == 's')
+						{
+							auto msItem = std::make_shared<MillisecondsItem>();
+							msItem->SetOptions(options);
+							item = msItem;
+							pos += 2;
+						}
+						else
+						{
+							auto msgItem = std::make_shared<MessageItem>();
+							msgItem->SetOptions(options);
+							item = msgItem;
+							pos++;
+						}
+						break;
+					}
+					case 'p':
+					{
+						// 日志级别
+						auto levelItem = std::make_shared<LevelItem>();
+						levelItem->SetOptions(options);
+						item = levelItem;
+						pos++;
+						break;
+					}
+					case 'c':
+					{
+						// 日志器名称
+						auto loggerItem = std::make_shared<LoggerNameItem>();
+						loggerItem->SetOptions(options);
+						item = loggerItem;
+						pos++;
+						break;
+					}
+					case 't':
+					{
+						// 线程ID
+						auto threadIdItem = std::make_shared<ThreadIdItem>();
+						threadIdItem->SetOptions(options);
+						item = threadIdItem;
+						pos++;
+						break;
+					}
+					case 'T':
+					{
+						// 线程名称
+						auto threadNameItem = std::make_shared<ThreadNameItem>();
+						threadNameItem->SetOptions(options);
+						item = threadNameItem;
+						pos++;
+						break;
+					}
+					case 'n':
+					{
+						// 换行符
+						item = std::make_shared<NewLineItem>();
+						pos++;
+						break;
+					}
+					case 'F':
+					{
+						// 源文件名
+						auto fileItem = std::make_shared<FileNameItem>();
+						fileItem->SetOptions(options);
+						item = fileItem;
+						pos++;
+						break;
+					}
+					case 'f':
+					{
+						// 函数名
+						auto funcItem = std::make_shared<FunctionNameItem>();
+						funcItem->SetOptions(options);
+						item = funcItem;
+						pos++;
+						break;
+					}
+					case 'L':
+					{
+						// 行号
+						auto lineItem = std::make_shared<LineNumberItem>();
+						lineItem->SetOptions(options);
+						item = lineItem;
+						pos++;
+						break;
+					}
+					case 'l':
+					{
+						// 源文件位置
+						auto srcLocItem = std::make_shared<SourceLocationItem>();
+						srcLocItem->SetOptions(options);
+						item = srcLocItem;
+						pos++;
+						break;
+					}
+					case '%':
+					{
+						// 百分号
+						item = std::make_shared<LiteralItem>("%");
+						pos++;
+						break;
+					}
+					case '\t':
+					{
+						// 制表符
+						item = std::make_shared<TabItem>();
+						pos++;
+						break;
+					}
+					default:
+					{
+						// 未知格式，作为字面文本处理
+						item = std::make_shared<LiteralItem>("%" + std::string(1, next));
+						pos++;
+						break;
+					}
+					}
+
+					if (item)
+					{
+						items.push_back(item);
+					}
+				}
+				else
+				{
+					// 处理字面文本
+					size_t start = pos;
+					while (pos < len && pattern[pos] != '%')
+					{
+						pos++;
+					}
+					std::string literalText = pattern.substr(start, pos - start);
+					if (!literalText.empty())
+					{
+						items.push_back(std::make_shared<LiteralItem>(literalText));
+					}
+				}
+			}
+		}
 	} // namespace anonymous
 
 	/// @brief 模式格式化器实现结构体
 	struct PatternFormatter::Impl
 	{
-		std::string pattern;					   ///< 模式字符串
-		std::vector<PatternItem::Pointer> items; ///< 解析后的格式化项列表
+		/// @brief 解析结果，发布后不再修改
+		struct State
+		{
+			std::string pattern;					 ///< 模式字符串
+			std::vector<PatternItem::Pointer> items; ///< 解析后的格式化项列表
+		};
+
+		std::atomic<const State *> state;			///< 当前解析结果，格式化时无锁读取
+		std::vector<std::unique_ptr<State>> states; ///< 发布过的全部解析结果，其他线程可能仍在读取旧结果，析构时释放
+		std::mutex mutex;							///< 串行化 SetPattern
+
+		/// @brief 解析并发布新的模式字符串（写时复制：正在格式化的线程继续使用旧结果）
+		/// @param pattern [IN] 模式字符串
+		void Publish(const std::string &pattern)
+		{
+			auto next = std::make_unique<State>();
+			next->pattern = pattern;
+			ParsePattern(next->pattern, next->items);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			states.push_back(std::move(next));
+			state.store(states.back().get(), std::memory_order_release);
+		}
 	};
 
 	PatternFormatter::PatternFormatter(const std::string &pattern)
 		: m_pImpl(new Impl)
 	{
-		m_pImpl->pattern = pattern;
 		// 解析模式字符串
-		ParsePattern();
+		m_pImpl->Publish(pattern);
 	}
 
 	PatternFormatter::~PatternFormatter()
@@ -279,10 +543,16 @@ namespace IDLog
 		return "%d{%Y-%m-%d %H:%M:%S}.%ms [%t] %-5p %c - %m%n";
 	}
 
+	const PatternFormatter::Pointer &PatternFormatter::GetDefault()
+	{
+		static const Pointer instance = std::make_shared<PatternFormatter>();
+		return instance;
+	}
+
 	std::string PatternFormatter::Format(const LogEventPtr &event)
 	{
 		std::stringstream ss;
-		for (const auto &item : m_pImpl->items)
+		for (const auto &item : m_pImpl->state.load(std::memory_order_acquire)->items)
 		{
 			item->Format(event, ss);
 		}
@@ -291,247 +561,17 @@ namespace IDLog
 
 	PatternFormatter::Pointer PatternFormatter::Clone() const
 	{
-		return std::make_shared<PatternFormatter>(m_pImpl->pattern);
+		return std::make_shared<PatternFormatter>(GetPattern());
 	}
 
 	const std::string &PatternFormatter::GetPattern() const
 	{
-		return m_pImpl->pattern;
+		return m_pImpl->state.load(std::memory_order_acquire)->pattern;
 	}
 
 	void PatternFormatter::SetPattern(const std::string &pattern)
 	{
-		m_pImpl->pattern = pattern;
-		ParsePattern();
-	}
-
-	void PatternFormatter::ParsePattern()
-	{
-		// 清空已有项
-		m_pImpl->items.clear();
-
-		size_t pos = 0;									// 当前解析位置
-		const size_t len = m_pImpl->pattern.length(); // 模式字符串长度
-
-		// 解析循环
-		while (pos < len)
-		{
-			// 处理转义字符
-			if (m_pImpl->pattern[pos] == '%')
-			{
-				if (pos + 1 >= len)
-				{
-					// 单独的 '%'，作为字面文本处理
-					m_pImpl->items.push_back(std::make_shared<LiteralItem>("%"));
-					break;
-				}
-
-				// 解析格式化选项
-				FormatOptions options;
-				char next = m_pImpl->pattern[++pos];
-
-				// 处理对齐和宽度
-				if (next == '-')
-				{
-					options.leftAlign = true;
-					if (pos + 1 >= len)
-						break;
-					next = m_pImpl->pattern[++pos];
-				}
-
-				// 检查是否有宽度数字
-				if (std::isdigit(next))
-				{
-					std::string widthStr;
-					while (pos < len && std::isdigit(m_pImpl->pattern[pos]))
-					{
-						widthStr.push_back(m_pImpl->pattern[pos++]);
-					}
-					options.width = std::stoi(widthStr);
-
-					if (pos >= len)
-						break;
-					next = m_pImpl->pattern[pos];
-				}
-
-				// 根据格式字符创建对应的模式项
-				PatternItem::Pointer item;
-				switch (next)
-				{
-				case 'd':
-				{
-					// 日期时间
-					if (pos + 1 < len && m_pImpl->pattern[pos + 1] == '{')
-					{
-						// 提取日期格式
-						size_t endBrace = m_pImpl->pattern.find('}', pos + 2);
-						if (endBrace != std::string::npos)
-						{
-							std::string dateFormat = m_pImpl->pattern.substr(pos + 2, endBrace - (pos + 2));
-							auto datetimeItem = std::make_shared<DateTimeItem>(dateFormat);
-							datetimeItem->SetOptions(options);
-							item = datetimeItem;
-							pos = endBrace + 1; // 更新位置到右括号后
-						}
-						else
-						{
-							auto datetimeItem = std::make_shared<DateTimeItem>();
-							datetimeItem->SetOptions(options);
-							item = datetimeItem;
-							pos++; // 没有找到右括号，继续解析
-						}
-					}
-					else
-					{
-						// 默认日期时间格式
-						auto datetimeItem = std::make_shared<DateTimeItem>();
-						datetimeItem->SetOptions(options);
-						item = datetimeItem;
-						pos++;
-					}
-					break;
-				}
-				case 'm':
-				{
-					// 消息或毫秒
-					if (pos + 1 < len && m_pImpl->pattern[pos + 1] == 's')
-					{
-						auto msItem = std::make_shared<MillisecondsItem>();
-						msItem->SetOptions(options);
-						item = msItem;
-						pos += 2;
-					}
-					else
-					{
-						auto msgItem = std::make_shared<MessageItem>();
-						msgItem->SetOptions(options);
-						item = msgItem;
-						pos++;
-					}
-					break;
-				}
-				case 'p':
-				{
-					// 日志级别
-					auto levelItem = std::make_shared<LevelItem>();
-					levelItem->SetOptions(options);
-					item = levelItem;
-					pos++;
-					break;
-				}
-				case 'c':
-				{
-					// 日志器名称
-					auto loggerItem = std::make_shared<LoggerNameItem>();
-					loggerItem->SetOptions(options);
-					item = loggerItem;
-					pos++;
-					break;
-				}
-				case 't':
-				{
-					// 线程ID
-					auto threadIdItem = std::make_shared<ThreadIdItem>();
-					threadIdItem->SetOptions(options);
-					item = threadIdItem;
-					pos++;
-					break;
-				}
-				case 'T':
-				{
-					// 线程名称
-					auto threadNameItem = std::make_shared<ThreadNameItem>();
-					threadNameItem->SetOptions(options);
-					item = threadNameItem;
-					pos++;
-					break;
-				}
-				case 'n':
-				{
-					// 换行符
-					item = std::make_shared<NewLineItem>();
-					pos++;
-					break;
-				}
-				case 'F':
-				{
-					// 源文件名
-					auto fileItem = std::make_shared<FileNameItem>();
-					fileItem->SetOptions(options);
-					item = fileItem;
-					pos++;
-					break;
-				}
-				case 'f':
-				{
-					// 函数名
-					auto funcItem = std::make_shared<FunctionNameItem>();
-					funcItem->SetOptions(options);
-					item = funcItem;
-					pos++;
-					break;
-				}
-				case 'L':
-				{
-					// 行号
-					auto lineItem = std::make_shared<LineNumberItem>();
-					lineItem->SetOptions(options);
-					item = lineItem;
-					pos++;
-					break;
-				}
-				case 'l':
-				{
-					// 源文件位置
-					auto srcLocItem = std::make_shared<SourceLocationItem>();
-					srcLocItem->SetOptions(options);
-					item = srcLocItem;
-					pos++;
-					break;
-				}
-				case '%':
-				{
-					// 百分号
-					item = std::make_shared<LiteralItem>("%");
-					pos++;
-					break;
-				}
-				case '\t':
-				{
-					// 制表符
-					item = std::make_shared<TabItem>();
-					pos++;
-					break;
-				}
-				default:
-				{
-					// 未知格式，作为字面文本处理
-					item = std::make_shared<LiteralItem>("%" + std::string(1, next));
-					pos++;
-					break;
-				}
-				}
-
-				if (item)
-				{
-					m_pImpl->items.push_back(item);
-				}
-			}
-			else
-			{
-				// 处理字面文本
-				size_t start = pos;
-				while (pos < len && m_pImpl->pattern[pos] != '%')
-				{
-					pos++;
-				}
-				std::string literalText = m_pImpl->pattern.substr(start, pos - start);
-				if (!literalText.empty())
-				{
-					m_pImpl->items.push_back(std::make_shared<LiteralItem>(literalText));
-				}
-			}
-		}
+		m_pImpl->Publish(pattern);
 	}
 
 } // namespace IDLog
\ No newline at end of file
@@ -0,0 +1,111 @@
+/**
+ * @Description: 读者纪元延迟释放源文件
+ * @Author: InverseDark
+ * @Date: 2026-10-19 11:48:36
+ * @LastEditTime: 2026-10-19 11:48:36
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/Utils/EpochReclaimer.h"
+
+#include <atomic>
+
+namespace IDLog
+{
+	namespace Utils
+	{
+		namespace
+		{
+			/// @brief 读者纪元槽（每个线程一个，独占缓存行，读者之间没有伪共享）
+			struct alignas(64) ReaderSlot
+			{
+				std::atomic<uint64_t> epoch{0};	 ///< 正在读取时为进入时的全局纪元，否则为0
+				std::atomic<bool> inUse{false}; ///< 是否被某个线程占用
+				ReaderSlot *next = nullptr;		 ///< 下一个槽（槽只增不减，线程退出后供其他线程复用）
+			};
+
+			/// @brief 全局纪元，每退役一个对象递增一次（从1开始，0表示未在读取）
+			std::atomic<uint64_t> g_readerEpoch{1};
+
+			/// @brief 全部读者槽的链表头
+			std::atomic<ReaderSlot *> g_readerSlots{nullptr};
+
+			/// @brief 占用一个空闲的读者槽，没有时新建
+			/// @return 读者槽
+			ReaderSlot *AcquireReaderSlot()
+			{
+				for (ReaderSlot *slot = g_readerSlots.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+				{
+					bool expected = false;
+					if (!slot->inUse.load(std::memory_order_relaxed) &&
+						slot->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+					{
+						return slot;
+					}
+				}
+				ReaderSlot *slot = new ReaderSlot;
+				slot->inUse.store(true, std::memory_order_relaxed);
+				slot->next = g_readerSlots.load(std::memory_order_relaxed);
+				while (!g_readerSlots.compare_exchange_weak(slot->next, slot, std::memory_order_release,
+															std::memory_order_relaxed))
+				{
+				}
+				return slot;
+			}
+
+			/// @brief 线程持有的读者槽，线程退出时归还
+			struct ReaderSlotHolder
+			{
+				ReaderSlot *slot = AcquireReaderSlot(); ///< 读者槽
+
+				~ReaderSlotHolder() { slot->inUse.store(false, std::memory_order_release); }
+			};
+
+			/// @brief 获取本线程的读者槽
+			/// @return 读者槽
+			ReaderSlot &LocalSlot()
+			{
+				thread_local ReaderSlotHolder holder;
+				return *holder.slot;
+			}
+		} // namespace
+
+		EpochReclaimer::ReaderGuard::ReaderGuard()
+			: m_slot(nullptr)
+		{
+			ReaderSlot &slot = LocalSlot();
+			if (slot.epoch.load(std::memory_order_relaxed) == 0)
+			{
+				// 先登记再读取共享指针（两者都是 seq_cst），写者要么看到登记，要么本读者读到新对象
+				slot.epoch.store(g_readerEpoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+				m_slot = &slot;
+			}
+		}
+
+		EpochReclaimer::ReaderGuard::~ReaderGuard()
+		{
+			if (m_slot != nullptr)
+			{
+				static_cast<ReaderSlot *>(m_slot)->epoch.store(0, std::memory_order_release);
+			}
+		}
+
+		uint64_t EpochReclaimer::Advance()
+		{
+			return g_readerEpoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+		}
+
+		uint64_t EpochReclaimer::OldestReader(uint64_t limit)
+		{
+			uint64_t oldest = limit;
+			for (const ReaderSlot *slot = g_readerSlots.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+			{
+				const uint64_t readerEpoch = slot->epoch.load(std::memory_order_seq_cst);
+				if (readerEpoch != 0)
+				{
+					oldest = std::min(oldest, readerEpoch);
+				}
+			}
+			return oldest;
+		}
+	} // namespace Utils
+} // namespace IDLog
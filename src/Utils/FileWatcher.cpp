@@ -0,0 +1,351 @@
+/**
+ * @Description: 文件监视工具源文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 21:26:40
+ * @LastEditTime: 2026-10-18 21:26:40
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/Utils/FileWatcher.h"
+#include "IDLog/Utils/ThreadUtil.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+#ifdef IDLOG_PLATFORM_LINUX
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace IDLog
+{
+	namespace Utils
+	{
+		namespace
+		{
+			/// @brief 文件指纹，用于轮询时判断文件是否变化
+			struct Fingerprint
+			{
+				bool exists = false;	 ///< 文件是否存在
+				fs::file_time_type time; ///< 修改时间
+				uintmax_t size = 0;		 ///< 文件大小
+
+				bool operator==(const Fingerprint &other) const
+				{
+					return exists == other.exists && time == other.time && size == other.size;
+				}
+				bool operator!=(const Fingerprint &other) const { return !(*this == other); }
+			};
+
+			/// @brief 获取文件指纹
+			/// @param path [IN] 文件路径
+			/// @return 文件指纹，文件不存在或无法访问时 exists 为false
+			Fingerprint GetFingerprint(const std::string &path)
+			{
+				Fingerprint fingerprint;
+				std::error_code ec;
+				fingerprint.time = fs::last_write_time(path, ec);
+				if (ec)
+				{
+					return Fingerprint();
+				}
+				fingerprint.size = fs::file_size(path, ec);
+				fingerprint.exists = !ec;
+				return fingerprint;
+			}
+		} // namespace
+
+		/// @brief 文件监视工具实现结构体
+		struct FileWatcher::Impl
+		{
+			std::string path;						 ///< 被监视的文件路径
+			Callback callback;						 ///< 变化回调
+			uint64_t debounceMs = 50;				 ///< 去抖时间，单位毫秒
+			uint64_t pollIntervalMs = 1000;			 ///< 轮询间隔，单位毫秒
+			std::thread thread;						 ///< 后台线程
+			std::atomic<bool> stop{false};			 ///< 停止标志
+			std::atomic<bool> running{false};		 ///< 是否正在监视
+			bool native = false;					 ///< 是否使用系统通知
+			std::mutex waitMutex;					 ///< 轮询等待互斥锁
+			std::condition_variable waitCv;			 ///< 轮询等待条件变量，停止时唤醒
+			mutable std::mutex stateMutex;			 ///< 保护 path 与线程句柄
+#ifdef IDLOG_PLATFORM_LINUX
+			int inotifyFd = -1; ///< inotify 描述符
+			int wakeFd = -1;	///< 停止时用于唤醒 poll 的 eventfd
+#endif
+
+			/// @brief 尝试初始化系统通知
+			/// @return 成功返回true
+			bool OpenNative();
+
+			/// @brief 关闭系统通知相关的描述符
+			void CloseNative();
+
+			/// @brief 基于系统通知的监视循环
+			void NativeLoop();
+
+			/// @brief 基于轮询的监视循环
+			void PollLoop();
+
+			/// @brief 等待指定时间，停止时提前返回
+			/// @param milliseconds [IN] 等待时间
+			void WaitFor(uint64_t milliseconds)
+			{
+				std::unique_lock<std::mutex> lock(waitMutex);
+				waitCv.wait_for(lock, std::chrono::milliseconds(milliseconds), [this]()
+								{ return stop.load(); });
+			}
+		};
+
+#ifdef IDLOG_PLATFORM_LINUX
+		bool FileWatcher::Impl::OpenNative()
+		{
+			inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+			if (inotifyFd < 0)
+			{
+				return false;
+			}
+			wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			if (wakeFd < 0)
+			{
+				CloseNative();
+				return false;
+			}
+
+			// 监视所在目录而非文件本身：编辑器保存与原子重命名部署都会替换 inode
+			fs::path dir = fs::path(path).parent_path();
+			if (dir.empty())
+			{
+				dir = ".";
+			}
+			const uint32_t mask = IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_ATTRIB | IN_DELETE;
+			if (inotify_add_watch(inotifyFd, dir.c_str(), mask) < 0)
+			{
+				CloseNative();
+				return false;
+			}
+			return true;
+		}
+
+		void FileWatcher::Impl::CloseNative()
+		{
+			if (inotifyFd >= 0)
+			{
+				close(inotifyFd);
+				inotifyFd = -1;
+			}
+			if (wakeFd >= 0)
+			{
+				close(wakeFd);
+				wakeFd = -1;
+			}
+		}
+
+		void FileWatcher::Impl::NativeLoop()
+		{
+			using Clock = std::chrono::steady_clock;
+			const std::string fileName = fs::path(path).filename().string();
+			alignas(struct inotify_event) char buffer[4096];
+			bool pending = false;
+			Clock::time_point deadline;
+
+			while (!stop.load())
+			{
+				int timeout = -1;
+				if (pending)
+				{
+					auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+					timeout = remaining > 0 ? static_cast<int>(remaining) : 0;
+				}
+
+				struct pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+				int ret = poll(fds, 2, timeout);
+				if (ret < 0 && errno != EINTR)
+				{
+					break;
+				}
+				if (stop.load())
+				{
+					break;
+				}
+
+				if (ret > 0 && (fds[0].revents & POLLIN))
+				{
+					ssize_t length;
+					while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+					{
+						for (char *ptr = buffer; ptr < buffer + length;)
+						{
+							const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(ptr);
+							// 队列溢出时无法确定是哪个文件，按变化处理
+							if ((event->mask & IN_Q_OVERFLOW) || (event->len > 0 && fileName == event->name))
+							{
+								pending = true;
+								deadline = Clock::now() + std::chrono::milliseconds(debounceMs);
+							}
+							ptr += sizeof(struct inotify_event) + event->len;
+						}
+					}
+				}
+
+				// 变化平息后回调一次；文件被删除（尚未重新创建）时不回调
+				if (pending && Clock::now() >= deadline)
+				{
+					pending = false;
+					if (GetFingerprint(path).exists)
+					{
+						callback(path);
+					}
+				}
+			}
+		}
+#else
+		bool FileWatcher::Impl::OpenNative()
+		{
+			return false;
+		}
+
+		void FileWatcher::Impl::CloseNative()
+		{
+		}
+
+		void FileWatcher::Impl::NativeLoop()
+		{
+		}
+#endif
+
+		void FileWatcher::Impl::PollLoop()
+		{
+			Fingerprint last = GetFingerprint(path);
+			while (!stop.load())
+			{
+				WaitFor(pollIntervalMs);
+				if (stop.load())
+				{
+					break;
+				}
+
+				Fingerprint current = GetFingerprint(path);
+				if (current == last)
+				{
+					continue;
+				}
+				// 发现变化后等待去抖时间，文件稳定后才回调
+				do
+				{
+					last = current;
+					WaitFor(debounceMs);
+					current = GetFingerprint(path);
+				} while (!stop.load() && current != last);
+
+				if (!stop.load() && current.exists)
+				{
+					callback(path);
+				}
+			}
+		}
+
+		FileWatcher::FileWatcher()
+			: m_pImpl(new Impl)
+		{
+		}
+
+		FileWatcher::~FileWatcher()
+		{
+			Stop();
+			delete m_pImpl;
+		}
+
+		bool FileWatcher::Start(const std::string &path, const Callback &callback,
+			uint64_t debounceMs, uint64_t pollIntervalMs)
+		{
+			Stop();
+			if (path.empty() || !callback)
+			{
+				return false;
+			}
+
+			std::lock_guard<std::mutex> lock(m_pImpl->stateMutex);
+			m_pImpl->path = path;
+			m_pImpl->callback = callback;
+			m_pImpl->debounceMs = debounceMs;
+			m_pImpl->pollIntervalMs = pollIntervalMs > 0 ? pollIntervalMs : 1000;
+			m_pImpl->stop = false;
+			m_pImpl->native = m_pImpl->OpenNative();
+			m_pImpl->running = true;
+			m_pImpl->thread = std::thread([impl = m_pImpl]()
+										  {
+											  ThreadUtil::SetThreadName("idlog-watch");
+											  if (impl->native)
+											  {
+												  impl->NativeLoop();
+											  }
+											  else
+											  {
+												  impl->PollLoop();
+											  } });
+			return true;
+		}
+
+		void FileWatcher::Stop()
+		{
+			std::thread thread;
+			{
+				std::lock_guard<std::mutex> lock(m_pImpl->stateMutex);
+				if (!m_pImpl->thread.joinable())
+				{
+					return;
+				}
+				thread = std::move(m_pImpl->thread);
+			}
+
+			// 唤醒后台线程：系统通知模式写 eventfd，轮询模式通知条件变量
+			m_pImpl->stop = true;
+#ifdef IDLOG_PLATFORM_LINUX
+			if (m_pImpl->wakeFd >= 0)
+			{
+				uint64_t one = 1;
+				ssize_t written = write(m_pImpl->wakeFd, &one, sizeof(one));
+				(void)written;
+			}
+#endif
+			{
+				std::lock_guard<std::mutex> lock(m_pImpl->waitMutex);
+			}
+			m_pImpl->waitCv.notify_all();
+			thread.join();
+
+			std::lock_guard<std::mutex> lock(m_pImpl->stateMutex);
+			m_pImpl->CloseNative();
+			m_pImpl->running = false;
+			m_pImpl->native = false;
+			m_pImpl->path.clear();
+			m_pImpl->callback = nullptr;
+		}
+
+		bool FileWatcher::IsRunning() const
+		{
+			return m_pImpl->running.load();
+		}
+
+		bool FileWatcher::IsNative() const
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->stateMutex);
+			return m_pImpl->native;
+		}
+
+		std::string FileWatcher::GetPath() const
+		{
+			std::lock_guard<std::mutex> lock(m_pImpl->stateMutex);
+			return m_pImpl->path;
+		}
+	} // namespace Utils
+} // namespace IDLog
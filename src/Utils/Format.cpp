@@ -0,0 +1,369 @@
+/**
+ * @Description: 类型安全的格式化工具源文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 23:20:15
+ * @LastEditTime: 2026-10-18 23:20:15
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/Utils/Format.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace IDLog
+{
+	namespace Utils
+	{
+		namespace detail
+		{
+			namespace
+			{
+				/// @brief 计算显示宽度：UTF-8 续字节不计数
+				/// @param text [IN] 文本
+				/// @return 字符个数
+				std::size_t DisplayWidth(std::string_view text)
+				{
+					std::size_t width = 0;
+					for (char c : text)
+					{
+						if ((static_cast<unsigned char>(c) & 0xC0) != 0x80)
+						{
+							++width;
+						}
+					}
+					return width;
+				}
+
+				/// @brief 追加填充字符
+				/// @param out [IN/OUT] 输出缓冲区
+				/// @param fill [IN] 填充字符
+				/// @param count [IN] 个数
+				void AppendFill(std::string &out, char fill, std::size_t count)
+				{
+					if (count > 0)
+					{
+						out.append(count, fill);
+					}
+				}
+
+				/// @brief 按宽度与对齐方式输出
+				/// @param out [IN/OUT] 输出缓冲区
+				/// @param prefix [IN] 符号与进制前缀，补零时写在零之前
+				/// @param body [IN] 主体内容
+				/// @param spec [IN] 格式说明
+				/// @param numeric [IN] 是否为数字（决定默认对齐方式与是否允许补零）
+				void WritePadded(std::string &out, std::string_view prefix, std::string_view body,
+								 const FormatSpec &spec, bool numeric)
+				{
+					const std::size_t width = prefix.size() + DisplayWidth(body);
+					const std::size_t target = static_cast<std::size_t>(spec.width);
+					if (width >= target)
+					{
+						out.append(prefix);
+						out.append(body);
+						return;
+					}
+
+					const std::size_t padding = target - width;
+					if (numeric && spec.zeroPad && spec.align == '\0')
+					{
+						out.append(prefix);
+						AppendFill(out, '0', padding);
+						out.append(body);
+						return;
+					}
+
+					char align = spec.align != '\0' ? spec.align : (numeric ? '>' : '<');
+					std::size_t left = 0;
+					if (align == '>')
+					{
+						left = padding;
+					}
+					else if (align == '^')
+					{
+						left = padding / 2;
+					}
+					AppendFill(out, spec.fill, left);
+					out.append(prefix);
+					out.append(body);
+					AppendFill(out, spec.fill, padding - left);
+				}
+
+				/// @brief 计算非负数的符号前缀
+				/// @param negative [IN] 是否为负数
+				/// @param spec [IN] 格式说明
+				/// @return 符号字符，不需要符号时返回'\0'
+				char SignChar(bool negative, const FormatSpec &spec)
+				{
+					if (negative)
+					{
+						return '-';
+					}
+					if (spec.sign == '+' || spec.sign == ' ')
+					{
+						return spec.sign;
+					}
+					return '\0';
+				}
+
+				/// @brief 浮点数格式化的实现，float/double/long double 共用
+				template <typename T>
+				void FormatFloatImpl(std::string &out, T value, const FormatSpec &spec)
+				{
+					const bool negative = std::signbit(value);
+					const T absValue = negative ? -value : value;
+					const bool upper = spec.type == 'E' || spec.type == 'F' || spec.type == 'G';
+
+					char prefix[1] = {SignChar(negative, spec)};
+					std::string_view prefixView(prefix, prefix[0] != '\0' ? 1 : 0);
+
+					if (std::isnan(absValue) || std::isinf(absValue))
+					{
+						std::string_view body = std::isnan(absValue) ? (upper ? "NAN" : "nan") : (upper ? "INF" : "inf");
+						FormatSpec noZero = spec;
+						noZero.zeroPad = false;
+						WritePadded(out, prefixView, body, noZero, true);
+						return;
+					}
+
+					// 定点格式下大数的位数较多，先用栈上缓冲区，不够时再分配
+					char stackBuffer[128];
+					std::string heapBuffer;
+					char *first = stackBuffer;
+					char *last = stackBuffer + sizeof(stackBuffer);
+					std::to_chars_result result{};
+					for (int attempt = 0; attempt < 2; ++attempt)
+					{
+						switch (spec.type)
+						{
+						case 'f':
+						case 'F':
+							result = std::to_chars(first, last, absValue, std::chars_format::fixed,
+												   spec.precision >= 0 ? spec.precision : 6);
+							break;
+						case 'e':
+						case 'E':
+							result = std::to_chars(first, last, absValue, std::chars_format::scientific,
+												   spec.precision >= 0 ? spec.precision : 6);
+							break;
+						case 'g':
+						case 'G':
+							result = std::to_chars(first, last, absValue, std::chars_format::general,
+												   spec.precision >= 0 ? spec.precision : 6);
+							break;
+						default:
+							// 未指定类型：无精度时输出能还原原值的最短表示
+							result = spec.precision >= 0
+										 ? std::to_chars(first, last, absValue, std::chars_format::general, spec.precision)
+										 : std::to_chars(first, last, absValue);
+							break;
+						}
+						if (result.ec == std::errc())
+						{
+							break;
+						}
+						heapBuffer.resize(static_cast<std::size_t>(std::numeric_limits<T>::max_exponent10) +
+										  static_cast<std::size_t>(std::max(spec.precision, 0)) + 64);
+						first = &heapBuffer[0];
+						last = first + heapBuffer.size();
+					}
+					if (result.ec != std::errc())
+					{
+						return;
+					}
+
+					if (upper)
+					{
+						std::transform(first, result.ptr, first, [](char c)
+									   { return static_cast<char>(std::toupper(static_cast<unsigned char>(c))); });
+					}
+					WritePadded(out, prefixView, std::string_view(first, static_cast<std::size_t>(result.ptr - first)), spec, true);
+				}
+			} // namespace
+
+			void FormatInteger(std::string &out, unsigned long long absValue, bool negative, const FormatSpec &spec)
+			{
+				if (spec.type == 'c')
+				{
+					char c = static_cast<char>(absValue);
+					FormatString(out, std::string_view(&c, 1), spec);
+					return;
+				}
+
+				int base = 10;
+				std::string_view basePrefix;
+				switch (spec.type)
+				{
+				case 'x':
+					base = 16;
+					basePrefix = "0x";
+					break;
+				case 'X':
+					base = 16;
+					basePrefix = "0X";
+					break;
+				case 'o':
+					base = 8;
+					basePrefix = "0";
+					break;
+				case 'b':
+					base = 2;
+					basePrefix = "0b";
+					break;
+				case 'B':
+					base = 2;
+					basePrefix = "0B";
+					break;
+				default:
+					break;
+				}
+
+				char digits[64];
+				std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), absValue, base);
+				if (spec.type == 'X')
+				{
+					std::transform(digits, result.ptr, digits, [](char c)
+								   { return static_cast<char>(std::toupper(static_cast<unsigned char>(c))); });
+				}
+
+				char prefix[3];
+				std::size_t prefixLength = 0;
+				char sign = SignChar(negative, spec);
+				if (sign != '\0')
+				{
+					prefix[prefixLength++] = sign;
+				}
+				if (spec.alternate && !(base == 8 && absValue == 0))
+				{
+					for (char c : basePrefix)
+					{
+						prefix[prefixLength++] = c;
+					}
+				}
+				WritePadded(out, std::string_view(prefix, prefixLength),
+							std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)), spec, true);
+			}
+
+			void FormatFloat(std::string &out, double value, const FormatSpec &spec)
+			{
+				FormatFloatImpl(out, value, spec);
+			}
+
+			void FormatFloat(std::string &out, float value, const FormatSpec &spec)
+			{
+				FormatFloatImpl(out, value, spec);
+			}
+
+			void FormatFloat(std::string &out, long double value, const FormatSpec &spec)
+			{
+				FormatFloatImpl(out, value, spec);
+			}
+
+			void FormatString(std::string &out, std::string_view value, const FormatSpec &spec)
+			{
+				if (spec.precision >= 0 && value.size() > static_cast<std::size_t>(spec.precision))
+				{
+					// 按字符截断，不截断 UTF-8 多字节字符
+					std::size_t count = 0;
+					std::size_t end = 0;
+					for (; end < value.size(); ++end)
+					{
+						if ((static_cast<unsigned char>(value[end]) & 0xC0) != 0x80)
+						{
+							if (count == static_cast<std::size_t>(spec.precision))
+							{
+								break;
+							}
+							++count;
+						}
+					}
+					value = value.substr(0, end);
+				}
+				if (spec.width == 0)
+				{
+					out.append(value);
+					return;
+				}
+				WritePadded(out, std::string_view(), value, spec, false);
+			}
+
+			void FormatPointer(std::string &out, const void *value, const FormatSpec &spec)
+			{
+				char digits[2 * sizeof(std::uintptr_t)];
+				std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits),
+															reinterpret_cast<std::uintptr_t>(value), 16);
+				WritePadded(out, "0x", std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)), spec, true);
+			}
+
+			void VFormatTo(std::string &out, std::string_view format, const FormatArg *args, std::size_t count)
+			{
+				std::size_t autoIndex = 0;
+				std::size_t pos = 0;
+				while (pos < format.size())
+				{
+					// 整段复制普通文本
+					std::size_t brace = format.find_first_of("{}", pos);
+					if (brace == std::string_view::npos)
+					{
+						out.append(format.substr(pos));
+						break;
+					}
+					out.append(format.substr(pos, brace - pos));
+					pos = brace;
+
+					// "{{" 与 "}}" 转义；单独的 '}' 原样输出
+					if (format[pos] == '}' || (pos + 1 < format.size() && format[pos + 1] == '{'))
+					{
+						out.push_back(format[pos]);
+						pos += (pos + 1 < format.size() && format[pos + 1] == format[pos]) ? 2 : 1;
+						continue;
+					}
+
+					std::size_t close = format.find('}', pos + 1);
+					if (close == std::string_view::npos)
+					{
+						out.append(format.substr(pos));
+						break;
+					}
+
+					std::string_view field = format.substr(pos + 1, close - pos - 1);
+					std::size_t colon = field.find(':');
+					std::string_view indexText = field.substr(0, colon);
+
+					bool valid = true;
+					std::size_t index = 0;
+					if (indexText.empty())
+					{
+						index = autoIndex++;
+					}
+					else
+					{
+						std::from_chars_result parsed = std::from_chars(indexText.data(), indexText.data() + indexText.size(), index);
+						valid = parsed.ec == std::errc() && parsed.ptr == indexText.data() + indexText.size();
+					}
+
+					FormatSpec spec;
+					if (colon != std::string_view::npos)
+					{
+						valid = valid && ParseFormatSpec(field.substr(colon + 1), spec);
+					}
+
+					if (valid && index < count)
+					{
+						args[index].format(out, args[index].value, spec);
+					}
+					else
+					{
+						// 无效的占位符或缺少参数：原样输出，便于发现问题
+						out.append(format.substr(pos, close - pos + 1));
+					}
+					pos = close + 1;
+				}
+			}
+		} // namespace detail
+	} // namespace Utils
+} // namespace IDLog
@@ -0,0 +1,392 @@
+/**
+ * @Description: JSON 工具源文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 11:05:40
+ * @LastEditTime: 2026-10-18 11:05:40
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/Utils/JsonUtil.h"
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__)) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IDLOG_JSON_HAS_SSE2 1
+#define IDLOG_JSON_HAS_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#define IDLOG_TARGET_AVX2
+#else
+#define IDLOG_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace IDLog
+{
+	namespace Utils
+	{
+		namespace
+		{
+			/// @brief 扫描函数类型：返回第一个需要特殊处理的字节下标，找不到时返回 size
+			/// @details stopOnNonAscii 为 true 时，非 ASCII 字节（>= 0x80）也视为需要特殊处理
+			using ScanFunc = size_t (*)(const unsigned char *data, size_t size, bool stopOnNonAscii);
+
+			/// @brief 判断字节是否需要转义（或在校验模式下需要检查）
+			/// @param ch [IN] 字节
+			/// @param stopOnNonAscii [IN] 是否将非 ASCII 字节视为特殊字节
+			/// @return 是否为特殊字节
+			inline bool IsSpecialByte(unsigned char ch, bool stopOnNonAscii)
+			{
+				return ch < 0x20 || ch == '"' || ch == '\\' || (stopOnNonAscii && ch >= 0x80);
+			}
+
+			/// @brief 计算整数最低位 1 的位置
+			/// @param mask [IN] 非零掩码
+			/// @return 最低位 1 的下标
+			inline unsigned CountTrailingZeros(unsigned mask)
+			{
+#if defined(_MSC_VER)
+				unsigned long index = 0;
+				_BitScanForward(&index, mask);
+				return static_cast<unsigned>(index);
+#else
+				return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+			}
+
+			/// @brief 标量扫描实现
+			size_t ScanScalar(const unsigned char *data, size_t size, bool stopOnNonAscii)
+			{
+				for (size_t i = 0; i < size; ++i)
+				{
+					if (IsSpecialByte(data[i], stopOnNonAscii))
+					{
+						return i;
+					}
+				}
+				return size;
+			}
+
+#if defined(IDLOG_JSON_HAS_SSE2)
+			/// @brief SSE2 扫描实现，每次处理 16 字节
+			size_t ScanSse2(const unsigned char *data, size_t size, bool stopOnNonAscii)
+			{
+				const __m128i quote = _mm_set1_epi8('"');
+				const __m128i backslash = _mm_set1_epi8('\\');
+				const __m128i ctrlMax = _mm_set1_epi8(0x1F);
+
+				size_t i = 0;
+				for (; i + 16 <= size; i += 16)
+				{
+					__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+					__m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+					// 无符号比较 chunk <= 0x1F 等价于 min(chunk, 0x1F) == chunk
+					special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_min_epu8(chunk, ctrlMax), chunk));
+					unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+					if (stopOnNonAscii)
+					{
+						mask |= static_cast<unsigned>(_mm_movemask_epi8(chunk));
+					}
+					if (mask != 0)
+					{
+						return i + CountTrailingZeros(mask);
+					}
+				}
+				return i + ScanScalar(data + i, size - i, stopOnNonAscii);
+			}
+#endif // IDLOG_JSON_HAS_SSE2
+
+#if defined(IDLOG_JSON_HAS_AVX2)
+			/// @brief AVX2 扫描实现，每次处理 32 字节
+			IDLOG_TARGET_AVX2 size_t ScanAvx2(const unsigned char *data, size_t size, bool stopOnNonAscii)
+			{
+				const __m256i quote = _mm256_set1_epi8('"');
+				const __m256i backslash = _mm256_set1_epi8('\\');
+				const __m256i ctrlMax = _mm256_set1_epi8(0x1F);
+
+				size_t i = 0;
+				for (; i + 32 <= size; i += 32)
+				{
+					__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+					__m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash));
+					special = _mm256_or_si256(special, _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, ctrlMax), chunk));
+					unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(special));
+					if (stopOnNonAscii)
+					{
+						mask |= static_cast<unsigned>(_mm256_movemask_epi8(chunk));
+					}
+					if (mask != 0)
+					{
+						return i + CountTrailingZeros(mask);
+					}
+				}
+				return i + ScanSse2(data + i, size - i, stopOnNonAscii);
+			}
+#endif // IDLOG_JSON_HAS_AVX2
+
+			/// @brief 检测 CPU 支持的最高指令集级别
+			/// @return 指令集级别
+			JsonUtil::SimdLevel DetectSimdLevel()
+			{
+#if defined(IDLOG_JSON_HAS_AVX2)
+#if defined(_MSC_VER)
+				int info[4] = {0};
+				__cpuid(info, 0);
+				if (info[0] >= 7)
+				{
+					__cpuid(info, 1);
+					bool osxsave = (info[2] & (1 << 27)) != 0;
+					bool avx = (info[2] & (1 << 28)) != 0;
+					__cpuidex(info, 7, 0);
+					bool avx2 = (info[1] & (1 << 5)) != 0;
+					if (osxsave && avx && avx2 && (_xgetbv(0) & 0x6) == 0x6)
+					{
+						return JsonUtil::SimdLevel::AVX2;
+					}
+				}
+#else
+				__builtin_cpu_init();
+				if (__builtin_cpu_supports("avx2"))
+				{
+					return JsonUtil::SimdLevel::AVX2;
+				}
+#endif
+#endif // IDLOG_JSON_HAS_AVX2
+#if defined(IDLOG_JSON_HAS_SSE2)
+				return JsonUtil::SimdLevel::SSE2;
+#else
+				return JsonUtil::SimdLevel::SCALAR;
+#endif
+			}
+
+			/// @brief 获取 CPU 支持的最高指令集级别（只检测一次）
+			JsonUtil::SimdLevel GetSupportedSimdLevel()
+			{
+				static const JsonUtil::SimdLevel supported = DetectSimdLevel();
+				return supported;
+			}
+
+			/// @brief 根据指令集级别选择扫描函数
+			ScanFunc SelectScanFunc(JsonUtil::SimdLevel level)
+			{
+				switch (level)
+				{
+#if defined(IDLOG_JSON_HAS_AVX2)
+				case JsonUtil::SimdLevel::AVX2:
+					return &ScanAvx2;
+#endif
+#if defined(IDLOG_JSON_HAS_SSE2)
+				case JsonUtil::SimdLevel::SSE2:
+					return &ScanSse2;
+#endif
+				default:
+					return &ScanScalar;
+				}
+			}
+
+			/// @brief 当前使用的指令集级别
+			std::atomic<int> g_simdLevel(-1);
+			/// @brief 当前使用的扫描函数
+			std::atomic<ScanFunc> g_scanFunc(nullptr);
+
+			/// @brief 获取当前扫描函数（首次调用时完成运行时分派）
+			ScanFunc GetScanFunc()
+			{
+				ScanFunc func = g_scanFunc.load(std::memory_order_acquire);
+				if (func == nullptr)
+				{
+					JsonUtil::SimdLevel level = GetSupportedSimdLevel();
+					func = SelectScanFunc(level);
+					g_simdLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+					g_scanFunc.store(func, std::memory_order_release);
+				}
+				return func;
+			}
+
+			/// @brief 计算从 data 开始的合法 UTF-8 序列长度
+			/// @param data [IN] 序列起始位置（首字节 >= 0x80）
+			/// @param size [IN] 剩余数据长度
+			/// @return 合法序列长度，非法时返回 0
+			size_t Utf8SequenceLength(const unsigned char *data, size_t size)
+			{
+				unsigned char lead = data[0];
+				if (lead >= 0xC2 && lead <= 0xDF)
+				{
+					return (size >= 2 && (data[1] & 0xC0) == 0x80) ? 2 : 0;
+				}
+				if (lead >= 0xE0 && lead <= 0xEF)
+				{
+					if (size < 3 || (data[1] & 0xC0) != 0x80 || (data[2] & 0xC0) != 0x80)
+					{
+						return 0;
+					}
+					// 排除过长编码与代理区
+					if ((lead == 0xE0 && data[1] < 0xA0) || (lead == 0xED && data[1] > 0x9F))
+					{
+						return 0;
+					}
+					return 3;
+				}
+				if (lead >= 0xF0 && lead <= 0xF4)
+				{
+					if (size < 4 || (data[1] & 0xC0) != 0x80 || (data[2] & 0xC0) != 0x80 || (data[3] & 0xC0) != 0x80)
+					{
+						return 0;
+					}
+					// 排除过长编码与超出 U+10FFFF 的码点
+					if ((lead == 0xF0 && data[1] < 0x90) || (lead == 0xF4 && data[1] > 0x8F))
+					{
+						return 0;
+					}
+					return 4;
+				}
+				return 0;
+			}
+
+			/// @brief 追加单个需要转义的字节
+			/// @param out [OUT] 输出缓冲区
+			/// @param ch [IN] 字节
+			void AppendEscapedByte(std::string &out, unsigned char ch)
+			{
+				static const char kHexDigits[] = "0123456789abcdef";
+				switch (ch)
+				{
+				case '"':
+					out.append("\\\"", 2);
+					break;
+				case '\\':
+					out.append("\\\\", 2);
+					break;
+				case '\b':
+					out.append("\\b", 2);
+					break;
+				case '\f':
+					out.append("\\f", 2);
+					break;
+				case '\n':
+					out.append("\\n", 2);
+					break;
+				case '\r':
+					out.append("\\r", 2);
+					break;
+				case '\t':
+					out.append("\\t", 2);
+					break;
+				default:
+				{
+					// 其余控制字符转义为 \u00XX
+					char buf[6] = {'\\', 'u', '0', '0', kHexDigits[ch >> 4], kHexDigits[ch & 0x0F]};
+					out.append(buf, sizeof(buf));
+					break;
+				}
+				}
+			}
+		} // namespace
+
+		void JsonUtil::AppendEscaped(std::string &out, const char *data, size_t size, bool validateUtf8)
+		{
+			if (size == 0)
+			{
+				return;
+			}
+
+			ScanFunc scan = GetScanFunc();
+			const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+			out.reserve(out.size() + size + 16);
+
+			size_t pos = 0;
+			while (pos < size)
+			{
+				// 整段拷贝无需转义的连续片段
+				size_t clean = scan(bytes + pos, size - pos, validateUtf8);
+				if (clean > 0)
+				{
+					out.append(data + pos, clean);
+					pos += clean;
+				}
+				if (pos >= size)
+				{
+					break;
+				}
+
+				unsigned char ch = bytes[pos];
+				if (ch >= 0x80)
+				{
+					// 仅校验模式下会停在非 ASCII 字节
+					size_t length = Utf8SequenceLength(bytes + pos, size - pos);
+					if (length == 0)
+					{
+						out.append("\xEF\xBF\xBD", 3); // U+FFFD
+						pos += 1;
+					}
+					else
+					{
+						out.append(data + pos, length);
+						pos += length;
+					}
+					continue;
+				}
+
+				AppendEscapedByte(out, ch);
+				++pos;
+			}
+		}
+
+		std::string JsonUtil::Escape(const std::string &str, bool validateUtf8)
+		{
+			std::string result;
+			AppendEscaped(result, str.data(), str.size(), validateUtf8);
+			return result;
+		}
+
+		bool JsonUtil::IsValidUtf8(const char *data, size_t size)
+		{
+			ScanFunc scan = GetScanFunc();
+			const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+
+			size_t pos = 0;
+			while (pos < size)
+			{
+				// 向量化跳过 ASCII 片段，引号与控制字符同样是合法 UTF-8，逐个跳过
+				pos += scan(bytes + pos, size - pos, true);
+				if (pos >= size)
+				{
+					break;
+				}
+				if (bytes[pos] < 0x80)
+				{
+					++pos;
+					continue;
+				}
+				size_t length = Utf8SequenceLength(bytes + pos, size - pos);
+				if (length == 0)
+				{
+					return false;
+				}
+				pos += length;
+			}
+			return true;
+		}
+
+		JsonUtil::SimdLevel JsonUtil::GetSimdLevel()
+		{
+			GetScanFunc();
+			return static_cast<SimdLevel>(g_simdLevel.load(std::memory_order_relaxed));
+		}
+
+		void JsonUtil::SetSimdLevel(SimdLevel level)
+		{
+			SimdLevel supported = GetSupportedSimdLevel();
+			if (static_cast<int>(level) > static_cast<int>(supported))
+			{
+				level = supported;
+			}
+			g_simdLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+			g_scanFunc.store(SelectScanFunc(level), std::memory_order_release);
+		}
+
+	} // namespace Utils
+} // namespace IDLog
@@ -0,0 +1,329 @@
+/**
+ * @Description: 日志文件读取器源文件
+ * @Author: InverseDark
+ * @Date: 2026-10-18 15:16:51
+ * @LastEditTime: 2026-10-19 12:42:20
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/Utils/LogReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace IDLog
+{
+	namespace Utils
+	{
+		namespace
+		{
+			/// @brief 索引文件魔数
+			const char kIndexMagic[4] = {'I', 'D', 'L', 'X'};
+
+			/// @brief 索引文件头长度
+			constexpr size_t kIndexHeaderSize = 8;
+
+			/// @brief 索引项长度
+			constexpr size_t kIndexEntrySize = 16;
+
+			/// @brief 以小端序写入64位整数
+			/// @param buf [OUT] 输出缓冲区（至少8字节）
+			/// @param value [IN] 数值
+			void PutU64(char *buf, uint64_t value)
+			{
+				for (int i = 0; i < 8; ++i)
+				{
+					buf[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+				}
+			}
+
+			/// @brief 以小端序读取64位整数
+			/// @param buf [IN] 输入缓冲区（至少8字节）
+			/// @return 数值
+			uint64_t GetU64(const char *buf)
+			{
+				uint64_t value = 0;
+				for (int i = 0; i < 8; ++i)
+				{
+					value |= static_cast<uint64_t>(static_cast<unsigned char>(buf[i])) << (8 * i);
+				}
+				return value;
+			}
+
+			/// @brief 时间点转换为纳秒数
+			/// @param time [IN] 时间点
+			/// @return 自 Unix 纪元起的纳秒数
+			int64_t ToNs(LogReader::TimePoint time)
+			{
+				// 时钟精度低于纳秒的平台上，极值直接换算会溢出
+				using Duration = LogReader::TimePoint::duration;
+				if (time.time_since_epoch() >= std::chrono::duration_cast<Duration>(std::chrono::nanoseconds::max()))
+				{
+					return std::chrono::nanoseconds::max().count();
+				}
+				if (time.time_since_epoch() <= std::chrono::duration_cast<Duration>(std::chrono::nanoseconds::min()))
+				{
+					return std::chrono::nanoseconds::min().count();
+				}
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+			}
+		} // namespace
+
+		/// @brief 日志文件读取器实现结构体
+		struct LogReader::Impl
+		{
+			std::string filename;			 ///< 日志文件名
+			bool exists;					 ///< 日志文件是否存在
+			bool hasIndex;					 ///< 是否加载到索引
+			bool binary;					 ///< 是否为二进制日志
+			uint64_t fileSize;				 ///< 日志文件大小
+			std::vector<IndexEntry> entries; ///< 索引项列表
+
+			/// @brief 构造函数
+			Impl()
+				: exists(false), hasIndex(false), binary(false), fileSize(0)
+			{
+			}
+		};
+
+		LogReader::LogReader(const std::string &filename)
+			: m_pImpl(new Impl)
+		{
+			m_pImpl->filename = filename;
+
+			std::error_code ec;
+			uint64_t size = std::filesystem::file_size(filename, ec);
+			m_pImpl->exists = !ec;
+			m_pImpl->fileSize = ec ? 0 : size;
+
+			// 二进制日志以段头帧开始：类型 0x01 + 长度（单字节 varint）+ "IDLB"
+			std::ifstream in(filename, std::ios::binary);
+			char head[6] = {0};
+			if (in.read(head, sizeof(head)))
+			{
+				m_pImpl->binary = head[0] == static_cast<char>(BinaryFormatter::FrameType::SEGMENT) &&
+								  std::memcmp(head + 2, "IDLB", 4) == 0;
+			}
+
+			m_pImpl->hasIndex = LoadIndex(GetIndexFilename(filename), m_pImpl->entries);
+
+			// 丢弃超出文件大小的索引项（日志被截断或索引残留）
+			while (!m_pImpl->entries.empty() && m_pImpl->entries.back().offset >= m_pImpl->fileSize)
+			{
+				m_pImpl->entries.pop_back();
+			}
+
+			// 多线程写入时相邻记录的时间戳可能轻微乱序，取前缀最大值使其单调以便二分查找
+			for (size_t i = 1; i < m_pImpl->entries.size(); ++i)
+			{
+				m_pImpl->entries[i].timeNs = std::max(m_pImpl->entries[i].timeNs, m_pImpl->entries[i - 1].timeNs);
+			}
+		}
+
+		LogReader::~LogReader()
+		{
+			delete m_pImpl;
+		}
+
+		bool LogReader::IsOpen() const
+		{
+			return m_pImpl->exists;
+		}
+
+		bool LogReader::HasIndex() const
+		{
+			return m_pImpl->hasIndex;
+		}
+
+		bool LogReader::IsBinary() const
+		{
+			return m_pImpl->binary;
+		}
+
+		uint64_t LogReader::GetFileSize() const
+		{
+			return m_pImpl->fileSize;
+		}
+
+		const std::vector<LogReader::IndexEntry> &LogReader::GetIndex() const
+		{
+			return m_pImpl->entries;
+		}
+
+		std::pair<uint64_t, uint64_t> LogReader::FindRange(TimePoint from, TimePoint to) const
+		{
+			const std::vector<IndexEntry> &entries = m_pImpl->entries;
+			int64_t fromNs = ToNs(from);
+			int64_t toNs = ToNs(to);
+			if (toNs < fromNs)
+			{
+				return {0, 0};
+			}
+
+			uint64_t begin = 0;
+			uint64_t end = m_pImpl->fileSize;
+
+			// 起点：第一个时间 >= from 的索引项之前的那个区间（from 可能落在其中）
+			auto first = std::partition_point(entries.begin(), entries.end(),
+											  [fromNs](const IndexEntry &e)
+											  { return e.timeNs < fromNs; });
+			if (first != entries.begin())
+			{
+				begin = std::prev(first)->offset;
+			}
+
+			// 终点：第一个时间 > to 的索引项
+			auto last = std::partition_point(first, entries.end(),
+											 [toNs](const IndexEntry &e)
+											 { return e.timeNs <= toNs; });
+			if (last != entries.end())
+			{
+				end = last->offset;
+			}
+			return {begin, std::max(begin, end)};
+		}
+
+		uint64_t LogReader::ReadRange(TimePoint from, TimePoint to, std::ostream &out) const
+		{
+			auto range = FindRange(from, to);
+			std::ifstream in(m_pImpl->filename, std::ios::binary);
+			if (!in.is_open() || range.first >= range.second)
+			{
+				return 0;
+			}
+			in.seekg(static_cast<std::streamoff>(range.first));
+
+			std::vector<char> buffer(64 * 1024);
+			uint64_t remaining = range.second - range.first;
+			uint64_t written = 0;
+			while (remaining > 0 && in)
+			{
+				size_t chunk = static_cast<size_t>(std::min<uint64_t>(remaining, buffer.size()));
+				in.read(buffer.data(), static_cast<std::streamsize>(chunk));
+				std::streamsize got = in.gcount();
+				if (got <= 0)
+				{
+					break;
+				}
+				out.write(buffer.data(), got);
+				remaining -= static_cast<uint64_t>(got);
+				written += static_cast<uint64_t>(got);
+			}
+			return written;
+		}
+
+		size_t LogReader::ReadEvents(TimePoint from, TimePoint to, const BinaryLogDecoder::EventCallback &callback) const
+		{
+			if (!m_pImpl->binary)
+			{
+				return 0;
+			}
+
+			auto range = FindRange(from, to);
+			std::ifstream in(m_pImpl->filename, std::ios::binary);
+			if (!in.is_open() || range.first >= range.second)
+			{
+				return 0;
+			}
+			in.seekg(static_cast<std::streamoff>(range.first));
+
+			size_t count = 0;
+			auto onEvent = [&](const LogEvent::Pointer &event)
+			{
+				if (event->GetTime() >= from && event->GetTime() <= to)
+				{
+					++count;
+					if (callback)
+					{
+						callback(event);
+					}
+				}
+			};
+
+			// 二进制日志的索引项只写在段头处，范围起点一定可独立解码。
+			// 按块读取，缓冲区中出现下一个段头时解码之前的完整段并丢弃，内存占用不超过一个段加一块
+			const size_t chunkSize = 64 * 1024;
+			std::string data;
+			uint64_t remaining = range.second - range.first;
+			while (remaining > 0 && in)
+			{
+				const size_t oldSize = data.size();
+				const size_t chunk = static_cast<size_t>(std::min<uint64_t>(remaining, chunkSize));
+				data.resize(oldSize + chunk);
+				in.read(&data[oldSize], static_cast<std::streamsize>(chunk));
+				const std::streamsize got = in.gcount();
+				data.resize(oldSize + static_cast<size_t>(std::max<std::streamsize>(got, 0)));
+				if (got <= 0)
+				{
+					break;
+				}
+				remaining -= static_cast<uint64_t>(got);
+
+				std::vector<BinaryLogDecoder::Segment> segments = BinaryLogDecoder::SplitSegments(data.data(), data.size());
+				if (segments.size() < 2)
+				{
+					continue;
+				}
+				for (size_t i = 0; i + 1 < segments.size(); ++i)
+				{
+					BinaryLogDecoder::Decode(data.data() + segments[i].offset, segments[i].size, onEvent);
+				}
+				data.erase(0, segments.back().offset);
+			}
+
+			// 最后一个段（可能在范围终点处被截断，截断前的事件已回调）
+			if (!data.empty())
+			{
+				BinaryLogDecoder::Decode(data.data(), data.size(), onEvent);
+			}
+			return count;
+		}
+
+		std::string LogReader::GetIndexFilename(const std::string &filename)
+		{
+			return filename + ".idx";
+		}
+
+		void LogReader::WriteIndexHeader(std::ostream &out)
+		{
+			char header[kIndexHeaderSize] = {0};
+			std::memcpy(header, kIndexMagic, sizeof(kIndexMagic));
+			header[4] = static_cast<char>(kIndexVersion);
+			out.write(header, sizeof(header));
+		}
+
+		void LogReader::WriteIndexEntry(std::ostream &out, const IndexEntry &entry)
+		{
+			char buf[kIndexEntrySize];
+			PutU64(buf, static_cast<uint64_t>(entry.timeNs));
+			PutU64(buf + 8, entry.offset);
+			out.write(buf, sizeof(buf));
+		}
+
+		bool LogReader::LoadIndex(const std::string &indexFilename, std::vector<IndexEntry> &entries)
+		{
+			entries.clear();
+			std::ifstream in(indexFilename, std::ios::binary);
+			if (!in.is_open())
+			{
+				return false;
+			}
+
+			char header[kIndexHeaderSize];
+			if (!in.read(header, sizeof(header)) || std::memcmp(header, kIndexMagic, sizeof(kIndexMagic)) != 0 ||
+				static_cast<unsigned char>(header[4]) > kIndexVersion)
+			{
+				return false;
+			}
+
+			char buf[kIndexEntrySize];
+			while (in.read(buf, sizeof(buf)))
+			{
+				entries.push_back({static_cast<int64_t>(GetU64(buf)), GetU64(buf + 8)});
+			}
+			return true;
+		}
+
+	} // namespace Utils
+} // namespace IDLog
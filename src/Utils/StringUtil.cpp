@@ -2,11 +2,12 @@
  * @Description: 字符串工具源文件
  * @Author: InverseDark
  * @Date: 2025-12-18 21:53:29
- * @LastEditTime: 2025-12-18 21:54:38
+ * @LastEditTime: 2026-10-18 22:31:05
  * @LastEditors: InverseDark
  */
 
 #include "IDLog/Utils/StringUtil.h"
+#include "IDLog/Utils/JsonUtil.h"
 
 #include <algorithm>
 
@@ -122,50 +123,8 @@ namespace IDLog
 
 		std::string StringUtil::Escape(const std::string &str)
 		{
-			std::string result;
-			result.reserve(str.length());
-
-			for (char ch : str)
-			{
-				switch (ch)
-				{
-				case '\"':
-					result += "\\\"";
-					break;
-				case '\\':
-					result += "\\\\";
-					break;
-				case '\b':
-					result += "\\b";
-					break;
-				case '\f':
-					result += "\\f";
-					break;
-				case '\n':
-					result += "\\n";
-					break;
-				case '\r':
-					result += "\\r";
-					break;
-				case '\t':
-					result += "\\t";
-					break;
-				default:
-					// 控制字符转义
-					if (static_cast<unsigned char>(ch) < 32)
-					{
-						char buf[8];
-						snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned char>(ch));
-						result += buf;
-					}
-					else
-					{
-						result += ch;
-					}
-				}
-			}
-
-			return result;
+			// 转义规则与 JSON 一致，复用向量化实现
+			return JsonUtil::Escape(str);
 		}
 
 		std::string StringUtil::Unescape(const std::string &str)
@@ -240,5 +199,45 @@ namespace IDLog
 			return result;
 		}
 
+		bool StringUtil::WildcardMatch(const std::string &str, const std::string &pattern)
+		{
+			// 贪心匹配并回溯到最近一个 '*'，最坏 O(n*m)，无需递归
+			size_t s = 0, p = 0;
+			size_t starPos = std::string::npos; // 最近一个 '*' 在模式中的位置
+			size_t matchPos = 0;				// 该 '*' 当前匹配到的字符串位置
+			while (s < str.size())
+			{
+				if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == str[s]))
+				{
+					++s;
+					++p;
+				}
+				else if (p < pattern.size() && pattern[p] == '*')
+				{
+					starPos = p++;
+					matchPos = s;
+				}
+				else if (starPos != std::string::npos)
+				{
+					p = starPos + 1;
+					s = ++matchPos;
+				}
+				else
+				{
+					return false;
+				}
+			}
+			while (p < pattern.size() && pattern[p] == '*')
+			{
+				++p;
+			}
+			return p == pattern.size();
+		}
+
+		bool StringUtil::HasWildcard(const std::string &str)
+		{
+			return str.find_first_of("*?") != std::string::npos;
+		}
+
 	} // namespace Utils
 } // namespace IDLog
\ No newline at end of file
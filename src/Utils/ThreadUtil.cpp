@@ -2,7 +2,7 @@
  * @Description: 线程工具源文件
  * @Author: InverseDark
  * @Date: 2025-12-18 19:03:14
- * @LastEditTime: 2025-12-18 19:03:14
+ * @LastEditTime: 2026-10-18 21:03:55
  * @LastEditors: InverseDark
  */
 #include "IDLog/Utils/ThreadUtil.h"
@@ -17,6 +17,7 @@
 #else
 #include <pthread.h>
 #include <unistd.h>
+#include <sys/resource.h>
 #include <sys/syscall.h>
 #endif
 
@@ -88,6 +89,16 @@ namespace IDLog
 #endif
 		}
 
+		void ThreadUtil::SetThreadLowPriority()
+		{
+#ifdef IDLOG_PLATFORM_WINDOWS
+			SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#else
+			// Linux 的 nice 值按线程生效
+			setpriority(PRIO_PROCESS, static_cast<id_t>(GetThreadIdNum()), 10);
+#endif
+		}
+
 		void ThreadUtil::Sleep(uint64_t milliseconds)
 		{
 			std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
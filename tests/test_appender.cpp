@@ -2,7 +2,7 @@
  * @Description: 输出器测试 (Console, File)
  * @Author: InverseDark
  * @Date: 2025-12-27 13:19:37
- * @LastEditTime: 2025-12-27 13:19:40
+ * @LastEditTime: 2026-10-19 12:46:05
  * @LastEditors: InverseDark
  */
 #include "IDLog/IDLog.h"
@@ -10,6 +10,12 @@
 #include <filesystem>
 #include <fstream>
 #include <cassert>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 void TestConsoleAppender()
 {
@@ -26,6 +32,93 @@ void TestConsoleAppender()
     std::cout << "  -> Passed (Visual)" << std::endl;
 }
 
+void TestConsoleAppenderBuffered()
+{
+#ifndef _WIN32
+    std::cout << "[Test] Console Appender (buffered pipe)..." << std::endl;
+
+    // 将 stderr 重定向到管道，模拟输出被重定向的场景
+    int fds[2];
+    [[maybe_unused]] int ret = pipe(fds);
+    assert(ret == 0);
+    int savedStderr = dup(STDERR_FILENO);
+    dup2(fds[1], STDERR_FILENO);
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+    {
+        auto appender = std::make_shared<IDLog::ConsoleAppender>(IDLog::ConsoleAppender::Target::STDERR);
+        appender->SetFlushInterval(0);
+        assert(!appender->IsTerminal());
+        assert(!appender->GetUseColor()); // 默认 AUTO 模式下管道不着色
+
+        IDLog::SourceLocation loc(__FILE__, __FUNCTION__, __LINE__);
+        for (int i = 0; i < 3; ++i)
+        {
+            appender->Append(std::make_shared<IDLog::LogEvent>(
+                IDLog::LogLevel::INFO, "PipeTest", "buffered line " + std::to_string(i), loc));
+        }
+
+        // 缓冲区未满且关闭了定时刷新，管道中应还没有数据
+        char buf[4096];
+        ssize_t n = read(fds[0], buf, sizeof(buf));
+        assert(n < 0);
+
+        appender->Flush();
+        n = read(fds[0], buf, sizeof(buf));
+        assert(n > 0);
+        std::string output(buf, static_cast<size_t>(n));
+        assert(output.find("buffered line 0") != std::string::npos);
+        assert(output.find("buffered line 2") != std::string::npos);
+        assert(output.find("\033[") == std::string::npos);
+
+        // 非阻塞模式：填满管道后写入应被丢弃并计数，而不是阻塞
+        appender->SetNonBlocking(true);
+        fcntl(fds[1], F_SETFL, O_NONBLOCK);
+        std::string filler(4096, 'x');
+        while (write(fds[1], filler.data(), filler.size()) > 0)
+        {
+        }
+        appender->Append(std::make_shared<IDLog::LogEvent>(
+            IDLog::LogLevel::WARN, "PipeTest", "dropped line", loc));
+        appender->Append(std::make_shared<IDLog::LogEvent>(
+            IDLog::LogLevel::WARN, "PipeTest", "dropped line", loc));
+        appender->Flush();
+        assert(appender->GetDroppedCount() == 2);
+
+        // 腾出一部分空间：只写出完整的日志，剩余的整条丢弃，管道中不会出现半条日志
+        n = read(fds[0], buf, sizeof(buf));
+        assert(n > 0);
+        std::string longLine(3000, 'y');
+        for (int i = 0; i < 3; ++i)
+        {
+            appender->Append(std::make_shared<IDLog::LogEvent>(
+                IDLog::LogLevel::WARN, "PipeTest", "partial " + std::to_string(i) + " " + longLine, loc));
+        }
+        appender->Flush();
+        std::string drained;
+        while ((n = read(fds[0], buf, sizeof(buf))) > 0)
+        {
+            drained.append(buf, static_cast<size_t>(n));
+        }
+        size_t start = drained.find_first_not_of('x');
+        std::string written = start == std::string::npos ? std::string() : drained.substr(start);
+        size_t writtenRecords = 0;
+        for (char c : written)
+        {
+            writtenRecords += (c == '\n') ? 1 : 0;
+        }
+        assert(written.empty() || written.back() == '\n');
+        assert(appender->GetDroppedCount() == 2 + (3 - writtenRecords));
+    }
+
+    dup2(savedStderr, STDERR_FILENO);
+    close(savedStderr);
+    close(fds[0]);
+    close(fds[1]);
+    std::cout << "  -> Passed" << std::endl;
+#endif
+}
+
 void TestFileAppender()
 {
     std::cout << "[Test] File Appender..." << std::endl;
@@ -51,11 +144,217 @@ void TestFileAppender()
     std::cout << "  -> Passed" << std::endl;
 }
 
+void TestBinaryFileAppender()
+{
+    std::cout << "[Test] Binary File Appender..." << std::endl;
+    std::string filename = "test_appender.idlb";
+    std::filesystem::remove(filename);
+
+    {
+        // 每段2条记录，5条日志会产生3个段
+        auto appender = std::make_shared<IDLog::BinaryFileAppender>(filename, 2);
+        IDLog::SourceLocation loc(__FILE__, __FUNCTION__, __LINE__);
+        for (int i = 0; i < 5; ++i)
+        {
+            auto event = std::make_shared<IDLog::LogEvent>(
+                i % 2 ? IDLog::LogLevel::WARN : IDLog::LogLevel::INFO, "BinTest", "binary message " + std::to_string(i), loc);
+            appender->Append(event);
+        }
+        appender->Flush();
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    assert(file.is_open());
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    auto segments = IDLog::BinaryLogDecoder::SplitSegments(data.data(), data.size());
+    assert(segments.size() == 3);
+    assert(segments.back().offset + segments.back().size == data.size());
+
+    // 单独解码中间的段，验证段可独立解码
+    std::vector<std::string> messages;
+    [[maybe_unused]] bool ok = IDLog::BinaryLogDecoder::Decode(data.data() + segments[1].offset, segments[1].size,
+        [&](const IDLog::LogEvent::Pointer& event) {
+            assert(event->GetLoggerName() == "BinTest");
+            assert(event->GetSourceLocation().lineNumber > 0);
+            assert(std::string(event->GetSourceLocation().functionName) == "TestBinaryFileAppender");
+            messages.push_back(event->GetLogMessage());
+        });
+    assert(ok);
+    assert(messages.size() == 2);
+    assert(messages[0] == "binary message 2");
+
+    // 整体解码并用文本格式化器还原
+    auto formatter = std::make_shared<IDLog::PatternFormatter>("%p %c %m");
+    std::vector<std::string> lines;
+    ok = IDLog::BinaryLogDecoder::Decode(data.data(), data.size(),
+        [&](const IDLog::LogEvent::Pointer& event) { lines.push_back(formatter->Format(event)); });
+    assert(ok);
+    assert(lines.size() == 5);
+    assert(lines[3] == "WARN BinTest binary message 3");
+
+    // 截断的流返回失败，但已解码的事件仍被回调
+    size_t count = 0;
+    ok = IDLog::BinaryLogDecoder::Decode(data.data(), data.size() - 1,
+        [&](const IDLog::LogEvent::Pointer&) { ++count; });
+    assert(!ok);
+    assert(count == 4);
+
+    // 损坏的字典编号（跳号或超大编号）返回失败，而不是按编号分配内存
+    std::string header = data.substr(0, 2 + static_cast<unsigned char>(data[1]));
+    const std::string badIds[] = {std::string("\x05", 1), std::string("\xFF\xFF\xFF\xFF\x0F", 5)};
+    for (const std::string& badId : badIds)
+    {
+        std::string payload = std::string(1, '\x01') + badId + "name";
+        std::string corrupt = header + std::string(1, '\x02') + std::string(1, static_cast<char>(payload.size())) + payload;
+        count = 0;
+        ok = IDLog::BinaryLogDecoder::Decode(corrupt.data(), corrupt.size(),
+            [&](const IDLog::LogEvent::Pointer&) { ++count; });
+        assert(!ok);
+        assert(count == 0);
+    }
+
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestFileIndex()
+{
+    std::cout << "[Test] File Time Index..." << std::endl;
+    std::string filename = "test_index.log";
+    std::string rolled;
+    std::filesystem::remove(filename);
+    std::filesystem::remove(IDLog::Utils::LogReader::GetIndexFilename(filename));
+
+    auto base = std::chrono::system_clock::now();
+    auto timeOf = [&](int i) { return base + std::chrono::seconds(i); };
+    {
+        auto appender = std::make_shared<IDLog::FileAppender>(filename,
+            std::make_shared<IDLog::PatternFormatter>("%m%n"));
+        appender->SetIndexInterval(10, 0);
+        IDLog::SourceLocation loc(__FILE__, __FUNCTION__, __LINE__);
+        for (int i = 0; i < 100; ++i)
+        {
+            auto event = std::make_shared<IDLog::LogEvent>(IDLog::LogLevel::INFO, "IndexTest",
+                "record " + std::to_string(i), loc, timeOf(i), "1", "main");
+            appender->Append(event);
+        }
+        appender->Flush();
+    }
+
+    IDLog::Utils::LogReader reader(filename);
+    assert(reader.HasIndex());
+    assert(!reader.IsBinary());
+    assert(reader.GetIndex().size() == 10);
+
+    // 只读取覆盖 [42s, 57s] 的索引区间
+    std::ostringstream oss;
+    [[maybe_unused]] uint64_t bytes = reader.ReadRange(timeOf(42), timeOf(57), oss);
+    std::string text = oss.str();
+    assert(bytes == text.size());
+    assert(bytes < reader.GetFileSize() / 2);
+    assert(text.find("record 42\n") != std::string::npos);
+    assert(text.find("record 57\n") != std::string::npos);
+    assert(text.find("record 20\n") == std::string::npos);
+    assert(text.find("record 70\n") == std::string::npos);
+    assert(text.compare(0, 10, "record 40\n") == 0);
+
+    // 范围之外没有数据
+    std::ostringstream none;
+    assert(reader.ReadRange(timeOf(-100), timeOf(-50), none) == 0);
+
+    // 按大小滚动时，索引随日志文件一起重命名
+    {
+        auto appender = std::make_shared<IDLog::FileAppender>(filename,
+            std::make_shared<IDLog::PatternFormatter>("%m%n"), IDLog::FileAppender::RollPolicy::SIZE, 64);
+        appender->SetIndexInterval(1, 0);
+        IDLog::SourceLocation loc(__FILE__, __FUNCTION__, __LINE__);
+        auto event = std::make_shared<IDLog::LogEvent>(IDLog::LogLevel::INFO, "IndexTest", "after roll", loc);
+        appender->Append(event);
+        appender->Flush();
+    }
+    for (const auto& entry : std::filesystem::directory_iterator("."))
+    {
+        std::string name = entry.path().filename().string();
+        if (name != filename && name.rfind(filename, 0) == 0 && name.size() > 4 && name.substr(name.size() - 4) != ".idx")
+        {
+            rolled = name;
+        }
+    }
+    assert(!rolled.empty());
+    assert(std::filesystem::exists(IDLog::Utils::LogReader::GetIndexFilename(rolled)));
+    IDLog::Utils::LogReader rolledReader(rolled);
+    assert(rolledReader.GetIndex().size() == 10);
+    IDLog::Utils::LogReader currentReader(filename);
+    assert(currentReader.GetIndex().size() == 1);
+    assert(currentReader.GetIndex()[0].offset == 0);
+
+    std::filesystem::remove(rolled);
+    std::filesystem::remove(IDLog::Utils::LogReader::GetIndexFilename(rolled));
+
+    // 二进制日志的索引项位于段头，按事件时间精确过滤
+    std::string binname = "test_index.idlb";
+    std::filesystem::remove(binname);
+    std::filesystem::remove(IDLog::Utils::LogReader::GetIndexFilename(binname));
+    {
+        auto appender = std::make_shared<IDLog::BinaryFileAppender>(binname, 10);
+        appender->SetIndexInterval(1, 0);
+        IDLog::SourceLocation loc(__FILE__, __FUNCTION__, __LINE__);
+        for (int i = 0; i < 100; ++i)
+        {
+            auto event = std::make_shared<IDLog::LogEvent>(IDLog::LogLevel::INFO, "IndexTest",
+                "record " + std::to_string(i), loc, timeOf(i), "1", "main");
+            appender->Append(event);
+        }
+        appender->Flush();
+    }
+    IDLog::Utils::LogReader binReader(binname);
+    assert(binReader.IsBinary());
+    assert(binReader.GetIndex().size() == 10);
+    std::vector<std::string> messages;
+    [[maybe_unused]] size_t count = binReader.ReadEvents(timeOf(42), timeOf(57),
+        [&](const IDLog::LogEvent::Pointer& event) { messages.push_back(event->GetLogMessage()); });
+    assert(count == 16);
+    assert(messages.front() == "record 42" && messages.back() == "record 57");
+
+    // 范围跨越多个读取块时按段解码，不遗漏也不重复
+    std::filesystem::remove(binname);
+    std::filesystem::remove(IDLog::Utils::LogReader::GetIndexFilename(binname));
+    {
+        auto appender = std::make_shared<IDLog::BinaryFileAppender>(binname, 10);
+        appender->SetIndexInterval(1, 0);
+        IDLog::SourceLocation loc(__FILE__, __FUNCTION__, __LINE__);
+        for (int i = 0; i < 100; ++i)
+        {
+            auto event = std::make_shared<IDLog::LogEvent>(IDLog::LogLevel::INFO, "IndexTest",
+                std::to_string(i) + std::string(3000, 'x'), loc, timeOf(i), "1", "main");
+            appender->Append(event);
+        }
+        appender->Flush();
+    }
+    IDLog::Utils::LogReader largeReader(binname);
+    assert(largeReader.GetFileSize() > 256 * 1024);
+    int next = 5;
+    bool ordered = true;
+    count = largeReader.ReadEvents(timeOf(5), timeOf(94),
+        [&](const IDLog::LogEvent::Pointer& event)
+        {
+            ordered = ordered && event->GetLogMessage().rfind(std::to_string(next) + "x", 0) == 0;
+            ++next;
+        });
+    assert(count == 90 && next == 95 && ordered);
+    std::filesystem::remove(binname);
+    std::filesystem::remove(IDLog::Utils::LogReader::GetIndexFilename(binname));
+    std::cout << "  -> Passed" << std::endl;
+}
+
 int main()
 {
     std::cout << "=== IDLog Appender Tests ===" << std::endl;
     TestConsoleAppender();
+    TestConsoleAppenderBuffered();
     TestFileAppender();
+    TestBinaryFileAppender();
+    TestFileIndex();
     std::cout << "=== All Appender Tests Passed ===" << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
  * @Description: 综合性能基准测试 (同步 vs 异步)
  * @Author: InverseDark
  * @Date: 2025-12-27 12:12:16
- * @LastEditTime: 2025-12-27 12:12:53
+ * @LastEditTime: 2026-10-18 23:12:20
  * @LastEditors: InverseDark
  */
 #include "IDLog/IDLog.h"
@@ -13,6 +13,8 @@
 #include <atomic>
 #include <iomanip>
 #include <filesystem>
+#include <fstream>
+#include <unistd.h>
 
 // 测试配置
 const int THREAD_COUNT = 1;          // 线程数
@@ -25,6 +27,93 @@ void CleanLogFiles() {
     std::filesystem::remove("bench_async.log");
 }
 
+// 辅助函数：获取当前进程的常驻内存（字节），无法获取时返回0
+size_t GetResidentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t totalPages = 0;
+    size_t residentPages = 0;
+    if (!(statm >> totalPages >> residentPages)) {
+        return 0;
+    }
+    return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+// 辅助函数：批量创建日志器，统计耗时与内存
+void RunLoggerCreationBenchmark(int loggerCount) {
+    std::cout << "正在运行 [创建 " << loggerCount << " 个日志器] 测试..." << std::endl;
+
+    std::vector<IDLog::LoggerManager::LoggerPtr> loggers;
+    loggers.reserve(loggerCount);
+    size_t rssBefore = GetResidentBytes();
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < loggerCount; ++i) {
+        loggers.push_back(IDLOG_GET_LOGGER("bench.module" + std::to_string(i % 100) + ".conn" + std::to_string(i)));
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    size_t rssAfter = GetResidentBytes();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    std::cout << "  -> 完成! 耗时: " << duration / 1000 << " ms, 单个: "
+              << std::fixed << std::setprecision(1) << (double)duration * 1000.0 / loggerCount << " ns" << std::endl;
+    if (rssBefore > 0 && rssAfter >= rssBefore) {
+        std::cout << "  -> 内存增长: " << (rssAfter - rssBefore) / 1024 << " KB, 单个: "
+                  << (rssAfter - rssBefore) / loggerCount << " 字节 (含管理器索引与名称)" << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+// 辅助函数：多线程查找已存在日志器的吞吐量
+void RunLoggerLookupBenchmark() {
+    const int LOGGER_COUNT = 1000;           // 预先创建的日志器数量
+    const int LOOKUPS_PER_ROUND = 2000000;  // 每轮查找总次数（平均分给各线程）
+
+    std::vector<std::string> names;
+    for (int i = 0; i < LOGGER_COUNT; ++i) {
+        names.push_back("lookup.module" + std::to_string(i % 10) + ".logger" + std::to_string(i));
+        IDLOG_GET_LOGGER(names.back());
+    }
+
+    std::cout << "正在运行 [GetLogger 多线程查找] 测试..." << std::endl;
+    std::cout << std::left << "  线程数  " << "耗时(ms)       " << "吞吐(百万次/秒)" << std::endl;
+    for (int threadCount = 1; threadCount <= 64; threadCount *= 2) {
+        const int lookupsPerThread = LOOKUPS_PER_ROUND / threadCount;
+        std::atomic<size_t> found(0);
+        std::vector<std::thread> threads;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t]() {
+                size_t localFound = 0;
+                for (int i = 0; i < lookupsPerThread; ++i) {
+                    if (IDLOG_GET_LOGGER(names[(i + t * 7) % LOGGER_COUNT])) {
+                        ++localFound;
+                    }
+                    if (IDLOG_GET_ROOT_LOGGER()) {
+                        ++localFound;
+                    }
+                }
+                found.fetch_add(localFound, std::memory_order_relaxed);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        size_t totalLookups = static_cast<size_t>(lookupsPerThread) * threadCount * 2;
+        if (found.load() != totalLookups) {
+            std::cerr << "  -> 查找结果不完整!" << std::endl;
+            std::exit(1);
+        }
+        std::cout << "  " << std::left << std::setw(8) << threadCount << std::setw(15) << std::fixed << std::setprecision(1) << ms
+                  << std::setprecision(2) << (totalLookups / ms / 1000.0) << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
 // 辅助函数：执行测试任务
 long long RunBenchmark(const std::string& testName, std::function<void()> logFunc) {
     std::cout << "正在运行 [" << testName << "] 测试..." << std::endl;
@@ -75,6 +164,7 @@ int main() {
     {
         auto syncLogger = IDLOG_GET_LOGGER("SyncBench");
         syncLogger->ClearAppenders();
+        syncLogger->SetAdditive(false); // 不输出到根日志器的控制台
         
         // 使用带缓冲优化的 FileAppender
         auto fileAppender = std::make_shared<IDLog::FileAppender>(
@@ -94,6 +184,7 @@ int main() {
         // -------------------------------------------------
         auto asyncLogger = IDLOG_GET_LOGGER("AsyncBench");
         asyncLogger->ClearAppenders();
+        asyncLogger->SetAdditive(false);
 
         auto asyncFileAppender = std::make_shared<IDLog::FileAppender>(
             "bench_async.log",
@@ -153,5 +244,15 @@ int main() {
         std::cout << "========================================" << std::endl;
     }
 
+    // -------------------------------------------------
+    // 4. 测试大量日志器的创建开销
+    // -------------------------------------------------
+    RunLoggerCreationBenchmark(100000);
+
+    // -------------------------------------------------
+    // 5. 测试日志器查找的多线程吞吐量
+    // -------------------------------------------------
+    RunLoggerLookupBenchmark();
+
     return 0;
 }
\ No newline at end of file
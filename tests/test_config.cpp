@@ -2,13 +2,15 @@
  * @Description: 配置加载测试
  * @Author: InverseDark
  * @Date: 2025-12-21 14:41:06
- * @LastEditTime: 2025-12-21 14:46:35
+ * @LastEditTime: 2026-10-19 12:46:05
  * @LastEditors: InverseDark
  */
 #include "IDLog/IDLog.h"
 #include <iostream>
 #include <fstream>
 #include <cassert>
+#include <chrono>
+#include <thread>
 
 void CreateTestConfig(const std::string& filename)
 {
@@ -24,7 +26,7 @@ void TestConfigLoad()
     CreateTestConfig(filename);
     
     auto& config = IDLog::Configuration::GetInstance();
-    bool ret = config.LoadFromFile(filename);
+    [[maybe_unused]] bool ret = config.LoadFromFile(filename);
     assert(ret == true);
     
     auto root = IDLog::LoggerManager::GetInstance().GetRootLogger();
@@ -34,10 +36,129 @@ void TestConfigLoad()
     std::filesystem::remove(filename);
 }
 
+void TestConfigAutoReload()
+{
+    std::cout << "[Test] Configuration Auto Reload..." << std::endl;
+    std::string filename = "test_config_reload.ini";
+    CreateTestConfig(filename);
+
+    auto& config = IDLog::Configuration::GetInstance();
+    [[maybe_unused]] bool ret = config.LoadFromFile(filename);
+    assert(ret == true);
+    config.EnableAutoReload(true, 1);
+    assert(config.IsAutoReloadEnabled());
+
+    auto root = IDLog::LoggerManager::GetInstance().GetRootLogger();
+    [[maybe_unused]] auto waitForLevel = [&](IDLog::LogLevel level) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (root->GetLevel() != level && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return root->GetLevel() == level;
+    };
+
+    // 原地改写
+    {
+        std::ofstream file(filename);
+        file << "[global]\nrootLevel=WARN\n";
+    }
+    assert(waitForLevel(IDLog::LogLevel::WARN));
+
+    // 原子重命名替换
+    {
+        std::ofstream file(filename + ".tmp");
+        file << "[global]\nrootLevel=ERROR\n";
+    }
+    std::filesystem::rename(filename + ".tmp", filename);
+    assert(waitForLevel(IDLog::LogLevel::ERR));
+
+    // 停止应立即返回，而不是等待一个轮询周期
+    [[maybe_unused]] auto start = std::chrono::steady_clock::now();
+    config.EnableAutoReload(false);
+    assert(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500));
+    assert(!config.IsAutoReloadEnabled());
+
+    std::cout << "  -> Passed" << std::endl;
+    std::filesystem::remove(filename);
+}
+
+void TestConfigIncrementalApply()
+{
+    std::cout << "[Test] Configuration Incremental Apply..." << std::endl;
+    auto& config = IDLog::Configuration::GetInstance();
+    [[maybe_unused]] bool ret = config.LoadFromString(
+        "[global]\nrootLevel=INFO\n"
+        "[appender.console]\ntype=console\n"
+        "[filter.level]\ntype=level\nminLevel=INFO\n"
+        "[logger.incremental]\nlevel=INFO\nappenders=console\nfilters=level\n"
+        "[logger.incremental.other]\nlevel=INFO\nappenders=console\n"
+        "[levels]\nincremental.rule.*=DEBUG\n");
+    assert(ret == true);
+
+    auto& loggerMgr = IDLog::LoggerManager::GetInstance();
+    auto logger = loggerMgr.GetLogger("incremental");
+    auto other = loggerMgr.GetLogger("incremental.other");
+    assert(logger->GetAppenders().size() == 1 && logger->GetFilters().size() == 1);
+    auto appender = logger->GetAppenders()[0];
+    auto filter = logger->GetFilters()[0];
+    // [levels] 节中的通配规则对之后创建的日志器生效
+    assert(loggerMgr.GetLogger("incremental.rule.x")->GetLevel() == IDLog::LogLevel::DBG);
+    // 同名输出器在日志器之间共享
+    assert(other->GetAppenders()[0] == appender);
+
+    // 只修改级别：输出器与过滤器实例保持不变
+    IDLog::Configuration::Options options = config.GetOptions();
+    options.loggers["incremental"].level = IDLog::LogLevel::WARN;
+    ret = config.ApplyOptions(options);
+    assert(ret == true);
+    assert(logger->GetLevel() == IDLog::LogLevel::WARN);
+    assert(logger->GetAppenders()[0] == appender);
+    assert(logger->GetFilters()[0] == filter);
+
+    // 修改输出器参数：只重建该输出器
+    options.appenders["console"].params["target"] = "stderr";
+    ret = config.ApplyOptions(options);
+    assert(ret == true);
+    assert(logger->GetAppenders()[0] != appender);
+    assert(other->GetAppenders()[0] == logger->GetAppenders()[0]);
+    assert(logger->GetFilters()[0] == filter);
+
+    // 创建失败时不修改任何日志器，也不保存失败的配置
+    auto current = logger->GetAppenders()[0];
+    options.appenders["console"].type = "unknown";
+    ret = config.ApplyOptions(options);
+    assert(ret == false);
+    assert(logger->GetAppenders()[0] == current);
+    assert(config.GetOptions().appenders.at("console").type != "unknown");
+
+    // JSON 格式化器含无法识别的字段时同样视为配置错误
+    options.appenders["console"].type = "console";
+    options.appenders["console"].formatter = "json";
+    options.formatters["json"].type = "json";
+    options.formatters["json"].params["fields"] = "level,mesage";
+    ret = config.ApplyOptions(options);
+    assert(ret == false);
+    assert(logger->GetAppenders()[0] == current);
+    options.appenders["console"].formatter.clear();
+    options.formatters.erase("json");
+
+    // 重新加载的配置删除日志器节后，该日志器恢复继承级别
+    options.appenders["console"].type = "console";
+    options.loggers.erase("incremental.other");
+    ret = config.ApplyOptions(options);
+    assert(ret == true);
+    assert(other->GetLevel() == IDLog::LogLevel::WARN);
+
+    std::cout << "  -> Passed" << std::endl;
+}
+
 int main()
 {
     std::cout << "=== IDLog Config Tests ===" << std::endl;
     TestConfigLoad();
+    TestConfigAutoReload();
+    TestConfigIncrementalApply();
     std::cout << "=== All Config Tests Passed ===" << std::endl;
     return 0;
 }
\ No newline at end of file
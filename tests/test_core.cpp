@@ -1,14 +1,17 @@
 /** 
- * @Description: 核心功能测试 (Level, Event, Logger, Macros)
+ * @Description: 核心功能测试 (Level, Event, Logger, Stream, Format, Macros)
  * @Author: InverseDark
  * @Date: 2025-12-27 13:08:58
- * @LastEditTime: 2025-12-27 13:18:46
+ * @LastEditTime: 2026-10-19 12:46:05
  * @LastEditors: InverseDark
  */
 #include "IDLog/IDLog.h"
 #include <iostream>
 #include <cassert>
 #include <string>
+#include <climits>
+#include <atomic>
+#include <thread>
 
 void TestLogLevel()
 {
@@ -46,6 +49,379 @@ void TestLoggerHierarchy()
     std::cout << "  -> Passed" << std::endl;
 }
 
+void TestLoggerRemoveChurn()
+{
+    std::cout << "[Test] Logger Remove Churn..." << std::endl;
+    auto& loggerMgr = IDLog::LoggerManager::GetInstance();
+    auto stable = loggerMgr.GetLogger("churn.stable");
+
+    // 反复创建与删除日志器时，并发的无锁查找始终能找到未删除的日志器
+    std::atomic<bool> stop(false);
+    std::atomic<bool> missing(false);
+    std::thread reader([&]() {
+        while (!stop.load())
+        {
+            if (loggerMgr.GetLogger("churn.stable") != stable)
+            {
+                missing = true;
+            }
+        }
+    });
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::string name = "churn.temp" + std::to_string(i % 300);
+        auto temp = loggerMgr.GetLogger(name);
+        assert(loggerMgr.HasLogger(name));
+        loggerMgr.RemoveLogger(name);
+        assert(!loggerMgr.HasLogger(name));
+    }
+    stop = true;
+    reader.join();
+    assert(!missing.load());
+    assert(loggerMgr.HasLogger("churn.stable"));
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestEffectiveLevels()
+{
+    std::cout << "[Test] Effective Levels and Level Rules..." << std::endl;
+    using IDLog::LogLevel;
+    auto& loggerMgr = IDLog::LoggerManager::GetInstance();
+    loggerMgr.SetRootLevel(LogLevel::INFO);
+
+    auto client = loggerMgr.GetLogger("net.http.client");
+    assert(client->GetLevel() == LogLevel::INFO);
+
+    // 父日志器尚未创建也能下发到子树
+    loggerMgr.SetLoggerLevel("net", LogLevel::DBG);
+    assert(client->GetLevel() == LogLevel::DBG);
+    assert(loggerMgr.GetLogger("net.tcp")->GetLevel() == LogLevel::DBG);
+    assert(loggerMgr.GetLogger("network")->GetLevel() == LogLevel::INFO);
+
+    // 子日志器单独设置的级别优先
+    loggerMgr.SetLoggerLevel("net.http", LogLevel::WARN);
+    assert(client->GetLevel() == LogLevel::WARN);
+    loggerMgr.ResetLoggerLevel("net.http");
+    assert(client->GetLevel() == LogLevel::DBG);
+    loggerMgr.ResetLoggerLevel("net");
+    assert(client->GetLevel() == LogLevel::INFO);
+
+    // 通配规则对之后创建的日志器同样生效，更具体的规则优先
+    loggerMgr.SetLevelRule("db.*", LogLevel::TRACE);
+    loggerMgr.SetLevelRule("db.pool.*", LogLevel::ERR);
+    assert(loggerMgr.GetLogger("db.query")->GetLevel() == LogLevel::TRACE);
+    assert(loggerMgr.GetLogger("db.pool.conn1")->GetLevel() == LogLevel::ERR);
+    assert(loggerMgr.GetLogger("db")->GetLevel() == LogLevel::INFO);
+
+    // 根级别只影响没有单独设置且不匹配规则的日志器
+    loggerMgr.SetRootLevel(LogLevel::WARN);
+    assert(client->GetLevel() == LogLevel::WARN);
+    assert(loggerMgr.GetLogger("db.query")->GetLevel() == LogLevel::TRACE);
+
+    assert(loggerMgr.RemoveLevelRule("db.*"));
+    assert(!loggerMgr.RemoveLevelRule("db.*"));
+    assert(loggerMgr.GetLogger("db.query")->GetLevel() == LogLevel::WARN);
+    loggerMgr.SetLevelRules({});
+    assert(loggerMgr.GetEffectiveLevel("db.pool.conn1") == LogLevel::WARN);
+    loggerMgr.SetRootLevel(LogLevel::INFO);
+
+    // 直接设置受管理日志器的级别等同于单独设置，之后的规则与根级别变化不会覆盖
+    auto db = loggerMgr.GetLogger("db");
+    db->SetLevel(LogLevel::ERR);
+    assert(loggerMgr.GetLogger("db.query")->GetLevel() == LogLevel::ERR);
+    loggerMgr.SetRootLevel(LogLevel::WARN);
+    loggerMgr.SetLevelRule("db*", LogLevel::DBG);
+    assert(db->GetLevel() == LogLevel::ERR);
+    loggerMgr.SetLevelRules({});
+    loggerMgr.ResetLoggerLevel("db");
+    assert(db->GetLevel() == LogLevel::WARN);
+    // 直接设置根日志器的级别等同于 SetRootLevel
+    loggerMgr.GetRootLogger()->SetLevel(LogLevel::INFO);
+    assert(db->GetLevel() == LogLevel::INFO);
+
+    assert(IDLog::Utils::StringUtil::WildcardMatch("net.http.client", "net.*"));
+    assert(IDLog::Utils::StringUtil::WildcardMatch("net.a", "net.?"));
+    assert(!IDLog::Utils::StringUtil::WildcardMatch("network", "net.*"));
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestSharedDefaultAppender()
+{
+    std::cout << "[Test] Shared Default Appender..." << std::endl;
+    auto& loggerMgr = IDLog::LoggerManager::GetInstance();
+    auto first = loggerMgr.GetLogger("Shared.First");
+    auto second = loggerMgr.GetLogger("Shared.Second");
+
+    // 新建的日志器共享同一个默认输出器与默认格式化器
+    auto standalone = std::make_shared<IDLog::Logger>("Standalone");
+    assert(standalone->GetAppenders().size() == 1);
+    assert(standalone->GetAppenders()[0] == IDLog::Logger::GetDefaultAppender());
+    assert(first->GetEffectiveAppenders().size() == 1);
+    assert(first->GetEffectiveAppenders()[0] == IDLog::Logger::GetDefaultAppender());
+    assert(second->GetEffectiveAppenders()[0] == first->GetEffectiveAppenders()[0]);
+    assert(IDLog::Logger::GetDefaultAppender()->GetFormatter() == IDLog::PatternFormatter::GetDefault());
+
+    // 不叠加时只输出到自身的输出器，不影响其他日志器
+    first->SetAdditive(false);
+    assert(first->GetEffectiveAppenders().empty());
+    assert(second->GetEffectiveAppenders()[0] == IDLog::Logger::GetDefaultAppender());
+    first->SetAdditive(true);
+    std::cout << "  -> Passed" << std::endl;
+}
+
+class CountingAppender : public IDLog::LogAppender
+{
+public:
+    int count = 0;
+    void Append(const IDLog::LogEvent::Pointer&) override { count++; }
+    std::string GetName() const override { return "Counting"; }
+    void Flush() override {}
+};
+
+void TestAdditiveAppenders()
+{
+    std::cout << "[Test] Additive Appenders..." << std::endl;
+    auto& loggerMgr = IDLog::LoggerManager::GetInstance();
+    auto app = loggerMgr.GetLogger("app");
+    auto leaf = loggerMgr.GetLogger("app.db.pool");
+    assert(leaf->GetParent() == app);
+    assert(app->GetParent() == loggerMgr.GetRootLogger());
+
+    auto appAppender = std::make_shared<CountingAppender>();
+    auto leafAppender = std::make_shared<CountingAppender>();
+    app->AddAppender(appAppender);
+    leaf->AddAppender(leafAppender);
+
+    // 叶子日志器的实际输出目标：自身 + app + 根（已展开）
+    assert(leaf->GetEffectiveAppenders().size() == 3);
+    leaf->Info("to all");
+    assert(leafAppender->count == 1 && appAppender->count == 1);
+
+    // 中间层后创建时，子日志器改挂到它下面
+    auto db = loggerMgr.GetLogger("app.db");
+    assert(leaf->GetParent() == db);
+    db->SetAdditive(false);
+    assert(leaf->GetEffectiveAppenders().size() == 1);
+    leaf->Info("leaf only");
+    assert(leafAppender->count == 2 && appAppender->count == 1);
+
+    // 删除中间层后恢复挂到 app 下
+    loggerMgr.RemoveLogger("app.db");
+    assert(leaf->GetParent() == app);
+    leaf->Info("again");
+    assert(leafAppender->count == 3 && appAppender->count == 2);
+
+    // 同一个输出器只输出一次
+    leaf->AddAppender(appAppender);
+    leaf->Info("dedup");
+    assert(appAppender->count == 3);
+
+    app->SetAppenders({});
+    leaf->SetAppenders({});
+    std::cout << "  -> Passed" << std::endl;
+}
+
+class LastEventAppender : public IDLog::LogAppender
+{
+public:
+    IDLog::LogEvent::Pointer last;
+    void Append(const IDLog::LogEvent::Pointer& event) override { last = event; }
+    std::string GetName() const override { return "LastEvent"; }
+    void Flush() override {}
+};
+
+void TestConditionalMacros()
+{
+    std::cout << "[Test] Conditional Macros..." << std::endl;
+    auto logger = std::make_shared<IDLog::Logger>("Conditional");
+    auto counter = std::make_shared<CountingAppender>();
+    logger->SetAppenders({counter});
+
+    for (int i = 0; i < 10; ++i)
+    {
+        IDLOG_INFO_EVERY_N(logger, 3, "every n {}", i);
+    }
+    assert(counter->count == 4); // 第 0、3、6、9 次
+
+    counter->count = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        IDLOG_WARN_FIRST_N(logger, 2, "first n");
+    }
+    assert(counter->count == 2);
+
+    counter->count = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        IDLOG_ERROR_EVERY_MS(logger, 60000, "every ms {}", i);
+    }
+    assert(counter->count == 1);
+
+    // 日志事件带有宏所在的源文件位置
+    auto last = std::make_shared<LastEventAppender>();
+    logger->SetAppenders({last});
+    [[maybe_unused]] const int expectedLine = __LINE__ + 1;
+    IDLOG_LOG_IF(logger, IDLog::LogLevel::INFO, true, "located {}", 1);
+    assert(last->last && last->last->GetSourceLocation().lineNumber == expectedLine);
+    logger->SetAppenders({counter});
+
+    // 级别未启用时条件与参数都不求值
+    counter->count = 0;
+    int evaluated = 0;
+    auto touch = [&]() { return ++evaluated; };
+    IDLOG_LOG_IF(logger, IDLog::LogLevel::DBG, touch() > 0, "{}", touch());
+    IDLOG_DEBUG_EVERY_N(logger, 1, "{}", touch());
+    assert(evaluated == 0 && counter->count == 0);
+
+    IDLOG_LOG_IF(logger, IDLog::LogLevel::INFO, evaluated > 0, "skipped");
+    IDLOG_LOG_IF(logger, IDLog::LogLevel::INFO, evaluated == 0, "taken {}", 1);
+    assert(counter->count == 1);
+    IDLOG_INFO_IF(false, "root logger {}", "never");
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestMessageOwnership()
+{
+    std::cout << "[Test] Message Ownership..." << std::endl;
+    auto logger = std::make_shared<IDLog::Logger>("MessageOwnership");
+    auto appender = std::make_shared<LastEventAppender>();
+    logger->SetAppenders({appender});
+
+    // 静态消息只保存指针
+    static const char kLiteral[] = "static literal";
+    logger->Info(IDLog::StaticMessage(kLiteral, sizeof(kLiteral) - 1));
+    assert(appender->last->GetLogMessageView().data() == kLiteral);
+    assert(appender->last->GetLogMessage() == "static literal");
+
+    // 宏传入的字面量转为静态消息，字符数组仍然复制
+    [[maybe_unused]] IDLog::LogMessage literal = IDLOG_MESSAGE("macro literal");
+    char buffer[16] = "stack buffer";
+    IDLog::LogMessage borrowed = IDLOG_MESSAGE(buffer);
+#if defined(__GNUC__) || defined(__clang__)
+    assert(literal.GetKind() == IDLog::LogMessage::Kind::STATIC);
+#endif
+    assert(borrowed.GetKind() == IDLog::LogMessage::Kind::BORROWED);
+    logger->Info(borrowed);
+    buffer[0] = 'X';
+    assert(appender->last->GetLogMessage() == "stack buffer");
+
+    // 右值字符串被移动到事件中
+    std::string large(256, 'm');
+    [[maybe_unused]] const char* data = large.data();
+    logger->Info(std::move(large));
+    assert(appender->last->GetLogMessageView().data() == data);
+
+    // string_view 与 C 字符串
+    std::string_view view("view message", 4);
+    logger->Warn(view);
+    assert(appender->last->GetLogMessage() == "view");
+    logger->Error(static_cast<const char*>(nullptr));
+    assert(appender->last->GetLogMessage().empty());
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestLogStream()
+{
+    std::cout << "[Test] Log Stream..." << std::endl;
+    auto logger = std::make_shared<IDLog::Logger>("LogStream");
+    auto appender = std::make_shared<LastEventAppender>();
+    logger->SetAppenders({appender});
+
+    IDLOG_INFO_S(logger) << "x=" << 42 << ' ' << 1.5;
+    assert(appender->last->GetLogMessage() == "x=42 1.5");
+    assert(appender->last->GetLevel() == IDLog::LogLevel::INFO);
+
+    // 级别未启用时不求值
+    int evaluated = 0;
+    auto count = [&]() { return ++evaluated; };
+    appender->last.reset();
+    IDLOG_DEBUG_S(logger) << count();
+    assert(evaluated == 0 && !appender->last);
+
+    // else 仍属于外层 if
+    [[maybe_unused]] bool elseTaken = false;
+    if (evaluated != 0)
+        IDLOG_INFO_S(logger) << "unreachable";
+    else
+        elseTaken = true;
+    assert(elseTaken);
+
+    // 格式状态不会带到下一条
+    IDLOG_WARN_S(logger.get()) << std::hex << 255;
+    assert(appender->last->GetLogMessage() == "ff");
+    IDLOG_WARN_S(logger) << 255;
+    assert(appender->last->GetLogMessage() == "255");
+
+    // 嵌套使用独立的缓冲区
+    auto inner = [&]() {
+        IDLOG_ERROR_S(logger) << "inner";
+        assert(appender->last->GetLogMessage() == "inner");
+        return "done";
+    };
+    IDLOG_INFO_S(logger) << "outer " << inner();
+    assert(appender->last->GetLogMessage() == "outer done");
+    std::cout << "  -> Passed" << std::endl;
+}
+
+struct TestPoint
+{
+    int x;
+    int y;
+};
+
+template <>
+struct IDLog::Utils::TypeFormatter<TestPoint>
+{
+    static void Format(std::string &out, const TestPoint &p, const IDLog::Utils::FormatSpec &)
+    {
+        IDLog::Utils::FormatTo(out, "({}, {})", p.x, p.y);
+    }
+};
+
+void TestFormat()
+{
+    std::cout << "[Test] Type-safe Format..." << std::endl;
+    using IDLog::Utils::Format;
+
+    // 编译期检查
+    static_assert(IDLog::Utils::CheckFormat("a={} b={}", 2), "count");
+    static_assert(IDLog::Utils::CheckFormat("{{}} {1} {0}", 2), "indexed");
+    static_assert(!IDLog::Utils::CheckFormat("{} {}", 1), "missing arg");
+    static_assert(!IDLog::Utils::CheckFormat("{", 0), "unclosed");
+    static_assert(!IDLog::Utils::CheckFormat("}", 0), "stray brace");
+    static_assert(!IDLog::Utils::CheckFormat("{:q}", 1), "bad type");
+
+    // 基本类型
+    std::string name = "idlog";
+    assert(Format("{} {} {} {}", 42, -7, name, "lit") == "42 -7 idlog lit");
+    assert(Format("{} {}", true, 'c') == "true c");
+    assert(Format("{}", LLONG_MIN) == "-9223372036854775808");
+    assert(Format("{}", 0.1) == "0.1");
+    assert(Format("{:.2f}", 3.14159) == "3.14");
+    assert(Format("{:.3e}", 12345.678) == "1.235e+04");
+    assert(Format("{}", static_cast<const char *>(nullptr)) == "(null)");
+
+    // 格式说明
+    assert(Format("{:x} {:#X} {:b} {:o}", 255, 255, 5, 8) == "ff 0XFF 101 10");
+    assert(Format("[{:>5}] [{:<5}] [{:^5}] [{:*^7}]", 1, 2, "ab", "mid") == "[    1] [2    ] [ ab  ] [**mid**]");
+    assert(Format("{:08.3f} {:+} {:05}", -3.5, 5, -42) == "-003.500 +5 -0042");
+    assert(Format("[{:.2}] [{:4}]", "abcdef", "中文") == "[ab] [中文  ]");
+
+    // 下标、转义与用户类型
+    assert(Format("{1}-{0} {{ok}}", "a", "b") == "b-a {ok}");
+    assert(Format("p={}", TestPoint{1, -2}) == "p=(1, -2)");
+
+    // 运行时错误不会崩溃，原样输出占位符
+    assert(Format("{} {}", 1) == "1 {}");
+    assert(Format("{:q}", 1) == "{:q}");
+
+    // 追加到已有缓冲区
+    std::string out = "prefix:";
+    IDLog::Utils::FormatTo(out, "{}", 9);
+    assert(out == "prefix:9");
+    std::cout << "  -> Passed" << std::endl;
+}
+
 void TestMacros()
 {
     std::cout << "[Test] Logging Macros..." << std::endl;
@@ -57,7 +433,7 @@ void TestMacros()
     IDLOG_ERROR("Error macro test");
     IDLOG_FATAL("Fatal macro test");
     
-    IDLOG_INFO_FMT("Formatted macro test: %d, %s", 123, "abc");
+    IDLOG_INFO_FMT("Formatted macro test: {}, {}", 123, "abc");
     std::cout << "  -> Passed" << std::endl;
 }
 
@@ -67,6 +443,14 @@ int main()
     TestLogLevel();
     TestLogEvent();
     TestLoggerHierarchy();
+    TestLoggerRemoveChurn();
+    TestEffectiveLevels();
+    TestSharedDefaultAppender();
+    TestAdditiveAppenders();
+    TestConditionalMacros();
+    TestMessageOwnership();
+    TestLogStream();
+    TestFormat();
     TestMacros();
     std::cout << "=== All Core Tests Passed ===" << std::endl;
     return 0;
@@ -2,19 +2,28 @@
  * @Description: 过滤器测试
  * @Author: InverseDark
  * @Date: 2025-12-27 13:20:17
- * @LastEditTime: 2025-12-27 13:20:20
+ * @LastEditTime: 2026-10-19 12:46:05
  * @LastEditors: InverseDark
  */
 #include "IDLog/IDLog.h"
 #include <iostream>
 #include <cassert>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
 
 // 模拟 Appender，用于计数
 class CounterAppender : public IDLog::LogAppender
 {
 public:
     int count = 0;
-    void Append(const IDLog::LogEvent::Pointer&) override { count++; }
+    std::string lastMessage;
+    void Append(const IDLog::LogEvent::Pointer& event) override
+    {
+        count++;
+        lastMessage = event->GetLogMessage();
+    }
     std::string GetName() const override { return "Counter"; }
     void Flush() override {}
 };
@@ -38,10 +47,304 @@ void TestLevelFilter()
     std::cout << "  -> Passed" << std::endl;
 }
 
+void TestRateLimitFilter()
+{
+    std::cout << "[Test] Rate Limit Filter..." << std::endl;
+    auto logger = std::make_shared<IDLog::Logger>("RateLimitTest");
+    auto appender = std::make_shared<CounterAppender>();
+    logger->ClearAppenders();
+    logger->AddAppender(appender);
+
+    // 每秒1条，最多连续3条：同一调用点连续10条只放行3条
+    auto filter = std::make_shared<IDLog::RateLimitFilter>(1.0, 3);
+    logger->AddFilter(filter);
+    for (int i = 0; i < 10; ++i)
+    {
+        logger->Info("flood", IDLOG_SOURCE_LOCATION());
+    }
+    assert(appender->count == 3);
+    assert(filter->GetSuppressedCount() == 7);
+
+    // 不同调用点使用不同的桶
+    logger->Info("other", IDLOG_SOURCE_LOCATION());
+    assert(appender->count == 4);
+
+    // 桶恢复放行时紧跟一条被抑制条数的说明
+    logger->ClearFilters();
+    logger->AddFilter(std::make_shared<IDLog::RateLimitFilter>(100.0, 1, IDLog::RateLimitFilter::KEY_LOGGER));
+    appender->count = 0;
+    logger->Warn("first");
+    logger->Warn("second");
+    logger->Warn("third");
+    assert(appender->count == 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    logger->Warn("recovered");
+    assert(appender->count == 3);
+    assert(appender->lastMessage.find("suppressed 2 messages") != std::string::npos);
+
+    // 不再出现的调用点：说明由之后其他调用点的日志汇总输出
+    appender->count = 0;
+    logger->ClearFilters();
+    logger->AddFilter(std::make_shared<IDLog::RateLimitFilter>(100.0, 1));
+    for (int i = 0; i < 3; ++i)
+    {
+        logger->Warn("stopped", IDLOG_SOURCE_LOCATION());
+    }
+    assert(appender->count == 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    logger->Info("elsewhere", IDLOG_SOURCE_LOCATION());
+    assert(appender->count == 3);
+    assert(appender->lastMessage.find("suppressed 2 messages") != std::string::npos);
+
+    // 移除过滤器时输出剩余的说明
+    for (int i = 0; i < 3; ++i)
+    {
+        logger->Warn("pending", IDLOG_SOURCE_LOCATION());
+    }
+    assert(appender->count == 4);
+    logger->ClearFilters();
+    assert(appender->count == 5);
+    assert(appender->lastMessage.find("suppressed 2 messages") != std::string::npos);
+
+    // 从配置参数创建
+    IDLog::LogFactory factory;
+    auto created = factory.CreateFilter("ratelimit", {{"rate", "5"}, {"burst", "2"}, {"key", "logger, level"}});
+    auto rateLimit = std::dynamic_pointer_cast<IDLog::RateLimitFilter>(created);
+    assert(rateLimit);
+    assert(rateLimit->GetBurst() == 2);
+    assert(rateLimit->GetKeyFields() == (IDLog::RateLimitFilter::KEY_LOGGER | IDLog::RateLimitFilter::KEY_LEVEL));
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestDedupFilter()
+{
+    std::cout << "[Test] Dedup Filter..." << std::endl;
+    auto logger = std::make_shared<IDLog::Logger>("DedupTest");
+    auto appender = std::make_shared<CounterAppender>();
+    logger->ClearAppenders();
+    logger->AddAppender(appender);
+
+    auto filter = std::make_shared<IDLog::DedupFilter>(std::chrono::milliseconds(50));
+    logger->AddFilter(filter);
+
+    // 窗口内完全相同的日志只输出一次，级别或内容不同的不受影响
+    for (int i = 0; i < 100; ++i)
+    {
+        logger->Error("connect failed: timeout");
+    }
+    logger->Warn("connect failed: timeout");
+    logger->Error("connect failed: refused");
+    assert(appender->count == 3);
+    assert(filter->GetSuppressedCount() == 99);
+
+    // 窗口结束后再次出现时放行，并输出重复次数与时间范围
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    logger->Error("connect failed: timeout");
+    assert(appender->count == 5);
+    assert(appender->lastMessage.find("last message repeated 99 times between ") != std::string::npos);
+    assert(appender->lastMessage.find("connect failed: timeout") != std::string::npos);
+    assert(appender->lastMessage.find(" in logger DedupTest") != std::string::npos);
+
+    // 重复停止后，窗口结束的次数由之后不同的日志带出
+    for (int i = 0; i < 5; ++i)
+    {
+        logger->Error("disk full");
+    }
+    assert(appender->count == 6);
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    logger->Info("disk cleaned");
+    assert(appender->count == 8);
+    assert(appender->lastMessage.find("last message repeated 4 times between ") != std::string::npos);
+    assert(appender->lastMessage.find("disk full") != std::string::npos);
+
+    // 移除过滤器时输出剩余的次数
+    logger->Error("retrying");
+    logger->Error("retrying");
+    assert(appender->count == 9);
+    logger->ClearFilters();
+    assert(appender->count == 10);
+    assert(appender->lastMessage.find("last message repeated 1 times between ") != std::string::npos);
+
+    // 共享的过滤器：说明由其他日志器带出时附带原日志器名称；克隆不影响原过滤器的表
+    auto other = std::make_shared<IDLog::Logger>("DedupOther");
+    other->ClearAppenders();
+    other->AddAppender(appender);
+    logger->AddFilter(filter);
+    other->AddFilter(filter);
+    logger->Error("shared");
+    logger->Error("shared");
+    auto clone = filter->Clone();
+    assert(clone && clone != filter);
+    assert(appender->count == 11);
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    other->Info("other message");
+    assert(appender->count == 13);
+    assert(appender->lastMessage.find("last message repeated 1 times between ") != std::string::npos);
+    assert(appender->lastMessage.find(" in logger DedupTest") != std::string::npos);
+    logger->Error("cloned");
+    logger->Error("cloned");
+    clone = filter->Clone();
+    std::vector<IDLog::Filter::Notice> notices;
+    filter->Flush(notices);
+    assert(notices.size() == 1);
+    assert(notices[0].message.find("cloned in logger DedupTest") != std::string::npos);
+    assert(appender->count == 14);
+    other->ClearFilters();
+    logger->ClearFilters();
+
+    IDLog::LogFactory factory;
+    auto created = std::dynamic_pointer_cast<IDLog::DedupFilter>(factory.CreateFilter("dedup", {{"window", "200"}, {"slots", "8"}}));
+    assert(created);
+    assert(created->GetWindow() == std::chrono::milliseconds(200));
+    assert(created->GetSlotCount() == 8);
+    std::cout << "  -> Passed" << std::endl;
+}
+
+// 模拟不能提前决策的过滤器，用于统计创建了多少日志事件
+class EventCounterFilter : public IDLog::Filter
+{
+public:
+    int count = 0;
+    IDLog::FilterDecision Decide(const LogEventPtr&) override
+    {
+        count++;
+        return IDLog::FilterDecision::NEUTRAL;
+    }
+    std::string GetName() const override { return "EventCounter"; }
+    Pointer Clone() const override { return std::make_shared<EventCounterFilter>(); }
+};
+
+void TestLoggerNameFilter()
+{
+    std::cout << "[Test] Logger Name Filter..." << std::endl;
+    auto net = std::make_shared<IDLog::Logger>("net");
+    auto http = std::make_shared<IDLog::Logger>("net.http");
+    auto network = std::make_shared<IDLog::Logger>("network");
+    assert(net->GetId() != http->GetId());
+    assert(IDLog::Logger::GetNameById(http->GetId()) == "net.http");
+
+    auto filter = std::make_shared<IDLog::LoggerNameFilter>(std::vector<std::string>{"net.*"}, false);
+    auto counter = std::make_shared<EventCounterFilter>();
+    auto appender = std::make_shared<CounterAppender>();
+    for (const auto& logger : {net, http, network})
+    {
+        logger->ClearAppenders();
+        logger->AddAppender(appender);
+        logger->AddFilter(filter);
+        logger->AddFilter(counter);
+    }
+
+    // 被拒绝的日志在创建事件之前返回，后面的过滤器看不到它们
+    for (int i = 0; i < 3; ++i)
+    {
+        net->Info("dropped");
+        http->Info("dropped");
+        network->Info("kept");
+    }
+    assert(appender->count == 3);
+    assert(counter->count == 3);
+
+    // 事件阶段的决策与提前决策一致
+    assert(filter->Decide(std::make_shared<IDLog::LogEvent>(IDLog::LogLevel::INFO, "net.http")) == IDLog::FilterDecision::DENY);
+    assert(filter->Decide(std::make_shared<IDLog::LogEvent>(IDLog::LogLevel::INFO, "network")) == IDLog::FilterDecision::NEUTRAL);
+
+    // 日志器析构后编号被回收，新日志器复用编号时代数不同，缓存的结果不会沿用
+    const uint32_t httpId = http->GetId();
+    [[maybe_unused]] const uint32_t httpGeneration = IDLog::Logger::GetIdGeneration(httpId);
+    http.reset();
+    assert(IDLog::Logger::GetNameById(httpId).empty());
+    auto storage = std::make_shared<IDLog::Logger>("storage");
+    assert(storage->GetId() == httpId);
+    assert(IDLog::Logger::GetIdGeneration(httpId) != httpGeneration);
+    assert(IDLog::Logger::GetNameById(httpId) == "storage");
+    storage->ClearAppenders();
+    storage->AddAppender(appender);
+    storage->AddFilter(filter);
+    storage->Info("kept");
+    assert(appender->count == 4);
+
+    // 编号超过单个缓存块的日志器同样按缓存决策
+    std::vector<std::shared_ptr<IDLog::Logger>> bulk;
+    for (int i = 0; i < 5000; ++i)
+    {
+        bulk.push_back(std::make_shared<IDLog::Logger>("net.bulk" + std::to_string(i)));
+    }
+    assert(bulk.back()->GetId() >= 4096);
+    assert(filter->PreDecide(IDLog::LogLevel::INFO, bulk.back()->GetId(), IDLog::SourceLocation()) == IDLog::FilterDecision::DENY);
+    assert(filter->PreDecide(IDLog::LogLevel::INFO, bulk.back()->GetId(), IDLog::SourceLocation()) == IDLog::FilterDecision::DENY);
+    assert(filter->PreDecide(IDLog::LogLevel::INFO, storage->GetId(), IDLog::SourceLocation()) == IDLog::FilterDecision::NEUTRAL);
+
+    IDLog::LogFactory factory;
+    auto created = std::dynamic_pointer_cast<IDLog::LoggerNameFilter>(factory.CreateFilter("loggername", {{"names", "db, cache.*"}}));
+    assert(created);
+    assert(created->GetNames().size() == 2);
+    assert(created->Matches("db") && created->Matches("cache.redis") && !created->Matches("dbx"));
+    std::cout << "  -> Passed" << std::endl;
+}
+
+// 线程安全的计数 Appender
+class AtomicCounterAppender : public IDLog::LogAppender
+{
+public:
+    std::atomic<int> count{0};
+    void Append(const IDLog::LogEvent::Pointer&) override { count++; }
+    std::string GetName() const override { return "AtomicCounter"; }
+    void Flush() override {}
+};
+
+void TestFilterSwapConcurrent()
+{
+    std::cout << "[Test] Filter Swap Concurrent..." << std::endl;
+    auto logger = std::make_shared<IDLog::Logger>("FilterSwapTest");
+    auto appender = std::make_shared<AtomicCounterAppender>();
+    logger->ClearAppenders();
+    logger->AddAppender(appender);
+
+    // 记录日志的同时反复替换过滤器链，被替换的链等读者离开后才释放
+    std::atomic<bool> running{true};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&]() {
+            while (running.load())
+            {
+                logger->Info("swap");
+            }
+        });
+    }
+    for (int i = 0; i < 2000; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            logger->SetFilters({std::make_shared<IDLog::LevelFilter>(IDLog::LogLevel::TRACE), std::make_shared<IDLog::DedupFilter>(std::chrono::milliseconds(0))});
+        }
+        else
+        {
+            logger->ClearFilters();
+        }
+    }
+    running.store(false);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // 最后一次清空之后不再有过滤器
+    [[maybe_unused]] const int before = appender->count.load();
+    logger->Info("after");
+    assert(appender->count.load() == before + 1);
+    assert(logger->GetFilters().empty());
+    std::cout << "  -> Passed" << std::endl;
+}
+
 int main()
 {
     std::cout << "=== IDLog Filter Tests ===" << std::endl;
     TestLevelFilter();
+    TestRateLimitFilter();
+    TestDedupFilter();
+    TestLoggerNameFilter();
+    TestFilterSwapConcurrent();
     std::cout << "=== All Filter Tests Passed ===" << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -2,13 +2,15 @@
  * @Description: 格式化器测试
  * @Author: InverseDark
  * @Date: 2025-12-27 13:10:05
- * @LastEditTime: 2025-12-27 13:19:21
+ * @LastEditTime: 2026-10-19 12:33:27
  * @LastEditors: InverseDark
  */
 #include "IDLog/IDLog.h"
 #include <iostream>
 #include <sstream>
 #include <cassert>
+#include <atomic>
+#include <thread>
 
 // 自定义 Appender 用于捕获格式化后的输出
 class StringStreamAppender : public IDLog::LogAppender
@@ -56,10 +58,191 @@ void TestPattern()
     std::cout << "  -> Passed" << std::endl;
 }
 
+void TestJsonEscape()
+{
+    std::cout << "[Test] JSON Escape (SIMD / Scalar)..." << std::endl;
+
+    using IDLog::Utils::JsonUtil;
+    const JsonUtil::SimdLevel original = JsonUtil::GetSimdLevel();
+    const JsonUtil::SimdLevel levels[] = {
+        JsonUtil::SimdLevel::SCALAR, JsonUtil::SimdLevel::SSE2, JsonUtil::SimdLevel::AVX2};
+
+    // 特殊字符出现在不同偏移处，覆盖向量块边界与尾部
+    std::string clean(100, 'a');
+    for (auto level : levels)
+    {
+        JsonUtil::SetSimdLevel(level);
+        for (size_t offset = 0; offset < 70; offset += 7)
+        {
+            std::string input = clean;
+            input[offset] = '"';
+            input[offset + 1] = '\\';
+            input[offset + 2] = '\n';
+            input[offset + 3] = '\x01';
+            std::string expected = clean.substr(0, offset) + "\\\"\\\\\\n\\u0001" + clean.substr(offset + 4);
+            assert(JsonUtil::Escape(input) == expected);
+        }
+        assert(JsonUtil::Escape(clean) == clean);
+        assert(JsonUtil::Escape("") == "");
+
+        // UTF-8 校验：合法多字节序列原样保留，非法字节替换为 U+FFFD
+        std::string utf8 = clean + "\xE4\xB8\xAD\xE6\x96\x87" + clean;
+        assert(JsonUtil::IsValidUtf8(utf8.data(), utf8.size()));
+        assert(JsonUtil::Escape(utf8, true) == utf8);
+        std::string invalid = clean + "\xC0\xAF" + clean;
+        assert(!JsonUtil::IsValidUtf8(invalid.data(), invalid.size()));
+        assert(JsonUtil::Escape(invalid, true) == clean + "\xEF\xBF\xBD\xEF\xBF\xBD" + clean);
+        assert(JsonUtil::Escape(invalid, false) == invalid);
+    }
+    JsonUtil::SetSimdLevel(original);
+
+    // 与 StringUtil::Escape 行为一致
+    assert(IDLog::Utils::StringUtil::Escape("tab\there") == "tab\\there");
+
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestJsonSchema()
+{
+    std::cout << "[Test] JSON Formatter (schema)..." << std::endl;
+
+    IDLog::SourceLocation loc("src/app/main.cpp", "Run", 42);
+    auto event = std::make_shared<IDLog::LogEvent>(
+        IDLog::LogLevel::WARN, "order", "say \"hi\"", loc);
+
+    // 默认 schema 保持原有的九个字段
+    IDLog::JsonFormatter defaultFmt(false);
+    std::string output = defaultFmt.Format(event);
+    assert(output.front() == '{' && output.back() == '\n');
+    assert(output.find("\"level\":\"WARN\"") != std::string::npos);
+    assert(output.find("\"file\":\"main.cpp\"") != std::string::npos);
+    assert(output.find("\"line\":42") != std::string::npos);
+    assert(output.find("\"message\":\"say \\\"hi\\\"\"}") != std::string::npos);
+
+    // 自定义字段、键名、数值时间戳与静态字段
+    IDLog::JsonFormatter fmt(false);
+    [[maybe_unused]] bool ok = fmt.SetFields("timestamp:ts,level:lvl,message:msg,function?");
+    assert(ok);
+    fmt.SetTimestampFormat(IDLog::JsonFormatter::TimestampFormat::EPOCH_NS);
+    fmt.AddStaticField("service", "order-api");
+    std::string buffer = "prefix";
+    fmt.FormatTo(event, buffer);
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(event->GetTime().time_since_epoch()).count();
+    std::string expected = "prefix{\"ts\":" + std::to_string(ns) +
+                           ",\"lvl\":\"WARN\",\"msg\":\"say \\\"hi\\\"\",\"function\":\"Run\",\"service\":\"order-api\"}\n";
+    assert(buffer == expected);
+
+    // 可选字段为空时省略
+    auto noFunc = std::make_shared<IDLog::LogEvent>(
+        IDLog::LogLevel::INFO, "order", "m", IDLog::SourceLocation());
+    std::string out2 = fmt.Format(noFunc);
+    assert(out2.find("function") == std::string::npos);
+    assert(out2.find("\"msg\":\"m\",\"service\"") != std::string::npos);
+
+    // Clone 复制 schema
+    auto cloned = fmt.Clone();
+    assert(cloned->Format(noFunc) == out2);
+
+    // 有无法识别的字段时返回false，字段列表保持不变
+    ok = fmt.SetFields("level,mesage");
+    assert(!ok);
+    assert(fmt.Format(noFunc) == out2);
+
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestPatternSetConcurrent()
+{
+    std::cout << "[Test] Pattern Formatter Concurrent SetPattern..." << std::endl;
+
+    auto fmt = std::make_shared<IDLog::PatternFormatter>("[%p] %m");
+    IDLog::SourceLocation loc(__FILE__, __FUNCTION__, __LINE__);
+    auto event = std::make_shared<IDLog::LogEvent>(IDLog::LogLevel::INFO, "TestLogger", "Hello", loc);
+
+    // 修改模式与格式化并发进行：每次格式化都得到某一个模式的完整结果
+    std::atomic<bool> stop(false);
+    std::atomic<bool> mismatch(false);
+    std::thread reader([&]() {
+        while (!stop.load())
+        {
+            std::string out = fmt->Format(event);
+            if (out != "[INFO] Hello" && out != "TestLogger: Hello")
+            {
+                mismatch = true;
+            }
+        }
+    });
+    for (int i = 0; i < 1000; ++i)
+    {
+        fmt->SetPattern(i % 2 == 0 ? "%c: %m" : "[%p] %m");
+    }
+    stop = true;
+    reader.join();
+    assert(!mismatch.load());
+    assert(fmt->GetPattern() == "[%p] %m");
+
+    // 默认格式化器与克隆互不影响
+    auto defaultFmt = std::static_pointer_cast<IDLog::PatternFormatter>(IDLog::PatternFormatter::GetDefault());
+    auto custom = std::static_pointer_cast<IDLog::PatternFormatter>(defaultFmt->Clone());
+    custom->SetPattern("%m");
+    assert(custom->Format(event) == "Hello");
+    assert(defaultFmt->GetPattern() == IDLog::PatternFormatter::defaultPattern());
+
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestJsonReconfigureConcurrent()
+{
+    std::cout << "[Test] JSON Formatter Concurrent Reconfigure..." << std::endl;
+
+    auto fmt = std::make_shared<IDLog::JsonFormatter>(false);
+    fmt->SetFields("level");
+    auto event = std::make_shared<IDLog::LogEvent>(IDLog::LogLevel::INFO, "TestLogger", "Hello");
+
+    // 修改 schema 与格式化并发进行：每次格式化都得到某一个 schema 的完整结果
+    std::atomic<bool> stop(false);
+    std::atomic<bool> mismatch(false);
+    std::thread reader([&]() {
+        std::string out;
+        while (!stop.load())
+        {
+            out.clear();
+            fmt->FormatTo(event, out);
+            if (out != "{\"level\":\"INFO\"}\n" && out != "{\"msg\":\"Hello\",\"service\":\"api\"}\n" &&
+                out != "{\"msg\":\"Hello\"}\n")
+            {
+                mismatch = true;
+            }
+        }
+    });
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            fmt->SetFields("message:msg");
+            fmt->AddStaticField("service", "api");
+        }
+        else
+        {
+            fmt->ClearStaticFields();
+            fmt->SetFields("level");
+        }
+    }
+    stop = true;
+    reader.join();
+    assert(!mismatch.load());
+
+    std::cout << "  -> Passed" << std::endl;
+}
+
 int main()
 {
     std::cout << "=== IDLog Formatter Tests ===" << std::endl;
     TestPattern();
+    TestPatternSetConcurrent();
+    TestJsonEscape();
+    TestJsonSchema();
+    TestJsonReconfigureConcurrent();
     std::cout << "=== All Formatter Tests Passed ===" << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,475 @@
+/**
+ * @Description: 统计功能测试 (StatisticsManager)
+ * @Author: InverseDark
+ * @Date: 2026-10-18 16:31:05
+ * @LastEditTime: 2026-10-19 12:46:05
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/IDLog.h"
+#include <iostream>
+#include <cassert>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+void TestShardedCounters()
+{
+    std::cout << "[Test] Sharded Statistics Counters..." << std::endl;
+    auto& stats = IDLog::StatisticsManager::GetInstance();
+    stats.EnableStatistics(true);
+
+    uint32_t id = stats.RegisterLogger("StatsA");
+    assert(id != IDLog::StatisticsManager::kInvalidLoggerId);
+    assert(stats.RegisterLogger("StatsA") == id);
+    assert(stats.GetLoggerName(id) == "StatsA");
+    uint32_t otherId = stats.RegisterLogger("StatsB");
+    assert(otherId != id);
+
+    // 多个线程写各自的分片，读取时汇总
+    const int threadCount = 4;
+    const int perThread = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < perThread; ++i)
+            {
+                stats.RecordLog(id, i % 2 ? IDLog::LogLevel::WARN : IDLog::LogLevel::INFO, 10);
+            }
+            stats.RecordDroppedLog(otherId, 7);
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    IDLog::LogStatistics a = stats.GetLoggerStatistics("StatsA");
+    assert(a.GetTotalLogs() == static_cast<uint64_t>(threadCount * perThread));
+    assert(a.GetTotalBytes() == static_cast<uint64_t>(threadCount * perThread * 10));
+    assert(a.GetLevelStatistics(IDLog::LogLevel::WARN).GetCount() == static_cast<uint64_t>(threadCount * perThread / 2));
+    assert(a.GetLevelStatistics(IDLog::LogLevel::INFO).GetMaxMessageSize() == 10);
+
+    IDLog::LogStatistics b = stats.GetLoggerStatistics("StatsB");
+    assert(b.GetTotalLogs() == 0);
+    assert(b.GetDroppedLogs() == static_cast<uint64_t>(threadCount));
+
+    IDLog::LogStatistics global = stats.GetGlobalStatistics();
+    assert(global.GetTotalLogs() >= a.GetTotalLogs());
+    assert(global.GetDroppedBytes() >= static_cast<uint64_t>(threadCount * 7));
+
+    // 重置单个日志器不影响其他日志器，重置后继续计数
+    stats.ResetLoggerStatistics("StatsA");
+    assert(stats.GetLoggerStatistics("StatsA").GetTotalLogs() == 0);
+    assert(stats.GetLoggerStatistics("StatsB").GetDroppedLogs() == static_cast<uint64_t>(threadCount));
+    stats.RecordLog(id, IDLog::LogLevel::ERR, 3);
+    assert(stats.GetLoggerStatistics("StatsA").GetTotalLogs() == 1);
+
+    stats.ResetAllStatistics();
+    assert(stats.GetGlobalStatistics().GetTotalLogs() == 0);
+    assert(stats.GetGlobalStatistics().GetDroppedLogs() == 0);
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestLoggerStatistics()
+{
+    std::cout << "[Test] Logger Statistics..." << std::endl;
+    auto& stats = IDLog::StatisticsManager::GetInstance();
+    stats.EnableStatistics(true);
+
+    auto logger = std::make_shared<IDLog::Logger>("StatsLogger");
+    logger->ClearAppenders();
+    logger->EnableStatistics(true);
+    logger->Info("hello");
+    logger->Debug("filtered by level");
+    logger->Error("world!");
+
+    IDLog::LogStatistics s = stats.GetLoggerStatistics("StatsLogger");
+    assert(s.GetTotalLogs() == 2);
+    assert(s.GetTotalBytes() == 11);
+    assert(s.GetLevelStatistics(IDLog::LogLevel::ERR).GetCount() == 1);
+    assert(stats.GenerateReport().find("Logger: StatsLogger") != std::string::npos);
+
+    stats.EnableStatistics(false);
+    logger->Info("not counted");
+    assert(stats.GetLoggerStatistics("StatsLogger").GetTotalLogs() == 2);
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestLatencyHistogram()
+{
+    std::cout << "[Test] Latency Histogram..." << std::endl;
+    using IDLog::LatencyHistogram;
+
+    // 桶边界：小值精确，大值相对误差不超过 1/16
+    assert(LatencyHistogram::GetBucketIndex(0) == 0);
+    assert(LatencyHistogram::GetBucketIndex(31) == 31);
+    for (uint64_t v : {32ull, 100ull, 1000ull, 123456ull, 987654321ull})
+    {
+        size_t index = LatencyHistogram::GetBucketIndex(v);
+        [[maybe_unused]] uint64_t upper = LatencyHistogram::GetBucketUpperBound(index);
+        assert(upper >= v);
+        assert(upper - v <= v / 16);
+        assert(index == 0 || LatencyHistogram::GetBucketUpperBound(index - 1) < v);
+    }
+
+    LatencyHistogram h;
+    for (uint64_t v = 1; v <= 1000; ++v)
+    {
+        h.Record(v * 1000);
+    }
+    assert(h.GetCount() == 1000);
+    assert(h.GetMax() == 1000000);
+    [[maybe_unused]] uint64_t p50 = h.GetPercentile(50.0);
+    [[maybe_unused]] uint64_t p99 = h.GetPercentile(99.0);
+    assert(p50 >= 500000 && p50 <= 500000 + 500000 / 16);
+    assert(p99 >= 990000 && p99 <= 1000000);
+    assert(h.GetPercentile(100.0) == 1000000);
+
+    LatencyHistogram other;
+    other.Record(5000000);
+    h.Merge(other);
+    assert(h.GetCount() == 1001);
+    assert(h.GetMax() == 5000000);
+    assert(h.ToJson().find("\"p999\"") != std::string::npos);
+
+    // 通过 StatisticsManager 记录，分片汇总后可读取
+    auto& stats = IDLog::StatisticsManager::GetInstance();
+    stats.EnableStatistics(true);
+    stats.ResetAllStatistics();
+    uint32_t id = stats.RegisterLogger("LatencyLogger");
+    std::thread worker([&]() {
+        for (int i = 1; i <= 100; ++i)
+        {
+            stats.RecordLog(id, IDLog::LogLevel::INFO, 1, static_cast<uint64_t>(i) * 1000);
+            stats.RecordLatency(IDLog::LatencyType::SINK_WRITE, 2000);
+        }
+    });
+    worker.join();
+
+    IDLog::LogStatistics s = stats.GetLoggerStatistics("LatencyLogger");
+    [[maybe_unused]] const LatencyHistogram& call = s.GetLatencyHistogram(IDLog::LatencyType::LOG_CALL);
+    assert(call.GetCount() == 100);
+    assert(call.GetMax() == 100000);
+    IDLog::LogStatistics global = stats.GetGlobalStatistics();
+    assert(global.GetLatencyHistogram(IDLog::LatencyType::SINK_WRITE).GetCount() == 100);
+    assert(global.ToJson().find("latency_ns") != std::string::npos);
+
+    stats.ResetAllStatistics();
+    global = stats.GetGlobalStatistics();
+    assert(global.GetLatencyHistogram(IDLog::LatencyType::SINK_WRITE).GetCount() == 0);
+    assert(global.GetLatencyHistogram(IDLog::LatencyType::LOG_CALL).GetCount() == 0);
+    stats.EnableStatistics(false);
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestRateWindow()
+{
+    std::cout << "[Test] Sliding Rate Window..." << std::endl;
+    using IDLog::RateWindow;
+    using IDLog::LogLevel;
+
+    // 使用显式的秒数，结果与真实时钟无关
+    RateWindow window;
+    const uint64_t base = 1001;
+    for (uint64_t sec = base; sec < base + 60; ++sec)
+    {
+        window.Record(LogLevel::INFO, 10, sec);
+        if (sec % 2 == 0)
+        {
+            window.Record(LogLevel::ERR, 100, sec);
+        }
+    }
+    const uint64_t now = base + 60;
+    assert(window.GetLogCount(1, now) == 2);        // 第 base+59 秒（偶数）
+    assert(window.GetLogCount(LogLevel::INFO, 10, now) == 10);
+    assert(window.GetLogCount(LogLevel::ERR, 10, now) == 5);
+    assert(window.GetLogCount(60, now) == 90);
+    assert(window.GetByteCount(LogLevel::ERR, 60, now) == 3000);
+    assert(window.GetByteCount(60, now) == 3600);
+    // 当前秒尚未结束，不计入窗口
+    window.Record(LogLevel::WARN, 1, now);
+    assert(window.GetLogCount(LogLevel::WARN, 1, now) == 0);
+    assert(window.GetLogCount(LogLevel::WARN, 1, now + 1) == 1);
+
+    // 桶环复用：64 秒后旧桶被覆盖，不会被误算
+    window.Record(LogLevel::INFO, 10, now + RateWindow::kSlotCount);
+    assert(window.GetLogCount(LogLevel::INFO, 1, now + RateWindow::kSlotCount + 1) == 1);
+    assert(window.GetLogCount(60, now + 200) == 0);
+
+    RateWindow merged;
+    RateWindow other;
+    merged.Record(LogLevel::INFO, 5, base);
+    other.Record(LogLevel::INFO, 7, base);
+    other.Record(LogLevel::INFO, 7, base - 100); // 超出桶环范围，合并时丢弃
+    merged.Merge(other, base + 1);
+    assert(merged.GetLogCount(LogLevel::INFO, 1, base + 1) == 2);
+    assert(merged.GetByteCount(1, base + 1) == 12);
+    assert(merged.GetLogCount(60, base + 1) == 2);
+
+    // StatisticsManager 按日志器、按级别汇总线程分片中的桶环
+    auto& stats = IDLog::StatisticsManager::GetInstance();
+    stats.EnableStatistics(true);
+    uint32_t id = stats.RegisterLogger("RateLogger");
+    [[maybe_unused]] uint64_t before = RateWindow::GetCurrentSecond();
+    std::thread worker([&]() {
+        for (int i = 0; i < 100; ++i)
+        {
+            stats.RecordLog(id, LogLevel::WARN, 4);
+        }
+    });
+    worker.join();
+    IDLog::LogStatistics loggerStats = stats.GetLoggerStatistics("RateLogger");
+    [[maybe_unused]] const RateWindow& rates = loggerStats.GetRateWindow();
+    [[maybe_unused]] uint64_t after = RateWindow::GetCurrentSecond();
+    assert(rates.GetLogCount(LogLevel::WARN, 60, after + 1) == 100);
+    assert(rates.GetByteCount(60, after + 1) == 400);
+    assert(rates.GetLogCount(LogLevel::INFO, 60, after + 1) == 0);
+    assert(rates.GetLogCount(60, before) == 0);
+    assert(stats.GetGlobalStatistics().GetRateWindow().GetLogCount(LogLevel::WARN, 60, after + 1) >= 100);
+    stats.EnableStatistics(false);
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestAppenderMetrics()
+{
+    std::cout << "[Test] Appender Metrics..." << std::endl;
+    auto& stats = IDLog::StatisticsManager::GetInstance();
+
+    // 文件输出器：记录数、字节数、刷新、滚动
+    std::string filename = "test_metrics.log";
+    std::filesystem::remove(filename);
+    auto fileAppender = std::make_shared<IDLog::FileAppender>(filename,
+        std::make_shared<IDLog::PatternFormatter>("%m%n"), IDLog::FileAppender::RollPolicy::SIZE, 64);
+    auto logger = std::make_shared<IDLog::Logger>("MetricsLogger");
+    logger->ClearAppenders();
+    logger->AddAppender(fileAppender);
+    for (int i = 0; i < 10; ++i)
+    {
+        logger->Info("metrics line " + std::to_string(i)); // 每行 15 字节
+    }
+    fileAppender->Flush();
+
+    [[maybe_unused]] const IDLog::AppenderMetrics& fileMetrics = fileAppender->GetMetrics();
+    assert(fileMetrics.GetRecords() == 10);
+    assert(fileMetrics.GetBytes() == 150);
+    assert(fileMetrics.GetFlushes() == 1);
+    assert(fileMetrics.GetFlushLatency().GetCount() == 1);
+    assert(fileMetrics.GetRollCount() >= 1);
+    assert(fileMetrics.GetWriteCalls() >= fileMetrics.GetRollCount());
+    assert(fileMetrics.GetWriteErrors() == 0);
+
+    // 挂到日志器上的输出器可以通过统计管理类查询
+    [[maybe_unused]] bool found = false;
+    for (const auto& [name, metrics] : stats.GetAllAppenderMetrics())
+    {
+        if (name == fileAppender->GetName())
+        {
+            found = true;
+            assert(metrics.GetRecords() == 10);
+        }
+    }
+    assert(found);
+    assert(stats.GenerateReport().find("Appender: " + fileAppender->GetName()) != std::string::npos);
+    assert(fileMetrics.ToJson().find("\"roll_count\"") != std::string::npos);
+
+    // 异步输出器：未启动时队列只进不出，按溢出策略统计丢弃数
+    auto backend = std::make_shared<IDLog::FileAppender>(filename);
+    auto asyncAppender = std::make_shared<IDLog::AsyncAppender>(backend, 2, 0, 1000,
+        IDLog::AsyncAppender::OverflowPolicy::DROP_NEWEST);
+    IDLog::SourceLocation location{__FILE__, __FUNCTION__, __LINE__};
+    for (int i = 0; i < 5; ++i)
+    {
+        asyncAppender->Append(std::make_shared<IDLog::LogEvent>(IDLog::LogLevel::INFO, "Async", "queued", location));
+    }
+    [[maybe_unused]] const IDLog::AppenderMetrics& asyncMetrics = asyncAppender->GetMetrics();
+    assert(asyncMetrics.GetRecords() == 2);
+    assert(asyncMetrics.GetDropped(static_cast<size_t>(IDLog::AsyncAppender::OverflowPolicy::DROP_NEWEST)) == 3);
+    assert(asyncMetrics.GetTotalDropped() == 3);
+    asyncAppender->Start();
+    asyncAppender->Flush();
+    asyncAppender->Stop();
+    assert(asyncMetrics.GetQueueHighWaterMark() == 2);
+    assert(backend->GetMetrics().GetRecords() == 2);
+
+    logger.reset();
+    fileAppender.reset();
+    asyncAppender.reset();
+    backend.reset();
+    assert(stats.GetAllAppenderMetrics().empty());
+
+    for (const auto& entry : std::filesystem::directory_iterator("."))
+    {
+        if (entry.path().filename().string().rfind("test_metrics", 0) == 0)
+        {
+            std::filesystem::remove(entry.path());
+        }
+    }
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestCallSiteProfiler()
+{
+    std::cout << "[Test] CallSite Profiler..." << std::endl;
+    auto& profiler = IDLog::CallSiteProfiler::GetInstance();
+    profiler.Reset();
+
+    auto logger = std::make_shared<IDLog::Logger>("CallSiteLogger");
+    logger->ClearAppenders();
+    logger->SetLevel(IDLog::LogLevel::TRACE);
+
+    // 未启用时不计数，但调用点仍会注册
+    [[maybe_unused]] size_t registered = profiler.GetCallSiteCount();
+    logger->Info("disabled", IDLOG_SOURCE_LOCATION());
+    assert(profiler.GetCallSiteCount() == registered + 1);
+    assert(profiler.GetAllCallSites().empty());
+
+    profiler.Enable(true);
+    for (int i = 0; i < 10; ++i)
+    {
+        logger->Info("noisy statement", IDLOG_SOURCE_LOCATION()); // 15 字节
+        if (i % 5 == 0)
+        {
+            logger->Warn("rare", IDLOG_SOURCE_LOCATION()); // 4 字节
+        }
+    }
+    // 同一语句多次执行只注册一次
+    assert(profiler.GetCallSiteCount() == registered + 3);
+
+    // 被过滤器拒绝的日志计入丢弃
+    logger->AddFilter(std::make_shared<IDLog::LevelThresholdFilter>(IDLog::LogLevel::WARN));
+    logger->Info("filtered", IDLOG_SOURCE_LOCATION());
+
+    std::vector<IDLog::CallSiteStats> top = profiler.GetTopCallSites(2);
+    assert(top.size() == 2);
+    assert(top[0].calls == 10);
+    assert(top[0].bytes == 150);
+    assert(top[0].functionName == std::string(__FUNCTION__));
+    assert(top[1].calls == 2);
+    assert(top[1].bytes == 8);
+
+    std::vector<IDLog::CallSiteStats> dropped = profiler.GetTopCallSites(1, IDLog::CallSiteProfiler::SortKey::DROPPED_BYTES);
+    assert(dropped.size() == 1);
+    assert(dropped[0].calls == 0);
+    assert(dropped[0].droppedCalls == 1);
+    assert(dropped[0].droppedBytes == 8);
+
+    std::string report = profiler.GenerateReport(5);
+    assert(report.find("#1 ") != std::string::npos);
+    assert(report.find("Calls=10, Bytes=150") != std::string::npos);
+
+    profiler.Reset();
+    assert(profiler.GetAllCallSites().empty());
+    profiler.Enable(false);
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestStatsFile()
+{
+    std::cout << "[Test] Stats File..." << std::endl;
+    auto& stats = IDLog::StatisticsManager::GetInstance();
+    stats.EnableStatistics(true);
+
+    std::string path = (std::filesystem::temp_directory_path() / "idlog_test.stats").string();
+    assert(stats.StartStatsFile(path, 20));
+    assert(stats.GetStatsFilePath() == path);
+    assert(std::filesystem::exists(path));
+
+    auto logger = std::make_shared<IDLog::Logger>("StatsFileLogger");
+    logger->ClearAppenders();
+    logger->EnableStatistics(true);
+    for (int i = 0; i < 5; ++i)
+    {
+        logger->Warn("published"); // 9 字节
+    }
+
+    // 外部读者映射同一文件，等待服务线程发布最新计数
+    IDLog::StatsFile reader;
+    assert(reader.Open(path));
+    IDLog::StatsFile::Snapshot snapshot;
+    const IDLog::StatsFile::Counters* counters = nullptr;
+    for (int attempt = 0; attempt < 200 && !counters; ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        assert(reader.Read(snapshot));
+        for (const auto& logger : snapshot.loggers)
+        {
+            if (std::string(logger.name) == "StatsFileLogger" && logger.totalLogs == 5)
+            {
+                counters = &logger;
+            }
+        }
+    }
+    assert(counters);
+    assert(counters->totalBytes == 45);
+    assert(counters->levelCount[static_cast<size_t>(IDLog::LogLevel::WARN)] == 5);
+    assert(counters->latency[static_cast<size_t>(IDLog::LatencyType::LOG_CALL)].count == 5);
+    assert(snapshot.global.totalLogs >= 5);
+    assert(snapshot.header.publishCount >= 2);
+    assert(snapshot.header.loggerCount == snapshot.loggers.size());
+
+    // 停止后文件被删除，再次打开失败
+    stats.StopStatsFile();
+    assert(stats.GetStatsFilePath().empty());
+    assert(!std::filesystem::exists(path));
+    IDLog::StatsFile closed;
+    assert(!closed.Open(path));
+
+    stats.EnableStatistics(false);
+    std::cout << "  -> Passed" << std::endl;
+}
+
+void TestReportThread()
+{
+    std::cout << "[Test] Report Thread..." << std::endl;
+    auto& stats = IDLog::StatisticsManager::GetInstance();
+    stats.EnableStatistics(true);
+    stats.SetStatisticsInterval(1);
+
+    // 报告回调在统计服务线程上执行，记录日志的线程不生成报告
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::string report;
+    std::thread::id reportThread;
+    stats.RegisterReportCallback([&](const std::string& text) {
+        std::lock_guard<std::mutex> lock(mutex);
+        report = text;
+        reportThread = std::this_thread::get_id();
+        cv.notify_all();
+    });
+
+    auto logger = std::make_shared<IDLog::Logger>("ReportLogger");
+    logger->ClearAppenders();
+    logger->EnableStatistics(true);
+    logger->Info("reported");
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        assert(cv.wait_for(lock, std::chrono::seconds(5), [&]() { return !report.empty(); }));
+        assert(reportThread != std::this_thread::get_id());
+        assert(report.find("Logger: ReportLogger") != std::string::npos);
+    }
+
+    stats.RegisterReportCallback(nullptr);
+    stats.SetStatisticsInterval(60);
+    stats.EnableStatistics(false);
+    std::cout << "  -> Passed" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== IDLog Statistics Tests ===" << std::endl;
+    TestShardedCounters();
+    TestLoggerStatistics();
+    TestLatencyHistogram();
+    TestRateWindow();
+    TestAppenderMetrics();
+    TestCallSiteProfiler();
+    TestStatsFile();
+    TestReportThread();
+    std::cout << "=== All Statistics Tests Passed ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,229 @@
+/**
+ * @Description: 二进制日志解码工具
+ * @Author: InverseDark
+ * @Date: 2026-10-18 14:36:22
+ * @LastEditTime: 2026-10-18 14:36:22
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/IDLog.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+using namespace IDLog;
+
+namespace
+{
+	/// @brief 命令行选项
+	struct Options
+	{
+		std::string format = "pattern";					   ///< 输出格式：pattern / json
+		std::string pattern = PatternFormatter::defaultPattern(); ///< 模式字符串
+		bool pretty = false;							   ///< JSON 是否美化输出
+		unsigned threads = 0;							   ///< 解码线程数，0表示自动
+		std::string output;								   ///< 输出文件，为空时输出到标准输出
+		std::vector<std::string> inputs;				   ///< 输入文件列表
+	};
+
+	/// @brief 打印用法
+	/// @param prog [IN] 程序名
+	void PrintUsage(const char *prog)
+	{
+		std::cerr << "Usage: " << prog << " [options] <file.idlb>...\n"
+				  << "Options:\n"
+				  << "  -f, --format <pattern|json>  output format (default: pattern)\n"
+				  << "  -p, --pattern <pattern>      pattern for pattern format\n"
+				  << "      --pretty                 pretty print json\n"
+				  << "  -j, --threads <n>            decode threads (default: hardware concurrency)\n"
+				  << "  -o, --output <file>          write to file instead of stdout\n"
+				  << "  -h, --help                   show this help\n";
+	}
+
+	/// @brief 解析命令行
+	/// @param argc [IN] 参数个数
+	/// @param argv [IN] 参数列表
+	/// @param options [OUT] 解析结果
+	/// @return 是否解析成功
+	bool ParseArgs(int argc, char **argv, Options &options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string arg = argv[i];
+			auto next = [&](std::string &value) -> bool
+			{
+				if (i + 1 >= argc)
+				{
+					std::cerr << "missing value for " << arg << "\n";
+					return false;
+				}
+				value = argv[++i];
+				return true;
+			};
+
+			std::string value;
+			if (arg == "-f" || arg == "--format")
+			{
+				if (!next(options.format))
+				{
+					return false;
+				}
+			}
+			else if (arg == "-p" || arg == "--pattern")
+			{
+				if (!next(options.pattern))
+				{
+					return false;
+				}
+			}
+			else if (arg == "--pretty")
+			{
+				options.pretty = true;
+			}
+			else if (arg == "-j" || arg == "--threads")
+			{
+				if (!next(value))
+				{
+					return false;
+				}
+				options.threads = static_cast<unsigned>(std::strtoul(value.c_str(), nullptr, 10));
+			}
+			else if (arg == "-o" || arg == "--output")
+			{
+				if (!next(options.output))
+				{
+					return false;
+				}
+			}
+			else if (arg == "-h" || arg == "--help")
+			{
+				return false;
+			}
+			else if (!arg.empty() && arg[0] == '-')
+			{
+				std::cerr << "unknown option: " << arg << "\n";
+				return false;
+			}
+			else
+			{
+				options.inputs.push_back(arg);
+			}
+		}
+		return !options.inputs.empty() && (options.format == "pattern" || options.format == "json");
+	}
+
+	/// @brief 解码一个文件并输出
+	/// @param path [IN] 文件路径
+	/// @param formatter [IN] 输出格式化器（每个线程使用其克隆）
+	/// @param threads [IN] 解码线程数
+	/// @param out [OUT] 输出流
+	/// @return 文件是否完整且格式正确
+	bool DecodeFile(const std::string &path, const Formatter::Pointer &formatter, unsigned threads, std::ostream &out)
+	{
+		std::ifstream in(path, std::ios::binary);
+		if (!in.is_open())
+		{
+			std::cerr << "cannot open " << path << "\n";
+			return false;
+		}
+		std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+		// 段之间互不依赖，按段分给多个线程解码，再按原顺序输出
+		std::vector<BinaryLogDecoder::Segment> segments = BinaryLogDecoder::SplitSegments(data.data(), data.size());
+		std::vector<std::string> results(segments.size());
+		std::vector<char> ok(segments.size(), 1);
+
+		unsigned workerCount = static_cast<unsigned>(std::min<size_t>(std::max(1u, threads), segments.size()));
+		auto worker = [&](unsigned index)
+		{
+			Formatter::Pointer local = formatter->Clone();
+			for (size_t s = index; s < segments.size(); s += workerCount)
+			{
+				std::string &text = results[s];
+				ok[s] = BinaryLogDecoder::Decode(data.data() + segments[s].offset, segments[s].size,
+												 [&](const LogEvent::Pointer &event)
+												 { local->FormatTo(event, text); })
+							? 1
+							: 0;
+			}
+		};
+
+		std::vector<std::thread> pool;
+		for (unsigned i = 1; i < workerCount; ++i)
+		{
+			pool.emplace_back(worker, i);
+		}
+		if (workerCount > 0)
+		{
+			worker(0);
+		}
+		for (auto &t : pool)
+		{
+			t.join();
+		}
+
+		bool success = true;
+		for (size_t s = 0; s < segments.size(); ++s)
+		{
+			out.write(results[s].data(), static_cast<std::streamsize>(results[s].size()));
+			success = success && ok[s];
+		}
+
+		// 末尾不完整的帧（如进程崩溃时正在写入）不属于任何段
+		size_t decoded = segments.empty() ? 0 : segments.back().offset + segments.back().size;
+		if (decoded != data.size())
+		{
+			std::cerr << path << ": " << (data.size() - decoded) << " trailing bytes could not be decoded\n";
+			success = false;
+		}
+		return success;
+	}
+} // namespace
+
+int main(int argc, char **argv)
+{
+	Options options;
+	if (!ParseArgs(argc, argv, options))
+	{
+		PrintUsage(argv[0]);
+		return 2;
+	}
+	if (options.threads == 0)
+	{
+		options.threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	Formatter::Pointer formatter;
+	if (options.format == "json")
+	{
+		formatter = std::make_shared<JsonFormatter>(options.pretty);
+	}
+	else
+	{
+		formatter = std::make_shared<PatternFormatter>(options.pattern);
+	}
+
+	std::ofstream file;
+	if (!options.output.empty())
+	{
+		file.open(options.output, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			std::cerr << "cannot open " << options.output << "\n";
+			return 1;
+		}
+	}
+	std::ostream &out = options.output.empty() ? std::cout : file;
+
+	bool success = true;
+	for (const auto &path : options.inputs)
+	{
+		success = DecodeFile(path, formatter, options.threads, out) && success;
+	}
+	out.flush();
+	return success ? 0 : 1;
+}
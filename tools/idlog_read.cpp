@@ -0,0 +1,214 @@
+/**
+ * @Description: 日志时间范围读取工具
+ * @Author: InverseDark
+ * @Date: 2026-10-18 15:31:20
+ * @LastEditTime: 2026-10-18 15:31:20
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/IDLog.h"
+
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace IDLog;
+
+namespace
+{
+	/// @brief 命令行选项
+	struct Options
+	{
+		Utils::LogReader::TimePoint from = Utils::LogReader::TimePoint::min(); ///< 起始时间
+		Utils::LogReader::TimePoint to = Utils::LogReader::TimePoint::max();   ///< 结束时间
+		std::string format = "pattern";									   ///< 二进制日志的输出格式
+		std::string pattern = PatternFormatter::defaultPattern();		   ///< 模式字符串
+		bool info = false;												   ///< 只打印索引信息
+		std::string input;												   ///< 日志文件
+	};
+
+	/// @brief 打印用法
+	/// @param prog [IN] 程序名
+	void PrintUsage(const char *prog)
+	{
+		std::cerr << "Usage: " << prog << " [options] <logfile>\n"
+				  << "Streams the part of a log file covering a time range, using its .idx sidecar.\n"
+				  << "Options:\n"
+				  << "  --from <time>                start time, inclusive\n"
+				  << "  --to <time>                  end time, inclusive\n"
+				  << "                               time is local \"YYYY-mm-dd HH:MM:SS[.mmm]\" or @<epoch ms>\n"
+				  << "  -f, --format <pattern|json>  output format for binary logs (default: pattern)\n"
+				  << "  -p, --pattern <pattern>      pattern for binary logs\n"
+				  << "      --info                   print index information only\n"
+				  << "  -h, --help                   show this help\n";
+	}
+
+	/// @brief 解析时间参数
+	/// @param text [IN] 时间文本
+	/// @param time [OUT] 时间点
+	/// @return 是否解析成功
+	bool ParseTime(const std::string &text, Utils::LogReader::TimePoint &time)
+	{
+		if (!text.empty() && text[0] == '@')
+		{
+			char *end = nullptr;
+			long long ms = std::strtoll(text.c_str() + 1, &end, 10);
+			if (end == text.c_str() + 1 || *end != '\0')
+			{
+				return false;
+			}
+			time = Utils::LogReader::TimePoint(std::chrono::milliseconds(ms));
+			return true;
+		}
+
+		std::tm tm = {};
+		std::istringstream iss(text);
+		iss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+		if (iss.fail())
+		{
+			return false;
+		}
+		int ms = 0;
+		if (iss.peek() == '.')
+		{
+			iss.get();
+			iss >> ms;
+		}
+		tm.tm_isdst = -1;
+		std::time_t seconds = std::mktime(&tm);
+		if (seconds == static_cast<std::time_t>(-1))
+		{
+			return false;
+		}
+		time = std::chrono::system_clock::from_time_t(seconds) + std::chrono::milliseconds(ms);
+		return true;
+	}
+
+	/// @brief 解析命令行
+	/// @param argc [IN] 参数个数
+	/// @param argv [IN] 参数列表
+	/// @param options [OUT] 解析结果
+	/// @return 是否解析成功
+	bool ParseArgs(int argc, char **argv, Options &options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string arg = argv[i];
+			auto next = [&](std::string &value) -> bool
+			{
+				if (i + 1 >= argc)
+				{
+					std::cerr << "missing value for " << arg << "\n";
+					return false;
+				}
+				value = argv[++i];
+				return true;
+			};
+
+			std::string value;
+			if (arg == "--from" || arg == "--to")
+			{
+				if (!next(value) || !ParseTime(value, arg == "--from" ? options.from : options.to))
+				{
+					std::cerr << "invalid time for " << arg << "\n";
+					return false;
+				}
+			}
+			else if (arg == "-f" || arg == "--format")
+			{
+				if (!next(options.format))
+				{
+					return false;
+				}
+			}
+			else if (arg == "-p" || arg == "--pattern")
+			{
+				if (!next(options.pattern))
+				{
+					return false;
+				}
+			}
+			else if (arg == "--info")
+			{
+				options.info = true;
+			}
+			else if (arg == "-h" || arg == "--help")
+			{
+				return false;
+			}
+			else if (!arg.empty() && arg[0] == '-')
+			{
+				std::cerr << "unknown option: " << arg << "\n";
+				return false;
+			}
+			else
+			{
+				options.input = arg;
+			}
+		}
+		return !options.input.empty() && (options.format == "pattern" || options.format == "json");
+	}
+} // namespace
+
+int main(int argc, char **argv)
+{
+	Options options;
+	if (!ParseArgs(argc, argv, options))
+	{
+		PrintUsage(argv[0]);
+		return 2;
+	}
+
+	Utils::LogReader reader(options.input);
+	if (!reader.IsOpen())
+	{
+		std::cerr << "cannot open " << options.input << "\n";
+		return 1;
+	}
+
+	if (options.info)
+	{
+		const auto &index = reader.GetIndex();
+		std::cout << "file:    " << options.input << " (" << reader.GetFileSize() << " bytes, "
+				  << (reader.IsBinary() ? "binary" : "text") << ")\n"
+				  << "index:   " << (reader.HasIndex() ? Utils::LogReader::GetIndexFilename(options.input) : "none")
+				  << " (" << index.size() << " entries)\n";
+		if (!index.empty())
+		{
+			std::cout << "range:   " << index.front().timeNs << " .. " << index.back().timeNs << " ns\n";
+		}
+		return 0;
+	}
+
+	if (!reader.HasIndex())
+	{
+		std::cerr << "warning: no index for " << options.input << ", reading the whole file\n";
+	}
+
+	if (reader.IsBinary())
+	{
+		Formatter::Pointer formatter;
+		if (options.format == "json")
+		{
+			formatter = std::make_shared<JsonFormatter>(false);
+		}
+		else
+		{
+			formatter = std::make_shared<PatternFormatter>(options.pattern);
+		}
+		std::string line;
+		reader.ReadEvents(options.from, options.to, [&](const LogEvent::Pointer &event)
+						  {
+							  line.clear();
+							  formatter->FormatTo(event, line);
+							  std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+						  });
+	}
+	else
+	{
+		reader.ReadRange(options.from, options.to, std::cout);
+	}
+	std::cout.flush();
+	return 0;
+}
@@ -0,0 +1,414 @@
+/**
+ * @Description: 统计文件查看工具
+ * @Author: InverseDark
+ * @Date: 2026-10-18 20:42:17
+ * @LastEditTime: 2026-10-18 20:42:17
+ * @LastEditors: InverseDark
+ */
+#include "IDLog/IDLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace IDLog;
+
+namespace
+{
+	/// @brief 命令行选项
+	struct Options
+	{
+		double interval = 1.0;	 ///< 刷新间隔（秒）
+		uint64_t count = 0;		 ///< 刷新次数，为0时持续刷新
+		bool prometheus = false; ///< 输出 Prometheus 文本格式
+		bool once = false;		 ///< 只输出一次
+		std::string input;		 ///< 进程号或统计文件路径
+	};
+
+	/// @brief 延迟类型名称，按 LatencyType 索引
+	const char *const kLatencyNames[StatsFile::kLatencyTypeCount] = {"log_call", "queue_wait", "sink_write"};
+	/// @brief 速率窗口名称
+	const char *const kWindowNames[StatsFile::kRateWindowCount] = {"1s", "10s", "60s"};
+	/// @brief 溢出策略名称，按 AsyncAppender::OverflowPolicy 索引
+	const char *const kDropPolicyNames[AppenderMetrics::kDropPolicyCount] = {"block", "drop_oldest", "drop_newest"};
+
+	/// @brief 打印用法
+	/// @param prog [IN] 程序名
+	void PrintUsage(const char *prog)
+	{
+		std::cerr << "Usage: " << prog << " [options] <pid|statsfile>\n"
+				  << "Shows the live statistics a process publishes with StatisticsManager::StartStatsFile.\n"
+				  << "Options:\n"
+				  << "  -i, --interval <seconds>  refresh interval (default: 1)\n"
+				  << "  -n, --count <n>           stop after n refreshes (default: run until interrupted)\n"
+				  << "      --once                print a single snapshot\n"
+				  << "      --prometheus          print a single snapshot in Prometheus text format\n"
+				  << "  -h, --help                show this help\n";
+	}
+
+	/// @brief 解析命令行
+	/// @param argc [IN] 参数个数
+	/// @param argv [IN] 参数列表
+	/// @param options [OUT] 解析结果
+	/// @return 是否解析成功
+	bool ParseArgs(int argc, char **argv, Options &options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string arg = argv[i];
+			auto next = [&](std::string &value) -> bool
+			{
+				if (i + 1 >= argc)
+				{
+					std::cerr << "missing value for " << arg << "\n";
+					return false;
+				}
+				value = argv[++i];
+				return true;
+			};
+
+			std::string value;
+			if (arg == "-i" || arg == "--interval")
+			{
+				if (!next(value))
+				{
+					return false;
+				}
+				options.interval = std::atof(value.c_str());
+				if (options.interval <= 0.0)
+				{
+					std::cerr << "invalid interval: " << value << "\n";
+					return false;
+				}
+			}
+			else if (arg == "-n" || arg == "--count")
+			{
+				if (!next(value))
+				{
+					return false;
+				}
+				options.count = std::strtoull(value.c_str(), nullptr, 10);
+			}
+			else if (arg == "--once")
+			{
+				options.once = true;
+			}
+			else if (arg == "--prometheus")
+			{
+				options.prometheus = true;
+			}
+			else if (arg == "-h" || arg == "--help")
+			{
+				return false;
+			}
+			else if (!arg.empty() && arg[0] == '-')
+			{
+				std::cerr << "unknown option: " << arg << "\n";
+				return false;
+			}
+			else
+			{
+				options.input = arg;
+			}
+		}
+		return !options.input.empty();
+	}
+
+	/// @brief 将命令行参数解析为统计文件路径（纯数字视为进程号）
+	/// @param input [IN] 进程号或路径
+	/// @return 文件路径
+	std::string ResolvePath(const std::string &input)
+	{
+		if (!input.empty() && std::all_of(input.begin(), input.end(), [](char c)
+										  { return c >= '0' && c <= '9'; }))
+		{
+			return StatsFile::GetDefaultPath(std::strtoull(input.c_str(), nullptr, 10));
+		}
+		return input;
+	}
+
+	/// @brief 转义 Prometheus 标签值
+	/// @param value [IN] 原始值
+	/// @return 转义后的值
+	std::string EscapeLabel(const char *value)
+	{
+		std::string result;
+		for (const char *p = value; *p; ++p)
+		{
+			switch (*p)
+			{
+			case '\\':
+				result += "\\\\";
+				break;
+			case '"':
+				result += "\\\"";
+				break;
+			case '\n':
+				result += "\\n";
+				break;
+			default:
+				result += *p;
+				break;
+			}
+		}
+		return result;
+	}
+
+	/// @brief 输出 Prometheus 延迟摘要
+	/// @param os [IN/OUT] 输出流
+	/// @param name [IN] 指标名
+	/// @param labels [IN] 其余标签（形如 type="log_call"）
+	/// @param summary [IN] 延迟摘要
+	void WritePrometheusSummary(std::ostream &os, const char *name, const std::string &labels, const StatsFile::LatencySummary &summary)
+	{
+		const std::pair<const char *, uint64_t> quantiles[] = {
+			{"0.5", summary.p50}, {"0.9", summary.p90}, {"0.99", summary.p99}, {"0.999", summary.p999}, {"1", summary.max}};
+		for (const auto &[quantile, value] : quantiles)
+		{
+			os << name << "{" << labels << ",quantile=\"" << quantile << "\"} " << value << "\n";
+		}
+		// 文件中只有均值，总和按 均值×样本数 还原
+		os << name << "_sum{" << labels << "} " << summary.mean * summary.count << "\n";
+		os << name << "_count{" << labels << "} " << summary.count << "\n";
+	}
+
+	/// @brief 输出 Prometheus 文本格式
+	/// @param os [IN/OUT] 输出流
+	/// @param snapshot [IN] 快照
+	void WritePrometheus(std::ostream &os, const StatsFile::Snapshot &snapshot)
+	{
+		os << "# HELP idlog_last_update_timestamp_seconds Time the statistics were last published.\n"
+		   << "# TYPE idlog_last_update_timestamp_seconds gauge\n"
+		   << "idlog_last_update_timestamp_seconds{pid=\"" << snapshot.header.pid << "\"} "
+		   << std::fixed << std::setprecision(3) << static_cast<double>(snapshot.header.updateTimeMs) / 1000.0 << "\n";
+
+		os << "# HELP idlog_logs_total Log records written, by logger and level.\n"
+		   << "# TYPE idlog_logs_total counter\n";
+		for (const auto &logger : snapshot.loggers)
+		{
+			for (size_t i = 0; i < StatsFile::kLevelCount; ++i)
+			{
+				os << "idlog_logs_total{logger=\"" << EscapeLabel(logger.name) << "\",level=\""
+				   << LevelToString(static_cast<LogLevel>(i)) << "\"} " << logger.levelCount[i] << "\n";
+			}
+		}
+		os << "# HELP idlog_bytes_total Message bytes written, by logger and level.\n"
+		   << "# TYPE idlog_bytes_total counter\n";
+		for (const auto &logger : snapshot.loggers)
+		{
+			for (size_t i = 0; i < StatsFile::kLevelCount; ++i)
+			{
+				os << "idlog_bytes_total{logger=\"" << EscapeLabel(logger.name) << "\",level=\""
+				   << LevelToString(static_cast<LogLevel>(i)) << "\"} " << logger.levelBytes[i] << "\n";
+			}
+		}
+		os << "# HELP idlog_dropped_logs_total Log records dropped, by logger.\n"
+		   << "# TYPE idlog_dropped_logs_total counter\n";
+		for (const auto &logger : snapshot.loggers)
+		{
+			os << "idlog_dropped_logs_total{logger=\"" << EscapeLabel(logger.name) << "\"} " << logger.droppedLogs << "\n";
+		}
+		os << "# HELP idlog_dropped_bytes_total Message bytes dropped, by logger.\n"
+		   << "# TYPE idlog_dropped_bytes_total counter\n";
+		for (const auto &logger : snapshot.loggers)
+		{
+			os << "idlog_dropped_bytes_total{logger=\"" << EscapeLabel(logger.name) << "\"} " << logger.droppedBytes << "\n";
+		}
+		os << "# HELP idlog_logs_per_second Recent log rate, by logger and window.\n"
+		   << "# TYPE idlog_logs_per_second gauge\n";
+		for (const auto &logger : snapshot.loggers)
+		{
+			for (size_t i = 0; i < StatsFile::kRateWindowCount; ++i)
+			{
+				os << "idlog_logs_per_second{logger=\"" << EscapeLabel(logger.name) << "\",window=\"" << kWindowNames[i]
+				   << "\"} " << std::setprecision(2) << logger.logsPerSecond[i] << "\n";
+			}
+		}
+		os << "# HELP idlog_latency_nanoseconds Logging latency, by stage.\n"
+		   << "# TYPE idlog_latency_nanoseconds summary\n";
+		for (size_t i = 0; i < StatsFile::kLatencyTypeCount; ++i)
+		{
+			WritePrometheusSummary(os, "idlog_latency_nanoseconds", std::string("type=\"") + kLatencyNames[i] + "\"",
+								   snapshot.global.latency[i]);
+		}
+
+		const std::pair<const char *, uint64_t StatsFile::AppenderCounters::*> appenderCounters[] = {
+			{"idlog_appender_records_total", &StatsFile::AppenderCounters::records},
+			{"idlog_appender_bytes_total", &StatsFile::AppenderCounters::bytes},
+			{"idlog_appender_write_calls_total", &StatsFile::AppenderCounters::writeCalls},
+			{"idlog_appender_write_errors_total", &StatsFile::AppenderCounters::writeErrors},
+			{"idlog_appender_flushes_total", &StatsFile::AppenderCounters::flushes},
+			{"idlog_appender_rolls_total", &StatsFile::AppenderCounters::rollCount},
+			{"idlog_appender_roll_nanoseconds_total", &StatsFile::AppenderCounters::totalRollTimeNs}};
+		for (const auto &[name, member] : appenderCounters)
+		{
+			os << "# TYPE " << name << " counter\n";
+			for (const auto &appender : snapshot.appenders)
+			{
+				os << name << "{appender=\"" << EscapeLabel(appender.name) << "\"} " << appender.*member << "\n";
+			}
+		}
+		os << "# TYPE idlog_appender_queue_high_water_mark gauge\n";
+		for (const auto &appender : snapshot.appenders)
+		{
+			os << "idlog_appender_queue_high_water_mark{appender=\"" << EscapeLabel(appender.name) << "\"} "
+			   << appender.queueHighWaterMark << "\n";
+		}
+		os << "# TYPE idlog_appender_dropped_total counter\n";
+		for (const auto &appender : snapshot.appenders)
+		{
+			for (size_t i = 0; i < AppenderMetrics::kDropPolicyCount; ++i)
+			{
+				os << "idlog_appender_dropped_total{appender=\"" << EscapeLabel(appender.name) << "\",policy=\""
+				   << kDropPolicyNames[i] << "\"} " << appender.dropped[i] << "\n";
+			}
+		}
+		os << "# TYPE idlog_appender_flush_nanoseconds summary\n";
+		for (const auto &appender : snapshot.appenders)
+		{
+			WritePrometheusSummary(os, "idlog_appender_flush_nanoseconds",
+								   "appender=\"" + EscapeLabel(appender.name) + "\"", appender.flushLatency);
+		}
+	}
+
+	/// @brief 以类似 top 的表格输出
+	/// @param os [IN/OUT] 输出流
+	/// @param path [IN] 文件路径
+	/// @param snapshot [IN] 快照
+	void WriteTable(std::ostream &os, const std::string &path, const StatsFile::Snapshot &snapshot)
+	{
+		std::time_t updated = static_cast<std::time_t>(snapshot.header.updateTimeMs / 1000);
+		std::tm tm = {};
+#ifdef _WIN32
+		localtime_s(&tm, &updated);
+#else
+		localtime_r(&updated, &tm);
+#endif
+		uint64_t nowMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count());
+		double age = nowMs > snapshot.header.updateTimeMs ? static_cast<double>(nowMs - snapshot.header.updateTimeMs) / 1000.0 : 0.0;
+
+		const StatsFile::Counters &global = snapshot.global;
+		os << std::fixed << std::setprecision(1)
+		   << "idlog-stat  pid " << snapshot.header.pid << "  " << path << "\n"
+		   << "updated " << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << " (" << age << "s ago, publish #"
+		   << snapshot.header.publishCount << ")\n\n"
+		   << "logs " << global.totalLogs << "  bytes " << global.totalBytes
+		   << "  dropped " << global.droppedLogs << " (" << global.droppedBytes << " bytes)\n"
+		   << "rate logs/s  1s " << global.logsPerSecond[0] << "  10s " << global.logsPerSecond[1]
+		   << "  60s " << global.logsPerSecond[2] << "\n"
+		   << "rate bytes/s 1s " << global.bytesPerSecond[0] << "  10s " << global.bytesPerSecond[1]
+		   << "  60s " << global.bytesPerSecond[2] << "\n\n";
+
+		os << std::left << std::setw(12) << "LATENCY(ns)" << std::right << std::setw(12) << "COUNT" << std::setw(10) << "MEAN"
+		   << std::setw(10) << "P50" << std::setw(10) << "P90" << std::setw(10) << "P99" << std::setw(10) << "P99.9"
+		   << std::setw(12) << "MAX" << "\n";
+		for (size_t i = 0; i < StatsFile::kLatencyTypeCount; ++i)
+		{
+			const StatsFile::LatencySummary &latency = global.latency[i];
+			os << std::left << std::setw(12) << kLatencyNames[i] << std::right << std::setw(12) << latency.count
+			   << std::setw(10) << latency.mean << std::setw(10) << latency.p50 << std::setw(10) << latency.p90
+			   << std::setw(10) << latency.p99 << std::setw(10) << latency.p999 << std::setw(12) << latency.max << "\n";
+		}
+
+		// 日志器按最近10秒速率降序
+		std::vector<const StatsFile::Counters *> loggers;
+		for (const auto &logger : snapshot.loggers)
+		{
+			loggers.push_back(&logger);
+		}
+		std::sort(loggers.begin(), loggers.end(), [](const StatsFile::Counters *lhs, const StatsFile::Counters *rhs)
+				  { return lhs->logsPerSecond[1] != rhs->logsPerSecond[1] ? lhs->logsPerSecond[1] > rhs->logsPerSecond[1]
+																		   : lhs->totalLogs > rhs->totalLogs; });
+		os << "\n"
+		   << std::left << std::setw(24) << "LOGGER" << std::right << std::setw(12) << "LOGS" << std::setw(14) << "BYTES"
+		   << std::setw(10) << "DROPPED" << std::setw(10) << "LOGS/1s" << std::setw(10) << "LOGS/10s"
+		   << std::setw(12) << "CALL P99" << "\n";
+		for (const StatsFile::Counters *logger : loggers)
+		{
+			os << std::left << std::setw(24) << logger->name << std::right << std::setw(12) << logger->totalLogs
+			   << std::setw(14) << logger->totalBytes << std::setw(10) << logger->droppedLogs
+			   << std::setw(10) << logger->logsPerSecond[0] << std::setw(10) << logger->logsPerSecond[1]
+			   << std::setw(12) << logger->latency[static_cast<size_t>(LatencyType::LOG_CALL)].p99 << "\n";
+		}
+
+		if (!snapshot.appenders.empty())
+		{
+			os << "\n"
+			   << std::left << std::setw(32) << "APPENDER" << std::right << std::setw(12) << "RECORDS" << std::setw(14) << "BYTES"
+			   << std::setw(10) << "WRITES" << std::setw(8) << "ERRORS" << std::setw(9) << "FLUSHES" << std::setw(7) << "ROLLS"
+			   << std::setw(8) << "HWM" << std::setw(10) << "DROPPED" << std::setw(12) << "FLUSH P99" << "\n";
+			for (const auto &appender : snapshot.appenders)
+			{
+				uint64_t dropped = 0;
+				for (uint64_t value : appender.dropped)
+				{
+					dropped += value;
+				}
+				os << std::left << std::setw(32) << appender.name << std::right << std::setw(12) << appender.records
+				   << std::setw(14) << appender.bytes << std::setw(10) << appender.writeCalls << std::setw(8) << appender.writeErrors
+				   << std::setw(9) << appender.flushes << std::setw(7) << appender.rollCount
+				   << std::setw(8) << appender.queueHighWaterMark << std::setw(10) << dropped
+				   << std::setw(12) << appender.flushLatency.p99 << "\n";
+			}
+		}
+	}
+} // namespace
+
+int main(int argc, char **argv)
+{
+	Options options;
+	if (!ParseArgs(argc, argv, options))
+	{
+		PrintUsage(argv[0]);
+		return 2;
+	}
+
+	std::string path = ResolvePath(options.input);
+	StatsFile statsFile;
+	if (!statsFile.Open(path))
+	{
+		std::cerr << "cannot open statistics file " << path << "\n";
+		return 1;
+	}
+
+	StatsFile::Snapshot snapshot;
+	if (options.prometheus || options.once)
+	{
+		if (!statsFile.Read(snapshot))
+		{
+			std::cerr << "statistics file is being updated too frequently, try again\n";
+			return 1;
+		}
+		if (options.prometheus)
+		{
+			WritePrometheus(std::cout, snapshot);
+		}
+		else
+		{
+			WriteTable(std::cout, path, snapshot);
+		}
+		return 0;
+	}
+
+	for (uint64_t iteration = 0; options.count == 0 || iteration < options.count; ++iteration)
+	{
+		if (iteration > 0)
+		{
+			std::this_thread::sleep_for(std::chrono::duration<double>(options.interval));
+		}
+		if (!statsFile.Read(snapshot))
+		{
+			continue;
+		}
+		std::ostringstream oss;
+		WriteTable(oss, path, snapshot);
+		std::cout << "\033[H\033[2J" << oss.str() << std::flush; // 清屏后重绘
+	}
+	return 0;
+}